@@ -1,11 +1,12 @@
 #include "gprat_c.hpp"
+#include <pybind11/functional.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 
 namespace py = pybind11;
 
 /**
- * @brief Adds classes `GP_data`, `Hyperparameters`, `GP` to Python module.
+ * @brief Adds classes `GP_data`, `Hyperparameters`, `GP`, `RandomFeatureGP` to Python module.
  */
 void init_gprat(py::module &m)
 {
@@ -45,6 +46,47 @@ void init_gprat(py::module &m)
         .def_readwrite("opt_iter", &gprat_hyper::AdamParams::opt_iter)
         .def("__repr__", &gprat_hyper::AdamParams::repr);
 
+    // Precision of the tiled CPU predictions
+    py::enum_<gprat::Precision>(m, "Precision", "Floating point precision of the tiled CPU predictions.")
+        .value("FP64", gprat::Precision::FP64)
+        .value("FP32", gprat::Precision::FP32)
+        .value("Mixed", gprat::Precision::Mixed);
+
+    // Storage precision of the cross-covariance tiles
+    py::enum_<gprat::StoragePrecision>(
+        m, "StoragePrecision", "Floating point precision in which the cross-covariance tiles are stored.")
+        .value("FP64", gprat::StoragePrecision::FP64)
+        .value("FP32", gprat::StoragePrecision::FP32);
+
+    // Uncertainty approximation of the recursive forecasts
+    py::enum_<cpu::ForecastUncertainty>(
+        m, "ForecastUncertainty", "Approximation of the uncertainty of recursive multi-step forecasts.")
+        .value("Off", cpu::ForecastUncertainty::Off)
+        .value("Naive", cpu::ForecastUncertainty::Naive)
+        .value("Linearized", cpu::ForecastUncertainty::Linearized);
+
+    // Sparse approximations of the training covariance by inducing points
+    py::enum_<cpu::SparseApproximation>(
+        m, "SparseApproximation", "Approximation of the training covariance by inducing points.")
+        .value("SoR", cpu::SparseApproximation::SoR)
+        .value("DTC", cpu::SparseApproximation::DTC)
+        .value("FITC", cpu::SparseApproximation::FITC)
+        .value("VFE", cpu::SparseApproximation::VFE);
+
+    // Rules to combine the predictions of the experts of the training tiles
+    py::enum_<cpu::ExpertAggregation>(m, "ExpertAggregation", "Rule to combine the predictions of the experts.")
+        .value("PoE", cpu::ExpertAggregation::PoE)
+        .value("gPoE", cpu::ExpertAggregation::gPoE)
+        .value("BCM", cpu::ExpertAggregation::BCM)
+        .value("rBCM", cpu::ExpertAggregation::rBCM);
+
+    // Convergence report of the mixed precision predictions
+    py::class_<cpu::RefinementReport>(m, "RefinementReport", "Convergence report of the mixed precision refinement.")
+        .def_readonly("iterations", &cpu::RefinementReport::iterations, "Number of FP32 solves")
+        .def_readonly("backward_error", &cpu::RefinementReport::backward_error, "Final normwise backward error")
+        .def_readonly("converged", &cpu::RefinementReport::converged, "True if FP64 accuracy was reached")
+        .def_readonly("fallback", &cpu::RefinementReport::fallback, "True if the prediction was recomputed in FP64");
+
     // Initializes Gaussian Process with `GP` class. Sets default parameters for
     // squared exponential kernel, number of regressors and trainable, unless
     // specified. Instance object has full access to parameters for squared
@@ -82,6 +124,28 @@ Parameters:
     n_streams (int): Number of streams for GPU computation. Default is 1.
              )pbdoc")
 
+        // CPU constructor with automatically tuned tiles
+        .def(py::init<std::vector<double>, std::vector<double>, int, std::vector<double>, std::vector<bool>>(),
+             py::arg("input_data"),
+             py::arg("output_data"),
+             py::arg("n_reg") = 8,
+             py::arg("kernel_params") = std::vector<double>{ 1.0, 1.0, 0.1 },
+             py::arg("trainable") = std::vector<bool>{ true, true, true },
+             R"pbdoc(
+Create Gaussian Process whose number of tiles and tile size are tuned per
+operation by calibration benchmarks on first use. The computations are
+performed on the CPU.
+
+Parameters:
+    input_data (list): Input data for the GP.
+    output_data (list): Output data for the GP.
+    n_reg (int): Number of regressors. Default is 8.
+    kernel_params (list): List of kernel hyperparameters. Default is
+        {1.0, 1.0, 0.1}
+    trainable (list): List of booleans for trainable hyperparameters. Default is
+        {true, true, true}.
+             )pbdoc")
+
         // GPU constructor
         .def(py::init<std::vector<double>,
                       std::vector<double>,
@@ -122,21 +186,203 @@ Parameters:
              )pbdoc")
         .def_readwrite("n_reg", &gprat::GP::n_reg)
         .def_readwrite("kernel_params", &gprat::GP::kernel_params)
+        .def_readwrite("small_problem_threshold", &gprat::GP::small_problem_threshold)
+        .def_readwrite("precision", &gprat::GP::precision)
+        .def_readwrite("cross_covariance_storage", &gprat::GP::cross_covariance_storage)
+        .def_readwrite("sparse_approximation", &gprat::GP::sparse_approximation)
+        .def_readwrite("vecchia_neighbours", &gprat::GP::vecchia_neighbours)
+        .def_readwrite("expert_aggregation", &gprat::GP::expert_aggregation)
+        .def_readwrite("blr_tolerance", &gprat::GP::blr_tolerance)
+        .def_readwrite("hodlr_tolerance", &gprat::GP::hodlr_tolerance)
+        .def_readwrite("cg_tolerance", &gprat::GP::cg_tolerance)
+        .def_readwrite("cg_max_iterations", &gprat::GP::cg_max_iterations)
+        .def_readwrite("cg_preconditioner_rank", &gprat::GP::cg_preconditioner_rank)
+        .def_readwrite("slq_probes", &gprat::GP::slq_probes)
+        .def_readwrite("slq_lanczos_steps", &gprat::GP::slq_lanczos_steps)
+        .def_readwrite("slq_seed", &gprat::GP::slq_seed)
+        .def_readwrite("compact_reorder", &gprat::GP::compact_reorder)
         .def("__repr__", &gprat::GP::repr)
         .def("get_input_data", &gprat::GP::get_training_input)
         .def("get_output_data", &gprat::GP::get_training_output)
+        .def("get_train_tiles", &gprat::GP::get_train_tiles, py::arg("operation"))
+        .def("get_refinement_report", &gprat::GP::get_refinement_report)
         .def("predict", &gprat::GP::predict, py::arg("test_data"), py::arg("m_tiles"), py::arg("m_tile_size"))
+        .def("predict_point", &gprat::GP::predict_point, py::arg("features"))
+        .def("predict_point_with_uncertainty", &gprat::GP::predict_point_with_uncertainty, py::arg("features"))
+        .def("predict_small_batch", &gprat::GP::predict_small_batch, py::arg("test_data"))
+        .def("forecast",
+             &gprat::GP::forecast,
+             py::arg("window"),
+             py::arg("horizon"),
+             py::arg("uncertainty") = cpu::ForecastUncertainty::Off)
+        .def("forecast_scenarios",
+             &gprat::GP::forecast_scenarios,
+             py::arg("windows"),
+             py::arg("horizon"),
+             py::arg("uncertainty") = cpu::ForecastUncertainty::Off)
         .def("predict_with_uncertainty",
              &gprat::GP::predict_with_uncertainty,
              py::arg("test_data"),
              py::arg("m_tiles"),
              py::arg("m_tile_size"))
+        .def("predict_with_uncertainty_streaming",
+             &gprat::GP::predict_with_uncertainty_streaming,
+             py::arg("test_data"),
+             py::arg("m_tiles"),
+             py::arg("m_tile_size"))
+        .def("predict_chunked",
+             &gprat::GP::predict_chunked,
+             py::arg("next_test_chunk"),
+             py::arg("consume_chunk"),
+             py::arg("with_uncertainty") = false)
         .def("predict_with_full_cov",
              &gprat::GP::predict_with_full_cov,
              py::arg("test_data"),
              py::arg("m_tiles"),
              py::arg("m_tile_size"))
+        .def("sample_posterior",
+             &gprat::GP::sample_posterior,
+             py::arg("test_data"),
+             py::arg("m_tiles"),
+             py::arg("m_tile_size"),
+             py::arg("n_samples"),
+             py::arg("seed") = 0)
         .def("optimize", &gprat::GP::optimize, py::arg("AdamParams"))
         .def("optimize_step", &gprat::GP::optimize_step, py::arg("AdamParams"), py::arg("iter"))
-        .def("compute_loss", &gprat::GP::calculate_loss);
+        .def("compute_loss", &gprat::GP::calculate_loss)
+        .def("set_inducing_points",
+             &gprat::GP::set_inducing_points,
+             py::arg("inducing_data"),
+             py::arg("inducing_tiles"),
+             py::arg("inducing_tile_size"))
+        .def("predict_sparse",
+             &gprat::GP::predict_sparse,
+             py::arg("test_data"),
+             py::arg("m_tiles"),
+             py::arg("m_tile_size"))
+        .def("predict_sparse_with_uncertainty",
+             &gprat::GP::predict_sparse_with_uncertainty,
+             py::arg("test_data"),
+             py::arg("m_tiles"),
+             py::arg("m_tile_size"))
+        .def("optimize_sparse", &gprat::GP::optimize_sparse, py::arg("AdamParams"))
+        .def("compute_sparse_loss", &gprat::GP::calculate_sparse_loss)
+        .def("predict_vecchia",
+             &gprat::GP::predict_vecchia,
+             py::arg("test_data"),
+             py::arg("m_tiles"),
+             py::arg("m_tile_size"))
+        .def("predict_vecchia_with_uncertainty",
+             &gprat::GP::predict_vecchia_with_uncertainty,
+             py::arg("test_data"),
+             py::arg("m_tiles"),
+             py::arg("m_tile_size"))
+        .def("optimize_vecchia", &gprat::GP::optimize_vecchia, py::arg("AdamParams"))
+        .def("compute_vecchia_loss", &gprat::GP::calculate_vecchia_loss)
+        .def("predict_experts",
+             &gprat::GP::predict_experts,
+             py::arg("test_data"),
+             py::arg("m_tiles"),
+             py::arg("m_tile_size"))
+        .def("predict_experts_with_uncertainty",
+             &gprat::GP::predict_experts_with_uncertainty,
+             py::arg("test_data"),
+             py::arg("m_tiles"),
+             py::arg("m_tile_size"))
+        .def("optimize_experts", &gprat::GP::optimize_experts, py::arg("AdamParams"))
+        .def("compute_experts_loss", &gprat::GP::calculate_experts_loss)
+        .def("predict_blr", &gprat::GP::predict_blr, py::arg("test_data"), py::arg("m_tiles"), py::arg("m_tile_size"))
+        .def("predict_blr_with_uncertainty",
+             &gprat::GP::predict_blr_with_uncertainty,
+             py::arg("test_data"),
+             py::arg("m_tiles"),
+             py::arg("m_tile_size"))
+        .def("compute_blr_loss", &gprat::GP::calculate_blr_loss)
+        .def("compute_blr_compression", &gprat::GP::calculate_blr_compression)
+        .def("predict_hodlr",
+             &gprat::GP::predict_hodlr,
+             py::arg("test_data"),
+             py::arg("m_tiles"),
+             py::arg("m_tile_size"))
+        .def("predict_hodlr_with_uncertainty",
+             &gprat::GP::predict_hodlr_with_uncertainty,
+             py::arg("test_data"),
+             py::arg("m_tiles"),
+             py::arg("m_tile_size"))
+        .def("compute_hodlr_loss", &gprat::GP::calculate_hodlr_loss)
+        .def("predict_cg", &gprat::GP::predict_cg, py::arg("test_data"), py::arg("m_tiles"), py::arg("m_tile_size"))
+        .def("predict_cg_with_uncertainty",
+             &gprat::GP::predict_cg_with_uncertainty,
+             py::arg("test_data"),
+             py::arg("m_tiles"),
+             py::arg("m_tile_size"))
+        .def("compute_slq_loss", &gprat::GP::calculate_slq_loss)
+        .def("optimize_slq", &gprat::GP::optimize_slq, py::arg("AdamParams"))
+        .def("predict_compact",
+             &gprat::GP::predict_compact,
+             py::arg("test_data"),
+             py::arg("m_tiles"),
+             py::arg("m_tile_size"))
+        .def("predict_compact_with_uncertainty",
+             &gprat::GP::predict_compact_with_uncertainty,
+             py::arg("test_data"),
+             py::arg("m_tiles"),
+             py::arg("m_tile_size"))
+        .def("compute_compact_loss", &gprat::GP::calculate_compact_loss)
+        .def("optimize_compact", &gprat::GP::optimize_compact, py::arg("AdamParams"))
+        .def("compute_compact_density", &gprat::GP::calculate_compact_density);
+
+    // Initializes Gaussian Process approximated by random Fourier features
+    // with `RandomFeatureGP` class. The computations are performed on the CPU.
+    py::class_<gprat::RandomFeatureGP>(m, "RandomFeatureGP")
+        .def(py::init<std::vector<double>,
+                      std::vector<double>,
+                      int,
+                      int,
+                      int,
+                      std::vector<double>,
+                      int,
+                      int,
+                      std::uint64_t>(),
+             py::arg("input_data"),
+             py::arg("output_data"),
+             py::arg("n_tiles"),
+             py::arg("n_tile_size"),
+             py::arg("n_reg") = 8,
+             py::arg("kernel_params") = std::vector<double>{ 1.0, 1.0, 0.1 },
+             py::arg("n_features") = 1024,
+             py::arg("n_feature_tiles") = 4,
+             py::arg("seed") = 0,
+             R"pbdoc(
+Create Gaussian Process whose squared exponential kernel is approximated by
+random Fourier features. The predictions solve a Bayesian linear regression on
+the features in O(n_samples * n_features^2). The computations are performed on
+the CPU.
+
+Parameters:
+    input_data (list): Input data for the GP.
+    output_data (list): Output data for the GP.
+    n_tiles (int): Number of tiles to split the input data.
+    n_tile_size (int): Size of each tile.
+    n_reg (int): Number of regressors. Default is 8.
+    kernel_params (list): List of kernel hyperparameters. Default is
+        {1.0, 1.0, 0.1}
+    n_features (int): Number of random features. Default is 1024.
+    n_feature_tiles (int): Number of tiles to split the features. Default is 4.
+    seed (int): Seed of the random features. Default is 0.
+             )pbdoc")
+        .def_readwrite("n_reg", &gprat::RandomFeatureGP::n_reg)
+        .def_readwrite("kernel_params", &gprat::RandomFeatureGP::kernel_params)
+        .def("__repr__", &gprat::RandomFeatureGP::repr)
+        .def("get_n_features", &gprat::RandomFeatureGP::get_n_features)
+        .def("predict",
+             &gprat::RandomFeatureGP::predict,
+             py::arg("test_data"),
+             py::arg("m_tiles"),
+             py::arg("m_tile_size"))
+        .def("predict_with_uncertainty",
+             &gprat::RandomFeatureGP::predict_with_uncertainty,
+             py::arg("test_data"),
+             py::arg("m_tiles"),
+             py::arg("m_tile_size"));
 }
@@ -37,7 +37,7 @@ void start_hpx_wrapper(std::vector<std::string> args, std::size_t n_cores)
 
 /**
  * @brief Add utility functions `compute_train_tiles`,
- * `compute_train_tile_size`, `compute_test_tiles`, `print`, `start_hpx`,
+ * `compute_train_tile_size`, `compute_test_tiles`, `compute_tuned_train_tiles`, `print`, `start_hpx`,
  * `resume_hpx`, `suspend_hpx`, `stop_hpx` to the module
  */
 void init_utils(py::module &m)
@@ -62,7 +62,9 @@ void init_utils(py::module &m)
           py::arg("n_samples"),
           py::arg("n_tiles"),
           R"pbdoc(
-          Compute the tile size for training data.
+          Compute the tile size for training data. The last tile contains the remainder.
+          Raises ValueError if n_tiles tiles of the rounded up size leave the last tile empty,
+          e.g. for 9 samples and 4 tiles. Use compute_train_tiles to obtain a valid number of tiles.
 
           Parameters:
               n_samples (int): Number of samples.
@@ -73,20 +75,63 @@ void init_utils(py::module &m)
           )pbdoc");
 
     m.def("compute_test_tiles",
-          &utils::compute_test_tiles,
+          py::overload_cast<int, int>(&utils::compute_test_tiles),
           py::arg("m_samples"),
-          py::arg("n_tiles"),
           py::arg("n_tile_size"),
           R"pbdoc(
           Compute the number of tiles for test data and the respective size of test tiles.
 
           Parameters:
               n_test (int): The number of test samples.
-              n_tiles (int): The number of tiles.
               n_tile_size (int): The size of each tile.
 
           Returns:
-              tuple: A tuple containing the number of test tiles and the adjusted tile size.
+              tuple: A tuple containing the number of test tiles and the test tile size. The last test tile
+              contains the remainder if n_tile_size does not divide n_test.
+          )pbdoc");
+
+    m.def(
+        "compute_test_tiles",
+        [](int m_samples, int, int n_tile_size) { return utils::compute_test_tiles(m_samples, n_tile_size); },
+        py::arg("m_samples"),
+        py::arg("n_tiles"),
+        py::arg("n_tile_size"),
+        R"pbdoc(
+          Deprecated: n_tiles is ignored, use compute_test_tiles(m_samples, n_tile_size) instead.
+
+          Parameters:
+              n_test (int): The number of test samples.
+              n_tiles (int): Unused number of training tiles.
+              n_tile_size (int): The size of each tile.
+
+          Returns:
+              tuple: A tuple containing the number of test tiles and the test tile size. The last test tile
+              contains the remainder if n_tile_size does not divide n_test.
+          )pbdoc");
+
+    py::enum_<gprat::TiledOperation>(m, "TiledOperation", "Tiled operations whose tile size can be tuned.")
+        .value("Cholesky", gprat::TiledOperation::Cholesky)
+        .value("Predict", gprat::TiledOperation::Predict)
+        .value("Optimize", gprat::TiledOperation::Optimize);
+
+    m.def("compute_tuned_train_tiles",
+          &utils::compute_tuned_train_tiles,
+          py::arg("n_samples"),
+          py::arg("n_regressors"),
+          py::arg("operation"),
+          R"pbdoc(
+          Compute the number of tiles and the tile size for training data, tuned
+          for an operation by calibration benchmarks on this machine. Results are
+          cached in the file given by GPRAT_TILE_CACHE (default
+          ~/.cache/gprat/tile_sizes.txt). Requires a running HPX runtime.
+
+          Parameters:
+              n_samples (int): Number of samples.
+              n_regressors (int): Number of regressors.
+              operation (TiledOperation): Operation to tune the tile size for.
+
+          Returns:
+              tuple: A tuple containing the number of tiles and the tile size.
           )pbdoc");
 
     m.def("print_vector",
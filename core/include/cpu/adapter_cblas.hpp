@@ -0,0 +1,133 @@
+#ifndef CPU_ADAPTER_CBLAS_H
+#define CPU_ADAPTER_CBLAS_H
+
+#include <hpx/future.hpp>
+#include <vector>
+
+// Constants that are compatible with CBLAS
+
+typedef enum BLAS_TRANSPOSE { Blas_no_trans = 111, Blas_trans = 112 } BLAS_TRANSPOSE;
+
+typedef enum BLAS_SIDE { Blas_left = 141, Blas_right = 142 } BLAS_SIDE;
+
+typedef enum BLAS_ALPHA { Blas_add = 1, Blas_substract = -1 } BLAS_ALPHA;
+
+// typedef enum BLAS_UPLO { Blas_upper = 121,
+//                          Blas_lower = 122 } BLAS_UPLO;
+
+// typedef enum BLAS_ORDERING { Blas_row_major = 101,
+//                              Blas_col_major = 102 } BLAS_ORDERING;
+
+// Tile operations templated on the scalar type T. They are specialized for
+// T = float in adapter_cblas_fp32.hpp and for T = double in
+// adapter_cblas_fp64.hpp, see there for the documentation.
+
+// BLAS level 3 operations
+
+template <typename T>
+std::vector<T> potrf(hpx::shared_future<std::vector<T>> f_A, const int N);
+
+template <typename T>
+std::vector<T> potrf_threaded(hpx::shared_future<std::vector<T>> f_A, const int N, const int n_threads);
+
+template <typename T>
+std::vector<T> potrs(hpx::shared_future<std::vector<T>> f_L, hpx::shared_future<std::vector<T>> f_a, const int N);
+
+template <typename T>
+std::vector<T> trsm(hpx::shared_future<std::vector<T>> f_L,
+                    hpx::shared_future<std::vector<T>> f_A,
+                    const int N,
+                    const int M,
+                    const BLAS_TRANSPOSE transpose_L,
+                    const BLAS_SIDE side_L);
+
+template <typename T>
+std::vector<T> trmm(hpx::shared_future<std::vector<T>> f_L,
+                    hpx::shared_future<std::vector<T>> f_A,
+                    const int N,
+                    const int M,
+                    const BLAS_TRANSPOSE transpose_L,
+                    const BLAS_SIDE side_L);
+
+template <typename T>
+std::vector<T> syrk(hpx::shared_future<std::vector<T>> f_A,
+                    hpx::shared_future<std::vector<T>> f_B,
+                    const int N,
+                    const int M,
+                    const BLAS_TRANSPOSE transpose_B);
+
+template <typename T>
+std::vector<T> gemm(hpx::shared_future<std::vector<T>> f_A,
+                    hpx::shared_future<std::vector<T>> f_B,
+                    hpx::shared_future<std::vector<T>> f_C,
+                    const int N,
+                    const int M,
+                    const int K,
+                    const BLAS_TRANSPOSE transpose_A,
+                    const BLAS_TRANSPOSE transpose_B);
+
+// BLAS level 2 operations
+
+template <typename T>
+std::vector<T> trsv(hpx::shared_future<std::vector<T>> f_L,
+                    hpx::shared_future<std::vector<T>> f_a,
+                    const int N,
+                    const BLAS_TRANSPOSE transpose_L);
+
+template <typename T>
+std::vector<T> gemv(hpx::shared_future<std::vector<T>> f_A,
+                    hpx::shared_future<std::vector<T>> f_a,
+                    hpx::shared_future<std::vector<T>> f_b,
+                    const int N,
+                    const int M,
+                    const BLAS_ALPHA alpha,
+                    const BLAS_TRANSPOSE transpose_A);
+
+template <typename T>
+std::vector<T>
+dot_diag_syrk(hpx::shared_future<std::vector<T>> f_A, hpx::shared_future<std::vector<T>> f_r, const int N, const int M);
+
+template <typename T>
+std::vector<T> dot_diag_gemm(hpx::shared_future<std::vector<T>> f_A,
+                             hpx::shared_future<std::vector<T>> f_B,
+                             hpx::shared_future<std::vector<T>> f_r,
+                             const int N,
+                             const int M);
+
+// Fused panel operations
+
+template <typename T>
+std::vector<std::vector<T>> trsm_panel(hpx::shared_future<std::vector<T>> f_L,
+                                       std::vector<hpx::shared_future<std::vector<T>>> ft_panel,
+                                       const int N,
+                                       const BLAS_TRANSPOSE transpose_L,
+                                       const BLAS_SIDE side_L);
+
+template <typename T>
+std::vector<std::vector<T>> trsm_panel_packed(hpx::shared_future<std::vector<T>> f_L,
+                                              std::vector<hpx::shared_future<std::vector<T>>> ft_panel,
+                                              const int N);
+
+template <typename T>
+std::vector<std::vector<T>> gemm_panel_packed(hpx::shared_future<std::vector<T>> f_A,
+                                              std::vector<hpx::shared_future<std::vector<T>>> ft_B,
+                                              std::vector<hpx::shared_future<std::vector<T>>> ft_C,
+                                              const int N,
+                                              const int M);
+
+template <typename T>
+std::vector<std::vector<T>> gemv_panel(std::vector<hpx::shared_future<std::vector<T>>> ft_A,
+                                       hpx::shared_future<std::vector<T>> f_a,
+                                       std::vector<hpx::shared_future<std::vector<T>>> ft_b,
+                                       const BLAS_ALPHA alpha,
+                                       const BLAS_TRANSPOSE transpose_A);
+
+// BLAS level 1 operations
+
+template <typename T>
+std::vector<T> axpy(hpx::shared_future<std::vector<T>> f_y, hpx::shared_future<std::vector<T>> f_x, const int N);
+
+template <typename T>
+T dot(std::vector<T> a, std::vector<T> b, const int N);
+
+#endif  // end of CPU_ADAPTER_CBLAS_H
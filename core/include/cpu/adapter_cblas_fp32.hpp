@@ -1,23 +1,12 @@
 #ifndef CPU_ADAPTER_CBLAS_FP32_H
 #define CPU_ADAPTER_CBLAS_FP32_H
 
+#include "cpu/adapter_cblas.hpp"
 #include <hpx/future.hpp>
 #include <vector>
-using vector_future = hpx::shared_future<std::vector<float>>;
-using vector = std::vector<float>;
 
-// Constants that are compatible with CBLAS
-typedef enum BLAS_TRANSPOSE { Blas_no_trans = 111, Blas_trans = 112 } BLAS_TRANSPOSE;
-
-typedef enum BLAS_SIDE { Blas_left = 141, Blas_right = 142 } BLAS_SIDE;
-
-typedef enum BLAS_ALPHA { Blas_add = 1, Blas_substract = -1 } BLAS_ALPHA;
-
-// typedef enum BLAS_UPLO { Blas_upper = 121,
-//                          Blas_lower = 122 } BLAS_UPLO;
-
-// typedef enum BLAS_ORDERING { Blas_row_major = 101,
-//                              Blas_col_major = 102 } BLAS_ORDERING;
+using vector_future_fp32 = hpx::shared_future<std::vector<float>>;
+using vector_fp32 = std::vector<float>;
 
 // BLAS level 3 operations
 
@@ -27,52 +16,106 @@ typedef enum BLAS_ALPHA { Blas_add = 1, Blas_substract = -1 } BLAS_ALPHA;
  * @param N matrix dimension
  * @return factorized, lower triangular matrix L
  */
-vector potrf(vector_future f_A, const int N);
+template <>
+vector_fp32 potrf<float>(vector_future_fp32 f_A, const int N);
+
+/**
+ * @brief FP32 In-place Cholesky decomposition of A using multiple BLAS threads
+ *
+ * Without GPRAT_ENABLE_HYBRID_BLAS this is equivalent to potrf. Otherwise this
+ * is the only adapter that uses more than the single global oneMKL thread set by
+ * utils::start_hpx_runtime.
+ *
+ * @param f_A matrix to be factorized
+ * @param N matrix dimension
+ * @param n_threads maximum number of BLAS threads
+ * @return factorized, lower triangular matrix L
+ */
+template <>
+vector_fp32 potrf_threaded<float>(vector_future_fp32 f_A, const int N, const int n_threads);
+
+/**
+ * @brief FP32 Solve K * x = a with the Cholesky factor L of K
+ * @param f_L Cholesky factor matrix
+ * @param f_a right hand side vector
+ * @param N matrix dimension
+ * @return solution vector x
+ */
+template <>
+vector_fp32 potrs<float>(vector_future_fp32 f_L, vector_future_fp32 f_a, const int N);
 
 /**
  * @brief FP32 In-place solve L(^T) * X = A or X * L(^T) = A where L lower triangular
  * @param f_L Cholesky factor matrix
  * @param f_A right hand side matrix
- * @param N first dimension
- * @param M second dimension
+ * @param N row dimension of A
+ * @param M column dimension of A
  * @return solution matrix X
  */
-vector trsm(vector_future f_L,
-            vector_future f_A,
-            const int N,
-            const int M,
-            const BLAS_TRANSPOSE transpose_L,
-            const BLAS_SIDE side_L);
+template <>
+vector_fp32 trsm<float>(vector_future_fp32 f_L,
+                        vector_future_fp32 f_A,
+                        const int N,
+                        const int M,
+                        const BLAS_TRANSPOSE transpose_L,
+                        const BLAS_SIDE side_L);
+
+/**
+ * @brief FP32 In-place multiply X = L(^T) * A or X = A * L(^T) where L lower triangular
+ * @param f_L Cholesky factor matrix
+ * @param f_A multiplied matrix
+ * @param N row dimension of A
+ * @param M column dimension of A
+ * @return product matrix X
+ */
+template <>
+vector_fp32 trmm<float>(vector_future_fp32 f_L,
+                        vector_future_fp32 f_A,
+                        const int N,
+                        const int M,
+                        const BLAS_TRANSPOSE transpose_L,
+                        const BLAS_SIDE side_L);
 
 /**
- * @brief FP32 Symmetric rank-k update: A = A - B * B^T
+ * @brief FP32 Symmetric rank-k update: A = A - B * B^T or A = A - B^T * B
+ *
+ * Only the lower triangle of A is updated.
+ *
  * @param f_A Base matrix
  * @param f_B Symmetric update matrix
  * @param N matrix dimension
+ * @param M inner dimension of the update
+ * @param transpose_B transpose update matrix, such that B is M x N
  * @return updated matrix A
  */
-vector syrk(vector_future f_A, vector_future f_B, const int N);
+template <>
+vector_fp32 syrk<float>(vector_future_fp32 f_A,
+                        vector_future_fp32 f_B,
+                        const int N,
+                        const int M,
+                        const BLAS_TRANSPOSE transpose_B);
 
 /**
  * @brief FP32 General matrix-matrix multiplication: C = C - A(^T) * B(^T)
  * @param f_C Base matrix
  * @param f_B Right update matrix
  * @param f_A Left update matrix
- * @param N first matrix dimension
- * @param M second matrix dimension
- * @param K third matrix dimension
+ * @param N inner dimension of A(^T) * B(^T)
+ * @param M column dimension of C
+ * @param K row dimension of C
  * @param transpose_A transpose left matrix
  * @param transpose_B transpose right matrix
  * @return updated matrix X
  */
-vector gemm(vector_future f_A,
-            vector_future f_B,
-            vector_future f_C,
-            const int N,
-            const int M,
-            const int K,
-            const BLAS_TRANSPOSE transpose_A,
-            const BLAS_TRANSPOSE transpose_B);
+template <>
+vector_fp32 gemm<float>(vector_future_fp32 f_A,
+                        vector_future_fp32 f_B,
+                        vector_future_fp32 f_C,
+                        const int N,
+                        const int M,
+                        const int K,
+                        const BLAS_TRANSPOSE transpose_A,
+                        const BLAS_TRANSPOSE transpose_B);
 
 // BLAS level 2 operations
 
@@ -84,7 +127,8 @@ vector gemm(vector_future f_A,
  * @param transpose_L transpose Cholesky factor
  * @return solution vector x
  */
-vector trsv(vector_future f_L, vector_future f_a, const int N, const BLAS_TRANSPOSE transpose_L);
+template <>
+vector_fp32 trsv<float>(vector_future_fp32 f_L, vector_future_fp32 f_a, const int N, const BLAS_TRANSPOSE transpose_L);
 
 /**
  * @brief FP32 General matrix-vector multiplication: b = b - A(^T) * a
@@ -96,13 +140,14 @@ vector trsv(vector_future f_L, vector_future f_a, const int N, const BLAS_TRANSP
  * @param transpose_A transpose update matrix
  * @return updated vector b
  */
-vector gemv(vector_future f_A,
-            vector_future f_a,
-            vector_future f_b,
-            const int N,
-            const int M,
-            const BLAS_ALPHA alpha,
-            const BLAS_TRANSPOSE transpose_A);
+template <>
+vector_fp32 gemv<float>(vector_future_fp32 f_A,
+                        vector_future_fp32 f_a,
+                        vector_future_fp32 f_b,
+                        const int N,
+                        const int M,
+                        const BLAS_ALPHA alpha,
+                        const BLAS_TRANSPOSE transpose_A);
 
 /**
  * @brief FP32 Vector update with diagonal SYRK: r = r + diag(A^T * A)
@@ -112,7 +157,8 @@ vector gemv(vector_future f_A,
  * @param M second matrix dimension
  * @return updated vector r
  */
-vector dot_diag_syrk(vector_future f_A, vector_future f_r, const int N, const int M);
+template <>
+vector_fp32 dot_diag_syrk<float>(vector_future_fp32 f_A, vector_future_fp32 f_r, const int N, const int M);
 
 /**
  * @brief FP32 Vector update with diagonal GEMM: r = r + diag(A * B)
@@ -123,7 +169,88 @@ vector dot_diag_syrk(vector_future f_A, vector_future f_r, const int N, const in
  * @param M second matrix dimension
  * @return updated vector r
  */
-vector dot_diag_gemm(vector_future f_A, vector_future f_B, vector_future f_r, const int N, const int M);
+template <>
+vector_fp32 dot_diag_gemm<float>(vector_future_fp32 f_A,
+                                 vector_future_fp32 f_B,
+                                 vector_future_fp32 f_r,
+                                 const int N,
+                                 const int M);
+
+// Fused panel operations
+
+/**
+ * @brief FP32 In-place solve X_i * L(^T) = A_i or L(^T) * X_i = A_i for all tiles A_i of a panel
+ *
+ * The other dimension of each A_i is derived from its size, such that the tiles may differ in size.
+ *
+ * @param f_L Cholesky factor matrix
+ * @param ft_panel right hand side matrices of the panel
+ * @param N dimension of the Cholesky factor
+ * @param transpose_L transpose Cholesky factor
+ * @param side_L side of the Cholesky factor
+ * @return solution matrices X_i
+ */
+template <>
+std::vector<vector_fp32> trsm_panel<float>(vector_future_fp32 f_L,
+                                           std::vector<vector_future_fp32> ft_panel,
+                                           const int N,
+                                           const BLAS_TRANSPOSE transpose_L,
+                                           const BLAS_SIDE side_L);
+
+/**
+ * @brief FP32 General matrix-vector multiplication for all tiles of a panel: b_i = b_i - A_i(^T) * a
+ *
+ * The dimensions of each A_i are derived from the sizes of a and b_i, such that the tiles may differ in size.
+ *
+ * @param ft_A update matrices of the panel
+ * @param f_a update vector
+ * @param ft_b base vectors of the panel
+ * @param alpha add or substract update to base vector
+ * @param transpose_A transpose update matrices
+ * @return updated vectors b_i
+ */
+template <>
+std::vector<vector_fp32> gemv_panel<float>(std::vector<vector_future_fp32> ft_A,
+                                           vector_future_fp32 f_a,
+                                           std::vector<vector_future_fp32> ft_b,
+                                           const BLAS_ALPHA alpha,
+                                           const BLAS_TRANSPOSE transpose_A);
+
+/**
+ * @brief FP32 In-place solve L * [X_1 | ... | X_c] = [A_1 | ... | A_c] with a single wide TRSM
+ *
+ * The N x M_i tiles A_i are packed side by side into one contiguous buffer, such that the solve
+ * runs as one BLAS call over all columns. The column count M_i of each tile is derived from its size.
+ *
+ * @param f_L Cholesky factor matrix
+ * @param ft_panel right hand side matrices of the panel
+ * @param N dimension of the Cholesky factor
+ * @return solution matrices X_i
+ */
+template <>
+std::vector<vector_fp32> trsm_panel_packed<float>(vector_future_fp32 f_L,
+                                                  std::vector<vector_future_fp32> ft_panel,
+                                                  const int N);
+
+/**
+ * @brief FP32 Update [C_1 | ... | C_c] = [C_1 | ... | C_c] - A * [B_1 | ... | B_c] with a single wide GEMM
+ *
+ * The tiles B_i and C_i are packed side by side into contiguous buffers. The column count of each
+ * pair is derived from the size of C_i.
+ *
+ * @param f_A update matrix of size N x M
+ * @param ft_B right update matrices of the panel with M rows
+ * @param ft_C base matrices of the panel with N rows
+ * @param N rows of A and C_i
+ * @param M columns of A and rows of B_i
+ * @return updated matrices C_i
+ */
+template <>
+std::vector<vector_fp32> gemm_panel_packed<float>(vector_future_fp32 f_A,
+                                                  std::vector<vector_future_fp32> ft_B,
+                                                  std::vector<vector_future_fp32> ft_C,
+                                                  const int N,
+                                                  const int M);
 
 // BLAS level 1 operations
 
@@ -134,7 +261,8 @@ vector dot_diag_gemm(vector_future f_A, vector_future f_B, vector_future f_r, co
  * @param N vector length
  * @return y - x
  */
-vector axpy(vector_future f_y, vector_future f_x, const int N);
+template <>
+vector_fp32 axpy<float>(vector_future_fp32 f_y, vector_future_fp32 f_x, const int N);
 
 /**
  * @brief FP32 Dot product: a * b
@@ -143,6 +271,7 @@ vector axpy(vector_future f_y, vector_future f_x, const int N);
  * @param N vector length
  * @return a * b
  */
-float dot(std::vector<float> a, std::vector<float> b, const int N);
+template <>
+float dot<float>(std::vector<float> a, std::vector<float> b, const int N);
 
 #endif  // end of CPU_ADAPTER_CBLAS_FP32_H
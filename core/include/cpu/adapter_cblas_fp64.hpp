@@ -1,26 +1,13 @@
 #ifndef CPU_ADAPTER_CBLAS_FP64_H
 #define CPU_ADAPTER_CBLAS_FP64_H
 
+#include "cpu/adapter_cblas.hpp"
 #include <hpx/future.hpp>
 #include <vector>
 
 using vector_future = hpx::shared_future<std::vector<double>>;
 using vector = std::vector<double>;
 
-// Constants that are compatible with CBLAS
-
-typedef enum BLAS_TRANSPOSE { Blas_no_trans = 111, Blas_trans = 112 } BLAS_TRANSPOSE;
-
-typedef enum BLAS_SIDE { Blas_left = 141, Blas_right = 142 } BLAS_SIDE;
-
-typedef enum BLAS_ALPHA { Blas_add = 1, Blas_substract = -1 } BLAS_ALPHA;
-
-// typedef enum BLAS_UPLO { Blas_upper = 121,
-//                          Blas_lower = 122 } BLAS_UPLO;
-
-// typedef enum BLAS_ORDERING { Blas_row_major = 101,
-//                              Blas_col_major = 102 } BLAS_ORDERING;
-
 // BLAS level 3 operations
 
 /**
@@ -29,52 +16,102 @@ typedef enum BLAS_ALPHA { Blas_add = 1, Blas_substract = -1 } BLAS_ALPHA;
  * @param N matrix dimension
  * @return factorized, lower triangular matrix L
  */
-vector potrf(vector_future f_A, const int N);
+template <>
+vector potrf<double>(vector_future f_A, const int N);
+
+/**
+ * @brief FP64 In-place Cholesky decomposition of A using multiple BLAS threads
+ *
+ * Without GPRAT_ENABLE_HYBRID_BLAS this is equivalent to potrf. Otherwise this
+ * is the only adapter that uses more than the single global oneMKL thread set by
+ * utils::start_hpx_runtime.
+ *
+ * @param f_A matrix to be factorized
+ * @param N matrix dimension
+ * @param n_threads maximum number of BLAS threads
+ * @return factorized, lower triangular matrix L
+ */
+template <>
+vector potrf_threaded<double>(vector_future f_A, const int N, const int n_threads);
+
+/**
+ * @brief FP64 Solve K * x = a with the Cholesky factor L of K
+ * @param f_L Cholesky factor matrix
+ * @param f_a right hand side vector
+ * @param N matrix dimension
+ * @return solution vector x
+ */
+template <>
+vector potrs<double>(vector_future f_L, vector_future f_a, const int N);
 
 /**
  * @brief FP64 In-place solve L(^T) * X = A or X * L(^T) = A where L lower triangular
  * @param f_L Cholesky factor matrix
  * @param f_A right hand side matrix
- * @param N first dimension
- * @param M second dimension
+ * @param N row dimension of A
+ * @param M column dimension of A
  * @return solution matrix X
  */
-vector trsm(vector_future f_L,
-            vector_future f_A,
-            const int N,
-            const int M,
-            const BLAS_TRANSPOSE transpose_L,
-            const BLAS_SIDE side_L);
+template <>
+vector trsm<double>(vector_future f_L,
+                    vector_future f_A,
+                    const int N,
+                    const int M,
+                    const BLAS_TRANSPOSE transpose_L,
+                    const BLAS_SIDE side_L);
 
 /**
- * @brief FP64 Symmetric rank-k update: A = A - B * B^T
+ * @brief FP64 In-place multiply X = L(^T) * A or X = A * L(^T) where L lower triangular
+ * @param f_L Cholesky factor matrix
+ * @param f_A multiplied matrix
+ * @param N row dimension of A
+ * @param M column dimension of A
+ * @return product matrix X
+ */
+template <>
+vector trmm<double>(vector_future f_L,
+                    vector_future f_A,
+                    const int N,
+                    const int M,
+                    const BLAS_TRANSPOSE transpose_L,
+                    const BLAS_SIDE side_L);
+
+/**
+ * @brief FP64 Symmetric rank-k update: A = A - B * B^T or A = A - B^T * B
+ *
+ * Only the lower triangle of A is updated.
+ *
  * @param f_A Base matrix
  * @param f_B Symmetric update matrix
  * @param N matrix dimension
+ * @param M inner dimension of the update
+ * @param transpose_B transpose update matrix, such that B is M x N
  * @return updated matrix A
  */
-vector syrk(vector_future f_A, vector_future f_B, const int N);
+template <>
+vector syrk<double>(vector_future f_A, vector_future f_B, const int N, const int M, const BLAS_TRANSPOSE transpose_B);
 
 /**
  * @brief FP64 General matrix-matrix multiplication: C = C - A(^T) * B(^T)
  * @param f_C Base matrix
  * @param f_B Right update matrix
  * @param f_A Left update matrix
- * @param N first matrix dimension
- * @param M second matrix dimension
- * @param K third matrix dimension
+ * @param N inner dimension of A(^T) * B(^T)
+ * @param M column dimension of C
+ * @param K row dimension of C
  * @param transpose_A transpose left matrix
  * @param transpose_B transpose right matrix
  * @return updated matrix X
  */
-vector gemm(vector_future f_A,
-            vector_future f_B,
-            vector_future f_C,
-            const int N,
-            const int M,
-            const int K,
-            const BLAS_TRANSPOSE transpose_A,
-            const BLAS_TRANSPOSE transpose_B);
+template <>
+vector gemm<double>(vector_future f_A,
+                    vector_future f_B,
+                    vector_future f_C,
+                    const int N,
+                    const int M,
+                    const int K,
+                    const BLAS_TRANSPOSE transpose_A,
+                    const BLAS_TRANSPOSE transpose_B);
 
 // BLAS level 2 operations
 
@@ -86,7 +123,8 @@ vector gemm(vector_future f_A,
  * @param transpose_L transpose Cholesky factor
  * @return solution vector x
  */
-vector trsv(vector_future f_L, vector_future f_a, const int N, const BLAS_TRANSPOSE transpose_L);
+template <>
+vector trsv<double>(vector_future f_L, vector_future f_a, const int N, const BLAS_TRANSPOSE transpose_L);
 
 /**
  * @brief FP64 General matrix-vector multiplication: b = b - A(^T) * a
@@ -98,13 +136,14 @@ vector trsv(vector_future f_L, vector_future f_a, const int N, const BLAS_TRANSP
  * @param transpose_A transpose update matrix
  * @return updated vector b
  */
-vector gemv(vector_future f_A,
-            vector_future f_a,
-            vector_future f_b,
-            const int N,
-            const int M,
-            const BLAS_ALPHA alpha,
-            const BLAS_TRANSPOSE transpose_A);
+template <>
+vector gemv<double>(vector_future f_A,
+                    vector_future f_a,
+                    vector_future f_b,
+                    const int N,
+                    const int M,
+                    const BLAS_ALPHA alpha,
+                    const BLAS_TRANSPOSE transpose_A);
 
 /**
  * @brief FP64 Vector update with diagonal SYRK: r = r + diag(A^T * A)
@@ -114,7 +153,8 @@ vector gemv(vector_future f_A,
  * @param M second matrix dimension
  * @return updated vector r
  */
-vector dot_diag_syrk(vector_future f_A, vector_future f_r, const int N, const int M);
+template <>
+vector dot_diag_syrk<double>(vector_future f_A, vector_future f_r, const int N, const int M);
 
 /**
  * @brief FP64 Vector update with diagonal GEMM: r = r + diag(A * B)
@@ -125,7 +165,84 @@ vector dot_diag_syrk(vector_future f_A, vector_future f_r, const int N, const in
  * @param M second matrix dimension
  * @return updated vector r
  */
-vector dot_diag_gemm(vector_future f_A, vector_future f_B, vector_future f_r, const int N, const int M);
+template <>
+vector dot_diag_gemm<double>(vector_future f_A, vector_future f_B, vector_future f_r, const int N, const int M);
+
+// Fused panel operations
+
+/**
+ * @brief FP64 In-place solve X_i * L(^T) = A_i or L(^T) * X_i = A_i for all tiles A_i of a panel
+ *
+ * The other dimension of each A_i is derived from its size, such that the tiles may differ in size.
+ *
+ * @param f_L Cholesky factor matrix
+ * @param ft_panel right hand side matrices of the panel
+ * @param N dimension of the Cholesky factor
+ * @param transpose_L transpose Cholesky factor
+ * @param side_L side of the Cholesky factor
+ * @return solution matrices X_i
+ */
+template <>
+std::vector<vector> trsm_panel<double>(vector_future f_L,
+                                       std::vector<vector_future> ft_panel,
+                                       const int N,
+                                       const BLAS_TRANSPOSE transpose_L,
+                                       const BLAS_SIDE side_L);
+
+/**
+ * @brief FP64 General matrix-vector multiplication for all tiles of a panel: b_i = b_i - A_i(^T) * a
+ *
+ * The dimensions of each A_i are derived from the sizes of a and b_i, such that the tiles may differ in size.
+ *
+ * @param ft_A update matrices of the panel
+ * @param f_a update vector
+ * @param ft_b base vectors of the panel
+ * @param alpha add or substract update to base vector
+ * @param transpose_A transpose update matrices
+ * @return updated vectors b_i
+ */
+template <>
+std::vector<vector> gemv_panel<double>(std::vector<vector_future> ft_A,
+                                       vector_future f_a,
+                                       std::vector<vector_future> ft_b,
+                                       const BLAS_ALPHA alpha,
+                                       const BLAS_TRANSPOSE transpose_A);
+
+/**
+ * @brief FP64 In-place solve L * [X_1 | ... | X_c] = [A_1 | ... | A_c] with a single wide TRSM
+ *
+ * The N x M_i tiles A_i are packed side by side into one contiguous buffer, such that the solve
+ * runs as one BLAS call over all columns. The column count M_i of each tile is derived from its size.
+ *
+ * @param f_L Cholesky factor matrix
+ * @param ft_panel right hand side matrices of the panel
+ * @param N dimension of the Cholesky factor
+ * @return solution matrices X_i
+ */
+template <>
+std::vector<vector> trsm_panel_packed<double>(vector_future f_L,
+                                              std::vector<vector_future> ft_panel,
+                                              const int N);
+
+/**
+ * @brief FP64 Update [C_1 | ... | C_c] = [C_1 | ... | C_c] - A * [B_1 | ... | B_c] with a single wide GEMM
+ *
+ * The tiles B_i and C_i are packed side by side into contiguous buffers. The column count of each
+ * pair is derived from the size of C_i.
+ *
+ * @param f_A update matrix of size N x M
+ * @param ft_B right update matrices of the panel with M rows
+ * @param ft_C base matrices of the panel with N rows
+ * @param N rows of A and C_i
+ * @param M columns of A and rows of B_i
+ * @return updated matrices C_i
+ */
+template <>
+std::vector<vector> gemm_panel_packed<double>(vector_future f_A,
+                                              std::vector<vector_future> ft_B,
+                                              std::vector<vector_future> ft_C,
+                                              const int N,
+                                              const int M);
 
 // BLAS level 1 operations
 
@@ -136,7 +253,8 @@ vector dot_diag_gemm(vector_future f_A, vector_future f_B, vector_future f_r, co
  * @param N vector length
  * @return y - x
  */
-vector axpy(vector_future f_y, vector_future f_x, const int N);
+template <>
+vector axpy<double>(vector_future f_y, vector_future f_x, const int N);
 
 /**
  * @brief FP64 Dot product: a * b
@@ -145,6 +263,7 @@ vector axpy(vector_future f_y, vector_future f_x, const int N);
  * @param N vector length
  * @return a * b
  */
-double dot(std::vector<double> a, std::vector<double> b, const int N);
+template <>
+double dot<double>(std::vector<double> a, std::vector<double> b, const int N);
 
 #endif  // end of CPU_ADAPTER_CBLAS_FP64_H
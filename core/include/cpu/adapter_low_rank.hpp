@@ -0,0 +1,112 @@
+#ifndef CPU_ADAPTER_LOW_RANK_H
+#define CPU_ADAPTER_LOW_RANK_H
+
+#include "cpu/adapter_cblas.hpp"
+#include <cstddef>
+#include <hpx/future.hpp>
+#include <vector>
+
+/**
+ * @brief Tile A = U * V^T of rank r in low-rank form
+ *
+ * U and V are stored row-major with r columns, such that the tile requires
+ * (n_rows + n_cols) * r instead of n_rows * n_cols elements. A tile of rank 0 is zero.
+ */
+struct LowRankTile
+{
+    std::size_t n_rows = 0;
+    std::size_t n_cols = 0;
+    std::size_t rank = 0;
+    /** @brief Left factor of size n_rows x rank */
+    std::vector<double> U;
+    /** @brief Right factor of size n_cols x rank */
+    std::vector<double> V;
+};
+
+using low_rank_future = hpx::shared_future<LowRankTile>;
+using dense_future = hpx::shared_future<std::vector<double>>;
+
+// Compression
+
+/**
+ * @brief FP64 Truncate a low-rank tile to the smallest rank that keeps its relative accuracy
+ *
+ * The factors are orthogonalized with QR decompositions and the singular values of the
+ * small core matrix are truncated, such that ||A - A_r||_F <= tolerance * ||A||_F.
+ *
+ * @param A tile to recompress
+ * @param tolerance relative truncation tolerance in the Frobenius norm
+ * @return recompressed tile with orthonormal right factor V
+ */
+LowRankTile recompress_low_rank(LowRankTile A, const double tolerance);
+
+/**
+ * @brief FP64 Number of stored elements of a low-rank tile
+ * @param A low-rank tile
+ * @return (n_rows + n_cols) * rank
+ */
+std::size_t low_rank_size(const LowRankTile &A);
+
+// BLAS level 3 operations on low-rank tiles
+
+/**
+ * @brief FP64 Solve X * L^T = A where L lower triangular and A low-rank
+ *
+ * Only the right factor is solved: X = U * (L^-1 * V)^T.
+ *
+ * @param f_L Cholesky factor matrix
+ * @param f_A right hand side low-rank matrix
+ * @return solution matrix X in low-rank form
+ */
+LowRankTile trsm_low_rank(dense_future f_L, low_rank_future f_A);
+
+/**
+ * @brief FP64 Symmetric update of a dense tile with a low-rank tile: A = A - B * B^T
+ * @param f_A dense base matrix of size n x n, n the row dimension of B
+ * @param f_B low-rank update matrix
+ * @return updated dense matrix A
+ */
+std::vector<double> syrk_low_rank(dense_future f_A, low_rank_future f_B);
+
+/**
+ * @brief FP64 Update of a low-rank tile with low-rank tiles: C = C - A * B^T
+ *
+ * The update has at most rank min(rank(A), rank(B)) and is appended to the factors of C,
+ * which are recompressed afterwards.
+ *
+ * @param f_A left low-rank update matrix
+ * @param f_B right low-rank update matrix
+ * @param f_C low-rank base matrix
+ * @param tolerance relative truncation tolerance in the Frobenius norm
+ * @return updated matrix C in low-rank form
+ */
+LowRankTile gemm_low_rank(low_rank_future f_A, low_rank_future f_B, low_rank_future f_C, const double tolerance);
+
+/**
+ * @brief FP64 Update of a dense tile with a low-rank tile: C = C - A * B
+ * @param f_A low-rank update matrix of size N x K
+ * @param f_B dense update matrix of size K x M
+ * @param f_C dense base matrix of size N x M
+ * @param M column dimension of B and C
+ * @return updated dense matrix C
+ */
+std::vector<double> gemm_low_rank_dense(low_rank_future f_A, dense_future f_B, dense_future f_C, const int M);
+
+// BLAS level 2 operations on low-rank tiles
+
+/**
+ * @brief FP64 Matrix-vector multiplication with a low-rank tile: b = b -/+ A(^T) * a
+ * @param f_A low-rank update matrix
+ * @param f_a update vector
+ * @param f_b base vector
+ * @param alpha add or substract update to base vector
+ * @param transpose_A transpose update matrix
+ * @return updated vector b
+ */
+std::vector<double> gemv_low_rank(low_rank_future f_A,
+                                  dense_future f_a,
+                                  dense_future f_b,
+                                  const BLAS_ALPHA alpha,
+                                  const BLAS_TRANSPOSE transpose_A);
+
+#endif  // end of CPU_ADAPTER_LOW_RANK_H
@@ -1,12 +1,41 @@
 #ifndef CPU_GP_ALGORITHMS_H
 #define CPU_GP_ALGORITHMS_H
 
+#include "cpu/adapter_low_rank.hpp"
 #include "gp_kernels.hpp"
+#include <cstdint>
 #include <vector>
 
 namespace cpu
 {
 
+/**
+ * @brief Compute the number of samples covered by the tiles of lagged data
+ *
+ * The data contains n_regressors - 1 leading entries. If it holds fewer than
+ * n_tiles * N samples, the last tile is smaller and contains the remainder.
+ *
+ * @param n_tiles The number of tiles
+ * @param N The size of a regular tile
+ * @param data_size The size of the data vector
+ * @param n_regressors The number of regressors
+ *
+ * @return The number of samples in all tiles
+ * @throws std::invalid_argument if the last tile would be empty
+ */
+std::size_t compute_n_samples(std::size_t n_tiles, std::size_t N, std::size_t data_size, std::size_t n_regressors);
+
+/**
+ * @brief Compute the size of a tile, where the last tile may be smaller
+ *
+ * @param k The index of the tile
+ * @param N The size of a regular tile
+ * @param n_total The number of elements in all tiles
+ *
+ * @return The size of tile k
+ */
+std::size_t compute_tile_size(std::size_t k, std::size_t N, std::size_t n_total);
+
 /**
  * @brief Compute the squared exponential kernel of two feature vectors
  *
@@ -32,17 +61,22 @@ double compute_covariance_function(std::size_t i_global,
  * @param input The input data vector
  * @param row The row index of the tile in the tiled matrix
  * @param col The column index of the tile in the tiled matrix
- * @param N The dimension of the quadratic tile (N*N elements)
+ * @param N The dimension of a regular quadratic tile (N*N elements)
+ * @param n_samples The number of samples, the last tile contains the remainder
  * @param n_regressors The number of regressors
  * @param sek_params The kernel hyperparameters
  *
- * @return A quadratic tile of the covariance matrix of size N x N
+ * @tparam T The scalar type of the tile
+ *
+ * @return A tile of the covariance matrix of size N x N, smaller in the last tile row or column
  * @note Does apply noise variance on the diagonal
  */
-std::vector<double> gen_tile_covariance(
+template <typename T = double>
+std::vector<T> gen_tile_covariance(
     std::size_t row,
     std::size_t col,
     std::size_t N,
+    std::size_t n_samples,
     std::size_t n_regressors,
     const gprat_hyper::SEKParams &sek_params,
     const std::vector<double> &input);
@@ -52,19 +86,24 @@ std::vector<double> gen_tile_covariance(
  *
  * @param row The row index of the tile in the tiled matrix
  * @param col The column index of the tile in the tiled matrix
- * @param N The dimension of the quadratic tile
+ * @param N The dimension of a regular quadratic tile
+ * @param n_samples The number of samples, the last tile contains the remainder
  * @param n_regressors The number of regressors
  * @param hyperparameters The kernel hyperparameters
  * @param input The input data vector
  *
- * @return A quadratic tile of the prior covariance matrix of size N x N
+ * @tparam T The scalar type of the tile
+ *
+ * @return A tile of the prior covariance matrix of size N x N, smaller in the last tile row or column
  * @note Does NOT apply noise variance on the diagonal
  */
 // NAME: gen_tile_priot_covariance
-std::vector<double> gen_tile_full_prior_covariance(
+template <typename T = double>
+std::vector<T> gen_tile_full_prior_covariance(
     std::size_t row,
     std::size_t col,
     std::size_t N,
+    std::size_t n_samples,
     std::size_t n_regressors,
     const gprat_hyper::SEKParams &sek_params,
     const std::vector<double> &input);
@@ -74,19 +113,24 @@ std::vector<double> gen_tile_full_prior_covariance(
  *
  * @param row The row index of the tile in the tiled matrix
  * @param col The column index of the tile in the tiled matrix
- * @param N The dimension of the tile diagonal
+ * @param N The dimension of a regular tile diagonal
+ * @param n_samples The number of samples, the last tile contains the remainder
  * @param n_regressors The number of regressors
  * @param hyperparameters The kernel hyperparameters
  * @param input The input data vector
  *
+ * @tparam T The scalar type of the tile
+ *
  * @return The diagonal of size N of a tile of the prior covariance matrix of size N x N
  * @note Does NOT apply noise variance
  */
 // NAME: gen_tile_diag_prior_covariance
-std::vector<double> gen_tile_prior_covariance(
+template <typename T = double>
+std::vector<T> gen_tile_prior_covariance(
     std::size_t row,
     std::size_t col,
     std::size_t N,
+    std::size_t n_samples,
     std::size_t n_regressors,
     const gprat_hyper::SEKParams &sek_params,
     const std::vector<double> &input);
@@ -96,25 +140,93 @@ std::vector<double> gen_tile_prior_covariance(
  *
  * @param row The row index of the tile in the tiled matrix
  * @param col The column index of the tile in the tiled matrix
- * @param N_row The row-wise dimension of the tile
- * @param N_col The column-wise dimension of the tile
+ * @param N_row The row-wise dimension of a regular tile
+ * @param N_col The column-wise dimension of a regular tile
+ * @param n_row_samples The number of row-wise samples, the last tile row contains the remainder
+ * @param n_col_samples The number of column-wise samples, the last tile column contains the remainder
  * @param n_regressors The number of regressors
  * @param hyperparameters The kernel hyperparameters
  * @param input The input data vector
  *
- * @return A tile of the cross covariance matrix of size N_row x N_col
+ * @tparam T The scalar type of the tile
+ *
+ * @return A tile of the cross covariance matrix of size N_row x N_col, smaller in the last tile row or column
  * @note Does NOT apply noise variance
  */
-std::vector<double> gen_tile_cross_covariance(
+template <typename T = double>
+std::vector<T> gen_tile_cross_covariance(
     std::size_t row,
     std::size_t col,
     std::size_t N_row,
     std::size_t N_col,
+    std::size_t n_row_samples,
+    std::size_t n_col_samples,
     std::size_t n_regressors,
     const gprat_hyper::SEKParams &sek_params,
     const std::vector<double> &row_input,
     const std::vector<double> &col_input);
 
+/**
+ * @brief Generate a block of the cross-covariance matrix in low-rank form
+ *
+ * Uses adaptive cross approximation with partial pivoting, which evaluates only the
+ * O((N_block_row + N_block_col) * r) entries of the pivot rows and columns for a block
+ * of rank r. The approximation is recompressed to the smallest rank within the tolerance.
+ *
+ * @param row_begin The index of the first row-wise sample of the block
+ * @param col_begin The index of the first column-wise sample of the block
+ * @param N_block_row The row-wise dimension of the block
+ * @param N_block_col The column-wise dimension of the block
+ * @param n_regressors The number of regressors
+ * @param hyperparameters The kernel hyperparameters
+ * @param row_input The row-wise input data vector
+ * @param col_input The column-wise input data vector
+ * @param tolerance The relative approximation tolerance in the Frobenius norm
+ *
+ * @return A block of the cross covariance matrix of size N_block_row x N_block_col in low-rank form
+ * @note Does NOT apply noise variance, such that off-diagonal blocks of the covariance
+ *       matrix are generated with the training input as row and column input
+ */
+LowRankTile gen_block_cross_covariance_low_rank(std::size_t row_begin,
+                                                std::size_t col_begin,
+                                                std::size_t N_block_row,
+                                                std::size_t N_block_col,
+                                                std::size_t n_regressors,
+                                                const gprat_hyper::SEKParams &sek_params,
+                                                const std::vector<double> &row_input,
+                                                const std::vector<double> &col_input,
+                                                double tolerance);
+
+/**
+ * @brief Generate a tile of the cross-covariance matrix in low-rank form,
+ * see gen_block_cross_covariance_low_rank
+ *
+ * @param row The row index of the tile in the tiled matrix
+ * @param col The column index of the tile in the tiled matrix
+ * @param N_row The row-wise dimension of a regular tile
+ * @param N_col The column-wise dimension of a regular tile
+ * @param n_row_samples The number of row-wise samples, the last tile row contains the remainder
+ * @param n_col_samples The number of column-wise samples, the last tile column contains the remainder
+ * @param n_regressors The number of regressors
+ * @param hyperparameters The kernel hyperparameters
+ * @param row_input The row-wise input data vector
+ * @param col_input The column-wise input data vector
+ * @param tolerance The relative approximation tolerance in the Frobenius norm
+ *
+ * @return A tile of the cross covariance matrix of size N_row x N_col in low-rank form
+ */
+LowRankTile gen_tile_cross_covariance_low_rank(std::size_t row,
+                                               std::size_t col,
+                                               std::size_t N_row,
+                                               std::size_t N_col,
+                                               std::size_t n_row_samples,
+                                               std::size_t n_col_samples,
+                                               std::size_t n_regressors,
+                                               const gprat_hyper::SEKParams &sek_params,
+                                               const std::vector<double> &row_input,
+                                               const std::vector<double> &col_input,
+                                               double tolerance);
+
 /**
  * @brief Transpose a tile of size N_row x N_col
  *
@@ -122,20 +234,28 @@ std::vector<double> gen_tile_cross_covariance(
  * @param N_col The column-wise dimension of the tile
  * @param tile The tile to transpose
  *
+ * @tparam T The scalar type of the tile
+ *
  * @return The transposed tile of size N_col x N_row
  */
-std::vector<double> gen_tile_transpose(std::size_t N_row, std::size_t N_col, const std::vector<double> &tile);
+template <typename T = double>
+std::vector<T> gen_tile_transpose(std::size_t N_row, std::size_t N_col, const std::vector<T> &tile);
 
 /**
  * @brief Generate a tile of the output data
  *
  * @param row The row index of the tile in relation to the tiled matrix
- * @param N The size of the tile
+ * @param N The size of a regular tile
+ * @param n_samples The number of samples, the last tile contains the remainder
  * @param output The output data vector
  *
- * @return A tile of the output data of size N
+ * @tparam T The scalar type of the tile
+ *
+ * @return A tile of the output data of size N, smaller for the last tile
  */
-std::vector<double> gen_tile_output(std::size_t row, std::size_t N, const std::vector<double> &output);
+template <typename T = double>
+std::vector<T>
+gen_tile_output(std::size_t row, std::size_t N, std::size_t n_samples, const std::vector<double> &output);
 
 /**
  * @brief Compute the L2-error norm over all tiles and elements
@@ -156,17 +276,49 @@ double compute_error_norm(std::size_t n_tiles,
  *
  * @param N The size of the tile
  *
+ * @tparam T The scalar type of the tile
+ *
  * @return A tile filled with zeros of size N
  */
-std::vector<double> gen_tile_zeros(std::size_t N);
+template <typename T = double>
+std::vector<T> gen_tile_zeros(std::size_t N);
 
 /**
  * @brief Generate an identity tile (i==j?1:0)
  *
  * @param N The dimension of the quadratic tile
+ * @tparam T The scalar type of the tile
  * @return A NxN identity tile
  */
-std::vector<double> gen_tile_identity(std::size_t N);
+template <typename T = double>
+std::vector<T> gen_tile_identity(std::size_t N);
+
+/**
+ * @brief Generate a tile of independent standard normal samples
+ *
+ * Each tile draws from its own generator seeded with the seed and the row index,
+ * such that the samples do not depend on the order in which the tiles are generated.
+ *
+ * @param row The row index of the tile in relation to the tiled matrix
+ * @param N The size of a regular tile
+ * @param n_samples The number of rows of the tiled matrix, the last tile contains the remainder
+ * @param n_columns The number of columns of the tile
+ * @param seed The seed of the random number generator
+ *
+ * @return A row-major tile of size N x n_columns, fewer rows for the last tile
+ */
+std::vector<double> gen_tile_standard_normal(
+    std::size_t row, std::size_t N, std::size_t n_samples, std::size_t n_columns, std::uint64_t seed);
+
+/**
+ * @brief Generate a tile whose columns are copies of a vector
+ *
+ * @param column The column vector of size N
+ * @param n_columns The number of columns of the tile
+ *
+ * @return A row-major tile of size N x n_columns
+ */
+std::vector<double> gen_tile_repeated_column(const std::vector<double> &column, std::size_t n_columns);
 
 }  // end of namespace cpu
 
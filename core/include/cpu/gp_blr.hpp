@@ -0,0 +1,103 @@
+#ifndef CPU_GP_BLR_H
+#define CPU_GP_BLR_H
+
+#include "gp_hyperparameters.hpp"
+#include "gp_kernels.hpp"
+#include <vector>
+
+namespace cpu
+{
+
+// Block low-rank (BLR) mode: the off-diagonal tiles of the covariance matrix are smooth
+// and numerically low-rank, such that they are assembled in low-rank form U * V^T by
+// adaptive cross approximation to a relative tolerance. The tiled Cholesky decomposition
+// and the triangular solves keep their DAG but operate on the low-rank tiles, which
+// reduces memory and flops from O(N^2) and O(N^3) to O(N * r) and O(N^2 * r) per tile.
+
+/**
+ * @brief Compute the predictions with a block low-rank Cholesky factor
+ *
+ * The cross-covariance tiles are compressed to the tolerance as well.
+ *
+ * @param training_input The training input data
+ * @param training_output The training output data
+ * @param test_input The test input data
+ * @param sek_params The kernel hyperparameters
+ * @param n_tiles The number of training tiles
+ * @param n_tile_size The size of each training tile
+ * @param m_tiles The number of test tiles
+ * @param m_tile_size The size of each test tile
+ * @param n_regressors The number of regressors
+ * @param tolerance The relative tolerance of the low-rank tiles in the Frobenius norm
+ *
+ * @return A vector containing the predictions
+ */
+std::vector<double> predict_blr(const std::vector<double> &training_input,
+                                const std::vector<double> &training_output,
+                                const std::vector<double> &test_input,
+                                const gprat_hyper::SEKParams &sek_params,
+                                int n_tiles,
+                                int n_tile_size,
+                                int m_tiles,
+                                int m_tile_size,
+                                int n_regressors,
+                                double tolerance);
+
+/**
+ * @brief Compute the predictions with uncertainties with a block low-rank Cholesky factor
+ *
+ * The parameters are the same as for predict_blr. The cross-covariance tiles are kept
+ * dense, since the triangular solve with them yields dense tiles.
+ *
+ * @return A vector containing the predictions and a vector containing their uncertainties
+ */
+std::vector<std::vector<double>> predict_blr_with_uncertainty(const std::vector<double> &training_input,
+                                                              const std::vector<double> &training_output,
+                                                              const std::vector<double> &test_input,
+                                                              const gprat_hyper::SEKParams &sek_params,
+                                                              int n_tiles,
+                                                              int n_tile_size,
+                                                              int m_tiles,
+                                                              int m_tile_size,
+                                                              int n_regressors,
+                                                              double tolerance);
+
+/**
+ * @brief Compute the negative log likelihood loss with a block low-rank Cholesky factor
+ *
+ * @param training_input The training input data
+ * @param training_output The training output data
+ * @param sek_params The kernel hyperparameters
+ * @param n_tiles The number of training tiles
+ * @param n_tile_size The size of each training tile
+ * @param n_regressors The number of regressors
+ * @param tolerance The relative tolerance of the low-rank tiles in the Frobenius norm
+ *
+ * @return The loss
+ */
+double compute_loss_blr(const std::vector<double> &training_input,
+                        const std::vector<double> &training_output,
+                        const gprat_hyper::SEKParams &sek_params,
+                        int n_tiles,
+                        int n_tile_size,
+                        int n_regressors,
+                        double tolerance);
+
+/**
+ * @brief Compute the memory of the block low-rank Cholesky factor relative to the dense one
+ *
+ * The parameters are the same as for compute_loss_blr without the training output.
+ *
+ * @return The number of stored elements of the lower triangular tiles divided by their
+ *         number in dense form
+ */
+double compute_blr_compression(const std::vector<double> &training_input,
+                               const gprat_hyper::SEKParams &sek_params,
+                               int n_tiles,
+                               int n_tile_size,
+                               int n_regressors,
+                               double tolerance);
+
+}  // end of namespace cpu
+
+#endif  // end of CPU_GP_BLR_H
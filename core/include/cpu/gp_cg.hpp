@@ -0,0 +1,227 @@
+#ifndef CPU_GP_CG_H
+#define CPU_GP_CG_H
+
+#include "gp_hyperparameters.hpp"
+#include "gp_kernels.hpp"
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace cpu
+{
+
+// Matrix-free solver: the covariance matrix is never stored. Its products with vectors
+// are computed row by row from the kernel, in parallel over the training tiles, and
+// K * alpha = y is solved by the preconditioned conjugate gradient (PCG) method. The
+// preconditioner is the partial pivoted Cholesky decomposition of rank p of the
+// noise-free covariance, P = L_p * L_p^T + noise_variance * I, which is applied by the
+// Woodbury identity. Memory is O(N * p) instead of O(N^2).
+
+/**
+ * @brief Matrix-free covariance matrix K of the training samples, including the noise variance
+ */
+class MatrixFreeCovariance
+{
+  private:
+    std::size_t n_samples_;
+    std::size_t tile_size_;
+    std::size_t n_regressors_;
+    gprat_hyper::SEKParams sek_params_;
+
+    /** @brief Lagged training features, n_regressors x n_samples such that a kernel row vectorizes */
+    std::vector<double> features_;
+
+    /**
+     * @brief Compute the squared distances of a point to all training samples.
+     */
+    void squared_distance_row(const double *features, double *row) const;
+
+    /**
+     * @brief Gather the lagged features of a training sample.
+     */
+    std::vector<double> training_features(std::size_t i) const;
+
+  public:
+    /**
+     * @brief Gather the training features.
+     *
+     * @param input The training input data
+     * @param sek_params The kernel hyperparameters
+     * @param n_tiles The number of training tiles, the products run in parallel over them
+     * @param n_tile_size The size of each training tile
+     * @param n_regressors The number of regressors
+     */
+    MatrixFreeCovariance(const std::vector<double> &input,
+                         const gprat_hyper::SEKParams &sek_params,
+                         int n_tiles,
+                         int n_tile_size,
+                         int n_regressors);
+
+    /**
+     * @brief Compute the kernel row k(x, x_j) of a point against all training samples,
+     * without the noise variance.
+     *
+     * @param features The n_regressors lagged features of the point
+     * @param row The output of n_samples entries
+     */
+    void kernel_row(const double *features, double *row) const;
+
+    /**
+     * @brief Compute the kernel row of a training sample, without the noise variance.
+     *
+     * @param i The index of the training sample
+     * @param row The output of n_samples entries
+     */
+    void training_kernel_row(std::size_t i, double *row) const;
+
+    /**
+     * @brief Compute K * X.
+     *
+     * @param X The row-major matrix of size n_samples x n_columns
+     * @param n_columns The number of columns of X
+     *
+     * @return The row-major product
+     */
+    std::vector<double> apply(const std::vector<double> &X, std::size_t n_columns) const;
+
+    /**
+     * @brief Compute the products of the derivatives of K with respect to the lengthscale
+     * and the vertical lengthscale with X, without the chain rule of the constraints.
+     *
+     * @param X The row-major matrix of size n_samples x n_columns
+     * @param n_columns The number of columns of X
+     *
+     * @return The row-major products dK/dl * X and dK/dv * X
+     */
+    std::pair<std::vector<double>, std::vector<double>>
+    apply_derivatives(const std::vector<double> &X, std::size_t n_columns) const;
+
+    /**
+     * @brief Return the number of training samples.
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Return the kernel hyperparameters.
+     */
+    const gprat_hyper::SEKParams &sek_params() const;
+};
+
+/**
+ * @brief Partial pivoted Cholesky preconditioner P = L_p * L_p^T + noise_variance * I
+ */
+class PivotedCholeskyPreconditioner
+{
+  private:
+    std::size_t n_samples_;
+    std::size_t rank_;
+    double noise_variance_;
+
+    /** @brief Low-rank factor L_p, row-major n_samples x rank */
+    std::vector<double> L_;
+
+    /** @brief Cholesky factor of the capacitance matrix noise_variance * I + L_p^T * L_p */
+    std::vector<double> capacitance_;
+
+  public:
+    /**
+     * @brief Compute the partial pivoted Cholesky decomposition of the noise-free covariance.
+     *
+     * Stops early if the trace of the remainder vanishes.
+     *
+     * @param K The matrix-free covariance matrix
+     * @param max_rank The maximum rank p, 0 for the diagonal preconditioner noise_variance * I
+     */
+    PivotedCholeskyPreconditioner(const MatrixFreeCovariance &K, std::size_t max_rank);
+
+    /**
+     * @brief Compute P^-1 * R.
+     *
+     * @param R The row-major matrix of size n_samples x n_columns
+     * @param n_columns The number of columns of R
+     *
+     * @return The row-major solution
+     */
+    std::vector<double> solve(const std::vector<double> &R, std::size_t n_columns) const;
+
+    /**
+     * @brief Return the rank of the preconditioner.
+     */
+    std::size_t rank() const;
+};
+
+/**
+ * @brief Solve K * X = B by the preconditioned conjugate gradient method, for all columns at once
+ *
+ * @param K The matrix-free covariance matrix
+ * @param preconditioner The preconditioner
+ * @param B The row-major right-hand side of size n_samples x n_columns
+ * @param n_columns The number of right-hand sides
+ * @param tolerance The relative residual norm at which a column has converged
+ * @param max_iterations The maximum number of iterations
+ *
+ * @return The row-major solution X
+ * @throws std::runtime_error if a column has not converged within max_iterations
+ */
+std::vector<double> solve_pcg(const MatrixFreeCovariance &K,
+                              const PivotedCholeskyPreconditioner &preconditioner,
+                              const std::vector<double> &B,
+                              std::size_t n_columns,
+                              double tolerance,
+                              int max_iterations);
+
+/**
+ * @brief Compute the predictions with the matrix-free PCG solver
+ *
+ * @param training_input The training input data
+ * @param training_output The training output data
+ * @param test_input The test input data
+ * @param sek_params The kernel hyperparameters
+ * @param n_tiles The number of training tiles
+ * @param n_tile_size The size of each training tile
+ * @param m_tiles The number of test tiles
+ * @param m_tile_size The size of each test tile
+ * @param n_regressors The number of regressors
+ * @param tolerance The relative residual norm at which PCG has converged
+ * @param max_iterations The maximum number of PCG iterations
+ * @param preconditioner_rank The rank of the pivoted Cholesky preconditioner
+ *
+ * @return A vector containing the predictions
+ */
+std::vector<double> predict_cg(const std::vector<double> &training_input,
+                               const std::vector<double> &training_output,
+                               const std::vector<double> &test_input,
+                               const gprat_hyper::SEKParams &sek_params,
+                               int n_tiles,
+                               int n_tile_size,
+                               int m_tiles,
+                               int m_tile_size,
+                               int n_regressors,
+                               double tolerance,
+                               int max_iterations,
+                               int preconditioner_rank);
+
+/**
+ * @brief Compute the predictions with uncertainties with the matrix-free PCG solver
+ *
+ * The parameters are the same as for predict_cg. The test points are additional
+ * right-hand sides, such that the cross-covariance of size n_train x n_test is stored.
+ *
+ * @return A vector containing the predictions and a vector containing their uncertainties
+ */
+std::vector<std::vector<double>> predict_cg_with_uncertainty(const std::vector<double> &training_input,
+                                                             const std::vector<double> &training_output,
+                                                             const std::vector<double> &test_input,
+                                                             const gprat_hyper::SEKParams &sek_params,
+                                                             int n_tiles,
+                                                             int n_tile_size,
+                                                             int m_tiles,
+                                                             int m_tile_size,
+                                                             int n_regressors,
+                                                             double tolerance,
+                                                             int max_iterations,
+                                                             int preconditioner_rank);
+
+}  // end of namespace cpu
+
+#endif  // end of CPU_GP_CG_H
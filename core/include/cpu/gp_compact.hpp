@@ -0,0 +1,148 @@
+#ifndef CPU_GP_COMPACT_H
+#define CPU_GP_COMPACT_H
+
+#include "gp_hyperparameters.hpp"
+#include "gp_kernels.hpp"
+#include <cstddef>
+#include <vector>
+
+namespace cpu
+{
+
+// Compactly supported kernels: the Wendland kernel
+//   k(z_i, z_j) = vertical_lengthscale * (1 - r)_+^(l + 1) * ((l + 1) * r + 1),  r = ||z_i - z_j|| / lengthscale,
+// with l = floor(n_regressors / 2) + 2 is positive definite for features in R^n_regressors and
+// vanishes beyond the support radius given by the lengthscale. Tiles whose bounding boxes
+// are at least one lengthscale apart are identically zero: they are neither assembled nor
+// touched by the Cholesky decomposition, the triangular solves and the gradients, see the
+// sparse tiled algorithms. Neighboring samples of lagged data are not necessarily close in
+// the feature space, such that the samples are optionally reordered by recursive coordinate
+// bisection. Each tile then covers a compact region and most tiles are empty for small
+// lengthscales. The results are returned in the original order of the samples.
+
+/**
+ * @brief Compute the Wendland kernel of two feature vectors
+ *
+ * @param distance The Euclidean distance of the feature vectors
+ * @param sek_params The kernel hyperparameters, the lengthscale is the support radius
+ * @param n_regressors The number of regressors, i.e. the dimension of the features
+ *
+ * @return The covariance, zero if the distance is at least the lengthscale
+ */
+double compute_wendland_covariance(double distance, const gprat_hyper::SEKParams &sek_params, std::size_t n_regressors);
+
+/**
+ * @brief Compute the predictions with the Wendland kernel and the tile-sparse Cholesky factor
+ *
+ * @param training_input The training input data
+ * @param training_output The training output data
+ * @param test_input The test input data
+ * @param sek_params The kernel hyperparameters
+ * @param n_tiles The number of training tiles
+ * @param n_tile_size The size of each training tile
+ * @param m_tiles The number of test tiles
+ * @param m_tile_size The size of each test tile
+ * @param n_regressors The number of regressors
+ * @param reorder Whether to reorder the training and test samples to maximize the zero tiles
+ *
+ * @return A vector containing the predictions
+ */
+std::vector<double> predict_compact(const std::vector<double> &training_input,
+                                    const std::vector<double> &training_output,
+                                    const std::vector<double> &test_input,
+                                    const gprat_hyper::SEKParams &sek_params,
+                                    int n_tiles,
+                                    int n_tile_size,
+                                    int m_tiles,
+                                    int m_tile_size,
+                                    int n_regressors,
+                                    bool reorder);
+
+/**
+ * @brief Compute the predictions with uncertainties with the Wendland kernel and the
+ * tile-sparse Cholesky factor
+ *
+ * The parameters are the same as for predict_compact.
+ *
+ * @return A vector containing the predictions and a vector containing their uncertainties
+ */
+std::vector<std::vector<double>> predict_compact_with_uncertainty(const std::vector<double> &training_input,
+                                                                  const std::vector<double> &training_output,
+                                                                  const std::vector<double> &test_input,
+                                                                  const gprat_hyper::SEKParams &sek_params,
+                                                                  int n_tiles,
+                                                                  int n_tile_size,
+                                                                  int m_tiles,
+                                                                  int m_tile_size,
+                                                                  int n_regressors,
+                                                                  bool reorder);
+
+/**
+ * @brief Compute the negative log likelihood loss with the Wendland kernel and the
+ * tile-sparse Cholesky factor
+ *
+ * @param training_input The training input data
+ * @param training_output The training output data
+ * @param sek_params The kernel hyperparameters
+ * @param n_tiles The number of training tiles
+ * @param n_tile_size The size of each training tile
+ * @param n_regressors The number of regressors
+ * @param reorder Whether to reorder the training samples to maximize the zero tiles
+ *
+ * @return The loss
+ */
+double compute_loss_compact(const std::vector<double> &training_input,
+                            const std::vector<double> &training_output,
+                            const gprat_hyper::SEKParams &sek_params,
+                            int n_tiles,
+                            int n_tile_size,
+                            int n_regressors,
+                            bool reorder);
+
+/**
+ * @brief Optimize the hyperparameters of the Wendland kernel with Adam
+ *
+ * The trace of K^-1 * dK only requires the tiles of K^-1 in the pattern of K, which are
+ * computed by the selected inverse, see selected_inverse_tiled. The zero tiles are
+ * recomputed in every iteration, since the support changes with the lengthscale.
+ *
+ * @param training_input The training input data
+ * @param training_output The training output data
+ * @param n_tiles The number of training tiles
+ * @param n_tile_size The size of each training tile
+ * @param n_regressors The number of regressors
+ * @param adam_params The Adam optimizer hyperparameters
+ * @param sek_params The kernel hyperparameters, updated in place
+ * @param trainable_params The flags of the trainable hyperparameters
+ * @param reorder Whether to reorder the training samples to maximize the zero tiles
+ *
+ * @return The losses of all iterations
+ */
+std::vector<double> optimize_compact(const std::vector<double> &training_input,
+                                     const std::vector<double> &training_output,
+                                     int n_tiles,
+                                     int n_tile_size,
+                                     int n_regressors,
+                                     const gprat_hyper::AdamParams &adam_params,
+                                     gprat_hyper::SEKParams &sek_params,
+                                     std::vector<bool> trainable_params,
+                                     bool reorder);
+
+/**
+ * @brief Compute the fraction of nonzero tiles of the tile-sparse Cholesky factor
+ *
+ * The parameters are the same as for compute_loss_compact without the training output.
+ *
+ * @return The number of nonzero lower triangular tiles, including the fill-in, divided by
+ *         the number of lower triangular tiles
+ */
+double compute_compact_density(const std::vector<double> &training_input,
+                               const gprat_hyper::SEKParams &sek_params,
+                               int n_tiles,
+                               int n_tile_size,
+                               int n_regressors,
+                               bool reorder);
+
+}  // end of namespace cpu
+
+#endif  // end of CPU_GP_COMPACT_H
@@ -0,0 +1,137 @@
+#ifndef CPU_GP_EXPERTS_H
+#define CPU_GP_EXPERTS_H
+
+#include "gp_hyperparameters.hpp"
+#include "gp_kernels.hpp"
+#include <vector>
+
+namespace cpu
+{
+
+// Distributed experts: each training tile is an independent GP expert that only
+// factorizes its diagonal tile K_kk, such that no off-diagonal tiles are assembled and
+// training costs O(n * b^2) for tiles of size b. The predictions of the experts are
+// combined per test point by their precisions.
+
+/**
+ * @brief Rule to combine the predictions of the experts
+ */
+enum class ExpertAggregation
+{
+    /** @brief Product of experts: the precisions add up, overconfident for many experts */
+    PoE,
+    /** @brief Generalized product of experts with weights 1 / n_experts */
+    gPoE,
+    /** @brief Bayesian committee machine: PoE corrected by the prior precision */
+    BCM,
+    /** @brief Robust BCM weighting each expert by its differential entropy to the prior */
+    rBCM
+};
+
+/**
+ * @brief Combine the predictions of the experts for a tile of test points
+ *
+ * @param means The predictions of each expert
+ * @param variances The uncertainties of each expert
+ * @param prior_variance The prior variance of the test points
+ * @param aggregation The combination rule
+ *
+ * @return A vector containing the predictions and a vector containing their uncertainties
+ */
+std::vector<std::vector<double>> combine_expert_predictions(const std::vector<std::vector<double>> &means,
+                                                            const std::vector<std::vector<double>> &variances,
+                                                            double prior_variance,
+                                                            ExpertAggregation aggregation);
+
+/**
+ * @brief Compute the predictions of the experts
+ *
+ * @param training_input The training input data
+ * @param training_output The training output data
+ * @param test_input The test input data
+ * @param sek_params The kernel hyperparameters
+ * @param aggregation The combination rule
+ * @param n_tiles The number of training tiles, one expert per tile
+ * @param n_tile_size The size of each training tile
+ * @param m_tiles The number of test tiles
+ * @param m_tile_size The size of each test tile
+ * @param n_regressors The number of regressors
+ *
+ * @return A vector containing the predictions
+ */
+std::vector<double> predict_experts(const std::vector<double> &training_input,
+                                    const std::vector<double> &training_output,
+                                    const std::vector<double> &test_input,
+                                    const gprat_hyper::SEKParams &sek_params,
+                                    ExpertAggregation aggregation,
+                                    int n_tiles,
+                                    int n_tile_size,
+                                    int m_tiles,
+                                    int m_tile_size,
+                                    int n_regressors);
+
+/**
+ * @brief Compute the predictions of the experts with uncertainties
+ *
+ * The parameters are the same as for predict_experts.
+ *
+ * @return A vector containing the predictions and a vector containing their uncertainties
+ */
+std::vector<std::vector<double>> predict_experts_with_uncertainty(const std::vector<double> &training_input,
+                                                                  const std::vector<double> &training_output,
+                                                                  const std::vector<double> &test_input,
+                                                                  const gprat_hyper::SEKParams &sek_params,
+                                                                  ExpertAggregation aggregation,
+                                                                  int n_tiles,
+                                                                  int n_tile_size,
+                                                                  int m_tiles,
+                                                                  int m_tile_size,
+                                                                  int n_regressors);
+
+/**
+ * @brief Compute the sum of the negative log likelihoods of the experts, normalized
+ * per sample like compute_loss.
+ *
+ * @param training_input The training input data
+ * @param training_output The training output data
+ * @param sek_params The kernel hyperparameters
+ * @param n_tiles The number of training tiles, one expert per tile
+ * @param n_tile_size The size of each training tile
+ * @param n_regressors The number of regressors
+ *
+ * @return The loss
+ */
+double compute_loss_experts(const std::vector<double> &training_input,
+                            const std::vector<double> &training_output,
+                            const gprat_hyper::SEKParams &sek_params,
+                            int n_tiles,
+                            int n_tile_size,
+                            int n_regressors);
+
+/**
+ * @brief Optimize the hyperparameters shared by all experts with Adam for the sum of
+ * their negative log likelihoods.
+ *
+ * @param training_input The training input data
+ * @param training_output The training output data
+ * @param n_tiles The number of training tiles, one expert per tile
+ * @param n_tile_size The size of each training tile
+ * @param n_regressors The number of regressors
+ * @param adam_params The Adam optimizer hyperparameters
+ * @param sek_params The kernel hyperparameters, afterwards containing the optimized values
+ * @param trainable_params The vector containing a bool wheather to train a hyperparameter
+ *
+ * @return A vector containing the loss values of each iteration
+ */
+std::vector<double> optimize_experts(const std::vector<double> &training_input,
+                                     const std::vector<double> &training_output,
+                                     int n_tiles,
+                                     int n_tile_size,
+                                     int n_regressors,
+                                     const gprat_hyper::AdamParams &adam_params,
+                                     gprat_hyper::SEKParams &sek_params,
+                                     std::vector<bool> trainable_params);
+
+}  // end of namespace cpu
+
+#endif  // end of CPU_GP_EXPERTS_H
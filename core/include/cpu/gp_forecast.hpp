@@ -0,0 +1,69 @@
+#ifndef CPU_GP_FORECAST_H
+#define CPU_GP_FORECAST_H
+
+#include "gp_point_prediction.hpp"
+#include <cstddef>
+#include <vector>
+
+namespace cpu
+{
+
+// Recursive multi-step forecasting: each prediction is shifted into the window of
+// lagged features of the next step. The rollout reuses the cached factor of the
+// inline predictions and runs on the calling thread.
+
+/**
+ * @brief Approximation of the uncertainty of a recursive multi-step forecast
+ */
+enum class ForecastUncertainty
+{
+    /** @brief Predictions only */
+    Off,
+    /** @brief Predictive variance of each step, treating the fed back predictions as exact inputs */
+    Naive,
+    /** @brief First-order propagation of the variance of the fed back predictions through the predictive mean */
+    Linearized
+};
+
+/**
+ * @brief Compute a recursive multi-step forecast.
+ *
+ * The squared distances of the shifted window to the lagged training features are
+ * the distances of the previous window to the preceding training sample, corrected
+ * by the leaving and the entering lag. Each step therefore updates the kernel row in
+ * O(n_train) instead of recomputing it in O(n_train * n_regressors). Subtracting the
+ * leaving lag cancels digits, so the distances are recomputed every few steps and
+ * whenever a distance falls far below the one it was updated from or below zero.
+ *
+ * @param factor The factor, it is not modified such that rollouts may run concurrently
+ * @param window The n_regressors most recent outputs, oldest first
+ * @param horizon The number of steps
+ * @param uncertainty The approximation of the uncertainty
+ *
+ * @return A vector containing the predictions and the uncertainties of the steps,
+ *         the uncertainties are empty for ForecastUncertainty::Off
+ */
+std::vector<std::vector<double>> forecast_rollout(const PointPredictionFactor &factor,
+                                                  const double *window,
+                                                  std::size_t horizon,
+                                                  ForecastUncertainty uncertainty);
+
+/**
+ * @brief Compute recursive multi-step forecasts of several scenarios in parallel.
+ *
+ * @param factor The factor
+ * @param windows The windows of n_regressors most recent outputs of each scenario
+ * @param horizon The number of steps
+ * @param uncertainty The approximation of the uncertainty
+ *
+ * @return The forecast of each scenario, see forecast_rollout
+ */
+std::vector<std::vector<std::vector<double>>>
+forecast_rollout_scenarios(const PointPredictionFactor &factor,
+                           const std::vector<std::vector<double>> &windows,
+                           std::size_t horizon,
+                           ForecastUncertainty uncertainty);
+
+}  // end of namespace cpu
+
+#endif  // end of CPU_GP_FORECAST_H
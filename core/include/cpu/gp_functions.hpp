@@ -3,11 +3,61 @@
 
 #include "gp_hyperparameters.hpp"
 #include "gp_kernels.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <vector>
 
 namespace cpu
 {
 
+/**
+ * @brief Maximum number of refinement steps of the mixed precision solver before it falls back to FP64
+ */
+constexpr int MAX_REFINEMENT_ITERATIONS = 30;
+
+/**
+ * @brief Number of test tile blocks the streaming uncertainty computation keeps in flight
+ */
+constexpr std::size_t STREAMING_BLOCKS_IN_FLIGHT = 2;
+
+/**
+ * @brief Diagonal shift of the posterior covariance relative to the vertical lengthscale before it is factorized
+ * for sampling, the posterior covariance of close test points is numerically singular
+ */
+constexpr double POSTERIOR_SAMPLING_JITTER = 1e-8;
+
+/**
+ * @brief Convergence report of the mixed precision iterative refinement
+ */
+struct RefinementReport
+{
+    /** @brief Number of FP32 solves, including the initial solve */
+    int iterations = 0;
+
+    /** @brief Final normwise backward error ||y - K * alpha|| / (||K|| * ||alpha||) in the infinity norm */
+    double backward_error = 0.0;
+
+    /** @brief True if the backward error reached FP64 accuracy */
+    bool converged = false;
+
+    /** @brief True if the refinement stalled and the prediction was recomputed in FP64 */
+    bool fallback = false;
+};
+
+/**
+ * @brief Callback returning the test input of the next chunk, an empty vector ends the prediction
+ *
+ * Like the full test input, each chunk starts with n_regressors - 1 leading entries for the lagged features.
+ */
+using TestChunkSource = std::function<std::vector<double>()>;
+
+/**
+ * @brief Callback receiving the predictions and the uncertainties of a chunk, the latter are empty if not requested
+ */
+template <typename T>
+using PredictionChunkSink = std::function<void(std::vector<T> prediction, std::vector<T> uncertainty)>;
+
 /**
  * @brief Perform Cholesky decompositon (+Assebmly)
  *
@@ -40,9 +90,12 @@ cholesky(const std::vector<double> &training_input,
  * @param m_tile_size The size of each test tile
  * @param n_regressors The number of regressors
  *
+ * @tparam T The scalar type of the tiled computation, double or float
+ *
  * @return A vector containing the predictions
  */
-std::vector<double>
+template <typename T = double>
+std::vector<T>
 predict(const std::vector<double> &training_input,
         const std::vector<double> &training_output,
         const std::vector<double> &test_input,
@@ -53,6 +106,39 @@ predict(const std::vector<double> &training_input,
         int m_tile_size,
         int n_regressors);
 
+/**
+ * @brief Compute the predictions with a FP32 Cholesky factor and FP64 iterative refinement.
+ *
+ * The covariance matrix is factorized in FP32. Afterwards, alpha = K^-1 * y is
+ * refined with FP64 residuals, whose covariance tiles are generated on the fly,
+ * until its backward error reaches FP64 accuracy. If the refinement stalls or
+ * does not converge within MAX_REFINEMENT_ITERATIONS steps, the prediction is
+ * recomputed in FP64.
+ *
+ * @param training_input The training input data
+ * @param training_output The raining output data
+ * @param test_input The test input data
+ * @param hyperparameters The kernel hyperparameters
+ * @param n_tiles The number of training tiles
+ * @param n_tile_size The size of each training tile
+ * @param m_tiles The number of test tiles
+ * @param m_tile_size The size of each test tile
+ * @param n_regressors The number of regressors
+ * @param report The convergence report of the refinement
+ *
+ * @return A vector containing the predictions
+ */
+std::vector<double> predict_mixed(const std::vector<double> &training_input,
+                                  const std::vector<double> &training_output,
+                                  const std::vector<double> &test_input,
+                                  const gprat_hyper::SEKParams &sek_params,
+                                  int n_tiles,
+                                  int n_tile_size,
+                                  int m_tiles,
+                                  int m_tile_size,
+                                  int n_regressors,
+                                  RefinementReport &report);
+
 /**
  * @brief Compute the predictions with uncertainties.
  *
@@ -66,9 +152,14 @@ predict(const std::vector<double> &training_input,
  * @param m_tile_size The size of each test tile
  * @param n_regressors The number of regressors
  *
+ * @tparam T The scalar type of the tiled computation, double or float
+ * @tparam S The scalar type in which the cross-covariance tiles and V are stored, T or float.
+ *           The solves and reductions still compute in T.
+ *
  * @return A vector containing the prediction vector and the uncertainty vector
  */
-std::vector<std::vector<double>> predict_with_uncertainty(
+template <typename T = double, typename S = T>
+std::vector<std::vector<T>> predict_with_uncertainty(
     const std::vector<double> &training_input,
     const std::vector<double> &training_output,
     const std::vector<double> &test_input,
@@ -92,9 +183,14 @@ std::vector<std::vector<double>> predict_with_uncertainty(
  * @param m_tile_size The size of each test tile
  * @param n_regressors The number of regressors
  *
+ * @tparam T The scalar type of the tiled computation, double or float
+ * @tparam S The scalar type in which the cross-covariance tiles and V are stored, T or float.
+ *           The solves and reductions still compute in T.
+ *
  * @return A vector containing the prediction vector and the full posterior covariance matrix
  */
-std::vector<std::vector<double>> predict_with_full_cov(
+template <typename T = double, typename S = T>
+std::vector<std::vector<T>> predict_with_full_cov(
     const std::vector<double> &training_input,
     const std::vector<double> &training_output,
     const std::vector<double> &test_data,
@@ -105,6 +201,109 @@ std::vector<std::vector<double>> predict_with_full_cov(
     int m_tile_size,
     int n_regressors);
 
+/**
+ * @brief Compute the predictions and uncertainties with bounded memory.
+ *
+ * The test tiles are processed as column blocks: the transposed cross-covariance
+ * of a block is assembled, solved with the Cholesky factor, reduced to the
+ * predictions and the uncertainty diagonal and released. At most
+ * STREAMING_BLOCKS_IN_FLIGHT blocks are alive at a time, such that the peak memory
+ * is O(N * m_tile_size) instead of O(N * M).
+ *
+ * @param training_input The training input data
+ * @param training_output The raining output data
+ * @param test_input The test input data
+ * @param hyperparameters The kernel hyperparameters
+ * @param n_tiles The number of training tiles
+ * @param n_tile_size The size of each training tile
+ * @param m_tiles The number of test tiles
+ * @param m_tile_size The size of each test tile
+ * @param n_regressors The number of regressors
+ *
+ * @tparam T The scalar type of the tiled computation, double or float
+ *
+ * @return A vector containing the prediction vector and the uncertainty vector
+ */
+template <typename T = double>
+std::vector<std::vector<T>> predict_with_uncertainty_streaming(
+    const std::vector<double> &training_input,
+    const std::vector<double> &training_output,
+    const std::vector<double> &test_input,
+    const gprat_hyper::SEKParams &sek_params,
+    int n_tiles,
+    int n_tile_size,
+    int m_tiles,
+    int m_tile_size,
+    int n_regressors);
+
+/**
+ * @brief Compute the predictions and optionally the uncertainties of a test set delivered in chunks.
+ *
+ * The training covariance is factorized once and reused by all chunks. While a chunk is
+ * computed, the next one is requested and assembled. At most STREAMING_BLOCKS_IN_FLIGHT
+ * chunks are alive at a time, such that the memory is bounded by the chunk size
+ * regardless of the size of the test set. The results are delivered in chunk order.
+ *
+ * @param training_input The training input data
+ * @param training_output The raining output data
+ * @param hyperparameters The kernel hyperparameters
+ * @param n_tiles The number of training tiles
+ * @param n_tile_size The size of each training tile
+ * @param n_regressors The number of regressors
+ * @param next_test_chunk Callback returning the test input of the next chunk
+ * @param consume_chunk Callback receiving the results of a chunk
+ * @param with_uncertainty Whether to compute the uncertainties
+ *
+ * @tparam T The scalar type of the tiled computation, double or float
+ *
+ * @return The number of chunks
+ *
+ * @throws std::invalid_argument if a chunk holds fewer than n_regressors entries
+ */
+template <typename T = double>
+std::size_t predict_chunked(const std::vector<double> &training_input,
+                            const std::vector<double> &training_output,
+                            const gprat_hyper::SEKParams &sek_params,
+                            int n_tiles,
+                            int n_tile_size,
+                            int n_regressors,
+                            const TestChunkSource &next_test_chunk,
+                            const PredictionChunkSink<T> &consume_chunk,
+                            bool with_uncertainty);
+
+/**
+ * @brief Draw samples from the posterior distribution at the test points.
+ *
+ * The posterior covariance matrix is assembled, shifted by POSTERIOR_SAMPLING_JITTER and
+ * factorized in the tiled layout. The standard normal samples are generated per tile
+ * and the factor is applied to all samples at once.
+ *
+ * @param training_input The training input data
+ * @param training_output The raining output data
+ * @param test_input The test input data
+ * @param hyperparameters The kernel hyperparameters
+ * @param n_tiles The number of training tiles
+ * @param n_tile_size The size of each training tile
+ * @param m_tiles The number of test tiles
+ * @param m_tile_size The size of each test tile
+ * @param n_regressors The number of regressors
+ * @param n_samples The number of samples
+ * @param seed The seed of the random number generator, equal seeds result in equal samples
+ *
+ * @return A vector containing n_samples samples of the test outputs
+ */
+std::vector<std::vector<double>> sample_posterior(const std::vector<double> &training_input,
+                                                  const std::vector<double> &training_output,
+                                                  const std::vector<double> &test_input,
+                                                  const gprat_hyper::SEKParams &sek_params,
+                                                  int n_tiles,
+                                                  int n_tile_size,
+                                                  int m_tiles,
+                                                  int m_tile_size,
+                                                  int n_regressors,
+                                                  int n_samples,
+                                                  std::uint64_t seed);
+
 /**
  * @brief Compute loss for given data and Gaussian process model
  *
@@ -0,0 +1,98 @@
+#ifndef CPU_GP_FUNCTIONS_CONTIGUOUS_H
+#define CPU_GP_FUNCTIONS_CONTIGUOUS_H
+
+#include "gp_hyperparameters.hpp"
+#include "gp_kernels.hpp"
+#include <vector>
+
+namespace cpu
+{
+
+// Small-problem fast path: the covariance matrices are assembled contiguously and
+// processed with monolithic BLAS/LAPACK calls instead of the tiled HPX pipeline.
+
+/**
+ * @brief Compute the predictions without uncertainties on contiguous matrices.
+ *
+ * @param training_input The training input data
+ * @param training_output The training output data
+ * @param test_input The test input data
+ * @param sek_params The kernel hyperparameters
+ * @param n_train The number of training samples
+ * @param n_test The number of test samples
+ * @param n_regressors The number of regressors
+ *
+ * @return A vector containing the predictions
+ */
+std::vector<double> predict_contiguous(const std::vector<double> &training_input,
+                                       const std::vector<double> &training_output,
+                                       const std::vector<double> &test_input,
+                                       const gprat_hyper::SEKParams &sek_params,
+                                       int n_train,
+                                       int n_test,
+                                       int n_regressors);
+
+/**
+ * @brief Compute the predictions with uncertainties on contiguous matrices.
+ *
+ * @param training_input The training input data
+ * @param training_output The training output data
+ * @param test_input The test input data
+ * @param sek_params The kernel hyperparameters
+ * @param n_train The number of training samples
+ * @param n_test The number of test samples
+ * @param n_regressors The number of regressors
+ *
+ * @return A vector containing the prediction vector and the uncertainty vector
+ */
+std::vector<std::vector<double>> predict_with_uncertainty_contiguous(
+    const std::vector<double> &training_input,
+    const std::vector<double> &training_output,
+    const std::vector<double> &test_input,
+    const gprat_hyper::SEKParams &sek_params,
+    int n_train,
+    int n_test,
+    int n_regressors);
+
+/**
+ * @brief Compute the predictions with full covariance matrix on contiguous matrices.
+ *
+ * @param training_input The training input data
+ * @param training_output The training output data
+ * @param test_input The test input data
+ * @param sek_params The kernel hyperparameters
+ * @param n_train The number of training samples
+ * @param n_test The number of test samples
+ * @param n_regressors The number of regressors
+ *
+ * @return A vector containing the prediction vector and the diagonal of the full covariance matrix
+ */
+std::vector<std::vector<double>> predict_with_full_cov_contiguous(
+    const std::vector<double> &training_input,
+    const std::vector<double> &training_output,
+    const std::vector<double> &test_input,
+    const gprat_hyper::SEKParams &sek_params,
+    int n_train,
+    int n_test,
+    int n_regressors);
+
+/**
+ * @brief Compute the negative log likelihood loss on contiguous matrices.
+ *
+ * @param training_input The training input data
+ * @param training_output The training output data
+ * @param sek_params The kernel hyperparameters
+ * @param n_train The number of training samples
+ * @param n_regressors The number of regressors
+ *
+ * @return The loss
+ */
+double compute_loss_contiguous(const std::vector<double> &training_input,
+                               const std::vector<double> &training_output,
+                               const gprat_hyper::SEKParams &sek_params,
+                               int n_train,
+                               int n_regressors);
+
+}  // end of namespace cpu
+
+#endif  // end of CPU_GP_FUNCTIONS_CONTIGUOUS_H
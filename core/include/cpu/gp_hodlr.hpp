@@ -0,0 +1,183 @@
+#ifndef CPU_GP_HODLR_H
+#define CPU_GP_HODLR_H
+
+#include "cpu/adapter_low_rank.hpp"
+#include "gp_hyperparameters.hpp"
+#include "gp_kernels.hpp"
+#include <cstddef>
+#include <vector>
+
+namespace cpu
+{
+
+// Hierarchical off-diagonal low-rank (HODLR) solver: the covariance matrix is split
+// recursively into halves, K = [K_1, B^T; B, K_2], until the diagonal blocks are single
+// training tiles. The off-diagonal blocks B = U * V^T are compressed to a tolerance, such
+// that K = diag(K_1, K_2) + Z * P * Z^T with Z = diag(V, U) and P = [0, I; I, 0]. The
+// Woodbury identity reduces solves and the log-determinant of K to those of the children
+// and a small 2r x 2r system per node, which costs O(r^2 * n * log^2(n)) for the
+// factorization and O(r * n * log(n)) per solve. The children are factorized in parallel.
+
+/**
+ * @brief Factorized HODLR representation of the covariance matrix of the training samples
+ */
+class HODLRMatrix
+{
+  private:
+    /**
+     * @brief Node of the tree covering the samples [begin, end)
+     */
+    struct Node
+    {
+        std::size_t begin;
+        std::size_t end;
+        /** @brief Child nodes covering [begin, middle) and [middle, end), 0 for leaves */
+        std::size_t left;
+        std::size_t right;
+        /** @brief Cholesky factor of the dense diagonal block of a leaf */
+        std::vector<double> L;
+        /** @brief Off-diagonal block B = U * V^T of an inner node */
+        LowRankTile off_diagonal;
+        /** @brief K_1^-1 * V and K_2^-1 * U */
+        std::vector<double> Y_left;
+        std::vector<double> Y_right;
+        /** @brief LU decomposition of S = P + Z^T * diag(K_1, K_2)^-1 * Z and its pivots */
+        std::vector<double> S;
+        std::vector<int> pivots;
+        /** @brief log(det(K)) of the block covered by the node */
+        double log_det;
+    };
+
+    /** @brief Size of a regular training tile */
+    std::size_t tile_size_;
+
+    /** @brief Nodes, the root first */
+    std::vector<Node> nodes_;
+
+    /**
+     * @brief Recursively build the node covering the tiles [first_tile, last_tile) and return its index
+     */
+    std::size_t build(std::size_t first_tile, std::size_t last_tile, std::size_t n_samples);
+
+    /**
+     * @brief Recursively assemble and factorize a node, the children in parallel
+     */
+    void factorize(std::size_t node,
+                   const std::vector<double> &input,
+                   const gprat_hyper::SEKParams &sek_params,
+                   std::size_t n_regressors,
+                   double tolerance);
+
+    /**
+     * @brief Recursively solve K_node * X = B for the rows of the node
+     */
+    std::vector<double> solve(std::size_t node, std::vector<double> B, std::size_t n_columns) const;
+
+  public:
+    /**
+     * @brief Assemble and factorize the HODLR representation of the covariance matrix.
+     *
+     * @param input The training input data
+     * @param sek_params The kernel hyperparameters
+     * @param n_tiles The number of training tiles, the leaves of the tree
+     * @param n_tile_size The size of each training tile
+     * @param n_regressors The number of regressors
+     * @param tolerance The relative tolerance of the off-diagonal blocks in the Frobenius norm
+     */
+    HODLRMatrix(const std::vector<double> &input,
+                const gprat_hyper::SEKParams &sek_params,
+                int n_tiles,
+                int n_tile_size,
+                int n_regressors,
+                double tolerance);
+
+    /**
+     * @brief Solve K * X = B.
+     *
+     * @param B The row-major right-hand side of size n_samples x n_columns
+     * @param n_columns The number of right-hand sides
+     *
+     * @return The row-major solution X
+     */
+    std::vector<double> solve(const std::vector<double> &B, std::size_t n_columns) const;
+
+    /**
+     * @brief Return log(det(K)).
+     */
+    double log_determinant() const;
+
+    /**
+     * @brief Return the number of samples.
+     */
+    std::size_t size() const;
+};
+
+/**
+ * @brief Compute the predictions with the HODLR solver
+ *
+ * @param training_input The training input data
+ * @param training_output The training output data
+ * @param test_input The test input data
+ * @param sek_params The kernel hyperparameters
+ * @param n_tiles The number of training tiles
+ * @param n_tile_size The size of each training tile
+ * @param m_tiles The number of test tiles
+ * @param m_tile_size The size of each test tile
+ * @param n_regressors The number of regressors
+ * @param tolerance The relative tolerance of the off-diagonal blocks in the Frobenius norm
+ *
+ * @return A vector containing the predictions
+ */
+std::vector<double> predict_hodlr(const std::vector<double> &training_input,
+                                  const std::vector<double> &training_output,
+                                  const std::vector<double> &test_input,
+                                  const gprat_hyper::SEKParams &sek_params,
+                                  int n_tiles,
+                                  int n_tile_size,
+                                  int m_tiles,
+                                  int m_tile_size,
+                                  int n_regressors,
+                                  double tolerance);
+
+/**
+ * @brief Compute the predictions with uncertainties with the HODLR solver
+ *
+ * The parameters are the same as for predict_hodlr.
+ *
+ * @return A vector containing the predictions and a vector containing their uncertainties
+ */
+std::vector<std::vector<double>> predict_hodlr_with_uncertainty(const std::vector<double> &training_input,
+                                                                const std::vector<double> &training_output,
+                                                                const std::vector<double> &test_input,
+                                                                const gprat_hyper::SEKParams &sek_params,
+                                                                int n_tiles,
+                                                                int n_tile_size,
+                                                                int m_tiles,
+                                                                int m_tile_size,
+                                                                int n_regressors,
+                                                                double tolerance);
+
+/**
+ * @brief Compute the negative log likelihood loss with the HODLR solver
+ *
+ * @param training_input The training input data
+ * @param training_output The training output data
+ * @param sek_params The kernel hyperparameters
+ * @param n_tiles The number of training tiles
+ * @param n_tile_size The size of each training tile
+ * @param n_regressors The number of regressors
+ * @param tolerance The relative tolerance of the off-diagonal blocks in the Frobenius norm
+ *
+ * @return The loss
+ */
+double compute_loss_hodlr(const std::vector<double> &training_input,
+                          const std::vector<double> &training_output,
+                          const gprat_hyper::SEKParams &sek_params,
+                          int n_tiles,
+                          int n_tile_size,
+                          int n_regressors,
+                          double tolerance);
+
+}  // end of namespace cpu
+
+#endif  // end of CPU_GP_HODLR_H
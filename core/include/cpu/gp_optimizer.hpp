@@ -63,17 +63,19 @@ double compute_covariance_distance(std::size_t i_global,
  *
  * @param row The row index of the tile in the tiled matrix
  * @param col The column index of the tile in the tiled matrix
- * @param N The dimension of the quadratic tile (N*N elements)
+ * @param N The dimension of a regular quadratic tile (N*N elements)
+ * @param n_samples The number of samples, the last tile contains the remainder
  * @param n_regressors The number of regressors
  * @param hyperparameters The kernel hyperparameters
  * @param input The input data vector
  *
- * @return A quadratic tile containing the distance between the features of size N x N
+ * @return A tile containing the distance between the features of size N x N, smaller in the last tile row or column
  */
 std::vector<double> gen_tile_distance(
     std::size_t row,
     std::size_t col,
     std::size_t N,
+    std::size_t n_samples,
     std::size_t n_regressors,
     const gprat_hyper::SEKParams &sek_params,
     const std::vector<double> &input);
@@ -83,42 +85,40 @@ std::vector<double> gen_tile_distance(
  *
  * @param row The row index of the tile in the tiled matrix
  * @param col The column index of the tile in the tiled matrix
- * @param N The dimension of the quadratic tile (N*N elements)
+ * @param N The dimension of a regular quadratic tile (N*N elements)
+ * @param n_samples The number of samples, the last tile contains the remainder
  * @param hyperparameters The kernel hyperparameters
  * @param cov_dists The pre-computed distances for the tile
  *
- * @return A quadratic tile of the covariance matrix of size N x N
+ * @return A tile of the covariance matrix of size N x N, smaller in the last tile row or column
  */
 std::vector<double> gen_tile_covariance_with_distance(
     std::size_t row,
     std::size_t col,
     std::size_t N,
+    std::size_t n_samples,
     const gprat_hyper::SEKParams &sek_params,
     const std::vector<double> &distance);
 
 /**
  * @brief  Generate a derivative tile w.r.t. vertical_lengthscale v
  *
- * @param N The dimension of the quadratic tile (N*N elements)
  * @param hyperparameters The kernel hyperparameters
  * @param cov_dists The pre-computed distances for the tile
  *
- * @return A quadratic tile of the derivative of v of size N x N
+ * @return A tile of the derivative of v of the same size as the distance tile
  */
-std::vector<double>
-gen_tile_grad_v(std::size_t N, const gprat_hyper::SEKParams &sek_params, const std::vector<double> &distance);
+std::vector<double> gen_tile_grad_v(const gprat_hyper::SEKParams &sek_params, const std::vector<double> &distance);
 
 /**
  * @brief  Generate a derivative tile w.r.t. lengthscale l
  *
- * @param N The dimension of the quadratic tile (N*N elements)
  * @param hyperparameters The kernel hyperparameters
  * @param cov_dists The pre-computed distances for the tile
  *
- * @return A quadratic tile of the derivative of l of size N x N
+ * @return A tile of the derivative of l of the same size as the distance tile
  */
-std::vector<double>
-gen_tile_grad_l(std::size_t N, const gprat_hyper::SEKParams &sek_params, const std::vector<double> &distance);
+std::vector<double> gen_tile_grad_l(const gprat_hyper::SEKParams &sek_params, const std::vector<double> &distance);
 
 /**
  * @brief Update biased first raw moment estimate: m_T+1 = beta_1 * m_T + (1 - beta_1) * g_T.
@@ -177,24 +177,22 @@ double compute_loss(const std::vector<double> &K_diag_tile,
  * @brief Add up negative-log likelihood loss for all tiles.
  *
  * @param losses A vector contianing the loss per tile
- * @param N The size of a tile
- * @param n_tiles The number of tiles
+ * @param n_samples The number of samples in all tiles
  *
  * @return The added up loss plus the constant factor
  */
-double add_losses(const std::vector<double> &losses, std::size_t N, std::size_t n);
+double add_losses(const std::vector<double> &losses, std::size_t n_samples);
 
 /**
  * @brief Compute the loss gradient.
  *
  * @param trace The first part of the gradient: trace(K^-1 * delta(K)/delta(theta_i))
  * @param dot The second part of the gradient:  beta^T * delta(K)/delta(theta_i) * beta
- * @param N The size of a tile
- * @param n_tiles The number of tiles
+ * @param n_samples The number of samples in all tiles
  *
  * @return The added up loss plus the constant factor
  */
-double compute_gradient(double trace, double dot, std::size_t N, std::size_t n_tiles);
+double compute_gradient(double trace, double dot, std::size_t n_samples);
 
 /**
  * @brief Add the local trace of a tile to the global trace.
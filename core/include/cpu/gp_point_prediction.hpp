@@ -0,0 +1,99 @@
+#ifndef CPU_GP_POINT_PREDICTION_H
+#define CPU_GP_POINT_PREDICTION_H
+
+#include "gp_kernels.hpp"
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace cpu
+{
+
+// Low-latency path: a cached factor of the training covariance serves single test
+// points inline on the calling thread, without HPX tasks and without allocations.
+// The factor is read-only once computed and may be shared between threads, the
+// scratch space of a prediction is owned by the caller.
+
+/**
+ * @brief Cached factor of a Gaussian process for inline predictions of single test points
+ */
+struct PointPredictionFactor
+{
+    /** @brief Number of training samples, 0 if the factor has not been computed */
+    std::size_t n_train = 0;
+
+    /** @brief Number of regressors */
+    std::size_t n_regressors = 0;
+
+    /** @brief Parameter generation of the GP the factor has been computed for */
+    std::size_t params_generation = 0;
+
+    /** @brief Kernel hyperparameters of the kernel row */
+    double lengthscale = 0.0;
+    double vertical_lengthscale = 0.0;
+
+    /** @brief Lagged training features, n_regressors x n_train such that a kernel row vectorizes over the samples */
+    std::vector<double> features;
+
+    /** @brief Lower triangular Cholesky factor L of K, row-major n_train x n_train */
+    std::vector<double> L;
+
+    /** @brief Weights alpha = K^-1 * y */
+    std::vector<double> alpha;
+};
+
+/**
+ * @brief Compute the factor for inline predictions on contiguous matrices.
+ *
+ * @param training_input The training input data
+ * @param training_output The training output data
+ * @param sek_params The kernel hyperparameters
+ * @param n_train The number of training samples
+ * @param n_regressors The number of regressors
+ *
+ * @return The factor
+ */
+PointPredictionFactor compute_point_prediction_factor(const std::vector<double> &training_input,
+                                                      const std::vector<double> &training_output,
+                                                      const gprat_hyper::SEKParams &sek_params,
+                                                      int n_train,
+                                                      int n_regressors);
+
+/**
+ * @brief Returns true if the factor has been computed for the given parameter generation.
+ *
+ * @param factor The factor
+ * @param params_generation The generation of the kernel parameters
+ * @param n_regressors The number of regressors
+ */
+bool is_point_prediction_factor_current(const PointPredictionFactor &factor,
+                                        std::size_t params_generation,
+                                        int n_regressors);
+
+/**
+ * @brief Compute the prediction hat(y) = k(x)^T * alpha of a single test point.
+ *
+ * @param factor The factor
+ * @param features The n_regressors lagged features of the test point
+ * @param workspace Scratch space of n_train entries for the kernel row, overwritten
+ *
+ * @return The prediction
+ */
+double predict_point(const PointPredictionFactor &factor, const double *features, double *workspace);
+
+/**
+ * @brief Compute the prediction and the uncertainty k(x, x) - v^T * v with L * v = k(x)
+ * of a single test point.
+ *
+ * @param factor The factor
+ * @param features The n_regressors lagged features of the test point
+ * @param workspace Scratch space of n_train entries for the kernel row and the triangular solve, overwritten
+ *
+ * @return The prediction and the uncertainty
+ */
+std::pair<double, double>
+predict_point_with_uncertainty(const PointPredictionFactor &factor, const double *features, double *workspace);
+
+}  // end of namespace cpu
+
+#endif  // end of CPU_GP_POINT_PREDICTION_H
@@ -0,0 +1,135 @@
+#ifndef CPU_GP_RANDOM_FEATURES_H
+#define CPU_GP_RANDOM_FEATURES_H
+
+#include "gp_kernels.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace cpu
+{
+
+// Random Fourier feature approximation of the squared exponential kernel:
+// k(z, z') ~ phi(z)^T * phi(z') with D features
+// phi_k(z) = sqrt(2 * vertical_lengthscale / D) * cos(omega_k^T * z + b_k),
+// omega_k ~ N(0, I / lengthscale^2) and b_k ~ U(0, 2 * pi). The GP becomes a Bayesian
+// linear regression on the features, whose D x D system costs O(n * D^2).
+
+/**
+ * @brief Random frequencies and phases of the features
+ */
+struct RandomFeatureBasis
+{
+    /** @brief Number of features D */
+    std::size_t n_features = 0;
+
+    /** @brief Number of regressors */
+    std::size_t n_regressors = 0;
+
+    /** @brief Frequencies omega scaled by the lengthscale, D x n_regressors row-major */
+    std::vector<double> frequencies;
+
+    /** @brief Phases b */
+    std::vector<double> phases;
+
+    /** @brief Amplitude sqrt(2 * vertical_lengthscale / D) of the features */
+    double amplitude = 0.0;
+};
+
+/**
+ * @brief Draw the random features of the squared exponential kernel.
+ *
+ * The standard normal and uniform draws only depend on the seed, such that
+ * the basis follows the kernel parameters for a fixed seed.
+ *
+ * @param n_features The number of features D
+ * @param n_regressors The number of regressors
+ * @param sek_params The kernel hyperparameters
+ * @param seed The seed of the random number generator
+ *
+ * @return The random feature basis
+ */
+RandomFeatureBasis gen_random_feature_basis(std::size_t n_features,
+                                            std::size_t n_regressors,
+                                            const gprat_hyper::SEKParams &sek_params,
+                                            std::uint64_t seed);
+
+/**
+ * @brief Generate a tile of the transposed feature matrix Phi^T
+ *
+ * @param row The row index of the tile, the feature tile
+ * @param col The column index of the tile, the sample tile
+ * @param N_row The dimension of a regular feature tile
+ * @param N_col The dimension of a regular sample tile
+ * @param n_row_samples The number of features, the last tile row contains the remainder
+ * @param n_col_samples The number of samples, the last tile column contains the remainder
+ * @param basis The random feature basis
+ * @param input The input data vector
+ *
+ * @return A tile of Phi^T of size N_row x N_col, smaller in the last tile row or column
+ */
+std::vector<double> gen_tile_random_features(std::size_t row,
+                                             std::size_t col,
+                                             std::size_t N_row,
+                                             std::size_t N_col,
+                                             std::size_t n_row_samples,
+                                             std::size_t n_col_samples,
+                                             const RandomFeatureBasis &basis,
+                                             const std::vector<double> &input);
+
+/**
+ * @brief Compute the predictions of the random feature approximation
+ *
+ * @param training_input The training input data
+ * @param training_output The training output data
+ * @param test_input The test input data
+ * @param sek_params The kernel hyperparameters
+ * @param n_tiles The number of training tiles
+ * @param n_tile_size The size of each training tile
+ * @param d_tiles The number of feature tiles
+ * @param d_tile_size The size of each feature tile
+ * @param m_tiles The number of test tiles
+ * @param m_tile_size The size of each test tile
+ * @param n_regressors The number of regressors
+ * @param n_features The number of features D
+ * @param seed The seed of the random features
+ *
+ * @return A vector containing the predictions
+ */
+std::vector<double> predict_random_features(const std::vector<double> &training_input,
+                                            const std::vector<double> &training_output,
+                                            const std::vector<double> &test_input,
+                                            const gprat_hyper::SEKParams &sek_params,
+                                            int n_tiles,
+                                            int n_tile_size,
+                                            int d_tiles,
+                                            int d_tile_size,
+                                            int m_tiles,
+                                            int m_tile_size,
+                                            int n_regressors,
+                                            int n_features,
+                                            std::uint64_t seed);
+
+/**
+ * @brief Compute the predictions and uncertainties of the random feature approximation
+ *
+ * The parameters are the same as for predict_random_features.
+ *
+ * @return A vector containing the predictions and a vector containing their uncertainties
+ */
+std::vector<std::vector<double>> predict_random_features_with_uncertainty(const std::vector<double> &training_input,
+                                                                          const std::vector<double> &training_output,
+                                                                          const std::vector<double> &test_input,
+                                                                          const gprat_hyper::SEKParams &sek_params,
+                                                                          int n_tiles,
+                                                                          int n_tile_size,
+                                                                          int d_tiles,
+                                                                          int d_tile_size,
+                                                                          int m_tiles,
+                                                                          int m_tile_size,
+                                                                          int n_regressors,
+                                                                          int n_features,
+                                                                          std::uint64_t seed);
+
+}  // end of namespace cpu
+
+#endif  // end of CPU_GP_RANDOM_FEATURES_H
@@ -0,0 +1,96 @@
+#ifndef CPU_GP_SLQ_H
+#define CPU_GP_SLQ_H
+
+#include "gp_hyperparameters.hpp"
+#include "gp_kernels.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace cpu
+{
+
+// Stochastic Lanczos quadrature (SLQ): the loss and its gradient are estimated from
+// matrix-free products with the covariance matrix, see MatrixFreeCovariance, such that
+// no Cholesky decomposition is required. With Rademacher probe vectors z_i,
+//   log(det(K))          ~ 1/t * sum_i ||z_i||^2 * e_1^T * log(T_i) * e_1,
+//   trace(K^-1 * dK)     ~ 1/t * sum_i (K^-1 * z_i)^T * dK * z_i,
+// where T_i is the tridiagonal matrix of m Lanczos steps started at z_i. The data-fit
+// term y^T * K^-1 * y and the solves K^-1 * z_i are computed by PCG. An iteration costs
+// O(N^2 * t * (m + CG iterations)) instead of O(N^3).
+
+/**
+ * @brief Parameters of the stochastic Lanczos quadrature
+ */
+struct SLQParams
+{
+    /** @brief Number of Rademacher probe vectors t */
+    int n_probes;
+
+    /** @brief Number of Lanczos steps m per probe vector */
+    int lanczos_steps;
+
+    /** @brief Seed of the probe vectors */
+    std::uint64_t seed;
+
+    /** @brief Relative residual norm at which PCG has converged */
+    double cg_tolerance;
+
+    /** @brief Maximum number of PCG iterations */
+    int cg_max_iterations;
+
+    /** @brief Rank of the pivoted Cholesky preconditioner */
+    int preconditioner_rank;
+};
+
+/**
+ * @brief Estimate the negative log likelihood loss with stochastic Lanczos quadrature
+ *
+ * @param training_input The training input data
+ * @param training_output The training output data
+ * @param sek_params The kernel hyperparameters
+ * @param n_tiles The number of training tiles
+ * @param n_tile_size The size of each training tile
+ * @param n_regressors The number of regressors
+ * @param slq_params The parameters of the quadrature
+ *
+ * @return The estimated loss
+ */
+double compute_loss_slq(const std::vector<double> &training_input,
+                        const std::vector<double> &training_output,
+                        const gprat_hyper::SEKParams &sek_params,
+                        int n_tiles,
+                        int n_tile_size,
+                        int n_regressors,
+                        const SLQParams &slq_params);
+
+/**
+ * @brief Optimize the hyperparameters with Adam on the loss and gradients estimated by
+ * stochastic Lanczos quadrature
+ *
+ * New probe vectors are drawn in every iteration.
+ *
+ * @param training_input The training input data
+ * @param training_output The training output data
+ * @param n_tiles The number of training tiles
+ * @param n_tile_size The size of each training tile
+ * @param n_regressors The number of regressors
+ * @param adam_params The Adam optimizer hyperparameters
+ * @param sek_params The kernel hyperparameters, updated in place
+ * @param trainable_params The flags of the trainable hyperparameters
+ * @param slq_params The parameters of the quadrature
+ *
+ * @return The estimated losses of all iterations
+ */
+std::vector<double> optimize_slq(const std::vector<double> &training_input,
+                                 const std::vector<double> &training_output,
+                                 int n_tiles,
+                                 int n_tile_size,
+                                 int n_regressors,
+                                 const gprat_hyper::AdamParams &adam_params,
+                                 gprat_hyper::SEKParams &sek_params,
+                                 std::vector<bool> trainable_params,
+                                 const SLQParams &slq_params);
+
+}  // end of namespace cpu
+
+#endif  // end of CPU_GP_SLQ_H
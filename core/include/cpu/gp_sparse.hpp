@@ -0,0 +1,161 @@
+#ifndef CPU_GP_SPARSE_H
+#define CPU_GP_SPARSE_H
+
+#include "gp_hyperparameters.hpp"
+#include "gp_kernels.hpp"
+#include <vector>
+
+namespace cpu
+{
+
+// Sparse inducing-point Gaussian processes: the covariance of the n training samples
+// is approximated through m inducing points z, Q = K_nm * K_mm^-1 * K_mn, such that
+// only M x M systems are factorized and the cost is O(n * m^2). The inducing points
+// are given as a series with n_regressors - 1 leading entries like the training input.
+
+/**
+ * @brief Approximation of the training covariance by the inducing points
+ */
+enum class SparseApproximation
+{
+    /** @brief Subset of regressors: degenerate prior Q, the predictive variance vanishes far from the data */
+    SoR,
+    /** @brief Deterministic training conditional: SoR mean with the exact prior variance of the test points */
+    DTC,
+    /** @brief Fully independent training conditional: Q plus the exact diagonal of K - Q */
+    FITC,
+    /** @brief Variational free energy: DTC with the trace of K - Q as penalty in the loss */
+    VFE
+};
+
+/**
+ * @brief Jitter added to the diagonal of K_mm relative to the vertical lengthscale
+ */
+constexpr double SPARSE_INDUCING_JITTER = 1e-8;
+
+/**
+ * @brief Step of the central finite differences of the sparse loss in the unconstrained hyperparameters
+ */
+constexpr double SPARSE_GRADIENT_STEP = 1e-5;
+
+/**
+ * @brief Compute the sparse predictions
+ *
+ * @param training_input The training input data
+ * @param training_output The training output data
+ * @param inducing_input The inducing points
+ * @param test_input The test input data
+ * @param sek_params The kernel hyperparameters
+ * @param approximation The sparse approximation
+ * @param n_tiles The number of training tiles
+ * @param n_tile_size The size of each training tile
+ * @param inducing_tiles The number of inducing tiles
+ * @param inducing_tile_size The size of each inducing tile
+ * @param m_tiles The number of test tiles
+ * @param m_tile_size The size of each test tile
+ * @param n_regressors The number of regressors
+ *
+ * @return A vector containing the predictions
+ */
+std::vector<double> predict_sparse(const std::vector<double> &training_input,
+                                   const std::vector<double> &training_output,
+                                   const std::vector<double> &inducing_input,
+                                   const std::vector<double> &test_input,
+                                   const gprat_hyper::SEKParams &sek_params,
+                                   SparseApproximation approximation,
+                                   int n_tiles,
+                                   int n_tile_size,
+                                   int inducing_tiles,
+                                   int inducing_tile_size,
+                                   int m_tiles,
+                                   int m_tile_size,
+                                   int n_regressors);
+
+/**
+ * @brief Compute the sparse predictions with uncertainties
+ *
+ * The parameters are the same as for predict_sparse.
+ *
+ * @return A vector containing the predictions and a vector containing their uncertainties
+ */
+std::vector<std::vector<double>> predict_sparse_with_uncertainty(const std::vector<double> &training_input,
+                                                                 const std::vector<double> &training_output,
+                                                                 const std::vector<double> &inducing_input,
+                                                                 const std::vector<double> &test_input,
+                                                                 const gprat_hyper::SEKParams &sek_params,
+                                                                 SparseApproximation approximation,
+                                                                 int n_tiles,
+                                                                 int n_tile_size,
+                                                                 int inducing_tiles,
+                                                                 int inducing_tile_size,
+                                                                 int m_tiles,
+                                                                 int m_tile_size,
+                                                                 int n_regressors);
+
+/**
+ * @brief Compute the sparse loss, normalized per sample like compute_loss.
+ *
+ * SoR, DTC and FITC return the negative log marginal likelihood of the approximate
+ * prior, VFE returns the negative variational lower bound.
+ *
+ * @param training_input The training input data
+ * @param training_output The training output data
+ * @param inducing_input The inducing points
+ * @param sek_params The kernel hyperparameters
+ * @param approximation The sparse approximation
+ * @param n_tiles The number of training tiles
+ * @param n_tile_size The size of each training tile
+ * @param inducing_tiles The number of inducing tiles
+ * @param inducing_tile_size The size of each inducing tile
+ * @param n_regressors The number of regressors
+ *
+ * @return The loss
+ */
+double compute_loss_sparse(const std::vector<double> &training_input,
+                           const std::vector<double> &training_output,
+                           const std::vector<double> &inducing_input,
+                           const gprat_hyper::SEKParams &sek_params,
+                           SparseApproximation approximation,
+                           int n_tiles,
+                           int n_tile_size,
+                           int inducing_tiles,
+                           int inducing_tile_size,
+                           int n_regressors);
+
+/**
+ * @brief Optimize the hyperparameters for the sparse loss with Adam.
+ *
+ * The gradient is approximated by central finite differences in the unconstrained
+ * hyperparameters, whose loss evaluations run concurrently.
+ *
+ * @param training_input The training input data
+ * @param training_output The training output data
+ * @param inducing_input The inducing points
+ * @param approximation The sparse approximation
+ * @param n_tiles The number of training tiles
+ * @param n_tile_size The size of each training tile
+ * @param inducing_tiles The number of inducing tiles
+ * @param inducing_tile_size The size of each inducing tile
+ * @param n_regressors The number of regressors
+ * @param adam_params The Adam optimizer hyperparameters
+ * @param sek_params The kernel hyperparameters, afterwards containing the optimized values
+ * @param trainable_params The vector containing a bool wheather to train a hyperparameter
+ *
+ * @return A vector containing the loss values of each iteration
+ */
+std::vector<double> optimize_sparse(const std::vector<double> &training_input,
+                                    const std::vector<double> &training_output,
+                                    const std::vector<double> &inducing_input,
+                                    SparseApproximation approximation,
+                                    int n_tiles,
+                                    int n_tile_size,
+                                    int inducing_tiles,
+                                    int inducing_tile_size,
+                                    int n_regressors,
+                                    const gprat_hyper::AdamParams &adam_params,
+                                    gprat_hyper::SEKParams &sek_params,
+                                    std::vector<bool> trainable_params);
+
+}  // end of namespace cpu
+
+#endif  // end of CPU_GP_SPARSE_H
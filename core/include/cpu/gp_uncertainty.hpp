@@ -13,10 +13,41 @@ namespace cpu
  * @param A The matrix
  * @param M The rumber of rows in the matrix
  *
+ * @tparam T Scalar type of the matrix
+ *
  * @return Diagonal element vector of the matrix A of size M
  */
 // std::vector<double> get_matrix_diagonal(const std::vector<double> &A, std::size_t M);
-hpx::shared_future<std::vector<double>> get_matrix_diagonal(hpx::shared_future<std::vector<double>> f_A, std::size_t M);
+template <typename T>
+hpx::shared_future<std::vector<T>> get_matrix_diagonal(hpx::shared_future<std::vector<T>> f_A, std::size_t M);
+
+/**
+ * @brief Add a constant to the diagonal elements of the matrix A.
+ *
+ * @param f_A The matrix
+ * @param M The number of rows in the matrix
+ * @param value The constant added to the diagonal
+ *
+ * @tparam T Scalar type of the matrix
+ *
+ * @return The matrix A with the shifted diagonal
+ */
+template <typename T>
+std::vector<T> add_matrix_diagonal(hpx::shared_future<std::vector<T>> f_A, std::size_t M, T value);
+
+/**
+ * @brief Negate the matrix A and add a constant to its diagonal elements: value * I - A.
+ *
+ * @param f_A The matrix
+ * @param M The number of rows in the matrix, 0 for a tile off the diagonal of a tiled matrix
+ * @param value The constant added to the diagonal
+ *
+ * @tparam T Scalar type of the matrix
+ *
+ * @return The negated matrix A with the shifted diagonal
+ */
+template <typename T>
+std::vector<T> negate_matrix_add_diagonal(hpx::shared_future<std::vector<T>> f_A, std::size_t M, T value);
 
 }  // end of namespace cpu
 
@@ -0,0 +1,193 @@
+#ifndef CPU_GP_VECCHIA_H
+#define CPU_GP_VECCHIA_H
+
+#include "gp_hyperparameters.hpp"
+#include "gp_kernels.hpp"
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace cpu
+{
+
+// Vecchia approximation: the joint density of the training outputs is approximated by
+// p(y) ~ prod_i p(y_i | y_c(i)), where the conditioning set c(i) holds the k nearest
+// earlier training samples in the regressor space. Each conditional factorizes a
+// (k + 1) x (k + 1) matrix, such that the loss costs O(n * k^3) and each test point,
+// conditioned on its k nearest training samples, O(k^3). The samples are ordered as
+// given, which for lagged time series is the time order.
+
+/**
+ * @brief Number of samples in a leaf of the KD-tree
+ */
+constexpr std::size_t KD_TREE_LEAF_SIZE = 16;
+
+/**
+ * @brief KD-tree over the lagged feature vectors of a series for nearest neighbour queries
+ */
+class KDTree
+{
+  private:
+    /**
+     * @brief Node of the tree covering the samples order_[begin, end)
+     */
+    struct Node
+    {
+        std::size_t begin;
+        std::size_t end;
+        /** @brief Smallest sample index in the node, to skip nodes without earlier samples */
+        std::size_t min_index;
+        /** @brief Feature that splits the node, only set for inner nodes */
+        std::size_t split_feature;
+        double split_value;
+        /** @brief Child nodes, 0 for leaves */
+        std::size_t left;
+        std::size_t right;
+    };
+
+    /** @brief Number of regressors */
+    std::size_t n_regressors_;
+
+    /** @brief Feature vectors, n_samples x n_regressors row-major */
+    std::vector<double> features_;
+
+    /** @brief Sample indices, permuted such that each node covers a contiguous range */
+    std::vector<std::size_t> order_;
+
+    /** @brief Nodes, the root first */
+    std::vector<Node> nodes_;
+
+    /**
+     * @brief Recursively build the node covering order_[begin, end) and return its index
+     */
+    std::size_t build(std::size_t begin, std::size_t end);
+
+    /**
+     * @brief Recursively collect the nearest samples below limit of a node into a max-heap
+     */
+    void search(std::size_t node,
+                const double *query,
+                std::size_t n_neighbours,
+                std::size_t limit,
+                std::vector<std::pair<double, std::size_t>> &heap) const;
+
+  public:
+    /**
+     * @brief Build the tree over the feature vectors of a series.
+     *
+     * @param input The input data vector, with n_regressors - 1 leading entries
+     * @param n_samples The number of samples
+     * @param n_regressors The number of regressors
+     */
+    KDTree(const std::vector<double> &input, std::size_t n_samples, std::size_t n_regressors);
+
+    /**
+     * @brief Find the nearest samples of a feature vector in Euclidean distance.
+     *
+     * @param query The feature vector with n_regressors entries
+     * @param n_neighbours The maximum number of neighbours k
+     * @param limit Only samples with an index below limit are considered
+     *
+     * @return The indices of the min(k, limit) nearest samples in ascending order of the index
+     */
+    std::vector<std::size_t> find_nearest(const double *query, std::size_t n_neighbours, std::size_t limit) const;
+};
+
+/**
+ * @brief Compute the Vecchia predictions
+ *
+ * @param training_input The training input data
+ * @param training_output The training output data
+ * @param test_input The test input data
+ * @param sek_params The kernel hyperparameters
+ * @param n_tiles The number of training tiles
+ * @param n_tile_size The size of each training tile
+ * @param m_tiles The number of test tiles
+ * @param m_tile_size The size of each test tile
+ * @param n_regressors The number of regressors
+ * @param n_neighbours The number of nearest training samples k a test point is conditioned on
+ *
+ * @return A vector containing the predictions
+ */
+std::vector<double> predict_vecchia(const std::vector<double> &training_input,
+                                    const std::vector<double> &training_output,
+                                    const std::vector<double> &test_input,
+                                    const gprat_hyper::SEKParams &sek_params,
+                                    int n_tiles,
+                                    int n_tile_size,
+                                    int m_tiles,
+                                    int m_tile_size,
+                                    int n_regressors,
+                                    int n_neighbours);
+
+/**
+ * @brief Compute the Vecchia predictions with uncertainties
+ *
+ * The parameters are the same as for predict_vecchia.
+ *
+ * @return A vector containing the predictions and a vector containing their uncertainties
+ */
+std::vector<std::vector<double>> predict_vecchia_with_uncertainty(const std::vector<double> &training_input,
+                                                                  const std::vector<double> &training_output,
+                                                                  const std::vector<double> &test_input,
+                                                                  const gprat_hyper::SEKParams &sek_params,
+                                                                  int n_tiles,
+                                                                  int n_tile_size,
+                                                                  int m_tiles,
+                                                                  int m_tile_size,
+                                                                  int n_regressors,
+                                                                  int n_neighbours);
+
+/**
+ * @brief Compute the negative log likelihood of the Vecchia approximation, normalized
+ * per sample like compute_loss.
+ *
+ * @param training_input The training input data
+ * @param training_output The training output data
+ * @param sek_params The kernel hyperparameters
+ * @param n_tiles The number of training tiles
+ * @param n_tile_size The size of each training tile
+ * @param n_regressors The number of regressors
+ * @param n_neighbours The number of nearest earlier samples k a training sample is conditioned on
+ *
+ * @return The loss
+ */
+double compute_loss_vecchia(const std::vector<double> &training_input,
+                            const std::vector<double> &training_output,
+                            const gprat_hyper::SEKParams &sek_params,
+                            int n_tiles,
+                            int n_tile_size,
+                            int n_regressors,
+                            int n_neighbours);
+
+/**
+ * @brief Optimize the hyperparameters for the Vecchia loss with Adam.
+ *
+ * The conditioning sets do not depend on the hyperparameters and are searched once.
+ * The exact gradient is a sum over the conditionals, computed tile by tile.
+ *
+ * @param training_input The training input data
+ * @param training_output The training output data
+ * @param n_tiles The number of training tiles
+ * @param n_tile_size The size of each training tile
+ * @param n_regressors The number of regressors
+ * @param n_neighbours The number of nearest earlier samples k a training sample is conditioned on
+ * @param adam_params The Adam optimizer hyperparameters
+ * @param sek_params The kernel hyperparameters, afterwards containing the optimized values
+ * @param trainable_params The vector containing a bool wheather to train a hyperparameter
+ *
+ * @return A vector containing the loss values of each iteration
+ */
+std::vector<double> optimize_vecchia(const std::vector<double> &training_input,
+                                     const std::vector<double> &training_output,
+                                     int n_tiles,
+                                     int n_tile_size,
+                                     int n_regressors,
+                                     int n_neighbours,
+                                     const gprat_hyper::AdamParams &adam_params,
+                                     gprat_hyper::SEKParams &sek_params,
+                                     std::vector<bool> trainable_params);
+
+}  // end of namespace cpu
+
+#endif  // end of CPU_GP_VECCHIA_H
@@ -1,6 +1,7 @@
 #ifndef CPU_TILED_ALGORITHMS_H
 #define CPU_TILED_ALGORITHMS_H
 
+#include "cpu/adapter_low_rank.hpp"
 #include "gp_hyperparameters.hpp"
 #include "gp_kernels.hpp"
 #include <hpx/future.hpp>
@@ -8,9 +9,70 @@
 using Tiled_matrix = std::vector<hpx::shared_future<std::vector<double>>>;
 using Tiled_vector = std::vector<hpx::shared_future<std::vector<double>>>;
 
+// Tiled matrix and tiled vector whose tiles have the scalar type T
+template <typename T>
+using Tiled_matrix_t = std::vector<hpx::shared_future<std::vector<T>>>;
+template <typename T>
+using Tiled_vector_t = std::vector<hpx::shared_future<std::vector<T>>>;
+
+// Tiled matrix whose tiles are stored in low-rank form
+using Tiled_low_rank_matrix = std::vector<hpx::shared_future<LowRankTile>>;
+
 namespace cpu
 {
 
+// Task Granularity
+
+/**
+ * @brief Minimum number of floating point operations per task to amortize the task overhead.
+ */
+constexpr std::size_t MIN_TASK_FLOPS = std::size_t{ 1 } << 17;
+
+/**
+ * @brief Compute the number of tiles of a panel that are processed by one fused task.
+ *
+ * Small tiles result in tasks where the HPX overhead dominates the BLAS work. The
+ * chunk size is chosen such that a task performs enough work while still generating
+ * at least one task per worker thread. Tiles of at least MIN_TASK_FLOPS are never
+ * fused, neither are panels with fewer tiles than worker threads.
+ *
+ * @param tile_flops Number of floating point operations per tile operation.
+ * @param n_panel Number of tiles in the panel.
+ *
+ * @return Number of tiles per fused task, 1 disables fusing.
+ */
+std::size_t compute_panel_chunk_size(std::size_t tile_flops, std::size_t n_panel);
+
+/**
+ * @brief Compute the number of BLAS threads for a tile kernel on the critical path.
+ *
+ * The worker threads of HPX are shared between the kernel and the tasks that may
+ * run concurrently, such that the BLAS threads do not oversubscribe the cores.
+ * The cores are not reserved from HPX: the kernel receives the share
+ * n_threads / (n_concurrent_tasks + 1), and since all other BLAS calls are
+ * single-threaded, at most n_concurrent_tasks + n_threads / (n_concurrent_tasks + 1)
+ * <= n_threads threads are busy at a time. The workers left idle by the concurrent
+ * tasks back off and yield their cores to the BLAS threads.
+ *
+ * @param n_concurrent_tasks Number of tasks that may run concurrently to the kernel.
+ *
+ * @return Number of BLAS threads, at least 1.
+ */
+int compute_blas_threads(std::size_t n_concurrent_tasks);
+
+// Tile Sizes
+
+/**
+ * @brief Compute the size of a tile in a tiled dimension whose last tile may be smaller.
+ *
+ * @param k Index of the tile.
+ * @param N Regular tile size.
+ * @param n_total Total size of the tiled dimension.
+ *
+ * @return Size of tile k.
+ */
+int get_tile_size(std::size_t k, int N, std::size_t n_total);
+
 // Tiled Cholesky Algorithm
 
 /**
@@ -20,8 +82,11 @@ namespace cpu
  *        covariance matrix, afterwards the Cholesky decomposition.
  * @param N Tile size per dimension.
  * @param n_tiles Number of tiles per dimension.
+ * @param n_total Matrix size per dimension, the last tile contains the remainder.
+ * @tparam T Scalar type of the tiles.
  */
-void right_looking_cholesky_tiled(Tiled_matrix &ft_tiles, int N, std::size_t n_tiles);
+template <typename T>
+void right_looking_cholesky_tiled(Tiled_matrix_t<T> &ft_tiles, int N, std::size_t n_tiles, std::size_t n_total);
 
 // Tiled Triangular Solve Algorithms
 
@@ -32,8 +97,12 @@ void right_looking_cholesky_tiled(Tiled_matrix &ft_tiles, int N, std::size_t n_t
  * @param ft_rhs Tiled right-hand side vector, afterwards containing the tiled solution vector
  * @param N Tile size per dimension.
  * @param n_tiles Number of tiles per dimension.
+ * @param n_total Matrix size per dimension, the last tile contains the remainder.
+ * @tparam T Scalar type of the tiles.
  */
-void forward_solve_tiled(Tiled_matrix &ft_tiles, Tiled_vector &ft_rhs, int N, std::size_t n_tiles);
+template <typename T>
+void forward_solve_tiled(
+    Tiled_matrix_t<T> &ft_tiles, Tiled_vector_t<T> &ft_rhs, int N, std::size_t n_tiles, std::size_t n_total);
 
 /**
  * @brief Perform tiled backward triangular matrix-vector solve.
@@ -42,8 +111,12 @@ void forward_solve_tiled(Tiled_matrix &ft_tiles, Tiled_vector &ft_rhs, int N, st
  * @param ft_rhs Tiled right-hand side vector, afterwards containing the tiled solution vector
  * @param N Tile size per dimension.
  * @param n_tiles Number of tiles per dimension.
+ * @param n_total Matrix size per dimension, the last tile contains the remainder.
+ * @tparam T Scalar type of the tiles.
  */
-void backward_solve_tiled(Tiled_matrix &ft_tiles, Tiled_vector &ft_rhs, int N, std::size_t n_tiles);
+template <typename T>
+void backward_solve_tiled(
+    Tiled_matrix_t<T> &ft_tiles, Tiled_vector_t<T> &ft_rhs, int N, std::size_t n_tiles, std::size_t n_total);
 
 /**
  * @brief Perform tiled forward triangular matrix-matrix solve.
@@ -54,9 +127,19 @@ void backward_solve_tiled(Tiled_matrix &ft_tiles, Tiled_vector &ft_rhs, int N, s
  * @param M Tile size of second dimension.
  * @param n_tiles Number of tiles in first dimension.
  * @param m_tiles Number of tiles in second dimension.
+ * @param n_total Matrix size of first dimension, the last tile contains the remainder.
+ * @param m_total Matrix size of second dimension, the last tile contains the remainder.
+ * @tparam T Scalar type of the tiles.
  */
-void forward_solve_tiled_matrix(
-    Tiled_matrix &ft_tiles, Tiled_matrix &ft_rhs, int N, int M, std::size_t n_tiles, std::size_t m_tiles);
+template <typename T>
+void forward_solve_tiled_matrix(Tiled_matrix_t<T> &ft_tiles,
+                               Tiled_matrix_t<T> &ft_rhs,
+                               int N,
+                               int M,
+                               std::size_t n_tiles,
+                               std::size_t m_tiles,
+                               std::size_t n_total,
+                               std::size_t m_total);
 
 /**
  * @brief Perform tiled backward triangular matrix-matrix solve.
@@ -67,9 +150,47 @@ void forward_solve_tiled_matrix(
  * @param M Tile size of second dimension.
  * @param n_tiles Number of tiles in first dimension.
  * @param m_tiles Number of tiles in second dimension.
+ * @param n_total Matrix size of first dimension, the last tile contains the remainder.
+ * @param m_total Matrix size of second dimension, the last tile contains the remainder.
+ * @tparam T Scalar type of the tiles.
  */
-void backward_solve_tiled_matrix(
-    Tiled_matrix &ft_tiles, Tiled_matrix &ft_rhs, int N, int M, std::size_t n_tiles, std::size_t m_tiles);
+template <typename T>
+void backward_solve_tiled_matrix(Tiled_matrix_t<T> &ft_tiles,
+                                Tiled_matrix_t<T> &ft_rhs,
+                                int N,
+                                int M,
+                                std::size_t n_tiles,
+                                std::size_t m_tiles,
+                                std::size_t n_total,
+                                std::size_t m_total);
+
+/**
+ * @brief Perform tiled forward triangular solve with a vector and a matrix as right-hand sides.
+ *
+ * Solves L * [x | X] = [a | A] in a single sweep over L. The matrix tiles of a
+ * row are split into column chunks sized by compute_panel_chunk_size, such that
+ * each tile of L is read by one task per chunk. A task packs its chunk, with the
+ * vector tile in the first chunk, into one contiguous buffer and runs a single
+ * wide TRSM or GEMM on it.
+ *
+ * @param ft_tiles Tiled triangular matrix represented as a vector of futurized tiles.
+ * @param ft_vector Tiled right-hand side vector, afterwards containing the tiled solution vector.
+ * @param ft_rhs Tiled right-hand side matrix, afterwards containing the tiled solution matrix.
+ * @param N Tile size of first dimension.
+ * @param n_tiles Number of tiles in first dimension.
+ * @param m_tiles Number of tiles in second dimension, the tile sizes are derived from the tiles.
+ * @param n_total Matrix size of first dimension, the last tile contains the remainder.
+ * @tparam T Scalar type of the triangular and vector tiles and of the computation.
+ * @tparam S Scalar type in which the right-hand side matrix tiles are stored.
+ */
+template <typename T, typename S = T>
+void forward_solve_tiled_multi_rhs(Tiled_matrix_t<T> &ft_tiles,
+                                   Tiled_vector_t<T> &ft_vector,
+                                   Tiled_matrix_t<S> &ft_rhs,
+                                   int N,
+                                   std::size_t n_tiles,
+                                   std::size_t m_tiles,
+                                   std::size_t n_total);
 
 /**
  * @brief Perform tiled matrix-vector multiplication
@@ -79,16 +200,48 @@ void backward_solve_tiled_matrix(
  * @param ft_rhsTiled solution represented as a vector of futurized tiles.
  * @param N_row Tile size of first dimension.
  * @param N_col Tile size of second dimension.
- * @param n_tiles Number of tiles in first dimension.
- * @param m_tiles Number of tiles in second dimension.
+ * @param n_tiles Number of tiles in second dimension.
+ * @param m_tiles Number of tiles in first dimension.
+ * @param n_row_total Matrix size of first dimension, the last tile contains the remainder.
+ * @param n_col_total Matrix size of second dimension, the last tile contains the remainder.
+ * @tparam T Scalar type of the tiles.
  */
-void matrix_vector_tiled(Tiled_matrix &ft_tiles,
-                         Tiled_vector &ft_vector,
-                         Tiled_vector &ft_rhs,
+template <typename T>
+void matrix_vector_tiled(Tiled_matrix_t<T> &ft_tiles,
+                         Tiled_vector_t<T> &ft_vector,
+                         Tiled_vector_t<T> &ft_rhs,
                          int N_row,
                          int N_col,
                          std::size_t n_tiles,
-                         std::size_t m_tiles);
+                         std::size_t m_tiles,
+                         std::size_t n_row_total,
+                         std::size_t n_col_total);
+
+/**
+ * @brief Perform tiled transposed matrix-vector multiplication: rhs = rhs + A^T * x
+ *
+ * @param ft_tiles Tiled matrix A represented as a vector of futurized tiles.
+ * @param ft_vector Tiled vector x represented as a vector of futurized tiles.
+ * @param ft_rhs Tiled solution represented as a vector of futurized tiles.
+ * @param N Tile size of first dimension of A.
+ * @param M Tile size of second dimension of A.
+ * @param n_tiles Number of tiles in first dimension of A.
+ * @param m_tiles Number of tiles in second dimension of A.
+ * @param n_total Matrix size of first dimension, the last tile contains the remainder.
+ * @param m_total Matrix size of second dimension, the last tile contains the remainder.
+ * @tparam T Scalar type of the vector tiles and of the computation.
+ * @tparam S Scalar type in which the matrix tiles are stored.
+ */
+template <typename T, typename S = T>
+void transpose_matrix_vector_tiled(Tiled_matrix_t<S> &ft_tiles,
+                                   Tiled_vector_t<T> &ft_vector,
+                                   Tiled_vector_t<T> &ft_rhs,
+                                   int N,
+                                   int M,
+                                   std::size_t n_tiles,
+                                   std::size_t m_tiles,
+                                   std::size_t n_total,
+                                   std::size_t m_total);
 
 /**
  * @brief Perform tiled symmetric k-rank update on diagonal tiles
@@ -99,22 +252,72 @@ void matrix_vector_tiled(Tiled_matrix &ft_tiles,
  * @param M Tile size of second dimension.
  * @param n_tiles Number of tiles in first dimension.
  * @param m_tiles Number of tiles in second dimension.
+ * @param n_total Matrix size of first dimension, the last tile contains the remainder.
+ * @param m_total Matrix size of second dimension, the last tile contains the remainder.
+ * @tparam T Scalar type of the vector tiles and of the computation.
+ * @tparam S Scalar type in which the matrix tiles are stored.
  */
-void symmetric_matrix_matrix_diagonal_tiled(
-    Tiled_matrix &ft_tiles, Tiled_vector &ft_vector, int N, int M, std::size_t n_tiles, std::size_t m_tiles);
+template <typename T, typename S = T>
+void symmetric_matrix_matrix_diagonal_tiled(Tiled_matrix_t<S> &ft_tiles,
+                                            Tiled_vector_t<T> &ft_vector,
+                                            int N,
+                                            int M,
+                                            std::size_t n_tiles,
+                                            std::size_t m_tiles,
+                                            std::size_t n_total,
+                                            std::size_t m_total);
 
 /**
  * @brief Perform tiled symmetric k-rank update (ft_tiles^T * ft_tiles)
  *
+ * Only the lower triangle is computed: SYRK on the diagonal tiles and GEMM on the
+ * tiles below. The tiles above the diagonal and the upper triangles of the diagonal
+ * tiles of ft_result are neither read nor written.
+ *
  * @param ft_tiles Tiled matrix represented as a vector of futurized tiles.
  * @param ft_result Tiled matrix holding the result of the computationi.
  * @param N Tile size of first dimension.
  * @param M Tile size of second dimension.
  * @param n_tiles Number of tiles in first dimension.
  * @param m_tiles Number of tiles in second dimension.
+ * @param n_total Matrix size of first dimension, the last tile contains the remainder.
+ * @param m_total Matrix size of second dimension, the last tile contains the remainder.
+ * @tparam T Scalar type of the result tiles and of the computation.
+ * @tparam S Scalar type in which the tiles of the input matrix are stored.
  */
-void symmetric_matrix_matrix_tiled(
-    Tiled_matrix &ft_tiles, Tiled_matrix &ft_result, int N, int M, std::size_t n_tiles, std::size_t m_tiles);
+template <typename T, typename S = T>
+void symmetric_matrix_matrix_tiled(Tiled_matrix_t<S> &ft_tiles,
+                                   Tiled_matrix_t<T> &ft_result,
+                                   int N,
+                                   int M,
+                                   std::size_t n_tiles,
+                                   std::size_t m_tiles,
+                                   std::size_t n_total,
+                                   std::size_t m_total);
+
+/**
+ * @brief Perform tiled symmetric k-rank update C = C - A * A^T
+ *
+ * Only the lower triangle is computed: SYRK on the diagonal tiles and GEMM on the
+ * tiles below.
+ *
+ * @param ft_tiles Tiled matrix A with m_tiles row tiles and n_tiles column tiles.
+ * @param ft_result Tiled matrix C with m_tiles tiles per dimension, afterwards containing the result.
+ * @param M Tile size of first dimension of A.
+ * @param N Tile size of second dimension of A.
+ * @param m_tiles Number of tiles in first dimension of A.
+ * @param n_tiles Number of tiles in second dimension of A.
+ * @param m_total Matrix size of first dimension, the last tile contains the remainder.
+ * @param n_total Matrix size of second dimension, the last tile contains the remainder.
+ */
+void symmetric_matrix_matrix_transpose_tiled(Tiled_matrix &ft_tiles,
+                                             Tiled_matrix &ft_result,
+                                             int M,
+                                             int N,
+                                             std::size_t m_tiles,
+                                             std::size_t n_tiles,
+                                             std::size_t m_total,
+                                             std::size_t n_total);
 
 /**
  * @brief Compute the difference between two tiled vectors
@@ -123,8 +326,12 @@ void symmetric_matrix_matrix_tiled(
  * @param ft_difference Tiled vector that contains the result of the substraction.
  * @param M Tile size dimension.
  * @param m_tiles Number of tiles.
+ * @param m_total Vector size, the last tile contains the remainder.
+ * @tparam T Scalar type of the tiles.
  */
-void vector_difference_tiled(Tiled_vector &ft_minuend, Tiled_vector &ft_substrahend, int M, std::size_t m_tiles);
+template <typename T>
+void vector_difference_tiled(
+    Tiled_vector_t<T> &ft_minuend, Tiled_vector_t<T> &ft_substrahend, int M, std::size_t m_tiles, std::size_t m_total);
 
 /**
  * @brief Extract the tiled diagonals of a tiled matrix
@@ -132,8 +339,57 @@ void vector_difference_tiled(Tiled_vector &ft_minuend, Tiled_vector &ft_substrah
  * @param ft_vector Tiled vector containing the diagonals of the matrix tiles
  * @param M Tile size per dimension.
  * @param m_tiles Number of tiles per dimension.
+ * @param m_total Matrix size per dimension, the last tile contains the remainder.
+ * @tparam T Scalar type of the tiles.
  */
-void matrix_diagonal_tiled(Tiled_matrix &ft_tiles, Tiled_vector &ft_vector, int M, std::size_t m_tiles);
+template <typename T>
+void matrix_diagonal_tiled(
+    Tiled_matrix_t<T> &ft_tiles, Tiled_vector_t<T> &ft_vector, int M, std::size_t m_tiles, std::size_t m_total);
+
+/**
+ * @brief Perform tiled triangular matrix-matrix multiplication C = C - L * B.
+ *
+ * @param ft_tiles Tiled lower triangular matrix L represented as a vector of futurized tiles.
+ * @param ft_matrix Tiled matrix B with m_tiles row tiles of n_columns columns.
+ * @param ft_result Tiled matrix C with m_tiles row tiles of n_columns columns, afterwards
+ *        containing the tiled result
+ * @param M Tile size per dimension.
+ * @param n_columns Number of columns of B and C.
+ * @param m_tiles Number of tiles per dimension.
+ * @param m_total Matrix size per dimension, the last tile contains the remainder.
+ */
+void triangular_matrix_matrix_tiled(Tiled_matrix &ft_tiles,
+                                    Tiled_matrix &ft_matrix,
+                                    Tiled_matrix &ft_result,
+                                    int M,
+                                    int n_columns,
+                                    std::size_t m_tiles,
+                                    std::size_t m_total);
+
+/**
+ * @brief Compute the FP64 residual r = y - K * x without storing the covariance matrix K.
+ *
+ * Each tile of K is generated by the task that multiplies it with x and is
+ * released afterwards, such that the FP64 matrix K is never stored as a whole.
+ *
+ * @param input The training input data
+ * @param sek_params The kernel hyperparameters
+ * @param ft_x Tiled vector x.
+ * @param ft_residual Tiled right-hand side y, afterwards containing the tiled residual r.
+ * @param N Tile size per dimension.
+ * @param n_tiles Number of tiles per dimension.
+ * @param n_total Matrix size per dimension, the last tile contains the remainder.
+ * @param n_regressors The number of regressors
+ * @note The caller must keep input and sek_params alive until the residual tiles are ready.
+ */
+void covariance_residual_tiled(const std::vector<double> &input,
+                               const gprat_hyper::SEKParams &sek_params,
+                               Tiled_vector &ft_x,
+                               Tiled_vector &ft_residual,
+                               int N,
+                               std::size_t n_tiles,
+                               std::size_t n_total,
+                               std::size_t n_regressors);
 
 /**
  * @brief Compute the negative log likelihood loss with a tiled covariance matrix K.
@@ -146,13 +402,15 @@ void matrix_diagonal_tiled(Tiled_matrix &ft_tiles, Tiled_vector &ft_vector, int
  * @param loss The loss value to be computed
  * @param N Tile size per dimension.
  * @param n_tiles Number of tiles per dimension.
+ * @param n_total Matrix size per dimension, the last tile contains the remainder.
  */
 void compute_loss_tiled(Tiled_matrix &ft_tiles,
                         Tiled_vector &ft_alpha,
                         Tiled_vector &ft_y,
                         hpx::shared_future<double> &loss,
                         int N,
-                        std::size_t n_tiles);
+                        std::size_t n_tiles,
+                        std::size_t n_total);
 
 /**
  * @brief Updates a hyperparameter of the SEK kernel using Adam
@@ -164,6 +422,7 @@ void compute_loss_tiled(Tiled_matrix &ft_tiles,
  * @param sek_params Hyperparameters of the SEK kernel
  * @param N Tile size per dimension.
  * @param n_tiles Number of tiles per dimension.
+ * @param n_total Matrix size per dimension, the last tile contains the remainder.
  * @param iter Current iteration.
  * @param param_idx Index of the hyperparameter to optimize.
  */
@@ -175,9 +434,239 @@ void update_hyperparameter_tiled(
     gprat_hyper::SEKParams &sek_params,
     int N,
     std::size_t n_tiles,
+    std::size_t n_total,
     std::size_t iter,
     std::size_t param_idx);
 
+// Block Low-Rank Tiled Algorithms
+//
+// The covariance matrix is split into dense diagonal tiles and off-diagonal tiles in
+// low-rank form, which traverse the same DAG as the dense algorithms above. The low-rank
+// kernels cost O(N^2 * r) instead of O(N^3) for tiles of size N and rank r.
+
+/**
+ * @brief Perform right-looking tiled Cholesky decomposition on a block low-rank matrix.
+ *
+ * The trailing updates of the off-diagonal tiles are recompressed to the tolerance.
+ *
+ * @param ft_tiles Tiled matrix whose diagonal tiles contain the dense diagonal tiles of the
+ *        covariance matrix, afterwards those of the Cholesky decomposition.
+ * @param ft_low_rank_tiles Tiled matrix whose tiles below the diagonal contain the off-diagonal
+ *        tiles of the covariance matrix in low-rank form, afterwards those of the Cholesky decomposition.
+ * @param N Tile size per dimension.
+ * @param n_tiles Number of tiles per dimension.
+ * @param n_total Matrix size per dimension, the last tile contains the remainder.
+ * @param tolerance Relative truncation tolerance of the low-rank tiles in the Frobenius norm.
+ */
+void right_looking_cholesky_tiled(Tiled_matrix &ft_tiles,
+                                  Tiled_low_rank_matrix &ft_low_rank_tiles,
+                                  int N,
+                                  std::size_t n_tiles,
+                                  std::size_t n_total,
+                                  double tolerance);
+
+/**
+ * @brief Perform tiled forward triangular matrix-vector solve with a block low-rank Cholesky factor.
+ *
+ * @param ft_tiles Tiled Cholesky factor holding the dense diagonal tiles.
+ * @param ft_low_rank_tiles Tiled Cholesky factor holding the off-diagonal tiles in low-rank form.
+ * @param ft_rhs Tiled right-hand side vector, afterwards containing the solution.
+ * @param N Tile size per dimension.
+ * @param n_tiles Number of tiles per dimension.
+ * @param n_total Matrix size per dimension, the last tile contains the remainder.
+ */
+void forward_solve_tiled(Tiled_matrix &ft_tiles,
+                         Tiled_low_rank_matrix &ft_low_rank_tiles,
+                         Tiled_vector &ft_rhs,
+                         int N,
+                         std::size_t n_tiles,
+                         std::size_t n_total);
+
+/**
+ * @brief Perform tiled backward triangular matrix-vector solve with a block low-rank Cholesky factor.
+ *
+ * @param ft_tiles Tiled Cholesky factor holding the dense diagonal tiles.
+ * @param ft_low_rank_tiles Tiled Cholesky factor holding the off-diagonal tiles in low-rank form.
+ * @param ft_rhs Tiled right-hand side vector, afterwards containing the solution.
+ * @param N Tile size per dimension.
+ * @param n_tiles Number of tiles per dimension.
+ * @param n_total Matrix size per dimension, the last tile contains the remainder.
+ */
+void backward_solve_tiled(Tiled_matrix &ft_tiles,
+                          Tiled_low_rank_matrix &ft_low_rank_tiles,
+                          Tiled_vector &ft_rhs,
+                          int N,
+                          std::size_t n_tiles,
+                          std::size_t n_total);
+
+/**
+ * @brief Perform tiled forward triangular matrix-matrix solve with a block low-rank Cholesky factor.
+ *
+ * @param ft_tiles Tiled Cholesky factor holding the dense diagonal tiles.
+ * @param ft_low_rank_tiles Tiled Cholesky factor holding the off-diagonal tiles in low-rank form.
+ * @param ft_rhs Tiled dense right-hand side matrix, afterwards containing the solution.
+ * @param N Tile size of first dimension.
+ * @param M Tile size of second dimension.
+ * @param n_tiles Number of tiles in first dimension.
+ * @param m_tiles Number of tiles in second dimension.
+ * @param n_total Matrix size of first dimension, the last tile contains the remainder.
+ * @param m_total Matrix size of second dimension, the last tile contains the remainder.
+ */
+void forward_solve_tiled_matrix(Tiled_matrix &ft_tiles,
+                                Tiled_low_rank_matrix &ft_low_rank_tiles,
+                                Tiled_matrix &ft_rhs,
+                                int N,
+                                int M,
+                                std::size_t n_tiles,
+                                std::size_t m_tiles,
+                                std::size_t n_total,
+                                std::size_t m_total);
+
+/**
+ * @brief Perform tiled matrix-vector multiplication with a matrix in low-rank form: rhs = rhs + A * x
+ *
+ * The tile sizes are stored in the low-rank tiles.
+ *
+ * @param ft_tiles Tiled matrix A whose tiles are stored in low-rank form.
+ * @param ft_vector Tiled vector x represented as a vector of futurized tiles.
+ * @param ft_rhs Tiled solution represented as a vector of futurized tiles.
+ * @param n_tiles Number of tiles in second dimension.
+ * @param m_tiles Number of tiles in first dimension.
+ */
+void matrix_vector_tiled(Tiled_low_rank_matrix &ft_tiles,
+                         Tiled_vector &ft_vector,
+                         Tiled_vector &ft_rhs,
+                         std::size_t n_tiles,
+                         std::size_t m_tiles);
+
+// Sparse Tiled Algorithms
+//
+// Compactly supported kernels yield tiles that are identically zero. The pattern holds
+// the nonzero tiles of the lower triangular Cholesky factor, including the fill-in of the
+// decomposition, at position i * n_tiles + j. Tiles outside the pattern are never
+// accessed, such that all operations which would only touch zero tiles are skipped.
+
+/**
+ * @brief Perform right-looking tiled Cholesky decomposition on a tile-sparse matrix.
+ *
+ * @param ft_tiles Tiled matrix whose tiles in the pattern contain the covariance matrix, zero
+ *        tiles of the fill-in included, afterwards those of the Cholesky decomposition.
+ * @param pattern Nonzero tiles of the Cholesky factor, closed under the fill-in.
+ * @param N Tile size per dimension.
+ * @param n_tiles Number of tiles per dimension.
+ * @param n_total Matrix size per dimension, the last tile contains the remainder.
+ */
+void right_looking_cholesky_tiled(
+    Tiled_matrix &ft_tiles, const std::vector<bool> &pattern, int N, std::size_t n_tiles, std::size_t n_total);
+
+/**
+ * @brief Perform tiled forward triangular matrix-vector solve with a tile-sparse Cholesky factor.
+ *
+ * @param ft_tiles Tiled Cholesky factor.
+ * @param pattern Nonzero tiles of the Cholesky factor.
+ * @param ft_rhs Tiled right-hand side vector, afterwards containing the solution.
+ * @param N Tile size per dimension.
+ * @param n_tiles Number of tiles per dimension.
+ * @param n_total Matrix size per dimension, the last tile contains the remainder.
+ */
+void forward_solve_tiled(Tiled_matrix &ft_tiles,
+                         const std::vector<bool> &pattern,
+                         Tiled_vector &ft_rhs,
+                         int N,
+                         std::size_t n_tiles,
+                         std::size_t n_total);
+
+/**
+ * @brief Perform tiled backward triangular matrix-vector solve with a tile-sparse Cholesky factor.
+ *
+ * @param ft_tiles Tiled Cholesky factor.
+ * @param pattern Nonzero tiles of the Cholesky factor.
+ * @param ft_rhs Tiled right-hand side vector, afterwards containing the solution.
+ * @param N Tile size per dimension.
+ * @param n_tiles Number of tiles per dimension.
+ * @param n_total Matrix size per dimension, the last tile contains the remainder.
+ */
+void backward_solve_tiled(Tiled_matrix &ft_tiles,
+                          const std::vector<bool> &pattern,
+                          Tiled_vector &ft_rhs,
+                          int N,
+                          std::size_t n_tiles,
+                          std::size_t n_total);
+
+/**
+ * @brief Perform tiled forward triangular matrix-matrix solve with a tile-sparse Cholesky factor.
+ *
+ * Zero tiles of the right-hand side are skipped until an update reaches them.
+ *
+ * @param ft_tiles Tiled Cholesky factor.
+ * @param pattern Nonzero tiles of the Cholesky factor.
+ * @param ft_rhs Tiled right-hand side matrix, zero tiles included, afterwards containing the solution.
+ * @param rhs_pattern Nonzero tiles of the right-hand side, afterwards those of the solution.
+ * @param N Tile size of first dimension.
+ * @param M Tile size of second dimension.
+ * @param n_tiles Number of tiles in first dimension.
+ * @param m_tiles Number of tiles in second dimension.
+ * @param n_total Matrix size of first dimension, the last tile contains the remainder.
+ * @param m_total Matrix size of second dimension, the last tile contains the remainder.
+ */
+void forward_solve_tiled_matrix(Tiled_matrix &ft_tiles,
+                                const std::vector<bool> &pattern,
+                                Tiled_matrix &ft_rhs,
+                                std::vector<bool> &rhs_pattern,
+                                int N,
+                                int M,
+                                std::size_t n_tiles,
+                                std::size_t m_tiles,
+                                std::size_t n_total,
+                                std::size_t m_total);
+
+/**
+ * @brief Perform tiled matrix-vector multiplication with a tile-sparse matrix: rhs = rhs + A * x
+ *
+ * @param ft_tiles Tiled matrix A, only the tiles in the pattern are accessed.
+ * @param pattern Nonzero tiles of A.
+ * @param ft_vector Tiled vector x represented as a vector of futurized tiles.
+ * @param ft_rhs Tiled solution represented as a vector of futurized tiles.
+ * @param N_row Tile size of first dimension.
+ * @param N_col Tile size of second dimension.
+ * @param n_tiles Number of tiles in second dimension.
+ * @param m_tiles Number of tiles in first dimension.
+ * @param n_row_total Matrix size of first dimension, the last tile contains the remainder.
+ * @param n_col_total Matrix size of second dimension, the last tile contains the remainder.
+ */
+void matrix_vector_tiled(Tiled_matrix &ft_tiles,
+                         const std::vector<bool> &pattern,
+                         Tiled_vector &ft_vector,
+                         Tiled_vector &ft_rhs,
+                         int N_row,
+                         int N_col,
+                         std::size_t n_tiles,
+                         std::size_t m_tiles,
+                         std::size_t n_row_total,
+                         std::size_t n_col_total);
+
+/**
+ * @brief Compute the tiles of the inverse covariance matrix in the pattern of its Cholesky factor.
+ *
+ * The selected inverse Z = K^-1 follows from Z * L = L^-T by the recursion
+ * Z_ij = (delta_ij * L_jj^-T - sum_{k > j} Z_ik * L_kj) * L_jj^-1 from the last tile column
+ * to the first, where the sum runs over the nonzero tiles L_kj only. The pattern is closed
+ * under the fill-in, such that all required tiles Z_ik are part of it.
+ *
+ * @param ft_tiles Tiled Cholesky factor.
+ * @param pattern Nonzero tiles of the Cholesky factor.
+ * @param ft_inverse Tiled matrix, afterwards containing the tiles of K^-1 in the pattern.
+ * @param N Tile size per dimension.
+ * @param n_tiles Number of tiles per dimension.
+ * @param n_total Matrix size per dimension, the last tile contains the remainder.
+ */
+void selected_inverse_tiled(Tiled_matrix &ft_tiles,
+                            const std::vector<bool> &pattern,
+                            Tiled_matrix &ft_inverse,
+                            int N,
+                            std::size_t n_tiles,
+                            std::size_t n_total);
+
 }  // end of namespace cpu
 
 #endif  // end of CPU_TILED_ALGORITHMS_H
@@ -1,17 +1,101 @@
 #ifndef GPRAT_C_H
 #define GPRAT_C_H
 
+#include "cpu/gp_blr.hpp"
+#include "cpu/gp_cg.hpp"
+#include "cpu/gp_compact.hpp"
+#include "cpu/gp_experts.hpp"
+#include "cpu/gp_forecast.hpp"
+#include "cpu/gp_functions.hpp"
+#include "cpu/gp_hodlr.hpp"
+#include "cpu/gp_point_prediction.hpp"
+#include "cpu/gp_random_features.hpp"
+#include "cpu/gp_slq.hpp"
+#include "cpu/gp_sparse.hpp"
+#include "cpu/gp_vecchia.hpp"
 #include "gp_hyperparameters.hpp"
 #include "gp_kernels.hpp"
 #include "target.hpp"
+#include "tile_tuner.hpp"
+#include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 // namespace for GPRat library entities
 namespace gprat
 {
 
+/**
+ * @brief Default number of training samples up to which the GP bypasses the
+ * tiled algorithms and uses monolithic LAPACK calls instead.
+ *
+ * A default constructed GP with at most 1024 training samples therefore never
+ * runs the tiled algorithms, independently of its number of tiles. Set
+ * GP::small_problem_threshold to 0 to benchmark or test the tiled algorithms
+ * on such problems.
+ */
+constexpr int DEFAULT_SMALL_PROBLEM_THRESHOLD = 1024;
+
+/**
+ * @brief Default number of nearest neighbours each sample is conditioned on
+ * in the Vecchia computations.
+ */
+constexpr int DEFAULT_VECCHIA_NEIGHBOURS = 16;
+
+/**
+ * @brief Default relative tolerance of the low-rank tiles in the block
+ * low-rank computations.
+ */
+constexpr double DEFAULT_BLR_TOLERANCE = 1e-8;
+
+/**
+ * @brief Default relative tolerance of the off-diagonal blocks in the HODLR
+ * computations.
+ */
+constexpr double DEFAULT_HODLR_TOLERANCE = 1e-8;
+
+/**
+ * @brief Default relative residual norm at which the conjugate gradient
+ * method has converged.
+ */
+constexpr double DEFAULT_CG_TOLERANCE = 1e-10;
+
+/**
+ * @brief Default maximum number of conjugate gradient iterations.
+ */
+constexpr int DEFAULT_CG_MAX_ITERATIONS = 1000;
+
+/**
+ * @brief Default rank of the pivoted Cholesky preconditioner of the
+ * conjugate gradient method.
+ */
+constexpr int DEFAULT_CG_PRECONDITIONER_RANK = 50;
+
+/**
+ * @brief Default number of probe vectors of the stochastic Lanczos quadrature.
+ */
+constexpr int DEFAULT_SLQ_PROBES = 16;
+
+/**
+ * @brief Default number of Lanczos steps of the stochastic Lanczos quadrature.
+ */
+constexpr int DEFAULT_SLQ_LANCZOS_STEPS = 30;
+
+/**
+ * @brief Floating point precision of the tiled CPU predictions.
+ *
+ * Mixed factorizes in FP32 and refines the solution to FP64 accuracy.
+ */
+enum class Precision { FP64, FP32, Mixed };
+
+/**
+ * @brief Floating point precision in which the cross-covariance tiles of the
+ * tiled CPU predictions with uncertainty are stored.
+ */
+enum class StoragePrecision { FP64, FP32 };
+
 /**
  * @brief Data structure for Gaussian Process data
  *
@@ -60,12 +144,36 @@ class GP
     /** @brief Output data for given input data */
     std::vector<double> training_output_;
 
-    /** @brief Number of tiles */
+    /** @brief Number of tiles, 0 if tiles are tuned automatically */
     int n_tiles_;
 
-    /** @brief Size of each tile in each dimension */
+    /** @brief Size of each tile in each dimension, 0 if tiles are tuned automatically */
     int n_tile_size_;
 
+    /** @brief Automatically tuned number of tiles and tile size per operation */
+    std::map<TiledOperation, std::pair<int, int>> tuned_tiles_;
+
+    /** @brief Convergence report of the last mixed precision prediction */
+    cpu::RefinementReport refinement_report_;
+
+    /** @brief Cached factor for the inline predictions of single test points */
+    cpu::PointPredictionFactor point_factor_;
+
+    /** @brief Scratch space of the inline predictions with one entry per training sample */
+    std::vector<double> point_workspace_;
+
+    /** @brief Generation of the kernel parameters, advanced whenever they change */
+    std::size_t params_generation_;
+
+    /** @brief Inducing points of the sparse approximation, empty if not set */
+    std::vector<double> inducing_input_;
+
+    /** @brief Number of inducing tiles */
+    int inducing_tiles_;
+
+    /** @brief Size of each inducing tile */
+    int inducing_tile_size_;
+
     /**
      * @brief List of bools indicating trainable parameters: lengthscale,
      * vertical lengthscale, noise variance
@@ -77,6 +185,110 @@ class GP
      */
     std::shared_ptr<Target> target_;
 
+    /**
+     * @brief Returns true if the CPU computations should bypass the tiled algorithms.
+     *
+     * @param n_train Number of training samples
+     */
+    bool use_contiguous_path(int n_train) const;
+
+    /**
+     * @brief Returns the number of training tiles and the tile size used for an
+     * operation, tuning them on first use if no tiles were specified.
+     *
+     * @param operation The tiled operation
+     */
+    std::pair<int, int> train_tiles(TiledOperation operation);
+
+    /**
+     * @brief Returns the factor for the inline predictions, recomputing it if
+     * the parameter generation or the number of regressors changed.
+     */
+    const cpu::PointPredictionFactor &point_prediction_factor();
+
+    /**
+     * @brief Dispatch the predictions on the CPU to the contiguous, mixed,
+     * FP32 or FP64 tiled algorithms.
+     *
+     * @param test_input Test input data
+     * @param n_tiles Number of training tiles
+     * @param n_tile_size Size of each training tile
+     * @param m_tiles Number of test tiles
+     * @param m_tile_size Size of each test tile
+     */
+    std::vector<double>
+    predict_cpu(const std::vector<double> &test_input, int n_tiles, int n_tile_size, int m_tiles, int m_tile_size);
+
+    /**
+     * @brief Dispatch the predictions with uncertainty on the CPU to the
+     * contiguous or tiled algorithms, see predict_cpu.
+     */
+    std::vector<std::vector<double>> predict_with_uncertainty_cpu(
+        const std::vector<double> &test_input, int n_tiles, int n_tile_size, int m_tiles, int m_tile_size);
+
+    /**
+     * @brief Dispatch the predictions with full covariance on the CPU to the
+     * contiguous or tiled algorithms, see predict_cpu.
+     */
+    std::vector<std::vector<double>> predict_with_full_cov_cpu(
+        const std::vector<double> &test_input, int n_tiles, int n_tile_size, int m_tiles, int m_tile_size);
+
+    /**
+     * @brief Throw if the sparse computations are not available, because no
+     * inducing points are set or the GP runs on the GPU.
+     */
+    void check_sparse() const;
+
+    /**
+     * @brief Throw if the Vecchia computations are not available, because the
+     * number of neighbours is negative or the GP runs on the GPU.
+     */
+    void check_vecchia() const;
+
+    /**
+     * @brief Throw if the expert computations are not available, because the
+     * GP runs on the GPU.
+     */
+    void check_experts() const;
+
+    /**
+     * @brief Throw if the block low-rank computations are not available,
+     * because the tolerance is negative or the GP runs on the GPU.
+     */
+    void check_blr() const;
+
+    /**
+     * @brief Throw if the HODLR computations are not available, because the
+     * tolerance is negative or the GP runs on the GPU.
+     */
+    void check_hodlr() const;
+
+    /**
+     * @brief Throw if the conjugate gradient computations are not available,
+     * because their parameters or the noise variance are invalid or the GP
+     * runs on the GPU.
+     */
+    void check_cg() const;
+
+    /**
+     * @brief Throw if the stochastic Lanczos quadrature is not available,
+     * because its parameters or those of the conjugate gradient method are
+     * invalid or the GP runs on the GPU.
+     */
+    void check_slq() const;
+
+    /**
+     * @brief Return the parameters of the stochastic Lanczos quadrature.
+     */
+    cpu::SLQParams slq_params() const;
+
+    /**
+     * @brief Throw if the computations with the compactly supported kernel
+     * are not available, because the lengthscale is not positive or the GP
+     * runs on the GPU.
+     */
+    void check_compact() const;
+
   public:
     /** @brief Number of regressors */
     int n_reg;
@@ -86,6 +298,114 @@ class GP
      */
     gprat_hyper::SEKParams kernel_params;
 
+    /**
+     * @brief Number of training samples up to which predictions and losses
+     * are computed on contiguous matrices without tiling (CPU only).
+     * Defaults to DEFAULT_SMALL_PROBLEM_THRESHOLD, i.e. small problems ignore
+     * the tiles. Set to 0 to always use the tiled algorithms.
+     */
+    int small_problem_threshold;
+
+    /**
+     * @brief Precision of the tiled predictions (CPU only). FP32 halves the
+     * memory of the tiles and roughly doubles the BLAS throughput at the cost
+     * of accuracy. Mixed uses the FP32 factor to refine the predictions to
+     * FP64 accuracy and computes uncertainties in FP64. Losses, optimization,
+     * the Cholesky factor and problems up to small_problem_threshold are
+     * always computed in FP64.
+     */
+    Precision precision;
+
+    /**
+     * @brief Storage precision of the cross-covariance tiles and their
+     * triangular solves in the tiled FP64 predictions with uncertainty (CPU
+     * only). FP32 halves the largest allocations of these predictions, while
+     * the solves and diagonal reductions still accumulate in FP64.
+     */
+    StoragePrecision cross_covariance_storage;
+
+    /**
+     * @brief Approximation of the training covariance by the inducing points
+     * in the sparse computations (CPU only), see set_inducing_points.
+     */
+    cpu::SparseApproximation sparse_approximation;
+
+    /**
+     * @brief Number of nearest neighbours k each sample is conditioned on in
+     * the Vecchia computations (CPU only). Training samples are conditioned
+     * on their nearest earlier training samples, test points on their
+     * nearest training samples.
+     */
+    int vecchia_neighbours;
+
+    /**
+     * @brief Rule to combine the predictions of the experts in the expert
+     * computations (CPU only). Each training tile is an independent expert.
+     */
+    cpu::ExpertAggregation expert_aggregation;
+
+    /**
+     * @brief Relative tolerance in the Frobenius norm to which the
+     * off-diagonal tiles are compressed in the block low-rank computations
+     * (CPU only). Larger tolerances reduce the ranks, and thereby memory and
+     * flops, at the cost of accuracy.
+     */
+    double blr_tolerance;
+
+    /**
+     * @brief Relative tolerance in the Frobenius norm to which the
+     * off-diagonal blocks of the hierarchical matrix are compressed in the
+     * HODLR computations (CPU only). The training tiles are the dense leaves
+     * of the hierarchy.
+     */
+    double hodlr_tolerance;
+
+    /**
+     * @brief Relative residual norm at which the preconditioned conjugate
+     * gradient method has converged in the matrix-free computations (CPU
+     * only).
+     */
+    double cg_tolerance;
+
+    /**
+     * @brief Maximum number of conjugate gradient iterations in the
+     * matrix-free computations (CPU only).
+     */
+    int cg_max_iterations;
+
+    /**
+     * @brief Rank of the pivoted Cholesky preconditioner in the matrix-free
+     * computations (CPU only). Set to 0 for a diagonal preconditioner.
+     */
+    int cg_preconditioner_rank;
+
+    /**
+     * @brief Number of Rademacher probe vectors of the stochastic Lanczos
+     * quadrature (CPU only). The variance of the estimated loss and
+     * gradients decreases with the number of probe vectors.
+     */
+    int slq_probes;
+
+    /**
+     * @brief Number of Lanczos steps per probe vector of the stochastic
+     * Lanczos quadrature (CPU only).
+     */
+    int slq_lanczos_steps;
+
+    /**
+     * @brief Seed of the probe vectors of the stochastic Lanczos quadrature
+     * (CPU only).
+     */
+    std::uint64_t slq_seed;
+
+    /**
+     * @brief Whether to reorder the samples by recursive coordinate bisection
+     * in the computations with the compactly supported Wendland kernel (CPU
+     * only), such that the tiles cover compact regions of the feature space
+     * and more tiles are identically zero.
+     */
+    bool compact_reorder;
+
     /**
      * @brief Constructs a Gaussian Process (GP)
      *
@@ -130,6 +450,27 @@ class GP
        std::vector<double> kernel_hyperparams,
        std::vector<bool> trainable_bool);
 
+    /**
+     * @brief Constructs a Gaussian Process (GP) for CPU computations with
+     * automatically tuned tiles
+     *
+     * The number of tiles and the tile size are chosen per operation on first
+     * use by calibration benchmarks, see tune_tile_size.
+     *
+     * @param input Input data for training of the GP
+     * @param output Expected output data for training of the GP
+     * @param n_regressors Number of regressors
+     * @param kernel_hyperparams Vector including lengthscale,
+     *                           vertical lengthscale, and noise variance
+     *                           parameter of squared exponential kernel
+     * @param trainable_bool Vector indicating which parameters are trainable
+     */
+    GP(std::vector<double> input,
+       std::vector<double> output,
+       int n_regressors,
+       std::vector<double> kernel_hyperparams,
+       std::vector<bool> trainable_bool);
+
     /**
      * @brief Constructs a Gaussian Process (GP) for GPU computations
      *
@@ -170,11 +511,91 @@ class GP
      */
     std::vector<double> get_training_output() const;
 
+    /**
+     * @brief Returns the number of training tiles and the tile size used for
+     * an operation
+     *
+     * @param operation The tiled operation
+     */
+    std::pair<int, int> get_train_tiles(TiledOperation operation);
+
+    /**
+     * @brief Returns the convergence report of the last prediction with
+     * mixed precision
+     */
+    cpu::RefinementReport get_refinement_report() const;
+
     /**
      * @brief Predict output for test input
      */
     std::vector<double> predict(const std::vector<double> &test_data, int m_tiles, int m_tile_size);
 
+    /**
+     * @brief Predict output for a single test point inline on the calling
+     * thread, without spawning tasks or allocating memory. The factor of the
+     * training covariance is computed on the CPU on first use and cached until
+     * an optimizer changes the kernel parameters. After changing kernel_params
+     * directly, call invalidate_point_prediction_factor.
+     *
+     * Like the other non-const member functions, it must not be called
+     * concurrently on the same GP, since the cached factor and the scratch
+     * space of the predictions are shared. Use forecast_scenarios or separate
+     * GP objects for parallel predictions.
+     *
+     * @param features The n_reg lagged features of the test point
+     */
+    double predict_point(const std::vector<double> &features);
+
+    /**
+     * @brief Recompute the cached factor of the inline predictions on their
+     * next use, e.g. after kernel_params has been changed directly.
+     */
+    void invalidate_point_prediction_factor();
+
+    /**
+     * @brief Predict output and uncertainty for a single test point inline on
+     * the calling thread, see predict_point.
+     *
+     * @param features The n_reg lagged features of the test point
+     */
+    std::pair<double, double> predict_point_with_uncertainty(const std::vector<double> &features);
+
+    /**
+     * @brief Predict output for a small batch of test points inline on the
+     * calling thread, see predict_point.
+     *
+     * @param test_data The test input, starting with n_reg - 1 leading
+     * entries like for predict
+     */
+    std::vector<double> predict_small_batch(const std::vector<double> &test_data);
+
+    /**
+     * @brief Forecast the next horizon outputs recursively, shifting each
+     * prediction into the lagged features of the next step. Uses the cached
+     * factor of predict_point and runs on the calling thread.
+     *
+     * @param window The n_reg most recent outputs, oldest first
+     * @param horizon The number of steps
+     * @param uncertainty The approximation of the uncertainty
+     *
+     * @return A vector containing the predictions and the uncertainties,
+     * which are empty for ForecastUncertainty::Off
+     */
+    std::vector<std::vector<double>>
+    forecast(const std::vector<double> &window, int horizon, cpu::ForecastUncertainty uncertainty);
+
+    /**
+     * @brief Forecast several scenarios in parallel, see forecast.
+     *
+     * @param windows The n_reg most recent outputs of each scenario
+     * @param horizon The number of steps
+     * @param uncertainty The approximation of the uncertainty
+     *
+     * @return The forecast of each scenario
+     */
+    std::vector<std::vector<std::vector<double>>> forecast_scenarios(
+        const std::vector<std::vector<double>> &windows, int horizon, cpu::ForecastUncertainty uncertainty);
+
     /**
      * @brief Predict output for test input and additionally provide
      * uncertainty for the predictions.
@@ -182,6 +603,31 @@ class GP
     std::vector<std::vector<double>>
     predict_with_uncertainty(const std::vector<double> &test_data, int m_tiles, int m_tile_size);
 
+    /**
+     * @brief Predict output for test input and additionally provide
+     * uncertainty for the predictions, processing the test tiles in blocks
+     * with bounded memory. Only available on the CPU.
+     */
+    std::vector<std::vector<double>>
+    predict_with_uncertainty_streaming(const std::vector<double> &test_data, int m_tiles, int m_tile_size);
+
+    /**
+     * @brief Predict output and optionally uncertainty for a test set that
+     * is delivered in chunks, reusing the training factor for all chunks and
+     * keeping the memory bounded by the chunk size. Only available on the CPU.
+     *
+     * @param next_test_chunk Returns the test input of the next chunk, an
+     * empty vector ends the prediction
+     * @param consume_chunk Receives the predictions and uncertainties of
+     * each chunk in order
+     * @param with_uncertainty Whether to compute the uncertainties
+     *
+     * @return The number of chunks
+     */
+    std::size_t predict_chunked(const cpu::TestChunkSource &next_test_chunk,
+                                const cpu::PredictionChunkSink<double> &consume_chunk,
+                                bool with_uncertainty);
+
     /**
      * @brief Predict output for test input and additionally compute full
      * posterior covariance matrix.
@@ -195,6 +641,22 @@ class GP
     std::vector<std::vector<double>>
     predict_with_full_cov(const std::vector<double> &test_data, int m_tiles, int m_tile_size);
 
+    /**
+     * @brief Draw samples from the posterior distribution at the test input.
+     * The posterior covariance matrix is factorized in FP64 and is not copied
+     * out of the tiles. Only available on the CPU.
+     *
+     * @param test_input Test input data
+     * @param m_tiles Number of tiles
+     * @param m_tile_size Size of each tile
+     * @param n_samples Number of samples
+     * @param seed Seed of the random number generator
+     *
+     * @return n_samples samples of the test output
+     */
+    std::vector<std::vector<double>> sample_posterior(
+        const std::vector<double> &test_data, int m_tiles, int m_tile_size, int n_samples, std::uint64_t seed);
+
     /**
      * @brief Optimize hyperparameters
      *
@@ -221,11 +683,324 @@ class GP
      */
     double calculate_loss();
 
+    /**
+     * @brief Set the inducing points of the sparse computations. The cost of
+     * the sparse computations is linear in the number of training samples and
+     * quadratic in the number of inducing points.
+     *
+     * @param inducing_input The inducing points, starting with n_reg - 1
+     * leading entries like the training input
+     * @param inducing_tiles Number of inducing tiles
+     * @param inducing_tile_size Size of each inducing tile
+     */
+    void set_inducing_points(const std::vector<double> &inducing_input, int inducing_tiles, int inducing_tile_size);
+
+    /**
+     * @brief Predict output for test input with the sparse approximation.
+     * Only available on the CPU.
+     */
+    std::vector<double> predict_sparse(const std::vector<double> &test_data, int m_tiles, int m_tile_size);
+
+    /**
+     * @brief Predict output for test input and additionally provide
+     * uncertainty for the predictions with the sparse approximation. Only
+     * available on the CPU.
+     */
+    std::vector<std::vector<double>>
+    predict_sparse_with_uncertainty(const std::vector<double> &test_data, int m_tiles, int m_tile_size);
+
+    /**
+     * @brief Calculate the loss of the sparse approximation. Only available
+     * on the CPU.
+     */
+    double calculate_sparse_loss();
+
+    /**
+     * @brief Optimize hyperparameters for the loss of the sparse
+     * approximation. The inducing points are kept fixed. Only available on
+     * the CPU.
+     *
+     * @param adam_params The Adam optimizer hyperparameters
+     *
+     * @return losses
+     */
+    std::vector<double> optimize_sparse(const gprat_hyper::AdamParams &adam_params);
+
+    /**
+     * @brief Predict output for test input with the Vecchia approximation,
+     * see vecchia_neighbours. Only available on the CPU.
+     */
+    std::vector<double> predict_vecchia(const std::vector<double> &test_data, int m_tiles, int m_tile_size);
+
+    /**
+     * @brief Predict output for test input and additionally provide
+     * uncertainty for the predictions with the Vecchia approximation. Only
+     * available on the CPU.
+     */
+    std::vector<std::vector<double>>
+    predict_vecchia_with_uncertainty(const std::vector<double> &test_data, int m_tiles, int m_tile_size);
+
+    /**
+     * @brief Calculate the loss of the Vecchia approximation. Only available
+     * on the CPU.
+     */
+    double calculate_vecchia_loss();
+
+    /**
+     * @brief Optimize hyperparameters for the loss of the Vecchia
+     * approximation. Only available on the CPU.
+     *
+     * @param adam_params The Adam optimizer hyperparameters
+     *
+     * @return losses
+     */
+    std::vector<double> optimize_vecchia(const gprat_hyper::AdamParams &adam_params);
+
+    /**
+     * @brief Predict output for test input with the experts of the training
+     * tiles, see expert_aggregation. Only available on the CPU.
+     */
+    std::vector<double> predict_experts(const std::vector<double> &test_data, int m_tiles, int m_tile_size);
+
+    /**
+     * @brief Predict output for test input and additionally provide
+     * uncertainty for the predictions with the experts of the training tiles.
+     * Only available on the CPU.
+     */
+    std::vector<std::vector<double>>
+    predict_experts_with_uncertainty(const std::vector<double> &test_data, int m_tiles, int m_tile_size);
+
+    /**
+     * @brief Calculate the sum of the losses of the experts of the training
+     * tiles. Only available on the CPU.
+     */
+    double calculate_experts_loss();
+
+    /**
+     * @brief Optimize hyperparameters shared by the experts of the training
+     * tiles for the sum of their losses. Only available on the CPU.
+     *
+     * @param adam_params The Adam optimizer hyperparameters
+     *
+     * @return losses
+     */
+    std::vector<double> optimize_experts(const gprat_hyper::AdamParams &adam_params);
+
+    /**
+     * @brief Predict output for test input with the block low-rank Cholesky
+     * factor, see blr_tolerance. Only available on the CPU.
+     */
+    std::vector<double> predict_blr(const std::vector<double> &test_data, int m_tiles, int m_tile_size);
+
+    /**
+     * @brief Predict output for test input and additionally provide
+     * uncertainty for the predictions with the block low-rank Cholesky
+     * factor. Only available on the CPU.
+     */
+    std::vector<std::vector<double>>
+    predict_blr_with_uncertainty(const std::vector<double> &test_data, int m_tiles, int m_tile_size);
+
+    /**
+     * @brief Calculate the loss with the block low-rank Cholesky factor.
+     * Only available on the CPU.
+     */
+    double calculate_blr_loss();
+
+    /**
+     * @brief Calculate the memory of the block low-rank Cholesky factor
+     * relative to the dense tiled factor. Only available on the CPU.
+     */
+    double calculate_blr_compression();
+
+    /**
+     * @brief Predict output for test input with the HODLR solver, see
+     * hodlr_tolerance. Only available on the CPU.
+     */
+    std::vector<double> predict_hodlr(const std::vector<double> &test_data, int m_tiles, int m_tile_size);
+
+    /**
+     * @brief Predict output for test input and additionally provide
+     * uncertainty for the predictions with the HODLR solver. Only available
+     * on the CPU.
+     */
+    std::vector<std::vector<double>>
+    predict_hodlr_with_uncertainty(const std::vector<double> &test_data, int m_tiles, int m_tile_size);
+
+    /**
+     * @brief Calculate the loss with the HODLR solver. Only available on
+     * the CPU.
+     */
+    double calculate_hodlr_loss();
+
+    /**
+     * @brief Predict output for test input with the matrix-free conjugate
+     * gradient solver, which does not store the covariance matrix. Only
+     * available on the CPU.
+     */
+    std::vector<double> predict_cg(const std::vector<double> &test_data, int m_tiles, int m_tile_size);
+
+    /**
+     * @brief Predict output for test input and additionally provide
+     * uncertainty for the predictions with the matrix-free conjugate gradient
+     * solver. Only available on the CPU.
+     */
+    std::vector<std::vector<double>>
+    predict_cg_with_uncertainty(const std::vector<double> &test_data, int m_tiles, int m_tile_size);
+
+    /**
+     * @brief Estimate the loss by stochastic Lanczos quadrature and the
+     * matrix-free conjugate gradient solver, without a Cholesky
+     * decomposition. Only available on the CPU.
+     */
+    double calculate_slq_loss();
+
+    /**
+     * @brief Optimize hyperparameters with the loss and gradients estimated
+     * by stochastic Lanczos quadrature and the matrix-free conjugate gradient
+     * solver. Only available on the CPU.
+     *
+     * @param adam_params The Adam optimizer hyperparameters
+     *
+     * @return losses
+     */
+    std::vector<double> optimize_slq(const gprat_hyper::AdamParams &adam_params);
+
+    /**
+     * @brief Predict output for test input with the compactly supported
+     * Wendland kernel, whose support radius is the lengthscale. Identically
+     * zero tiles are skipped in the tiled Cholesky decomposition and solves.
+     * Only available on the CPU.
+     */
+    std::vector<double> predict_compact(const std::vector<double> &test_data, int m_tiles, int m_tile_size);
+
+    /**
+     * @brief Predict output for test input and additionally provide
+     * uncertainty for the predictions with the compactly supported Wendland
+     * kernel. Only available on the CPU.
+     */
+    std::vector<std::vector<double>>
+    predict_compact_with_uncertainty(const std::vector<double> &test_data, int m_tiles, int m_tile_size);
+
+    /**
+     * @brief Calculate the loss with the compactly supported Wendland
+     * kernel. Only available on the CPU.
+     */
+    double calculate_compact_loss();
+
+    /**
+     * @brief Optimize hyperparameters of the compactly supported Wendland
+     * kernel, skipping identically zero tiles. Only available on the CPU.
+     *
+     * @param adam_params The Adam optimizer hyperparameters
+     *
+     * @return losses
+     */
+    std::vector<double> optimize_compact(const gprat_hyper::AdamParams &adam_params);
+
+    /**
+     * @brief Calculate the fraction of nonzero tiles of the Cholesky factor,
+     * including the fill-in, with the compactly supported Wendland kernel.
+     * Only available on the CPU.
+     */
+    double calculate_compact_density();
+
     /**
      * @brief Computes & returns cholesky decomposition
      */
     std::vector<std::vector<double>> cholesky();
 };
+
+/**
+ * @brief Gaussian Process approximated by random Fourier features
+ *
+ * The squared exponential kernel is approximated by D random features, such
+ * that the predictions solve a D x D Bayesian linear regression in
+ * O(n * D^2) instead of the n x n training system. The features are tiled
+ * like the training samples and the computations run on the CPU.
+ */
+class RandomFeatureGP
+{
+  private:
+    /** @brief Input data for training */
+    std::vector<double> training_input_;
+
+    /** @brief Output data for given input data */
+    std::vector<double> training_output_;
+
+    /** @brief Number of tiles */
+    int n_tiles_;
+
+    /** @brief Size of each tile in each dimension */
+    int n_tile_size_;
+
+    /** @brief Number of random features */
+    int n_features_;
+
+    /** @brief Number of feature tiles */
+    int n_feature_tiles_;
+
+    /** @brief Size of each feature tile, the last tile contains the remainder */
+    int n_feature_tile_size_;
+
+    /** @brief Seed of the random features */
+    std::uint64_t seed_;
+
+  public:
+    /** @brief Number of regressors */
+    int n_reg;
+
+    /**
+     * @brief Hyperarameters of the squared exponential kernel
+     */
+    gprat_hyper::SEKParams kernel_params;
+
+    /**
+     * @brief Constructs a Gaussian Process approximated by random features
+     *
+     * @param input Input data for training of the GP
+     * @param output Expected output data for training of the GP
+     * @param n_tiles Number of tiles
+     * @param n_tile_size Size of each tile in each dimension
+     * @param n_regressors Number of regressors
+     * @param kernel_hyperparams Vector including lengthscale,
+     *                           vertical lengthscale, and noise variance
+     *                           parameter of squared exponential kernel
+     * @param n_features Number of random features
+     * @param n_feature_tiles Number of feature tiles
+     * @param seed Seed of the random features
+     */
+    RandomFeatureGP(std::vector<double> input,
+                    std::vector<double> output,
+                    int n_tiles,
+                    int n_tile_size,
+                    int n_regressors,
+                    std::vector<double> kernel_hyperparams,
+                    int n_features,
+                    int n_feature_tiles,
+                    std::uint64_t seed);
+
+    /**
+     * Returns Gaussian Process attributes as string.
+     */
+    std::string repr() const;
+
+    /**
+     * @brief Returns the number of random features
+     */
+    int get_n_features() const;
+
+    /**
+     * @brief Predict output for test input
+     */
+    std::vector<double> predict(const std::vector<double> &test_data, int m_tiles, int m_tile_size);
+
+    /**
+     * @brief Predict output for test input and additionally provide
+     * uncertainty for the predictions.
+     */
+    std::vector<std::vector<double>>
+    predict_with_uncertainty(const std::vector<double> &test_data, int m_tiles, int m_tile_size);
+};
 }  // namespace gprat
 
 #endif  // end of GPRAT_C_H
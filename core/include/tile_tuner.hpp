@@ -0,0 +1,71 @@
+#ifndef TILE_TUNER_H
+#define TILE_TUNER_H
+
+#include <string>
+
+namespace gprat
+{
+
+/**
+ * @brief Tiled operations whose tile size can be tuned independently.
+ */
+enum class TiledOperation { Cholesky, Predict, Optimize };
+
+/**
+ * @brief Returns the name of a tiled operation as used in the tuning cache.
+ */
+std::string tiled_operation_name(TiledOperation operation);
+
+/**
+ * @brief Returns the default path of the tile size cache file.
+ *
+ * Uses $GPRAT_TILE_CACHE if set, otherwise $XDG_CACHE_HOME/gprat/tile_sizes.txt
+ * or $HOME/.cache/gprat/tile_sizes.txt, and falls back to the working directory.
+ */
+std::string default_tile_cache_path();
+
+/**
+ * @brief Measure the runtime of a tiled operation on synthetic data.
+ *
+ * Requires a running HPX runtime.
+ *
+ * @param operation The tiled operation to benchmark
+ * @param n_samples Number of training (and test) samples
+ * @param n_tile_size Size of each tile, the last tile may be smaller
+ * @param n_regressors Number of regressors
+ *
+ * @return Runtime in seconds
+ */
+double benchmark_tile_size(TiledOperation operation, int n_samples, int n_tile_size, int n_regressors);
+
+/**
+ * @brief Determine the fastest tile size for a tiled operation on this machine.
+ *
+ * Runs short calibration benchmarks for a set of power of two candidate tile
+ * sizes on a problem of at most 4096 samples, each candidate is timed by the
+ * median of repeated runs. The result is stored in the cache file per operation,
+ * calibration size, number of regressors and number of HPX worker threads, one
+ * line "operation n_calibration n_regressors n_threads tile_size" per entry, such
+ * that later calls only read the cache. Requires a running HPX runtime.
+ *
+ * Larger problems are additionally calibrated on 2048 samples. If the best tile
+ * size grows with the calibration size, the number of tiles of the calibration
+ * is kept and the tile size scales with n_samples, otherwise the tile size is kept.
+ * Extrapolated tile sizes are at most 2048 and leave at least one tile per worker
+ * thread.
+ *
+ * @param operation The tiled operation to tune
+ * @param n_samples Number of training samples
+ * @param n_regressors Number of regressors
+ * @param cache_path Path to the tile size cache file, empty to disable caching
+ *
+ * @return Tile size that performed best
+ */
+int tune_tile_size(TiledOperation operation,
+                   int n_samples,
+                   int n_regressors,
+                   const std::string &cache_path = default_tile_cache_path());
+
+}  // namespace gprat
+
+#endif  // end of TILE_TUNER_H
@@ -1,6 +1,7 @@
 #ifndef UTILS_C_H
 #define UTILS_C_H
 
+#include "tile_tuner.hpp"
 #include <hpx/future.hpp>
 #include <hpx/hpx_start.hpp>
 #include <hpx/hpx_suspend.hpp>
@@ -13,32 +14,60 @@ namespace utils
  * @brief Compute the number of tiles for training data, given the number of
  * samples and the size of each tile.
  *
+ * If n_tile_size does not divide n_samples, the last tile is smaller.
+ *
  * @param n_samples Number of samples
  * @param n_tile_size Size of each tile
  */
 int compute_train_tiles(int n_samples, int n_tile_size);
 
 /**
- * @brief Compute the number of tiles for training data, given the number of
- * samples and the size of each tile.
+ * @brief Compute the size of each tile for training data, given the number of
+ * samples and the number of tiles.
+ *
+ * If n_tiles does not divide n_samples, the last tile is smaller. The tile size
+ * is rounded up, such that n_tiles must satisfy
+ * compute_train_tiles(n_samples, tile_size) == n_tiles, e.g. 9 samples cannot be
+ * split into 4 tiles of size 3. Otherwise std::invalid_argument is thrown.
  *
  * @param n_samples Number of samples
- * @param n_tile_size Size of each tile
+ * @param n_tiles Number of tiles
  */
 int compute_train_tile_size(int n_samples, int n_tiles);
 
 /**
  * @brief Compute the number of test tiles and the size of a test tile.
  *
- * Uses n_tiles_size if n_test is divisible by n_tile_size. Otherwise uses
- * n_tiles for calculation.
+ * Uses the training tile size n_tile_size, such that the last test tile is
+ * smaller if n_tile_size does not divide n_test.
  *
  * @param n_test Number of test samples
- * @param n_tiles Number of tiles
  * @param n_tile_size Size of each tile
  */
+std::pair<int, int> compute_test_tiles(int n_test, int n_tile_size);
+
+/**
+ * @brief Compute the number of test tiles and the size of a test tile.
+ *
+ * @deprecated The number of training tiles does not affect the test tiles, use
+ * compute_test_tiles(n_test, n_tile_size) instead.
+ */
+[[deprecated("Use compute_test_tiles(n_test, n_tile_size)")]]
 std::pair<int, int> compute_test_tiles(int n_test, int n_tiles, int n_tile_size);
 
+/**
+ * @brief Compute the number of tiles and the tile size for training data with
+ * the tile size tuned for an operation on this machine.
+ *
+ * Runs calibration benchmarks unless the tile size is found in the cache file.
+ * Requires a running HPX runtime.
+ *
+ * @param n_samples Number of samples
+ * @param n_regressors Number of regressors
+ * @param operation Tiled operation to tune the tile size for
+ */
+std::pair<int, int> compute_tuned_train_tiles(int n_samples, int n_regressors, gprat::TiledOperation operation);
+
 /**
  * @brief Load data from file
  *
@@ -60,6 +89,9 @@ void print_vector(const std::vector<double> &vec, int start, int end, const std:
 /**
  * @brief Start HPX runtime
  *
+ * With GPRAT_ENABLE_HYBRID_BLAS, the global oneMKL thread count is set to 1
+ * such that the BLAS calls of the HPX worker threads do not spawn OpenMP teams.
+ *
  * @param argc Number of arguments
  * @param argv Arguments as array of strings
  */
@@ -4,33 +4,134 @@
 // MKL CBLAS and LAPACKE
 #include "mkl_cblas.h"
 #include "mkl_lapacke.h"
+#include "mkl_service.h"
 #else
 #include "cblas.h"
 #include "lapacke.h"
 #endif
+#include <algorithm>
+
+namespace
+{
+
+/**
+ * @brief Returns the column offsets of row-major tiles with the given number of rows when packed side by side.
+ */
+std::vector<std::size_t> panel_offsets(const std::vector<vector_future_fp32> &ft_panel, std::size_t rows)
+{
+    std::vector<std::size_t> offsets(ft_panel.size() + 1, 0);
+    for (std::size_t i = 0; i < ft_panel.size(); i++)
+    {
+        offsets[i + 1] = offsets[i] + ft_panel[i].get().size() / rows;
+    }
+    return offsets;
+}
+
+/**
+ * @brief Pack row-major tiles side by side into one row-major matrix.
+ */
+vector_fp32 pack_panel(const std::vector<vector_future_fp32> &ft_panel,
+                       const std::vector<std::size_t> &offsets,
+                       std::size_t rows)
+{
+    const std::size_t cols = offsets.back();
+    vector_fp32 packed(rows * cols);
+    for (std::size_t i = 0; i < ft_panel.size(); i++)
+    {
+        const vector_fp32 &tile = ft_panel[i].get();
+        const std::size_t cols_i = offsets[i + 1] - offsets[i];
+        for (std::size_t r = 0; r < rows; r++)
+        {
+            std::copy_n(tile.begin() + static_cast<std::ptrdiff_t>(r * cols_i),
+                        cols_i,
+                        packed.begin() + static_cast<std::ptrdiff_t>(r * cols + offsets[i]));
+        }
+    }
+    return packed;
+}
+
+/**
+ * @brief Split a packed row-major matrix into the tiles between consecutive column offsets.
+ */
+std::vector<vector_fp32>
+unpack_panel(const vector_fp32 &packed, const std::vector<std::size_t> &offsets, std::size_t rows)
+{
+    const std::size_t cols = offsets.back();
+    std::vector<vector_fp32> panel;
+    panel.reserve(offsets.size() - 1);
+    for (std::size_t i = 0; i + 1 < offsets.size(); i++)
+    {
+        const std::size_t cols_i = offsets[i + 1] - offsets[i];
+        vector_fp32 tile(rows * cols_i);
+        for (std::size_t r = 0; r < rows; r++)
+        {
+            std::copy_n(packed.begin() + static_cast<std::ptrdiff_t>(r * cols + offsets[i]),
+                        cols_i,
+                        tile.begin() + static_cast<std::ptrdiff_t>(r * cols_i));
+        }
+        panel.push_back(std::move(tile));
+    }
+    return panel;
+}
+
+}  // namespace
 
 // BLAS level 3 operations
 
-vector potrf(vector_future f_A, const int N)
+template <>
+vector_fp32 potrf<float>(vector_future_fp32 f_A, const int N)
+{
+    vector_fp32 A = f_A.get();
+    // POTRF: in-place Cholesky decomposition of A
+    // use spotrf2 recursive version for better stability
+    LAPACKE_spotrf2(LAPACK_ROW_MAJOR, 'L', N, A.data(), N);
+    // return factorized matrix L
+    return A;
+}
+
+template <>
+vector_fp32 potrf_threaded<float>(vector_future_fp32 f_A, const int N, const int n_threads)
 {
-    vector A = f_A.get();
+    vector_fp32 A = f_A.get();
+#ifdef GPRAT_ENABLE_HYBRID_BLAS
+    // Raise the oneMKL threads of the calling thread above the global single
+    // thread, restored afterwards
+    const int previous_threads = mkl_set_num_threads_local(n_threads);
+#else
+    (void) n_threads;
+#endif
     // POTRF: in-place Cholesky decomposition of A
     // use spotrf2 recursive version for better stability
     LAPACKE_spotrf2(LAPACK_ROW_MAJOR, 'L', N, A.data(), N);
+#ifdef GPRAT_ENABLE_HYBRID_BLAS
+    mkl_set_num_threads_local(previous_threads);
+#endif
     // return factorized matrix L
     return A;
 }
 
-vector trsm(vector_future f_L,
-            vector_future f_A,
-            const int N,
-            const int M,
-            const BLAS_TRANSPOSE transpose_L,
-            const BLAS_SIDE side_L)
+template <>
+vector_fp32 potrs<float>(vector_future_fp32 f_L, vector_future_fp32 f_a, const int N)
+{
+    const vector_fp32 &L = f_L.get();
+    vector_fp32 a = f_a.get();
+    // POTRS: in-place solve L * L^T * x = a
+    LAPACKE_spotrs(LAPACK_ROW_MAJOR, 'L', N, 1, L.data(), N, a.data(), 1);
+    // return solution vector x
+    return a;
+}
+
+template <>
+vector_fp32 trsm<float>(vector_future_fp32 f_L,
+                        vector_future_fp32 f_A,
+                        const int N,
+                        const int M,
+                        const BLAS_TRANSPOSE transpose_L,
+                        const BLAS_SIDE side_L)
 
 {
-    const vector &L = f_L.get();
-    vector A = f_A.get();
+    const vector_fp32 &L = f_L.get();
+    vector_fp32 A = f_A.get();
     // TRSM constants
     const float alpha = 1.0;
     // TRSM: in-place solve L(^T) * X = A or X * L(^T) = A where L lower triangular
@@ -44,38 +145,84 @@ vector trsm(vector_future f_L,
         M,
         alpha,
         L.data(),
-        N,
+        side_L == Blas_left ? N : M,
         A.data(),
         M);
     // return vector
     return A;
 }
 
-vector syrk(vector_future f_A, vector_future f_B, const int N)
+template <>
+vector_fp32 trmm<float>(vector_future_fp32 f_L,
+                        vector_future_fp32 f_A,
+                        const int N,
+                        const int M,
+                        const BLAS_TRANSPOSE transpose_L,
+                        const BLAS_SIDE side_L)
 {
-    const vector &B = f_B.get();
-    vector A = f_A.get();
+    const vector_fp32 &L = f_L.get();
+    vector_fp32 A = f_A.get();
+    // TRMM constants
+    const float alpha = 1.0;
+    // TRMM: in-place multiply X = L(^T) * A or X = A * L(^T) where L lower triangular
+    cblas_strmm(
+        CblasRowMajor,
+        static_cast<CBLAS_SIDE>(side_L),
+        CblasLower,
+        static_cast<CBLAS_TRANSPOSE>(transpose_L),
+        CblasNonUnit,
+        N,
+        M,
+        alpha,
+        L.data(),
+        side_L == Blas_left ? N : M,
+        A.data(),
+        M);
+    // return product matrix
+    return A;
+}
+
+template <>
+vector_fp32 syrk<float>(vector_future_fp32 f_A,
+                        vector_future_fp32 f_B,
+                        const int N,
+                        const int M,
+                        const BLAS_TRANSPOSE transpose_B)
+{
+    const vector_fp32 &B = f_B.get();
+    vector_fp32 A = f_A.get();
     // SYRK constants
     const float alpha = -1.0;
     const float beta = 1.0;
-    // SYRK:A = A - B * B^T
-    cblas_ssyrk(CblasRowMajor, CblasLower, CblasNoTrans, N, N, alpha, B.data(), N, beta, A.data(), N);
+    // SYRK: A = A - B(^T) * B(^T)^T
+    cblas_ssyrk(CblasRowMajor,
+                CblasLower,
+                static_cast<CBLAS_TRANSPOSE>(transpose_B),
+                N,
+                M,
+                alpha,
+                B.data(),
+                transpose_B == Blas_no_trans ? M : N,
+                beta,
+                A.data(),
+                N);
     // return updated matrix A
     return A;
 }
 
-vector gemm(vector_future f_A,
-            vector_future f_B,
-            vector_future f_C,
-            const int N,
-            const int M,
-            const int K,
-            const BLAS_TRANSPOSE transpose_A,
-            const BLAS_TRANSPOSE transpose_B)
+template <>
+vector_fp32 gemm<float>(vector_future_fp32 f_A,
+                        vector_future_fp32 f_B,
+                        vector_future_fp32 f_C,
+                        const int N,
+                        const int M,
+                        const int K,
+                        const BLAS_TRANSPOSE transpose_A,
+                        const BLAS_TRANSPOSE transpose_B)
 {
-    vector C = f_C.get();
-    const vector &B = f_B.get();
-    const vector &A = f_A.get();
+    vector_fp32 C = f_C.get();
+    const vector_fp32 &B = f_B.get();
+    const vector_fp32 &A = f_A.get();
     // GEMM constants
     const float alpha = -1.0;
     const float beta = 1.0;
@@ -89,9 +236,9 @@ vector gemm(vector_future f_A,
         N,
         alpha,
         A.data(),
-        K,
+        transpose_A == Blas_no_trans ? N : K,
         B.data(),
-        M,
+        transpose_B == Blas_no_trans ? M : N,
         beta,
         C.data(),
         M);
@@ -101,10 +248,11 @@ vector gemm(vector_future f_A,
 
 // BLAS level 2 operations
 
-vector trsv(vector_future f_L, vector_future f_a, const int N, const BLAS_TRANSPOSE transpose_L)
+template <>
+vector_fp32 trsv<float>(vector_future_fp32 f_L, vector_future_fp32 f_a, const int N, const BLAS_TRANSPOSE transpose_L)
 {
-    const vector &L = f_L.get();
-    vector a = f_a.get();
+    const vector_fp32 &L = f_L.get();
+    vector_fp32 a = f_a.get();
     // TRSV: In-place solve L(^T) * x = a where L lower triangular
     cblas_strsv(CblasRowMajor,
                 CblasLower,
@@ -119,17 +267,18 @@ vector trsv(vector_future f_L, vector_future f_a, const int N, const BLAS_TRANSP
     return a;
 }
 
-vector gemv(vector_future f_A,
-            vector_future f_a,
-            vector_future f_b,
-            const int N,
-            const int M,
-            const BLAS_ALPHA alpha,
-            const BLAS_TRANSPOSE transpose_A)
+template <>
+vector_fp32 gemv<float>(vector_future_fp32 f_A,
+                        vector_future_fp32 f_a,
+                        vector_future_fp32 f_b,
+                        const int N,
+                        const int M,
+                        const BLAS_ALPHA alpha,
+                        const BLAS_TRANSPOSE transpose_A)
 {
-    const vector &A = f_A.get();
-    const vector &a = f_a.get();
-    vector b = f_b.get();
+    const vector_fp32 &A = f_A.get();
+    const vector_fp32 &a = f_a.get();
+    vector_fp32 b = f_b.get();
     // GEMV constants
     // const float alpha = -1.0;
     const float beta = 1.0;
@@ -151,10 +300,11 @@ vector gemv(vector_future f_A,
     return b;
 }
 
-vector dot_diag_syrk(vector_future f_A, vector_future f_r, const int N, const int M)
+template <>
+vector_fp32 dot_diag_syrk<float>(vector_future_fp32 f_A, vector_future_fp32 f_r, const int N, const int M)
 {
-    const vector &A = f_A.get();
-    vector r = f_r.get();
+    const vector_fp32 &A = f_A.get();
+    vector_fp32 r = f_r.get();
     // r = r + diag(A^T * A)
     for (std::size_t j = 0; j < static_cast<std::size_t>(M); ++j)
     {
@@ -164,11 +314,16 @@ vector dot_diag_syrk(vector_future f_A, vector_future f_r, const int N, const in
     return r;
 }
 
-vector dot_diag_gemm(vector_future f_A, vector_future f_B, vector_future f_r, const int N, const int M)
+template <>
+vector_fp32 dot_diag_gemm<float>(vector_future_fp32 f_A,
+                                 vector_future_fp32 f_B,
+                                 vector_future_fp32 f_r,
+                                 const int N,
+                                 const int M)
 {
-    const vector &A = f_A.get();
-    const vector &B = f_B.get();
-    vector r = f_r.get();
+    const vector_fp32 &A = f_A.get();
+    const vector_fp32 &B = f_B.get();
+    vector_fp32 r = f_r.get();
     // r = r + diag(A * B)
     for (std::size_t i = 0; i < static_cast<std::size_t>(N); ++i)
     {
@@ -177,17 +332,151 @@ vector dot_diag_gemm(vector_future f_A, vector_future f_B, vector_future f_r, co
     return r;
 }
 
+// Fused panel operations
+
+template <>
+std::vector<vector_fp32> trsm_panel<float>(vector_future_fp32 f_L,
+                                           std::vector<vector_future_fp32> ft_panel,
+                                           const int N,
+                                           const BLAS_TRANSPOSE transpose_L,
+                                           const BLAS_SIDE side_L)
+{
+    const vector_fp32 &L = f_L.get();
+    std::vector<vector_fp32> panel;
+    panel.reserve(ft_panel.size());
+    // TRSM constants
+    const float alpha = 1.0;
+    for (auto &f_A : ft_panel)
+    {
+        vector_fp32 A = f_A.get();
+        // The tiles of a panel only share the dimension of L
+        const int rows = side_L == Blas_left ? N : static_cast<int>(A.size()) / N;
+        const int cols = side_L == Blas_left ? static_cast<int>(A.size()) / N : N;
+        // TRSM: in-place solve L(^T) * X = A or X * L(^T) = A where L lower triangular
+        cblas_strsm(
+            CblasRowMajor,
+            static_cast<CBLAS_SIDE>(side_L),
+            CblasLower,
+            static_cast<CBLAS_TRANSPOSE>(transpose_L),
+            CblasNonUnit,
+            rows,
+            cols,
+            alpha,
+            L.data(),
+            side_L == Blas_left ? rows : cols,
+            A.data(),
+            cols);
+        panel.push_back(std::move(A));
+    }
+    // return solution matrices
+    return panel;
+}
+
+template <>
+std::vector<vector_fp32> gemv_panel<float>(std::vector<vector_future_fp32> ft_A,
+                                           vector_future_fp32 f_a,
+                                           std::vector<vector_future_fp32> ft_b,
+                                           const BLAS_ALPHA alpha,
+                                           const BLAS_TRANSPOSE transpose_A)
+{
+    const vector_fp32 &a = f_a.get();
+    std::vector<vector_fp32> panel;
+    panel.reserve(ft_b.size());
+    // GEMV constants
+    const float beta = 1.0;
+    for (std::size_t i = 0; i < ft_b.size(); i++)
+    {
+        const vector_fp32 &A = ft_A[i].get();
+        vector_fp32 b = ft_b[i].get();
+        // The tiles of a panel may differ in the dimension of b
+        const int N = static_cast<int>(transpose_A == Blas_no_trans ? b.size() : a.size());
+        const int M = static_cast<int>(transpose_A == Blas_no_trans ? a.size() : b.size());
+        // GEMV:  b{N} = b{N} - A(^T){NxM} * a{M}
+        cblas_sgemv(
+            CblasRowMajor,
+            static_cast<CBLAS_TRANSPOSE>(transpose_A),
+            N,
+            M,
+            alpha,
+            A.data(),
+            M,
+            a.data(),
+            1,
+            beta,
+            b.data(),
+            1);
+        panel.push_back(std::move(b));
+    }
+    // return updated vectors
+    return panel;
+}
+
+template <>
+std::vector<vector_fp32> trsm_panel_packed<float>(vector_future_fp32 f_L,
+                                                  std::vector<vector_future_fp32> ft_panel,
+                                                  const int N)
+{
+    const vector_fp32 &L = f_L.get();
+    const std::size_t rows = static_cast<std::size_t>(N);
+    const std::vector<std::size_t> offsets = panel_offsets(ft_panel, rows);
+    const int cols = static_cast<int>(offsets.back());
+    vector_fp32 X = pack_panel(ft_panel, offsets, rows);
+    // TRSM constants
+    const float alpha = 1.0;
+    // TRSM: in-place solve L * X = [A_1 | ... | A_c] where L lower triangular
+    cblas_strsm(
+        CblasRowMajor, CblasLeft, CblasLower, CblasNoTrans, CblasNonUnit, N, cols, alpha, L.data(), N, X.data(), cols);
+    // return solution matrices X_i
+    return unpack_panel(X, offsets, rows);
+}
+
+template <>
+std::vector<vector_fp32> gemm_panel_packed<float>(vector_future_fp32 f_A,
+                                                  std::vector<vector_future_fp32> ft_B,
+                                                  std::vector<vector_future_fp32> ft_C,
+                                                  const int N,
+                                                  const int M)
+{
+    const vector_fp32 &A = f_A.get();
+    const std::vector<std::size_t> offsets = panel_offsets(ft_C, static_cast<std::size_t>(N));
+    const int cols = static_cast<int>(offsets.back());
+    const vector_fp32 B = pack_panel(ft_B, offsets, static_cast<std::size_t>(M));
+    vector_fp32 C = pack_panel(ft_C, offsets, static_cast<std::size_t>(N));
+    // GEMM constants
+    const float alpha = -1.0;
+    const float beta = 1.0;
+    // GEMM: [C_1 | ... | C_c] = [C_1 | ... | C_c] - A * [B_1 | ... | B_c]
+    cblas_sgemm(CblasRowMajor,
+                CblasNoTrans,
+                CblasNoTrans,
+                N,
+                cols,
+                M,
+                alpha,
+                A.data(),
+                M,
+                B.data(),
+                cols,
+                beta,
+                C.data(),
+                cols);
+    // return updated matrices C_i
+    return unpack_panel(C, offsets, static_cast<std::size_t>(N));
+}
+
 // BLAS level 1 operations
 
-vector axpy(vector_future f_y, vector_future f_x, const int N)
+template <>
+vector_fp32 axpy<float>(vector_future_fp32 f_y, vector_future_fp32 f_x, const int N)
 {
-    vector y = f_y.get();
-    const vector &x = f_x.get();
+    vector_fp32 y = f_y.get();
+    const vector_fp32 &x = f_x.get();
     cblas_saxpy(N, -1.0, x.data(), 1, y.data(), 1);
     return y;
 }
 
-float dot(vector a, vector b, const int N)
+template <>
+float dot<float>(vector_fp32 a, vector_fp32 b, const int N)
 {
     // DOT: a * b
     return cblas_sdot(N, a.data(), 1, b.data(), 1);
@@ -0,0 +1,415 @@
+#include "cpu/adapter_low_rank.hpp"
+
+#include "cpu/adapter_cblas_fp64.hpp"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#ifdef GPRAT_ENABLE_MKL
+// MKL CBLAS and LAPACKE
+#include "mkl_cblas.h"
+#include "mkl_lapacke.h"
+#else
+#include "cblas.h"
+#include "lapacke.h"
+#endif
+
+namespace
+{
+
+/**
+ * @brief In-place QR decomposition of a row-major n x r factor F.
+ *
+ * @return The upper triangular matrix R of size min(n, r) x r, F contains the orthonormal
+ *         columns Q in its first min(n, r) columns afterwards.
+ */
+vector orthogonalize_factor(vector &F, std::size_t n, std::size_t r)
+{
+    const std::size_t k = std::min(n, r);
+    vector tau(k);
+    LAPACKE_dgeqrf(LAPACK_ROW_MAJOR,
+                   static_cast<int>(n),
+                   static_cast<int>(r),
+                   F.data(),
+                   static_cast<int>(r),
+                   tau.data());
+    vector R(k * r, 0.0);
+    for (std::size_t i = 0; i < k; i++)
+    {
+        std::copy(F.begin() + static_cast<std::ptrdiff_t>(i * r + i),
+                  F.begin() + static_cast<std::ptrdiff_t>((i + 1) * r),
+                  R.begin() + static_cast<std::ptrdiff_t>(i * r + i));
+    }
+    LAPACKE_dorgqr(LAPACK_ROW_MAJOR,
+                   static_cast<int>(n),
+                   static_cast<int>(k),
+                   static_cast<int>(k),
+                   F.data(),
+                   static_cast<int>(r),
+                   tau.data());
+    return R;
+}
+
+}  // end of anonymous namespace
+
+// Compression
+
+LowRankTile recompress_low_rank(LowRankTile A, const double tolerance)
+{
+    if (A.rank == 0)
+    {
+        return A;
+    }
+    const std::size_t r = A.rank;
+    const std::size_t k_u = std::min(A.n_rows, r);
+    const std::size_t k_v = std::min(A.n_cols, r);
+    const std::size_t p = std::min(k_u, k_v);
+    // A = Q_u * R_u * R_v^T * Q_v^T
+    const vector R_u = orthogonalize_factor(A.U, A.n_rows, r);
+    const vector R_v = orthogonalize_factor(A.V, A.n_cols, r);
+    vector C(k_u * k_v);
+    cblas_dgemm(CblasRowMajor,
+                CblasNoTrans,
+                CblasTrans,
+                static_cast<int>(k_u),
+                static_cast<int>(k_v),
+                static_cast<int>(r),
+                1.0,
+                R_u.data(),
+                static_cast<int>(r),
+                R_v.data(),
+                static_cast<int>(r),
+                0.0,
+                C.data(),
+                static_cast<int>(k_v));
+    // SVD of the core matrix: R_u * R_v^T = X * S * Y^T
+    vector s(p);
+    vector X(k_u * p);
+    vector Yt(p * k_v);
+    vector superb(p);
+    LAPACKE_dgesvd(LAPACK_ROW_MAJOR,
+                   'S',
+                   'S',
+                   static_cast<int>(k_u),
+                   static_cast<int>(k_v),
+                   C.data(),
+                   static_cast<int>(k_v),
+                   s.data(),
+                   X.data(),
+                   static_cast<int>(p),
+                   Yt.data(),
+                   static_cast<int>(k_v),
+                   superb.data());
+    // Smallest rank whose truncated singular values are below the tolerance
+    double norm_squared = 0.0;
+    for (const double s_i : s)
+    {
+        norm_squared += s_i * s_i;
+    }
+    const double threshold = tolerance * tolerance * norm_squared;
+    std::size_t rank = p;
+    double truncated = 0.0;
+    while (rank > 0 && truncated + s[rank - 1] * s[rank - 1] <= threshold)
+    {
+        rank--;
+        truncated += s[rank] * s[rank];
+    }
+
+    LowRankTile result;
+    result.n_rows = A.n_rows;
+    result.n_cols = A.n_cols;
+    result.rank = rank;
+    if (rank == 0)
+    {
+        return result;
+    }
+    // U = Q_u * X_r * S_r and V = Q_v * Y_r
+    result.U.resize(A.n_rows * rank);
+    result.V.resize(A.n_cols * rank);
+    cblas_dgemm(CblasRowMajor,
+                CblasNoTrans,
+                CblasNoTrans,
+                static_cast<int>(A.n_rows),
+                static_cast<int>(rank),
+                static_cast<int>(k_u),
+                1.0,
+                A.U.data(),
+                static_cast<int>(r),
+                X.data(),
+                static_cast<int>(p),
+                0.0,
+                result.U.data(),
+                static_cast<int>(rank));
+    for (std::size_t i = 0; i < A.n_rows; i++)
+    {
+        for (std::size_t j = 0; j < rank; j++)
+        {
+            result.U[i * rank + j] *= s[j];
+        }
+    }
+    cblas_dgemm(CblasRowMajor,
+                CblasNoTrans,
+                CblasTrans,
+                static_cast<int>(A.n_cols),
+                static_cast<int>(rank),
+                static_cast<int>(k_v),
+                1.0,
+                A.V.data(),
+                static_cast<int>(r),
+                Yt.data(),
+                static_cast<int>(k_v),
+                0.0,
+                result.V.data(),
+                static_cast<int>(rank));
+    return result;
+}
+
+std::size_t low_rank_size(const LowRankTile &A) { return (A.n_rows + A.n_cols) * A.rank; }
+
+// BLAS level 3 operations on low-rank tiles
+
+LowRankTile trsm_low_rank(dense_future f_L, low_rank_future f_A)
+{
+    const vector &L = f_L.get();
+    LowRankTile A = f_A.get();
+    if (A.rank == 0)
+    {
+        return A;
+    }
+    // TRSM: in-place solve L * X = V, such that U * X^T * L^T = U * V^T
+    cblas_dtrsm(CblasRowMajor,
+                CblasLeft,
+                CblasLower,
+                CblasNoTrans,
+                CblasNonUnit,
+                static_cast<int>(A.n_cols),
+                static_cast<int>(A.rank),
+                1.0,
+                L.data(),
+                static_cast<int>(A.n_cols),
+                A.V.data(),
+                static_cast<int>(A.rank));
+    // return solution in low-rank form
+    return A;
+}
+
+vector syrk_low_rank(dense_future f_A, low_rank_future f_B)
+{
+    const LowRankTile &B = f_B.get();
+    vector A = f_A.get();
+    if (B.rank == 0)
+    {
+        return A;
+    }
+    const int n = static_cast<int>(B.n_rows);
+    const int r = static_cast<int>(B.rank);
+    // W = V^T * V
+    vector W(B.rank * B.rank);
+    cblas_dgemm(CblasRowMajor,
+                CblasTrans,
+                CblasNoTrans,
+                r,
+                r,
+                static_cast<int>(B.n_cols),
+                1.0,
+                B.V.data(),
+                r,
+                B.V.data(),
+                r,
+                0.0,
+                W.data(),
+                r);
+    // T = U * W
+    vector T(B.n_rows * B.rank);
+    cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, n, r, r, 1.0, B.U.data(), r, W.data(), r, 0.0, T.data(), r);
+    // A = A - T * U^T
+    cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasTrans, n, n, r, -1.0, T.data(), r, B.U.data(), r, 1.0, A.data(), n);
+    // return updated matrix A
+    return A;
+}
+
+LowRankTile gemm_low_rank(low_rank_future f_A, low_rank_future f_B, low_rank_future f_C, const double tolerance)
+{
+    const LowRankTile &A = f_A.get();
+    const LowRankTile &B = f_B.get();
+    const LowRankTile &C = f_C.get();
+    if (A.rank == 0 || B.rank == 0)
+    {
+        return C;
+    }
+    const int r_a = static_cast<int>(A.rank);
+    const int r_b = static_cast<int>(B.rank);
+    // W = V_a^T * V_b
+    vector W(A.rank * B.rank);
+    cblas_dgemm(CblasRowMajor,
+                CblasTrans,
+                CblasNoTrans,
+                r_a,
+                r_b,
+                static_cast<int>(A.n_cols),
+                1.0,
+                A.V.data(),
+                r_a,
+                B.V.data(),
+                r_b,
+                0.0,
+                W.data(),
+                r_b);
+    // A * B^T = left * right^T with the smaller inner rank
+    const std::size_t s = std::min(A.rank, B.rank);
+    vector left;
+    vector right;
+    if (A.rank <= B.rank)
+    {
+        // left = U_a, right = U_b * W^T
+        left = A.U;
+        right.resize(B.n_rows * s);
+        cblas_dgemm(CblasRowMajor,
+                    CblasNoTrans,
+                    CblasTrans,
+                    static_cast<int>(B.n_rows),
+                    r_a,
+                    r_b,
+                    1.0,
+                    B.U.data(),
+                    r_b,
+                    W.data(),
+                    r_b,
+                    0.0,
+                    right.data(),
+                    r_a);
+    }
+    else
+    {
+        // left = U_a * W, right = U_b
+        left.resize(A.n_rows * s);
+        cblas_dgemm(CblasRowMajor,
+                    CblasNoTrans,
+                    CblasNoTrans,
+                    static_cast<int>(A.n_rows),
+                    r_b,
+                    r_a,
+                    1.0,
+                    A.U.data(),
+                    r_a,
+                    W.data(),
+                    r_b,
+                    0.0,
+                    left.data(),
+                    r_b);
+        right = B.U;
+    }
+    // C - left * right^T = [U_c, -left] * [V_c, right]^T
+    LowRankTile updated;
+    updated.n_rows = C.n_rows;
+    updated.n_cols = C.n_cols;
+    updated.rank = C.rank + s;
+    updated.U.resize(C.n_rows * updated.rank);
+    updated.V.resize(C.n_cols * updated.rank);
+    for (std::size_t i = 0; i < C.n_rows; i++)
+    {
+        for (std::size_t j = 0; j < C.rank; j++)
+        {
+            updated.U[i * updated.rank + j] = C.U[i * C.rank + j];
+        }
+        for (std::size_t j = 0; j < s; j++)
+        {
+            updated.U[i * updated.rank + C.rank + j] = -left[i * s + j];
+        }
+    }
+    for (std::size_t i = 0; i < C.n_cols; i++)
+    {
+        for (std::size_t j = 0; j < C.rank; j++)
+        {
+            updated.V[i * updated.rank + j] = C.V[i * C.rank + j];
+        }
+        for (std::size_t j = 0; j < s; j++)
+        {
+            updated.V[i * updated.rank + C.rank + j] = right[i * s + j];
+        }
+    }
+    // return recompressed matrix C
+    return recompress_low_rank(std::move(updated), tolerance);
+}
+
+vector gemm_low_rank_dense(low_rank_future f_A, dense_future f_B, dense_future f_C, const int M)
+{
+    const LowRankTile &A = f_A.get();
+    const vector &B = f_B.get();
+    vector C = f_C.get();
+    if (A.rank == 0)
+    {
+        return C;
+    }
+    const int r = static_cast<int>(A.rank);
+    // T = V^T * B
+    vector T(A.rank * static_cast<std::size_t>(M));
+    cblas_dgemm(CblasRowMajor,
+                CblasTrans,
+                CblasNoTrans,
+                r,
+                M,
+                static_cast<int>(A.n_cols),
+                1.0,
+                A.V.data(),
+                r,
+                B.data(),
+                M,
+                0.0,
+                T.data(),
+                M);
+    // C = C - U * T
+    cblas_dgemm(CblasRowMajor,
+                CblasNoTrans,
+                CblasNoTrans,
+                static_cast<int>(A.n_rows),
+                M,
+                r,
+                -1.0,
+                A.U.data(),
+                r,
+                T.data(),
+                M,
+                1.0,
+                C.data(),
+                M);
+    // return updated matrix C
+    return C;
+}
+
+// BLAS level 2 operations on low-rank tiles
+
+vector gemv_low_rank(
+    low_rank_future f_A, dense_future f_a, dense_future f_b, const BLAS_ALPHA alpha, const BLAS_TRANSPOSE transpose_A)
+{
+    const LowRankTile &A = f_A.get();
+    const vector &a = f_a.get();
+    vector b = f_b.get();
+    if (A.rank == 0)
+    {
+        return b;
+    }
+    const int r = static_cast<int>(A.rank);
+    // A^T * a = V * (U^T * a), A * a = U * (V^T * a)
+    const vector &inner = transpose_A == Blas_trans ? A.U : A.V;
+    const vector &outer = transpose_A == Blas_trans ? A.V : A.U;
+    const std::size_t n_inner = transpose_A == Blas_trans ? A.n_rows : A.n_cols;
+    const std::size_t n_outer = transpose_A == Blas_trans ? A.n_cols : A.n_rows;
+    vector t(A.rank);
+    cblas_dgemv(
+        CblasRowMajor, CblasTrans, static_cast<int>(n_inner), r, 1.0, inner.data(), r, a.data(), 1, 0.0, t.data(), 1);
+    cblas_dgemv(CblasRowMajor,
+                CblasNoTrans,
+                static_cast<int>(n_outer),
+                r,
+                static_cast<double>(alpha),
+                outer.data(),
+                r,
+                t.data(),
+                1,
+                1.0,
+                b.data(),
+                1);
+    // return updated vector b
+    return b;
+}
@@ -1,11 +1,37 @@
 #include "cpu/gp_algorithms.hpp"
 
+#include <algorithm>
 #include <cmath>
 #include <iterator>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
 
 namespace cpu
 {
 
+// Tile sizes
+
+std::size_t compute_n_samples(std::size_t n_tiles, std::size_t N, std::size_t data_size, std::size_t n_regressors)
+{
+    // The data contains n_regressors - 1 leading entries for the lagged features
+    const std::size_t n_data = data_size + 1 > n_regressors ? data_size + 1 - n_regressors : 0;
+    const std::size_t n_samples = std::min(n_tiles * N, n_data);
+    if (n_tiles == 0 || n_samples <= (n_tiles - 1) * N)
+    {
+        throw std::invalid_argument("Error: " + std::to_string(n_tiles) + " tiles of size " + std::to_string(N)
+                                    + " leave the last tile empty for " + std::to_string(n_data) + " samples.");
+    }
+    return n_samples;
+}
+
+std::size_t compute_tile_size(std::size_t k, std::size_t N, std::size_t n_total)
+{
+    return std::min(N, n_total - k * N);
+}
+
 // Tile generation
 
 double compute_covariance_function(std::size_t i_global,
@@ -27,24 +53,28 @@ double compute_covariance_function(std::size_t i_global,
     return sek_params.vertical_lengthscale * exp(-0.5 / (sek_params.lengthscale * sek_params.lengthscale) * distance);
 }
 
-std::vector<double> gen_tile_covariance(
+template <typename T>
+std::vector<T> gen_tile_covariance(
     std::size_t row,
     std::size_t col,
     std::size_t N,
+    std::size_t n_samples,
     std::size_t n_regressors,
     const gprat_hyper::SEKParams &sek_params,
     const std::vector<double> &input)
 {
     std::size_t i_global, j_global;
     double covariance_function;
+    const std::size_t N_row = compute_tile_size(row, N, n_samples);
+    const std::size_t N_col = compute_tile_size(col, N, n_samples);
     // Preallocate required memory
-    std::vector<double> tile;
-    tile.reserve(N * N);
+    std::vector<T> tile;
+    tile.reserve(N_row * N_col);
     // Compute entries
-    for (std::size_t i = 0; i < N; i++)
+    for (std::size_t i = 0; i < N_row; i++)
     {
         i_global = N * row + i;
-        for (std::size_t j = 0; j < N; j++)
+        for (std::size_t j = 0; j < N_col; j++)
         {
             j_global = N * col + j;
             // compute covariance function
@@ -55,94 +85,272 @@ std::vector<double> gen_tile_covariance(
                 // noise variance on diagonal
                 covariance_function += sek_params.noise_variance;
             }
-            tile.push_back(covariance_function);
+            tile.push_back(static_cast<T>(covariance_function));
         }
     }
     return tile;
 }
 
-std::vector<double> gen_tile_full_prior_covariance(
+template <typename T>
+std::vector<T> gen_tile_full_prior_covariance(
     std::size_t row,
     std::size_t col,
     std::size_t N,
+    std::size_t n_samples,
     std::size_t n_regressors,
     const gprat_hyper::SEKParams &sek_params,
     const std::vector<double> &input)
 {
     std::size_t i_global, j_global;
+    const std::size_t N_row = compute_tile_size(row, N, n_samples);
+    const std::size_t N_col = compute_tile_size(col, N, n_samples);
     // Preallocate required memory
-    std::vector<double> tile;
-    tile.reserve(N * N);
+    std::vector<T> tile;
+    tile.reserve(N_row * N_col);
     // Compute entries
-    for (std::size_t i = 0; i < N; i++)
+    for (std::size_t i = 0; i < N_row; i++)
     {
         i_global = N * row + i;
-        for (std::size_t j = 0; j < N; j++)
+        for (std::size_t j = 0; j < N_col; j++)
         {
             j_global = N * col + j;
             // compute covariance function
-            tile.push_back(compute_covariance_function(i_global, j_global, n_regressors, sek_params, input, input));
+            tile.push_back(static_cast<T>(
+                compute_covariance_function(i_global, j_global, n_regressors, sek_params, input, input)));
         }
     }
     return tile;
 }
 
-std::vector<double> gen_tile_prior_covariance(
+template <typename T>
+std::vector<T> gen_tile_prior_covariance(
     std::size_t row,
     std::size_t col,
     std::size_t N,
+    std::size_t n_samples,
     std::size_t n_regressors,
     const gprat_hyper::SEKParams &sek_params,
     const std::vector<double> &input)
 {
     std::size_t i_global, j_global;
+    const std::size_t N_diag = compute_tile_size(row, N, n_samples);
     // Preallocate required memory
-    std::vector<double> tile;
-    tile.reserve(N);
+    std::vector<T> tile;
+    tile.reserve(N_diag);
     // Compute entries
-    for (std::size_t i = 0; i < N; i++)
+    for (std::size_t i = 0; i < N_diag; i++)
     {
         i_global = N * row + i;
         j_global = N * col + i;
         // compute covariance function
-        tile.push_back(compute_covariance_function(i_global, j_global, n_regressors, sek_params, input, input));
+        tile.push_back(
+            static_cast<T>(compute_covariance_function(i_global, j_global, n_regressors, sek_params, input, input)));
     }
     return tile;
 }
 
-std::vector<double> gen_tile_cross_covariance(
+template <typename T>
+std::vector<T> gen_tile_cross_covariance(
     std::size_t row,
     std::size_t col,
     std::size_t N_row,
     std::size_t N_col,
+    std::size_t n_row_samples,
+    std::size_t n_col_samples,
     std::size_t n_regressors,
     const gprat_hyper::SEKParams &sek_params,
     const std::vector<double> &row_input,
     const std::vector<double> &col_input)
 {
     std::size_t i_global, j_global;
+    const std::size_t N_tile_row = compute_tile_size(row, N_row, n_row_samples);
+    const std::size_t N_tile_col = compute_tile_size(col, N_col, n_col_samples);
     // Preallocate required memory
-    std::vector<double> tile;
-    tile.reserve(N_row * N_col);
+    std::vector<T> tile;
+    tile.reserve(N_tile_row * N_tile_col);
     // Compute entries
-    for (std::size_t i = 0; i < N_row; i++)
+    for (std::size_t i = 0; i < N_tile_row; i++)
     {
         i_global = N_row * row + i;
-        for (std::size_t j = 0; j < N_col; j++)
+        for (std::size_t j = 0; j < N_tile_col; j++)
         {
             j_global = N_col * col + j;
             // compute covariance function
-            tile.push_back(
-                compute_covariance_function(i_global, j_global, n_regressors, sek_params, row_input, col_input));
+            tile.push_back(static_cast<T>(
+                compute_covariance_function(i_global, j_global, n_regressors, sek_params, row_input, col_input)));
         }
     }
     return tile;
 }
 
-std::vector<double> gen_tile_transpose(std::size_t N_row, std::size_t N_col, const std::vector<double> &tile)
+LowRankTile gen_block_cross_covariance_low_rank(std::size_t row_begin,
+                                                std::size_t col_begin,
+                                                std::size_t N_block_row,
+                                                std::size_t N_block_col,
+                                                std::size_t n_regressors,
+                                                const gprat_hyper::SEKParams &sek_params,
+                                                const std::vector<double> &row_input,
+                                                const std::vector<double> &col_input,
+                                                double tolerance)
+{
+    const std::size_t max_rank = std::min(N_block_row, N_block_col);
+    // Columns u_l and v_l of the crosses, A ~ sum_l u_l * v_l^T
+    std::vector<std::vector<double>> u_columns;
+    std::vector<std::vector<double>> v_columns;
+    std::vector<bool> used_rows(N_block_row, false);
+    std::vector<double> v(N_block_col);
+    std::vector<double> u(N_block_row);
+    std::size_t pivot_row = 0;
+    // Squared Frobenius norm of the approximation
+    double norm_squared = 0.0;
+    // Magnitude of the first pivot, pivots below its rounding error are numerically zero
+    double first_pivot = 0.0;
+    while (u_columns.size() < max_rank)
+    {
+        used_rows[pivot_row] = true;
+        // Residual of the pivot row and its largest entry as pivot column
+        std::size_t pivot_col = 0;
+        for (std::size_t j = 0; j < N_block_col; j++)
+        {
+            v[j] = compute_covariance_function(
+                row_begin + pivot_row, col_begin + j, n_regressors, sek_params, row_input, col_input);
+            for (std::size_t l = 0; l < u_columns.size(); l++)
+            {
+                v[j] -= u_columns[l][pivot_row] * v_columns[l][j];
+            }
+            if (std::abs(v[j]) > std::abs(v[pivot_col]))
+            {
+                pivot_col = j;
+            }
+        }
+        const double pivot_magnitude = std::abs(v[pivot_col]);
+        if (!(pivot_magnitude > std::numeric_limits<double>::epsilon() * first_pivot))
+        {
+            // The pivot row is approximated up to rounding, continue with the next unused row
+            const auto next_row = std::find(used_rows.begin(), used_rows.end(), false);
+            if (next_row == used_rows.end())
+            {
+                break;
+            }
+            pivot_row = static_cast<std::size_t>(std::distance(used_rows.begin(), next_row));
+            continue;
+        }
+        if (u_columns.empty())
+        {
+            first_pivot = pivot_magnitude;
+        }
+        const double pivot = v[pivot_col];
+        for (double &v_j : v)
+        {
+            v_j /= pivot;
+        }
+        // Residual of the pivot column
+        for (std::size_t i = 0; i < N_block_row; i++)
+        {
+            u[i] = compute_covariance_function(
+                row_begin + i, col_begin + pivot_col, n_regressors, sek_params, row_input, col_input);
+            for (std::size_t l = 0; l < u_columns.size(); l++)
+            {
+                u[i] -= u_columns[l][i] * v_columns[l][pivot_col];
+            }
+        }
+        // ||S + u * v^T||_F^2 = ||S||_F^2 + 2 * sum_l (u_l^T * u) * (v_l^T * v) + ||u||^2 * ||v||^2
+        double u_norm_squared = 0.0;
+        double v_norm_squared = 0.0;
+        for (const double u_i : u)
+        {
+            u_norm_squared += u_i * u_i;
+        }
+        for (const double v_j : v)
+        {
+            v_norm_squared += v_j * v_j;
+        }
+        for (std::size_t l = 0; l < u_columns.size(); l++)
+        {
+            double uu = 0.0;
+            double vv = 0.0;
+            for (std::size_t i = 0; i < N_block_row; i++)
+            {
+                uu += u_columns[l][i] * u[i];
+            }
+            for (std::size_t j = 0; j < N_block_col; j++)
+            {
+                vv += v_columns[l][j] * v[j];
+            }
+            norm_squared += 2.0 * uu * vv;
+        }
+        norm_squared += u_norm_squared * v_norm_squared;
+        u_columns.push_back(u);
+        v_columns.push_back(v);
+        if (u_norm_squared * v_norm_squared <= tolerance * tolerance * norm_squared)
+        {
+            break;
+        }
+        // The next pivot row is the largest entry of the pivot column among the unused rows
+        bool found = false;
+        for (std::size_t i = 0; i < N_block_row; i++)
+        {
+            if (!used_rows[i] && (!found || std::abs(u[i]) > std::abs(u[pivot_row])))
+            {
+                pivot_row = i;
+                found = true;
+            }
+        }
+        if (!found)
+        {
+            break;
+        }
+    }
+
+    // Row-major factors from the crosses
+    LowRankTile block;
+    block.n_rows = N_block_row;
+    block.n_cols = N_block_col;
+    block.rank = u_columns.size();
+    block.U.resize(N_block_row * block.rank);
+    block.V.resize(N_block_col * block.rank);
+    for (std::size_t l = 0; l < block.rank; l++)
+    {
+        for (std::size_t i = 0; i < N_block_row; i++)
+        {
+            block.U[i * block.rank + l] = u_columns[l][i];
+        }
+        for (std::size_t j = 0; j < N_block_col; j++)
+        {
+            block.V[j * block.rank + l] = v_columns[l][j];
+        }
+    }
+    return recompress_low_rank(std::move(block), tolerance);
+}
+
+LowRankTile gen_tile_cross_covariance_low_rank(std::size_t row,
+                                               std::size_t col,
+                                               std::size_t N_row,
+                                               std::size_t N_col,
+                                               std::size_t n_row_samples,
+                                               std::size_t n_col_samples,
+                                               std::size_t n_regressors,
+                                               const gprat_hyper::SEKParams &sek_params,
+                                               const std::vector<double> &row_input,
+                                               const std::vector<double> &col_input,
+                                               double tolerance)
+{
+    return gen_block_cross_covariance_low_rank(N_row * row,
+                                               N_col * col,
+                                               compute_tile_size(row, N_row, n_row_samples),
+                                               compute_tile_size(col, N_col, n_col_samples),
+                                               n_regressors,
+                                               sek_params,
+                                               row_input,
+                                               col_input,
+                                               tolerance);
+}
+
+template <typename T>
+std::vector<T> gen_tile_transpose(std::size_t N_row, std::size_t N_col, const std::vector<T> &tile)
 {
     // Preallocate required memory
-    std::vector<double> transposed;
+    std::vector<T> transposed;
     transposed.reserve(N_row * N_col);
     // Transpose entries
     for (std::size_t j = 0; j < N_col; j++)
@@ -156,28 +364,66 @@ std::vector<double> gen_tile_transpose(std::size_t N_row, std::size_t N_col, con
     return transposed;
 }
 
-std::vector<double> gen_tile_output(std::size_t row, std::size_t N, const std::vector<double> &output)
+template <typename T>
+std::vector<T>
+gen_tile_output(std::size_t row, std::size_t N, std::size_t n_samples, const std::vector<double> &output)
 {
+    const std::size_t N_tile = compute_tile_size(row, N, n_samples);
     // Preallocate required memory
-    std::vector<double> tile;
-    tile.reserve(N);
+    std::vector<T> tile;
+    tile.reserve(N_tile);
     // Copy entries
-    std::copy(output.begin() + static_cast<long int>(N * row),
-              output.begin() + static_cast<long int>(N * (row + 1)),
-              std::back_inserter(tile));
+    std::transform(output.begin() + static_cast<long int>(N * row),
+                   output.begin() + static_cast<long int>(N * row + N_tile),
+                   std::back_inserter(tile),
+                   [](double value) { return static_cast<T>(value); });
     return tile;
 }
 
-std::vector<double> gen_tile_zeros(std::size_t N) { return std::vector<double>(N, 0.0); }
+template <typename T>
+std::vector<T> gen_tile_zeros(std::size_t N) { return std::vector<T>(N, T(0)); }
 
-std::vector<double> gen_tile_identity(std::size_t N)
+template <typename T>
+std::vector<T> gen_tile_identity(std::size_t N)
 {
     // Initialize zero tile
-    std::vector<double> tile(N * N, 0.0);
+    std::vector<T> tile(N * N, T(0));
     // Fill diagonal with ones
     for (std::size_t i = 0; i < N; i++)
     {
-        tile[i * N + i] = 1.0;
+        tile[i * N + i] = T(1);
+    }
+    return tile;
+}
+
+std::vector<double> gen_tile_standard_normal(
+    std::size_t row, std::size_t N, std::size_t n_samples, std::size_t n_columns, std::uint64_t seed)
+{
+    const std::size_t N_row = compute_tile_size(row, N, n_samples);
+    // Independent stream per tile
+    std::seed_seq seed_sequence{ seed, static_cast<std::uint64_t>(row) };
+    std::mt19937_64 generator(seed_sequence);
+    std::normal_distribution<double> distribution(0.0, 1.0);
+    // Preallocate required memory
+    std::vector<double> tile;
+    tile.reserve(N_row * n_columns);
+    // Draw entries
+    for (std::size_t i = 0; i < N_row * n_columns; i++)
+    {
+        tile.push_back(distribution(generator));
+    }
+    return tile;
+}
+
+std::vector<double> gen_tile_repeated_column(const std::vector<double> &column, std::size_t n_columns)
+{
+    // Preallocate required memory
+    std::vector<double> tile;
+    tile.reserve(column.size() * n_columns);
+    // Copy entries row by row
+    for (const double value : column)
+    {
+        tile.insert(tile.end(), n_columns, value);
     }
     return tile;
 }
@@ -193,7 +439,8 @@ double compute_error_norm(std::size_t n_tiles,
     for (std::size_t k = 0; k < n_tiles; k++)
     {
         const std::vector<double> &a = tiles[k];
-        for (std::size_t i = 0; i < tile_size; i++)
+        // The last tile may be smaller
+        for (std::size_t i = 0; i < a.size(); i++)
         {
             std::size_t i_global = tile_size * k + i;
             // ||a - b||_2
@@ -203,4 +450,87 @@ double compute_error_norm(std::size_t n_tiles,
     return sqrt(error);
 }
 
+// Explicit instantiations for the supported precisions
+
+template std::vector<float> gen_tile_covariance<float>(
+    std::size_t,
+    std::size_t,
+    std::size_t,
+    std::size_t,
+    std::size_t,
+    const gprat_hyper::SEKParams &,
+    const std::vector<double> &);
+template std::vector<float> gen_tile_full_prior_covariance<float>(
+    std::size_t,
+    std::size_t,
+    std::size_t,
+    std::size_t,
+    std::size_t,
+    const gprat_hyper::SEKParams &,
+    const std::vector<double> &);
+template std::vector<float> gen_tile_prior_covariance<float>(
+    std::size_t,
+    std::size_t,
+    std::size_t,
+    std::size_t,
+    std::size_t,
+    const gprat_hyper::SEKParams &,
+    const std::vector<double> &);
+template std::vector<float> gen_tile_cross_covariance<float>(
+    std::size_t,
+    std::size_t,
+    std::size_t,
+    std::size_t,
+    std::size_t,
+    std::size_t,
+    std::size_t,
+    const gprat_hyper::SEKParams &,
+    const std::vector<double> &,
+    const std::vector<double> &);
+template std::vector<float> gen_tile_transpose<float>(std::size_t, std::size_t, const std::vector<float> &);
+template std::vector<float> gen_tile_output<float>(std::size_t, std::size_t, std::size_t, const std::vector<double> &);
+template std::vector<float> gen_tile_zeros<float>(std::size_t);
+template std::vector<float> gen_tile_identity<float>(std::size_t);
+
+template std::vector<double> gen_tile_covariance<double>(
+    std::size_t,
+    std::size_t,
+    std::size_t,
+    std::size_t,
+    std::size_t,
+    const gprat_hyper::SEKParams &,
+    const std::vector<double> &);
+template std::vector<double> gen_tile_full_prior_covariance<double>(
+    std::size_t,
+    std::size_t,
+    std::size_t,
+    std::size_t,
+    std::size_t,
+    const gprat_hyper::SEKParams &,
+    const std::vector<double> &);
+template std::vector<double> gen_tile_prior_covariance<double>(
+    std::size_t,
+    std::size_t,
+    std::size_t,
+    std::size_t,
+    std::size_t,
+    const gprat_hyper::SEKParams &,
+    const std::vector<double> &);
+template std::vector<double> gen_tile_cross_covariance<double>(
+    std::size_t,
+    std::size_t,
+    std::size_t,
+    std::size_t,
+    std::size_t,
+    std::size_t,
+    std::size_t,
+    const gprat_hyper::SEKParams &,
+    const std::vector<double> &,
+    const std::vector<double> &);
+template std::vector<double> gen_tile_transpose<double>(std::size_t, std::size_t, const std::vector<double> &);
+template std::vector<double> gen_tile_output<double>(
+    std::size_t, std::size_t, std::size_t, const std::vector<double> &);
+template std::vector<double> gen_tile_zeros<double>(std::size_t);
+template std::vector<double> gen_tile_identity<double>(std::size_t);
+
 }  // end of namespace cpu
@@ -0,0 +1,311 @@
+#include "cpu/gp_blr.hpp"
+
+#include "cpu/adapter_low_rank.hpp"
+#include "cpu/gp_algorithms.hpp"
+#include "cpu/tiled_algorithms.hpp"
+#include <hpx/future.hpp>
+
+namespace cpu
+{
+
+namespace
+{
+
+/**
+ * @brief Block low-rank Cholesky factor, see right_looking_cholesky_tiled
+ */
+struct BlrFactor
+{
+    /** @brief Dense diagonal tiles */
+    Tiled_matrix L;
+    /** @brief Off-diagonal tiles below the diagonal in low-rank form */
+    Tiled_low_rank_matrix L_low_rank;
+};
+
+/**
+ * @brief Launch the asynchronous assembly and Cholesky decomposition of the block low-rank
+ * covariance matrix.
+ */
+BlrFactor launch_blr_factor(const std::vector<double> &training_input,
+                            const gprat_hyper::SEKParams &sek_params,
+                            std::size_t n_tiles,
+                            std::size_t N,
+                            std::size_t n_train,
+                            std::size_t n_regressors,
+                            double tolerance)
+{
+    BlrFactor factor;
+    factor.L.resize(n_tiles * n_tiles);           // Only the diagonal tiles are used
+    factor.L_low_rank.resize(n_tiles * n_tiles);  // Only the tiles below the diagonal are used
+    for (std::size_t i = 0; i < n_tiles; i++)
+    {
+        factor.L[i * n_tiles + i] = hpx::async(hpx::annotated_function(gen_tile_covariance<double>, "assemble_tiled_K"),
+                                               i,
+                                               i,
+                                               N,
+                                               n_train,
+                                               n_regressors,
+                                               sek_params,
+                                               training_input);
+        for (std::size_t j = 0; j < i; j++)
+        {
+            // Off-diagonal tiles do not contain the noise variance
+            factor.L_low_rank[i * n_tiles + j] =
+                hpx::async(hpx::annotated_function(gen_tile_cross_covariance_low_rank, "assemble_tiled_K_blr"),
+                           i,
+                           j,
+                           N,
+                           N,
+                           n_train,
+                           n_train,
+                           n_regressors,
+                           sek_params,
+                           training_input,
+                           training_input,
+                           tolerance);
+        }
+    }
+    right_looking_cholesky_tiled(factor.L, factor.L_low_rank, static_cast<int>(N), n_tiles, n_train, tolerance);
+    return factor;
+}
+
+/**
+ * @brief Launch the asynchronous assembly of the tiled training output.
+ */
+Tiled_vector launch_output_tiles(const std::vector<double> &training_output,
+                                 std::size_t n_tiles,
+                                 std::size_t N,
+                                 std::size_t n_train)
+{
+    Tiled_vector y_tiles;
+    y_tiles.reserve(n_tiles);
+    for (std::size_t i = 0; i < n_tiles; i++)
+    {
+        y_tiles.push_back(hpx::async(
+            hpx::annotated_function(gen_tile_output<double>, "assemble_tiled_y"), i, N, n_train, training_output));
+    }
+    return y_tiles;
+}
+
+/**
+ * @brief Concatenate the tiles of a tiled vector.
+ */
+std::vector<double> gather_tiles(const Tiled_vector &ft_tiles, std::size_t n_total)
+{
+    std::vector<double> result;
+    result.reserve(n_total);
+    for (const auto &ft_tile : ft_tiles)
+    {
+        const std::vector<double> &tile = ft_tile.get();
+        result.insert(result.end(), tile.begin(), tile.end());
+    }
+    return result;
+}
+
+}  // namespace
+
+std::vector<double> predict_blr(const std::vector<double> &training_input,
+                                const std::vector<double> &training_output,
+                                const std::vector<double> &test_input,
+                                const gprat_hyper::SEKParams &sek_params,
+                                int n_tiles,
+                                int n_tile_size,
+                                int m_tiles,
+                                int m_tile_size,
+                                int n_regressors,
+                                double tolerance)
+{
+    /*
+     * Algorithm:
+     * 1: Compute the block low-rank Cholesky factor L of K
+     * 2: Compute alpha = K^-1 * y with the triangular solves L * (L^T * alpha) = y
+     * 3: Compute hat(y) = cross(K) * alpha with cross(K) in low-rank form
+     */
+    const std::size_t n_reg = static_cast<std::size_t>(n_regressors);
+    const std::size_t N = static_cast<std::size_t>(n_tile_size);
+    const std::size_t M = static_cast<std::size_t>(m_tile_size);
+    const std::size_t n_t = static_cast<std::size_t>(n_tiles);
+    const std::size_t m_t = static_cast<std::size_t>(m_tiles);
+    const std::size_t n_train = compute_n_samples(n_t, N, training_input.size(), n_reg);
+    const std::size_t n_test = compute_n_samples(m_t, M, test_input.size(), n_reg);
+
+    BlrFactor factor = launch_blr_factor(training_input, sek_params, n_t, N, n_train, n_reg, tolerance);
+    Tiled_vector alpha_tiles = launch_output_tiles(training_output, n_t, N, n_train);
+    forward_solve_tiled(factor.L, factor.L_low_rank, alpha_tiles, n_tile_size, n_t, n_train);
+    backward_solve_tiled(factor.L, factor.L_low_rank, alpha_tiles, n_tile_size, n_t, n_train);
+
+    Tiled_low_rank_matrix cross_covariance_tiles;
+    Tiled_vector prediction_tiles;
+    cross_covariance_tiles.reserve(m_t * n_t);
+    prediction_tiles.reserve(m_t);
+    for (std::size_t i = 0; i < m_t; i++)
+    {
+        for (std::size_t j = 0; j < n_t; j++)
+        {
+            cross_covariance_tiles.push_back(
+                hpx::async(hpx::annotated_function(gen_tile_cross_covariance_low_rank, "assemble_pred_blr"),
+                           i,
+                           j,
+                           M,
+                           N,
+                           n_test,
+                           n_train,
+                           n_reg,
+                           sek_params,
+                           test_input,
+                           training_input,
+                           tolerance));
+        }
+        prediction_tiles.push_back(hpx::async(hpx::annotated_function(gen_tile_zeros<double>, "assemble_tiled"),
+                                              compute_tile_size(i, M, n_test)));
+    }
+    matrix_vector_tiled(cross_covariance_tiles, alpha_tiles, prediction_tiles, n_t, m_t);
+
+    return gather_tiles(prediction_tiles, n_test);
+}
+
+std::vector<std::vector<double>> predict_blr_with_uncertainty(const std::vector<double> &training_input,
+                                                              const std::vector<double> &training_output,
+                                                              const std::vector<double> &test_input,
+                                                              const gprat_hyper::SEKParams &sek_params,
+                                                              int n_tiles,
+                                                              int n_tile_size,
+                                                              int m_tiles,
+                                                              int m_tile_size,
+                                                              int n_regressors,
+                                                              double tolerance)
+{
+    /*
+     * Algorithm:
+     * 1: Compute the block low-rank Cholesky factor L of K
+     * 2: Compute the triangular solves L * beta = y and L * V = cross(K)^T
+     * 3: Compute hat(y) = V^T * beta
+     * 4: Compute diag(Sigma) = diag(prior(K)) - diag(V^T * V)
+     */
+    const std::size_t n_reg = static_cast<std::size_t>(n_regressors);
+    const std::size_t N = static_cast<std::size_t>(n_tile_size);
+    const std::size_t M = static_cast<std::size_t>(m_tile_size);
+    const std::size_t n_t = static_cast<std::size_t>(n_tiles);
+    const std::size_t m_t = static_cast<std::size_t>(m_tiles);
+    const std::size_t n_train = compute_n_samples(n_t, N, training_input.size(), n_reg);
+    const std::size_t n_test = compute_n_samples(m_t, M, test_input.size(), n_reg);
+
+    BlrFactor factor = launch_blr_factor(training_input, sek_params, n_t, N, n_train, n_reg, tolerance);
+    Tiled_vector beta_tiles = launch_output_tiles(training_output, n_t, N, n_train);
+    forward_solve_tiled(factor.L, factor.L_low_rank, beta_tiles, n_tile_size, n_t, n_train);
+
+    // The kernel is symmetric, such that cross(K)^T is assembled without transposition
+    Tiled_matrix t_cross_covariance_tiles;
+    t_cross_covariance_tiles.reserve(n_t * m_t);
+    for (std::size_t j = 0; j < n_t; j++)
+    {
+        for (std::size_t i = 0; i < m_t; i++)
+        {
+            t_cross_covariance_tiles.push_back(
+                hpx::async(hpx::annotated_function(gen_tile_cross_covariance<double>, "assemble_pred"),
+                           j,
+                           i,
+                           N,
+                           M,
+                           n_train,
+                           n_test,
+                           n_reg,
+                           sek_params,
+                           training_input,
+                           test_input));
+        }
+    }
+    Tiled_vector prediction_tiles;
+    Tiled_vector prior_K_tiles;
+    Tiled_vector uncertainty_tiles;
+    prediction_tiles.reserve(m_t);
+    prior_K_tiles.reserve(m_t);
+    uncertainty_tiles.reserve(m_t);
+    for (std::size_t i = 0; i < m_t; i++)
+    {
+        const std::size_t M_i = compute_tile_size(i, M, n_test);
+        prediction_tiles.push_back(hpx::async(hpx::annotated_function(gen_tile_zeros<double>, "assemble_tiled"), M_i));
+        prior_K_tiles.push_back(hpx::async(hpx::annotated_function(gen_tile_prior_covariance<double>, "assemble_tiled"),
+                                           i,
+                                           i,
+                                           M,
+                                           n_test,
+                                           n_reg,
+                                           sek_params,
+                                           test_input));
+        uncertainty_tiles.push_back(
+            hpx::async(hpx::annotated_function(gen_tile_zeros<double>, "assemble_prior_inter"), M_i));
+    }
+
+    forward_solve_tiled_matrix(
+        factor.L, factor.L_low_rank, t_cross_covariance_tiles, n_tile_size, m_tile_size, n_t, m_t, n_train, n_test);
+    transpose_matrix_vector_tiled(
+        t_cross_covariance_tiles, beta_tiles, prediction_tiles, n_tile_size, m_tile_size, n_t, m_t, n_train, n_test);
+    symmetric_matrix_matrix_diagonal_tiled(
+        t_cross_covariance_tiles, uncertainty_tiles, n_tile_size, m_tile_size, n_t, m_t, n_train, n_test);
+    vector_difference_tiled(prior_K_tiles, uncertainty_tiles, m_tile_size, m_t, n_test);
+
+    return std::vector<std::vector<double>>{ gather_tiles(prediction_tiles, n_test),
+                                             gather_tiles(uncertainty_tiles, n_test) };
+}
+
+double compute_loss_blr(const std::vector<double> &training_input,
+                        const std::vector<double> &training_output,
+                        const gprat_hyper::SEKParams &sek_params,
+                        int n_tiles,
+                        int n_tile_size,
+                        int n_regressors,
+                        double tolerance)
+{
+    /*
+     * Algorithm:
+     * 1: Compute the block low-rank Cholesky factor L of K
+     * 2: Compute alpha = K^-1 * y with the triangular solves L * (L^T * alpha) = y
+     * 3: Compute the loss from the dense diagonal tiles of L and y^T * alpha, see compute_loss
+     */
+    const std::size_t n_reg = static_cast<std::size_t>(n_regressors);
+    const std::size_t N = static_cast<std::size_t>(n_tile_size);
+    const std::size_t n_t = static_cast<std::size_t>(n_tiles);
+    const std::size_t n_train = compute_n_samples(n_t, N, training_input.size(), n_reg);
+
+    BlrFactor factor = launch_blr_factor(training_input, sek_params, n_t, N, n_train, n_reg, tolerance);
+    Tiled_vector y_tiles = launch_output_tiles(training_output, n_t, N, n_train);
+    Tiled_vector alpha_tiles = y_tiles;
+    forward_solve_tiled(factor.L, factor.L_low_rank, alpha_tiles, n_tile_size, n_t, n_train);
+    backward_solve_tiled(factor.L, factor.L_low_rank, alpha_tiles, n_tile_size, n_t, n_train);
+
+    hpx::shared_future<double> loss_value;
+    compute_loss_tiled(factor.L, alpha_tiles, y_tiles, loss_value, n_tile_size, n_t, n_train);
+    return loss_value.get();
+}
+
+double compute_blr_compression(const std::vector<double> &training_input,
+                               const gprat_hyper::SEKParams &sek_params,
+                               int n_tiles,
+                               int n_tile_size,
+                               int n_regressors,
+                               double tolerance)
+{
+    const std::size_t n_reg = static_cast<std::size_t>(n_regressors);
+    const std::size_t N = static_cast<std::size_t>(n_tile_size);
+    const std::size_t n_t = static_cast<std::size_t>(n_tiles);
+    const std::size_t n_train = compute_n_samples(n_t, N, training_input.size(), n_reg);
+
+    BlrFactor factor = launch_blr_factor(training_input, sek_params, n_t, N, n_train, n_reg, tolerance);
+    std::size_t n_stored = 0;
+    std::size_t n_dense = 0;
+    for (std::size_t i = 0; i < n_t; i++)
+    {
+        const std::size_t N_i = compute_tile_size(i, N, n_train);
+        n_stored += N_i * N_i;
+        n_dense += N_i * N_i;
+        for (std::size_t j = 0; j < i; j++)
+        {
+            n_stored += low_rank_size(factor.L_low_rank[i * n_t + j].get());
+            n_dense += N_i * compute_tile_size(j, N, n_train);
+        }
+    }
+    return static_cast<double>(n_stored) / static_cast<double>(n_dense);
+}
+
+}  // end of namespace cpu
@@ -0,0 +1,576 @@
+#include "cpu/gp_cg.hpp"
+
+#include "cpu/gp_algorithms.hpp"
+#include <algorithm>
+#include <cmath>
+#include <hpx/future.hpp>
+#include <stdexcept>
+
+#ifdef GPRAT_ENABLE_MKL
+// MKL CBLAS and LAPACKE
+#include "mkl_cblas.h"
+#include "mkl_lapacke.h"
+#else
+#include "cblas.h"
+#include "lapacke.h"
+#endif
+
+namespace cpu
+{
+
+MatrixFreeCovariance::MatrixFreeCovariance(const std::vector<double> &input,
+                                           const gprat_hyper::SEKParams &sek_params,
+                                           int n_tiles,
+                                           int n_tile_size,
+                                           int n_regressors) :
+    tile_size_(static_cast<std::size_t>(n_tile_size)),
+    n_regressors_(static_cast<std::size_t>(n_regressors)),
+    sek_params_(sek_params)
+{
+    n_samples_ = compute_n_samples(static_cast<std::size_t>(n_tiles), tile_size_, input.size(), n_regressors_);
+
+    // Gather the lagged features of sample j, input[j + k], feature by feature
+    features_.resize(n_regressors_ * n_samples_);
+    for (std::size_t k = 0; k < n_regressors_; k++)
+    {
+        for (std::size_t j = 0; j < n_samples_; j++)
+        {
+            features_[k * n_samples_ + j] = input[j + k];
+        }
+    }
+}
+
+void MatrixFreeCovariance::squared_distance_row(const double *features, double *row) const
+{
+    const std::size_t N = n_samples_;
+#pragma omp simd
+    for (std::size_t j = 0; j < N; j++)
+    {
+        row[j] = 0.0;
+    }
+    for (std::size_t k = 0; k < n_regressors_; k++)
+    {
+        const double z_k = features[k];
+        const double *feature_k = features_.data() + k * N;
+#pragma omp simd
+        for (std::size_t j = 0; j < N; j++)
+        {
+            const double z_k_minus_z_jk = z_k - feature_k[j];
+            row[j] += z_k_minus_z_jk * z_k_minus_z_jk;
+        }
+    }
+}
+
+std::vector<double> MatrixFreeCovariance::training_features(std::size_t i) const
+{
+    std::vector<double> features(n_regressors_);
+    for (std::size_t k = 0; k < n_regressors_; k++)
+    {
+        features[k] = features_[k * n_samples_ + i];
+    }
+    return features;
+}
+
+void MatrixFreeCovariance::kernel_row(const double *features, double *row) const
+{
+    const std::size_t N = n_samples_;
+    squared_distance_row(features, row);
+    // k(z, z_j) = vertical_lengthscale * exp(-0.5 / lengthscale^2 * (z - z_j)^2)
+    const double scale = -0.5 / (sek_params_.lengthscale * sek_params_.lengthscale);
+    const double vertical_lengthscale = sek_params_.vertical_lengthscale;
+#pragma omp simd
+    for (std::size_t j = 0; j < N; j++)
+    {
+        row[j] = vertical_lengthscale * std::exp(scale * row[j]);
+    }
+}
+
+void MatrixFreeCovariance::training_kernel_row(std::size_t i, double *row) const
+{
+    kernel_row(training_features(i).data(), row);
+}
+
+std::vector<double> MatrixFreeCovariance::apply(const std::vector<double> &X, std::size_t n_columns) const
+{
+    const std::size_t N = n_samples_;
+    const std::size_t k = n_columns;
+    std::vector<double> Y(N * k);
+
+    // Each task assembles the kernel rows of one training tile into a single row of
+    // workspace and multiplies them with X right away
+    const std::size_t n_tiles = (N + tile_size_ - 1) / tile_size_;
+    std::vector<hpx::future<void>> tiles;
+    tiles.reserve(n_tiles);
+    for (std::size_t t = 0; t < n_tiles; t++)
+    {
+        tiles.push_back(hpx::async(hpx::annotated_function(
+            [this, &X, &Y, t, N, k]()
+            {
+                std::vector<double> row(N);
+                const std::size_t end = std::min((t + 1) * tile_size_, N);
+                for (std::size_t i = t * tile_size_; i < end; i++)
+                {
+                    training_kernel_row(i, row.data());
+                    row[i] += sek_params_.noise_variance;
+                    // GEMV: Y[i, :] = k(x_i)^T * X
+                    cblas_dgemv(CblasRowMajor,
+                                CblasTrans,
+                                static_cast<int>(N),
+                                static_cast<int>(k),
+                                1.0,
+                                X.data(),
+                                static_cast<int>(k),
+                                row.data(),
+                                1,
+                                0.0,
+                                Y.data() + i * k,
+                                1);
+                }
+            },
+            "cg_matvec")));
+    }
+    hpx::wait_all(tiles);
+    return Y;
+}
+
+std::pair<std::vector<double>, std::vector<double>>
+MatrixFreeCovariance::apply_derivatives(const std::vector<double> &X, std::size_t n_columns) const
+{
+    const std::size_t N = n_samples_;
+    const std::size_t k = n_columns;
+    std::vector<double> Y_lengthscale(N * k);
+    std::vector<double> Y_vertical_lengthscale(N * k);
+
+    // dK/dv = exp(-0.5 / l^2 * (z_i - z_j)^2), dK/dl = v * dK/dv * (z_i - z_j)^2 / l^3
+    const double l = sek_params_.lengthscale;
+    const double scale = -0.5 / (l * l);
+    const double lengthscale_factor = sek_params_.vertical_lengthscale / (l * l * l);
+    const std::size_t n_tiles = (N + tile_size_ - 1) / tile_size_;
+    std::vector<hpx::future<void>> tiles;
+    tiles.reserve(n_tiles);
+    for (std::size_t t = 0; t < n_tiles; t++)
+    {
+        tiles.push_back(hpx::async(hpx::annotated_function(
+            [&, t]()
+            {
+                std::vector<double> distance_row(N);
+                std::vector<double> lengthscale_row(N);
+                const std::size_t end = std::min((t + 1) * tile_size_, N);
+                for (std::size_t i = t * tile_size_; i < end; i++)
+                {
+                    double *vertical_lengthscale_row = distance_row.data();
+                    squared_distance_row(training_features(i).data(), distance_row.data());
+#pragma omp simd
+                    for (std::size_t j = 0; j < N; j++)
+                    {
+                        const double exponential = std::exp(scale * distance_row[j]);
+                        lengthscale_row[j] = lengthscale_factor * distance_row[j] * exponential;
+                        vertical_lengthscale_row[j] = exponential;
+                    }
+                    for (auto [row, Y] : { std::pair{ lengthscale_row.data(), Y_lengthscale.data() },
+                                           std::pair{ vertical_lengthscale_row, Y_vertical_lengthscale.data() } })
+                    {
+                        // GEMV: Y[i, :] = dk(x_i)^T * X
+                        cblas_dgemv(CblasRowMajor,
+                                    CblasTrans,
+                                    static_cast<int>(N),
+                                    static_cast<int>(k),
+                                    1.0,
+                                    X.data(),
+                                    static_cast<int>(k),
+                                    row,
+                                    1,
+                                    0.0,
+                                    Y + i * k,
+                                    1);
+                    }
+                }
+            },
+            "cg_gradient_matvec")));
+    }
+    hpx::wait_all(tiles);
+    return { Y_lengthscale, Y_vertical_lengthscale };
+}
+
+std::size_t MatrixFreeCovariance::size() const { return n_samples_; }
+
+const gprat_hyper::SEKParams &MatrixFreeCovariance::sek_params() const { return sek_params_; }
+
+PivotedCholeskyPreconditioner::PivotedCholeskyPreconditioner(const MatrixFreeCovariance &K, std::size_t max_rank) :
+    n_samples_(K.size()),
+    rank_(0),
+    noise_variance_(K.sek_params().noise_variance)
+{
+    const std::size_t N = n_samples_;
+    const std::size_t p = std::min(max_rank, N);
+
+    // Greedily pick the sample with the largest remaining variance as pivot, such that
+    // L_p * L_p^T matches the pivot rows and columns exactly
+    std::vector<double> diagonal(N, K.sek_params().vertical_lengthscale);
+    std::vector<double> columns(p * N);
+    std::vector<double> row(N);
+    const double threshold = 1e-12 * K.sek_params().vertical_lengthscale * static_cast<double>(N);
+    while (rank_ < p)
+    {
+        double trace = 0.0;
+        for (std::size_t i = 0; i < N; i++)
+        {
+            trace += diagonal[i];
+        }
+        if (trace <= threshold)
+        {
+            break;
+        }
+        const std::size_t pivot =
+            static_cast<std::size_t>(std::max_element(diagonal.begin(), diagonal.end()) - diagonal.begin());
+        K.training_kernel_row(pivot, row.data());
+        // l = (k(x_pivot) - L_p * L_p[pivot, :]^T) / sqrt(d_pivot)
+        double *l = columns.data() + rank_ * N;
+        for (std::size_t j = 0; j < rank_; j++)
+        {
+            const double *l_j = columns.data() + j * N;
+            const double l_j_pivot = l_j[pivot];
+            for (std::size_t i = 0; i < N; i++)
+            {
+                row[i] -= l_j[i] * l_j_pivot;
+            }
+        }
+        const double scale = 1.0 / std::sqrt(diagonal[pivot]);
+        for (std::size_t i = 0; i < N; i++)
+        {
+            l[i] = row[i] * scale;
+            diagonal[i] = std::max(diagonal[i] - l[i] * l[i], 0.0);
+        }
+        diagonal[pivot] = 0.0;
+        rank_++;
+    }
+
+    // Transpose the columns to the row-major factor L_p
+    const std::size_t r = rank_;
+    L_.resize(N * r);
+    for (std::size_t j = 0; j < r; j++)
+    {
+        for (std::size_t i = 0; i < N; i++)
+        {
+            L_[i * r + j] = columns[j * N + i];
+        }
+    }
+    if (r == 0)
+    {
+        return;
+    }
+
+    // POTRF: noise_variance * I + L_p^T * L_p = C * C^T
+    capacitance_.assign(r * r, 0.0);
+    cblas_dsyrk(CblasRowMajor,
+                CblasLower,
+                CblasTrans,
+                static_cast<int>(r),
+                static_cast<int>(N),
+                1.0,
+                L_.data(),
+                static_cast<int>(r),
+                0.0,
+                capacitance_.data(),
+                static_cast<int>(r));
+    for (std::size_t j = 0; j < r; j++)
+    {
+        capacitance_[j * r + j] += noise_variance_;
+    }
+    LAPACKE_dpotrf(LAPACK_ROW_MAJOR, 'L', static_cast<int>(r), capacitance_.data(), static_cast<int>(r));
+}
+
+std::vector<double> PivotedCholeskyPreconditioner::solve(const std::vector<double> &R, std::size_t n_columns) const
+{
+    // Woodbury identity: P^-1 = (I - L_p * (noise_variance * I + L_p^T * L_p)^-1 * L_p^T) / noise_variance
+    const std::size_t N = n_samples_;
+    const std::size_t r = rank_;
+    const std::size_t k = n_columns;
+    std::vector<double> Z = R;
+    if (r > 0)
+    {
+        std::vector<double> T(r * k);
+        cblas_dgemm(CblasRowMajor,
+                    CblasTrans,
+                    CblasNoTrans,
+                    static_cast<int>(r),
+                    static_cast<int>(k),
+                    static_cast<int>(N),
+                    1.0,
+                    L_.data(),
+                    static_cast<int>(r),
+                    R.data(),
+                    static_cast<int>(k),
+                    0.0,
+                    T.data(),
+                    static_cast<int>(k));
+        for (const CBLAS_TRANSPOSE transpose : { CblasNoTrans, CblasTrans })
+        {
+            cblas_dtrsm(CblasRowMajor,
+                        CblasLeft,
+                        CblasLower,
+                        transpose,
+                        CblasNonUnit,
+                        static_cast<int>(r),
+                        static_cast<int>(k),
+                        1.0,
+                        capacitance_.data(),
+                        static_cast<int>(r),
+                        T.data(),
+                        static_cast<int>(k));
+        }
+        cblas_dgemm(CblasRowMajor,
+                    CblasNoTrans,
+                    CblasNoTrans,
+                    static_cast<int>(N),
+                    static_cast<int>(k),
+                    static_cast<int>(r),
+                    -1.0,
+                    L_.data(),
+                    static_cast<int>(r),
+                    T.data(),
+                    static_cast<int>(k),
+                    1.0,
+                    Z.data(),
+                    static_cast<int>(k));
+    }
+    cblas_dscal(static_cast<int>(N * k), 1.0 / noise_variance_, Z.data(), 1);
+    return Z;
+}
+
+std::size_t PivotedCholeskyPreconditioner::rank() const { return rank_; }
+
+namespace
+{
+
+/**
+ * @brief Compute the column-wise dot products of two row-major matrices.
+ */
+std::vector<double>
+column_dots(const std::vector<double> &A, const std::vector<double> &B, std::size_t n_rows, std::size_t n_columns)
+{
+    std::vector<double> dots(n_columns, 0.0);
+    for (std::size_t i = 0; i < n_rows; i++)
+    {
+        for (std::size_t j = 0; j < n_columns; j++)
+        {
+            dots[j] += A[i * n_columns + j] * B[i * n_columns + j];
+        }
+    }
+    return dots;
+}
+
+/**
+ * @brief Compute Kn* in row-major order n_test x n_train, one task per test tile.
+ */
+std::vector<double> assemble_test_kernel_rows(const MatrixFreeCovariance &K,
+                                              const std::vector<double> &test_input,
+                                              std::size_t m_tiles,
+                                              std::size_t M,
+                                              std::size_t n_test)
+{
+    const std::size_t N = K.size();
+    std::vector<double> kernel_rows(n_test * N);
+    std::vector<hpx::future<void>> tiles;
+    tiles.reserve(m_tiles);
+    for (std::size_t t = 0; t < m_tiles; t++)
+    {
+        tiles.push_back(hpx::async(hpx::annotated_function(
+            [&, t]()
+            {
+                const std::size_t end = std::min((t + 1) * M, n_test);
+                for (std::size_t j = t * M; j < end; j++)
+                {
+                    K.kernel_row(test_input.data() + j, kernel_rows.data() + j * N);
+                }
+            },
+            "assemble_pred")));
+    }
+    hpx::wait_all(tiles);
+    return kernel_rows;
+}
+
+}  // namespace
+
+std::vector<double> solve_pcg(const MatrixFreeCovariance &K,
+                              const PivotedCholeskyPreconditioner &preconditioner,
+                              const std::vector<double> &B,
+                              std::size_t n_columns,
+                              double tolerance,
+                              int max_iterations)
+{
+    const std::size_t N = K.size();
+    const std::size_t k = n_columns;
+    if (B.size() != N * k)
+    {
+        throw std::invalid_argument("The right-hand side does not match the size of the covariance matrix");
+    }
+
+    std::vector<double> X(N * k, 0.0);
+    std::vector<double> R = B;
+    std::vector<double> Z = preconditioner.solve(R, k);
+    std::vector<double> P = Z;
+    std::vector<double> rz = column_dots(R, Z, N, k);
+    std::vector<double> b_norm = column_dots(B, B, N, k);
+    std::vector<double> r_norm = b_norm;
+    std::vector<double> step(k);
+    for (int iteration = 0;; iteration++)
+    {
+        // Converged columns are no longer updated
+        std::vector<bool> active(k);
+        for (std::size_t j = 0; j < k; j++)
+        {
+            active[j] = r_norm[j] > tolerance * tolerance * b_norm[j];
+        }
+        if (std::none_of(active.begin(), active.end(), [](bool is_active) { return is_active; }))
+        {
+            return X;
+        }
+        if (iteration == max_iterations)
+        {
+            throw std::runtime_error("The conjugate gradient method has not converged within the maximum iterations");
+        }
+
+        // alpha = (r^T * z) / (p^T * K * p)
+        const std::vector<double> Q = K.apply(P, k);
+        const std::vector<double> pq = column_dots(P, Q, N, k);
+        for (std::size_t j = 0; j < k; j++)
+        {
+            step[j] = active[j] ? rz[j] / pq[j] : 0.0;
+        }
+        for (std::size_t i = 0; i < N; i++)
+        {
+            for (std::size_t j = 0; j < k; j++)
+            {
+                X[i * k + j] += step[j] * P[i * k + j];
+                R[i * k + j] -= step[j] * Q[i * k + j];
+            }
+        }
+        r_norm = column_dots(R, R, N, k);
+
+        // beta = (r_new^T * z_new) / (r^T * z)
+        Z = preconditioner.solve(R, k);
+        const std::vector<double> rz_new = column_dots(R, Z, N, k);
+        for (std::size_t i = 0; i < N; i++)
+        {
+            for (std::size_t j = 0; j < k; j++)
+            {
+                const double beta = rz[j] > 0.0 ? rz_new[j] / rz[j] : 0.0;
+                P[i * k + j] = Z[i * k + j] + beta * P[i * k + j];
+            }
+        }
+        rz = rz_new;
+    }
+}
+
+std::vector<double> predict_cg(const std::vector<double> &training_input,
+                               const std::vector<double> &training_output,
+                               const std::vector<double> &test_input,
+                               const gprat_hyper::SEKParams &sek_params,
+                               int n_tiles,
+                               int n_tile_size,
+                               int m_tiles,
+                               int m_tile_size,
+                               int n_regressors,
+                               double tolerance,
+                               int max_iterations,
+                               int preconditioner_rank)
+{
+    /*
+     * Algorithm:
+     * 1: Compute the pivoted Cholesky preconditioner P
+     * 2: Compute alpha = K^-1 * y with PCG
+     * 3: Compute hat(y) = cross(K) * alpha row by row
+     */
+    const std::size_t n_reg = static_cast<std::size_t>(n_regressors);
+    const std::size_t M = static_cast<std::size_t>(m_tile_size);
+    const std::size_t m_t = static_cast<std::size_t>(m_tiles);
+    const std::size_t n_test = compute_n_samples(m_t, M, test_input.size(), n_reg);
+
+    const MatrixFreeCovariance K(training_input, sek_params, n_tiles, n_tile_size, n_regressors);
+    const std::size_t n_train = K.size();
+    const PivotedCholeskyPreconditioner preconditioner(K, static_cast<std::size_t>(preconditioner_rank));
+    const std::vector<double> y(training_output.begin(),
+                                training_output.begin() + static_cast<std::ptrdiff_t>(n_train));
+    const std::vector<double> alpha = solve_pcg(K, preconditioner, y, 1, tolerance, max_iterations);
+
+    std::vector<double> prediction(n_test);
+    std::vector<hpx::future<void>> tiles;
+    tiles.reserve(m_t);
+    for (std::size_t t = 0; t < m_t; t++)
+    {
+        tiles.push_back(hpx::async(hpx::annotated_function(
+            [&, t]()
+            {
+                std::vector<double> row(n_train);
+                const std::size_t end = std::min((t + 1) * M, n_test);
+                for (std::size_t j = t * M; j < end; j++)
+                {
+                    K.kernel_row(test_input.data() + j, row.data());
+                    // DOT: hat(y) = k(x)^T * alpha
+                    prediction[j] = cblas_ddot(static_cast<int>(n_train), row.data(), 1, alpha.data(), 1);
+                }
+            },
+            "cg_prediction")));
+    }
+    hpx::wait_all(tiles);
+    return prediction;
+}
+
+std::vector<std::vector<double>> predict_cg_with_uncertainty(const std::vector<double> &training_input,
+                                                             const std::vector<double> &training_output,
+                                                             const std::vector<double> &test_input,
+                                                             const gprat_hyper::SEKParams &sek_params,
+                                                             int n_tiles,
+                                                             int n_tile_size,
+                                                             int m_tiles,
+                                                             int m_tile_size,
+                                                             int n_regressors,
+                                                             double tolerance,
+                                                             int max_iterations,
+                                                             int preconditioner_rank)
+{
+    /*
+     * Algorithm:
+     * 1: Compute the pivoted Cholesky preconditioner P
+     * 2: Compute [alpha, X] = K^-1 * [y, cross(K)^T] with PCG for all columns at once
+     * 3: Compute hat(y) = cross(K) * alpha
+     * 4: Compute diag(Sigma) = diag(prior(K)) - diag(cross(K) * X)
+     */
+    const std::size_t n_reg = static_cast<std::size_t>(n_regressors);
+    const std::size_t M = static_cast<std::size_t>(m_tile_size);
+    const std::size_t m_t = static_cast<std::size_t>(m_tiles);
+    const std::size_t n_test = compute_n_samples(m_t, M, test_input.size(), n_reg);
+
+    const MatrixFreeCovariance K(training_input, sek_params, n_tiles, n_tile_size, n_regressors);
+    const std::size_t n_train = K.size();
+    const PivotedCholeskyPreconditioner preconditioner(K, static_cast<std::size_t>(preconditioner_rank));
+    const std::vector<double> kernel_rows = assemble_test_kernel_rows(K, test_input, m_t, M, n_test);
+
+    // Right-hand sides [y, cross(K)^T] of size n_train x (n_test + 1)
+    const std::size_t k = n_test + 1;
+    std::vector<double> B(n_train * k);
+    for (std::size_t i = 0; i < n_train; i++)
+    {
+        B[i * k] = training_output[i];
+        for (std::size_t j = 0; j < n_test; j++)
+        {
+            B[i * k + j + 1] = kernel_rows[j * n_train + i];
+        }
+    }
+    const std::vector<double> X = solve_pcg(K, preconditioner, B, k, tolerance, max_iterations);
+
+    std::vector<double> prediction(n_test, 0.0);
+    std::vector<double> uncertainty(n_test, sek_params.vertical_lengthscale);
+    for (std::size_t i = 0; i < n_train; i++)
+    {
+        for (std::size_t j = 0; j < n_test; j++)
+        {
+            prediction[j] += B[i * k + j + 1] * X[i * k];
+            uncertainty[j] -= B[i * k + j + 1] * X[i * k + j + 1];
+        }
+    }
+    return std::vector<std::vector<double>>{ prediction, uncertainty };
+}
+
+}  // end of namespace cpu
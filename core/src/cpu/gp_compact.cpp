@@ -0,0 +1,764 @@
+#include "cpu/gp_compact.hpp"
+
+#include "cpu/gp_algorithms.hpp"
+#include "cpu/gp_optimizer.hpp"
+#include "cpu/tiled_algorithms.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <functional>
+#include <hpx/future.hpp>
+#include <limits>
+#include <numeric>
+
+namespace cpu
+{
+
+namespace
+{
+
+/**
+ * @brief Samples in tile order with the bounding boxes of the tiles
+ */
+struct CompactLayout
+{
+    /** @brief Original index of each sample */
+    std::vector<std::size_t> order;
+    /** @brief Lagged features of the samples in tile order, n_samples x n_regressors */
+    std::vector<double> features;
+    /** @brief Lower and upper corners of the bounding boxes, n_tiles x n_regressors */
+    std::vector<double> lower;
+    std::vector<double> upper;
+};
+
+/**
+ * @brief Tile-sparse Cholesky factor, see right_looking_cholesky_tiled
+ */
+struct CompactFactor
+{
+    /** @brief Tiles of the Cholesky factor, only those in the pattern are used */
+    Tiled_matrix L;
+    /** @brief Nonzero tiles of the covariance matrix */
+    std::vector<bool> covariance_pattern;
+    /** @brief Nonzero tiles of the Cholesky factor including the fill-in */
+    std::vector<bool> pattern;
+};
+
+/**
+ * @brief Return the exponent l = floor(n_regressors / 2) + 2 of the Wendland kernel.
+ */
+double wendland_exponent(std::size_t n_regressors) { return static_cast<double>(n_regressors / 2 + 2); }
+
+/**
+ * @brief Compute the Euclidean distance of two feature vectors.
+ */
+double compute_distance(const double *i_features, const double *j_features, std::size_t n_regressors)
+{
+    double distance = 0.0;
+    for (std::size_t k = 0; k < n_regressors; k++)
+    {
+        const double z_ik_minus_z_jk = i_features[k] - j_features[k];
+        distance += z_ik_minus_z_jk * z_ik_minus_z_jk;
+    }
+    return std::sqrt(distance);
+}
+
+/**
+ * @brief Recursively split the samples of the tiles [first_tile, last_tile) at a tile boundary
+ * by the median of the coordinate with the largest extent.
+ */
+void bisect_samples(const std::vector<double> &input,
+                    std::vector<std::size_t> &order,
+                    std::size_t first_tile,
+                    std::size_t last_tile,
+                    std::size_t N,
+                    std::size_t n_samples,
+                    std::size_t n_regressors)
+{
+    if (last_tile - first_tile < 2)
+    {
+        return;
+    }
+    const std::size_t begin = first_tile * N;
+    const std::size_t end = std::min(last_tile * N, n_samples);
+    std::size_t split_dimension = 0;
+    double largest_extent = -1.0;
+    for (std::size_t k = 0; k < n_regressors; k++)
+    {
+        const auto [min, max] = std::minmax_element(order.begin() + static_cast<std::ptrdiff_t>(begin),
+                                                    order.begin() + static_cast<std::ptrdiff_t>(end),
+                                                    [&](std::size_t a, std::size_t b)
+                                                    { return input[a + k] < input[b + k]; });
+        if (input[*max + k] - input[*min + k] > largest_extent)
+        {
+            largest_extent = input[*max + k] - input[*min + k];
+            split_dimension = k;
+        }
+    }
+    const std::size_t middle_tile = (first_tile + last_tile) / 2;
+    std::nth_element(order.begin() + static_cast<std::ptrdiff_t>(begin),
+                     order.begin() + static_cast<std::ptrdiff_t>(middle_tile * N),
+                     order.begin() + static_cast<std::ptrdiff_t>(end),
+                     [&](std::size_t a, std::size_t b)
+                     { return input[a + split_dimension] < input[b + split_dimension]; });
+    bisect_samples(input, order, first_tile, middle_tile, N, n_samples, n_regressors);
+    bisect_samples(input, order, middle_tile, last_tile, N, n_samples, n_regressors);
+}
+
+/**
+ * @brief Order the samples, gather their features and compute the bounding boxes of the tiles.
+ */
+CompactLayout build_layout(const std::vector<double> &input,
+                           std::size_t n_tiles,
+                           std::size_t N,
+                           std::size_t n_samples,
+                           std::size_t n_regressors,
+                           bool reorder)
+{
+    CompactLayout layout;
+    layout.order.resize(n_samples);
+    std::iota(layout.order.begin(), layout.order.end(), std::size_t{ 0 });
+    if (reorder)
+    {
+        bisect_samples(input, layout.order, 0, n_tiles, N, n_samples, n_regressors);
+    }
+
+    layout.features.resize(n_samples * n_regressors);
+    layout.lower.resize(n_tiles * n_regressors);
+    layout.upper.resize(n_tiles * n_regressors);
+    for (std::size_t t = 0; t < n_tiles; t++)
+    {
+        double *lower = &layout.lower[t * n_regressors];
+        double *upper = &layout.upper[t * n_regressors];
+        std::fill(lower, lower + n_regressors, std::numeric_limits<double>::infinity());
+        std::fill(upper, upper + n_regressors, -std::numeric_limits<double>::infinity());
+        for (std::size_t s = t * N; s < std::min((t + 1) * N, n_samples); s++)
+        {
+            for (std::size_t k = 0; k < n_regressors; k++)
+            {
+                const double z_sk = input[layout.order[s] + k];
+                layout.features[s * n_regressors + k] = z_sk;
+                lower[k] = std::min(lower[k], z_sk);
+                upper[k] = std::max(upper[k], z_sk);
+            }
+        }
+    }
+    return layout;
+}
+
+/**
+ * @brief Compute the nonzero tiles of the covariance matrix of two sets of samples, which
+ * are those whose bounding boxes are closer than the support radius.
+ */
+std::vector<bool> compute_covariance_pattern(const CompactLayout &row_layout,
+                                             const CompactLayout &col_layout,
+                                             std::size_t n_row_tiles,
+                                             std::size_t n_col_tiles,
+                                             std::size_t n_regressors,
+                                             double support)
+{
+    std::vector<bool> pattern(n_row_tiles * n_col_tiles);
+    for (std::size_t i = 0; i < n_row_tiles; i++)
+    {
+        for (std::size_t j = 0; j < n_col_tiles; j++)
+        {
+            double distance = 0.0;
+            for (std::size_t k = 0; k < n_regressors; k++)
+            {
+                const double gap = std::max({ 0.0,
+                                              row_layout.lower[i * n_regressors + k]
+                                                  - col_layout.upper[j * n_regressors + k],
+                                              col_layout.lower[j * n_regressors + k]
+                                                  - row_layout.upper[i * n_regressors + k] });
+                distance += gap * gap;
+            }
+            pattern[i * n_col_tiles + j] = distance < support * support;
+        }
+    }
+    return pattern;
+}
+
+/**
+ * @brief Add the fill-in of the tiled Cholesky decomposition to the lower triangular pattern.
+ */
+std::vector<bool> add_fill_in(std::vector<bool> pattern, std::size_t n_tiles)
+{
+    for (std::size_t k = 0; k < n_tiles; k++)
+    {
+        for (std::size_t m = k + 1; m < n_tiles; m++)
+        {
+            for (std::size_t n = k + 1; n < m && pattern[m * n_tiles + k]; n++)
+            {
+                if (pattern[n * n_tiles + k])
+                {
+                    pattern[m * n_tiles + n] = true;
+                }
+            }
+        }
+    }
+    return pattern;
+}
+
+/**
+ * @brief Generate a tile of the Wendland covariance matrix of two sets of samples in tile order.
+ *
+ * The noise variance is added on the diagonal of the diagonal tiles of the training covariance.
+ */
+std::vector<double> gen_tile_wendland(std::size_t row,
+                                      std::size_t col,
+                                      std::size_t N_row,
+                                      std::size_t N_col,
+                                      std::size_t n_row_samples,
+                                      std::size_t n_col_samples,
+                                      std::size_t n_regressors,
+                                      const gprat_hyper::SEKParams &sek_params,
+                                      const std::vector<double> &row_features,
+                                      const std::vector<double> &col_features,
+                                      bool noise)
+{
+    const std::size_t rows = compute_tile_size(row, N_row, n_row_samples);
+    const std::size_t cols = compute_tile_size(col, N_col, n_col_samples);
+    std::vector<double> tile(rows * cols);
+    for (std::size_t i = 0; i < rows; i++)
+    {
+        const double *i_features = &row_features[(row * N_row + i) * n_regressors];
+        for (std::size_t j = 0; j < cols; j++)
+        {
+            const double distance =
+                compute_distance(i_features, &col_features[(col * N_col + j) * n_regressors], n_regressors);
+            tile[i * cols + j] = compute_wendland_covariance(distance, sek_params, n_regressors);
+        }
+        if (noise)
+        {
+            tile[i * cols + i] += sek_params.noise_variance;
+        }
+    }
+    return tile;
+}
+
+/**
+ * @brief Generate the diagonal of a tile of the prior covariance matrix, which is constant
+ * for the Wendland kernel.
+ */
+std::vector<double> gen_tile_prior_variance(std::size_t N, double vertical_lengthscale)
+{
+    return std::vector<double>(N, vertical_lengthscale);
+}
+
+/**
+ * @brief Compute the contributions of a nonzero tile of the covariance matrix to the gradients
+ *
+ * The derivative tiles are computed on the fly. Tiles below the diagonal are counted twice
+ * for their transposed counterparts.
+ *
+ * @return The contributions to trace(K^-1 * dK/dl), trace(K^-1 * dK/dv), alpha^T * dK/dl * alpha
+ *         and alpha^T * dK/dv * alpha
+ */
+std::array<double, 4> compute_gradient_tile(const std::vector<double> &inverse_tile,
+                                            const std::vector<double> &alpha_row,
+                                            const std::vector<double> &alpha_col,
+                                            std::size_t row,
+                                            std::size_t col,
+                                            std::size_t N,
+                                            std::size_t n_samples,
+                                            std::size_t n_regressors,
+                                            const gprat_hyper::SEKParams &sek_params,
+                                            const std::vector<double> &features)
+{
+    const std::size_t rows = compute_tile_size(row, N, n_samples);
+    const std::size_t cols = compute_tile_size(col, N, n_samples);
+    const double weight = row == col ? 1.0 : 2.0;
+    const double l = wendland_exponent(n_regressors);
+    std::array<double, 4> contributions{ 0.0, 0.0, 0.0, 0.0 };
+    for (std::size_t i = 0; i < rows; i++)
+    {
+        const double *i_features = &features[(row * N + i) * n_regressors];
+        for (std::size_t j = 0; j < cols; j++)
+        {
+            const double r =
+                compute_distance(i_features, &features[(col * N + j) * n_regressors], n_regressors)
+                / sek_params.lengthscale;
+            if (r >= 1.0)
+            {
+                continue;
+            }
+            // dk/dv = (1 - r)^(l + 1) * ((l + 1) * r + 1)
+            // dk/dl = vertical_lengthscale * (l + 1) * (l + 2) * r^2 * (1 - r)^l / lengthscale
+            const double power = std::pow(1.0 - r, l);
+            const double grad_v = power * (1.0 - r) * ((l + 1.0) * r + 1.0);
+            const double grad_l =
+                sek_params.vertical_lengthscale * (l + 1.0) * (l + 2.0) * r * r * power / sek_params.lengthscale;
+            const double inverse = weight * inverse_tile[i * cols + j];
+            const double alpha = weight * alpha_row[i] * alpha_col[j];
+            contributions[0] += inverse * grad_l;
+            contributions[1] += inverse * grad_v;
+            contributions[2] += alpha * grad_l;
+            contributions[3] += alpha * grad_v;
+        }
+    }
+    return contributions;
+}
+
+/**
+ * @brief Launch the asynchronous assembly and Cholesky decomposition of the tile-sparse
+ * covariance matrix.
+ */
+CompactFactor launch_compact_factor(const CompactLayout &layout,
+                                    const gprat_hyper::SEKParams &sek_params,
+                                    std::size_t n_tiles,
+                                    std::size_t N,
+                                    std::size_t n_train,
+                                    std::size_t n_regressors)
+{
+    CompactFactor factor;
+    factor.covariance_pattern =
+        compute_covariance_pattern(layout, layout, n_tiles, n_tiles, n_regressors, sek_params.lengthscale);
+    factor.pattern = add_fill_in(factor.covariance_pattern, n_tiles);
+    factor.L.resize(n_tiles * n_tiles);  // Only the tiles in the pattern are used
+    for (std::size_t i = 0; i < n_tiles; i++)
+    {
+        for (std::size_t j = 0; j <= i; j++)
+        {
+            if (factor.covariance_pattern[i * n_tiles + j])
+            {
+                factor.L[i * n_tiles + j] =
+                    hpx::async(hpx::annotated_function(&gen_tile_wendland, "assemble_tiled_K_compact"),
+                               i,
+                               j,
+                               N,
+                               N,
+                               n_train,
+                               n_train,
+                               n_regressors,
+                               sek_params,
+                               std::cref(layout.features),
+                               std::cref(layout.features),
+                               i == j);
+            }
+            else if (factor.pattern[i * n_tiles + j])
+            {
+                // Zero tile of the covariance matrix that is filled in by the decomposition
+                factor.L[i * n_tiles + j] =
+                    hpx::async(hpx::annotated_function(gen_tile_zeros<double>, "assemble"),
+                               compute_tile_size(i, N, n_train) * compute_tile_size(j, N, n_train));
+            }
+        }
+    }
+    right_looking_cholesky_tiled(factor.L, factor.pattern, static_cast<int>(N), n_tiles, n_train);
+    return factor;
+}
+
+/**
+ * @brief Launch the asynchronous assembly of the tiled training output in tile order.
+ */
+Tiled_vector launch_output_tiles(const CompactLayout &layout,
+                                 const std::vector<double> &training_output,
+                                 std::size_t n_tiles,
+                                 std::size_t N,
+                                 std::size_t n_train)
+{
+    std::vector<double> output(n_train);
+    for (std::size_t s = 0; s < n_train; s++)
+    {
+        output[s] = training_output[layout.order[s]];
+    }
+    Tiled_vector y_tiles;
+    y_tiles.reserve(n_tiles);
+    for (std::size_t i = 0; i < n_tiles; i++)
+    {
+        y_tiles.push_back(hpx::async(
+            hpx::annotated_function(gen_tile_output<double>, "assemble_tiled_y"), i, N, n_train, output));
+    }
+    return y_tiles;
+}
+
+/**
+ * @brief Concatenate the tiles of a tiled vector and restore the original order of the samples.
+ */
+std::vector<double> scatter_tiles(const Tiled_vector &ft_tiles, const CompactLayout &layout)
+{
+    std::vector<double> result(layout.order.size());
+    std::size_t s = 0;
+    for (const auto &ft_tile : ft_tiles)
+    {
+        for (const double value : ft_tile.get())
+        {
+            result[layout.order[s++]] = value;
+        }
+    }
+    return result;
+}
+
+}  // namespace
+
+double compute_wendland_covariance(double distance, const gprat_hyper::SEKParams &sek_params, std::size_t n_regressors)
+{
+    const double r = distance / sek_params.lengthscale;
+    if (r >= 1.0)
+    {
+        return 0.0;
+    }
+    const double l = wendland_exponent(n_regressors);
+    return sek_params.vertical_lengthscale * std::pow(1.0 - r, l + 1.0) * ((l + 1.0) * r + 1.0);
+}
+
+std::vector<double> predict_compact(const std::vector<double> &training_input,
+                                    const std::vector<double> &training_output,
+                                    const std::vector<double> &test_input,
+                                    const gprat_hyper::SEKParams &sek_params,
+                                    int n_tiles,
+                                    int n_tile_size,
+                                    int m_tiles,
+                                    int m_tile_size,
+                                    int n_regressors,
+                                    bool reorder)
+{
+    /*
+     * Algorithm:
+     * 1: Reorder the training and test samples
+     * 2: Compute the tile-sparse Cholesky factor L of K
+     * 3: Compute alpha = K^-1 * y with the triangular solves L * (L^T * alpha) = y
+     * 4: Compute hat(y) = cross(K) * alpha on the nonzero tiles of cross(K)
+     */
+    const std::size_t n_reg = static_cast<std::size_t>(n_regressors);
+    const std::size_t N = static_cast<std::size_t>(n_tile_size);
+    const std::size_t M = static_cast<std::size_t>(m_tile_size);
+    const std::size_t n_t = static_cast<std::size_t>(n_tiles);
+    const std::size_t m_t = static_cast<std::size_t>(m_tiles);
+    const std::size_t n_train = compute_n_samples(n_t, N, training_input.size(), n_reg);
+    const std::size_t n_test = compute_n_samples(m_t, M, test_input.size(), n_reg);
+
+    const CompactLayout training_layout = build_layout(training_input, n_t, N, n_train, n_reg, reorder);
+    const CompactLayout test_layout = build_layout(test_input, m_t, M, n_test, n_reg, reorder);
+    CompactFactor factor = launch_compact_factor(training_layout, sek_params, n_t, N, n_train, n_reg);
+    Tiled_vector alpha_tiles = launch_output_tiles(training_layout, training_output, n_t, N, n_train);
+    forward_solve_tiled(factor.L, factor.pattern, alpha_tiles, n_tile_size, n_t, n_train);
+    backward_solve_tiled(factor.L, factor.pattern, alpha_tiles, n_tile_size, n_t, n_train);
+
+    const std::vector<bool> cross_pattern =
+        compute_covariance_pattern(test_layout, training_layout, m_t, n_t, n_reg, sek_params.lengthscale);
+    Tiled_matrix cross_covariance_tiles(m_t * n_t);  // Only the tiles in the pattern are used
+    Tiled_vector prediction_tiles;
+    prediction_tiles.reserve(m_t);
+    for (std::size_t i = 0; i < m_t; i++)
+    {
+        for (std::size_t j = 0; j < n_t; j++)
+        {
+            if (cross_pattern[i * n_t + j])
+            {
+                cross_covariance_tiles[i * n_t + j] =
+                    hpx::async(hpx::annotated_function(&gen_tile_wendland, "assemble_pred_compact"),
+                               i,
+                               j,
+                               M,
+                               N,
+                               n_test,
+                               n_train,
+                               n_reg,
+                               sek_params,
+                               std::cref(test_layout.features),
+                               std::cref(training_layout.features),
+                               false);
+            }
+        }
+        prediction_tiles.push_back(hpx::async(hpx::annotated_function(gen_tile_zeros<double>, "assemble_tiled"),
+                                              compute_tile_size(i, M, n_test)));
+    }
+    matrix_vector_tiled(cross_covariance_tiles,
+                        cross_pattern,
+                        alpha_tiles,
+                        prediction_tiles,
+                        m_tile_size,
+                        n_tile_size,
+                        n_t,
+                        m_t,
+                        n_test,
+                        n_train);
+
+    return scatter_tiles(prediction_tiles, test_layout);
+}
+
+std::vector<std::vector<double>> predict_compact_with_uncertainty(const std::vector<double> &training_input,
+                                                                  const std::vector<double> &training_output,
+                                                                  const std::vector<double> &test_input,
+                                                                  const gprat_hyper::SEKParams &sek_params,
+                                                                  int n_tiles,
+                                                                  int n_tile_size,
+                                                                  int m_tiles,
+                                                                  int m_tile_size,
+                                                                  int n_regressors,
+                                                                  bool reorder)
+{
+    /*
+     * Algorithm:
+     * 1: Reorder the training and test samples
+     * 2: Compute the tile-sparse Cholesky factor L of K
+     * 3: Compute the triangular solves L * beta = y and L * V = cross(K)^T, skipping zero tiles
+     * 4: Compute hat(y) = V^T * beta
+     * 5: Compute diag(Sigma) = diag(prior(K)) - diag(V^T * V)
+     */
+    const std::size_t n_reg = static_cast<std::size_t>(n_regressors);
+    const std::size_t N = static_cast<std::size_t>(n_tile_size);
+    const std::size_t M = static_cast<std::size_t>(m_tile_size);
+    const std::size_t n_t = static_cast<std::size_t>(n_tiles);
+    const std::size_t m_t = static_cast<std::size_t>(m_tiles);
+    const std::size_t n_train = compute_n_samples(n_t, N, training_input.size(), n_reg);
+    const std::size_t n_test = compute_n_samples(m_t, M, test_input.size(), n_reg);
+
+    const CompactLayout training_layout = build_layout(training_input, n_t, N, n_train, n_reg, reorder);
+    const CompactLayout test_layout = build_layout(test_input, m_t, M, n_test, n_reg, reorder);
+    CompactFactor factor = launch_compact_factor(training_layout, sek_params, n_t, N, n_train, n_reg);
+    Tiled_vector beta_tiles = launch_output_tiles(training_layout, training_output, n_t, N, n_train);
+    forward_solve_tiled(factor.L, factor.pattern, beta_tiles, n_tile_size, n_t, n_train);
+
+    // The kernel is symmetric, such that cross(K)^T is assembled without transposition. Its
+    // zero tiles are kept, since the triangular solve may fill them in.
+    std::vector<bool> t_cross_pattern =
+        compute_covariance_pattern(training_layout, test_layout, n_t, m_t, n_reg, sek_params.lengthscale);
+    Tiled_matrix t_cross_covariance_tiles;
+    t_cross_covariance_tiles.reserve(n_t * m_t);
+    for (std::size_t j = 0; j < n_t; j++)
+    {
+        for (std::size_t i = 0; i < m_t; i++)
+        {
+            if (t_cross_pattern[j * m_t + i])
+            {
+                t_cross_covariance_tiles.push_back(
+                    hpx::async(hpx::annotated_function(&gen_tile_wendland, "assemble_pred_compact"),
+                               j,
+                               i,
+                               N,
+                               M,
+                               n_train,
+                               n_test,
+                               n_reg,
+                               sek_params,
+                               std::cref(training_layout.features),
+                               std::cref(test_layout.features),
+                               false));
+            }
+            else
+            {
+                t_cross_covariance_tiles.push_back(
+                    hpx::async(hpx::annotated_function(gen_tile_zeros<double>, "assemble"),
+                               compute_tile_size(j, N, n_train) * compute_tile_size(i, M, n_test)));
+            }
+        }
+    }
+    Tiled_vector prediction_tiles;
+    Tiled_vector prior_K_tiles;
+    Tiled_vector uncertainty_tiles;
+    prediction_tiles.reserve(m_t);
+    prior_K_tiles.reserve(m_t);
+    uncertainty_tiles.reserve(m_t);
+    for (std::size_t i = 0; i < m_t; i++)
+    {
+        const std::size_t M_i = compute_tile_size(i, M, n_test);
+        prediction_tiles.push_back(hpx::async(hpx::annotated_function(gen_tile_zeros<double>, "assemble_tiled"), M_i));
+        prior_K_tiles.push_back(hpx::async(hpx::annotated_function(&gen_tile_prior_variance, "assemble_tiled"),
+                                           M_i,
+                                           sek_params.vertical_lengthscale));
+        uncertainty_tiles.push_back(
+            hpx::async(hpx::annotated_function(gen_tile_zeros<double>, "assemble_prior_inter"), M_i));
+    }
+
+    forward_solve_tiled_matrix(factor.L,
+                               factor.pattern,
+                               t_cross_covariance_tiles,
+                               t_cross_pattern,
+                               n_tile_size,
+                               m_tile_size,
+                               n_t,
+                               m_t,
+                               n_train,
+                               n_test);
+    transpose_matrix_vector_tiled(
+        t_cross_covariance_tiles, beta_tiles, prediction_tiles, n_tile_size, m_tile_size, n_t, m_t, n_train, n_test);
+    symmetric_matrix_matrix_diagonal_tiled(
+        t_cross_covariance_tiles, uncertainty_tiles, n_tile_size, m_tile_size, n_t, m_t, n_train, n_test);
+    vector_difference_tiled(prior_K_tiles, uncertainty_tiles, m_tile_size, m_t, n_test);
+
+    return std::vector<std::vector<double>>{ scatter_tiles(prediction_tiles, test_layout),
+                                             scatter_tiles(uncertainty_tiles, test_layout) };
+}
+
+double compute_loss_compact(const std::vector<double> &training_input,
+                            const std::vector<double> &training_output,
+                            const gprat_hyper::SEKParams &sek_params,
+                            int n_tiles,
+                            int n_tile_size,
+                            int n_regressors,
+                            bool reorder)
+{
+    /*
+     * Algorithm:
+     * 1: Reorder the training samples, which leaves the loss unchanged
+     * 2: Compute the tile-sparse Cholesky factor L of K
+     * 3: Compute alpha = K^-1 * y with the triangular solves L * (L^T * alpha) = y
+     * 4: Compute the loss from the diagonal tiles of L and y^T * alpha, see compute_loss
+     */
+    const std::size_t n_reg = static_cast<std::size_t>(n_regressors);
+    const std::size_t N = static_cast<std::size_t>(n_tile_size);
+    const std::size_t n_t = static_cast<std::size_t>(n_tiles);
+    const std::size_t n_train = compute_n_samples(n_t, N, training_input.size(), n_reg);
+
+    const CompactLayout layout = build_layout(training_input, n_t, N, n_train, n_reg, reorder);
+    CompactFactor factor = launch_compact_factor(layout, sek_params, n_t, N, n_train, n_reg);
+    Tiled_vector y_tiles = launch_output_tiles(layout, training_output, n_t, N, n_train);
+    Tiled_vector alpha_tiles = y_tiles;
+    forward_solve_tiled(factor.L, factor.pattern, alpha_tiles, n_tile_size, n_t, n_train);
+    backward_solve_tiled(factor.L, factor.pattern, alpha_tiles, n_tile_size, n_t, n_train);
+
+    hpx::shared_future<double> loss_value;
+    compute_loss_tiled(factor.L, alpha_tiles, y_tiles, loss_value, n_tile_size, n_t, n_train);
+    return loss_value.get();
+}
+
+std::vector<double> optimize_compact(const std::vector<double> &training_input,
+                                     const std::vector<double> &training_output,
+                                     int n_tiles,
+                                     int n_tile_size,
+                                     int n_regressors,
+                                     const gprat_hyper::AdamParams &adam_params,
+                                     gprat_hyper::SEKParams &sek_params,
+                                     std::vector<bool> trainable_params,
+                                     bool reorder)
+{
+    /*
+     * Reorder the training samples once, then
+     * for opt_iter:
+     *   1: Compute the tile-sparse Cholesky factor L of K and alpha = K^-1 * y
+     *   2: Compute the loss
+     *   3: Compute the tiles of K^-1 in the pattern of L by the selected inverse
+     *   4: Compute trace(K^-1 * dK/dtheta_p) and alpha^T * dK/dtheta_p * alpha on the nonzero tiles of K
+     *   5: Update hyperparameters theta with Adam optimizer, see update_hyperparameter_tiled
+     * endfor
+     */
+    const std::size_t n_reg = static_cast<std::size_t>(n_regressors);
+    const std::size_t N = static_cast<std::size_t>(n_tile_size);
+    const std::size_t n_t = static_cast<std::size_t>(n_tiles);
+    const std::size_t n_train = compute_n_samples(n_t, N, training_input.size(), n_reg);
+
+    const CompactLayout layout = build_layout(training_input, n_t, N, n_train, n_reg, reorder);
+    const Tiled_vector y_tiles = launch_output_tiles(layout, training_output, n_t, N, n_train);
+
+    std::vector<double> losses;
+    losses.reserve(static_cast<std::size_t>(adam_params.opt_iter));
+    for (std::size_t iter = 0; iter < static_cast<std::size_t>(adam_params.opt_iter); iter++)
+    {
+        CompactFactor factor = launch_compact_factor(layout, sek_params, n_t, N, n_train, n_reg);
+        Tiled_vector alpha_tiles = y_tiles;
+        forward_solve_tiled(factor.L, factor.pattern, alpha_tiles, n_tile_size, n_t, n_train);
+        backward_solve_tiled(factor.L, factor.pattern, alpha_tiles, n_tile_size, n_t, n_train);
+
+        Tiled_vector loss_y_tiles = y_tiles;
+        hpx::shared_future<double> loss_value;
+        compute_loss_tiled(factor.L, alpha_tiles, loss_y_tiles, loss_value, n_tile_size, n_t, n_train);
+
+        Tiled_matrix inverse_tiles(n_t * n_t);  // Only the tiles in the pattern are used
+        selected_inverse_tiled(factor.L, factor.pattern, inverse_tiles, n_tile_size, n_t, n_train);
+
+        std::vector<hpx::shared_future<std::array<double, 4>>> contributions;
+        std::vector<hpx::shared_future<double>> noise_traces;
+        std::vector<hpx::shared_future<double>> noise_dots;
+        for (std::size_t i = 0; i < n_t; i++)
+        {
+            for (std::size_t j = 0; j <= i; j++)
+            {
+                if (factor.covariance_pattern[i * n_t + j])
+                {
+                    contributions.push_back(hpx::dataflow(
+                        hpx::annotated_function(hpx::unwrapping(&compute_gradient_tile), "gradient_compact"),
+                        inverse_tiles[i * n_t + j],
+                        alpha_tiles[i],
+                        alpha_tiles[j],
+                        i,
+                        j,
+                        N,
+                        n_train,
+                        n_reg,
+                        sek_params,
+                        std::cref(layout.features)));
+                }
+            }
+            noise_traces.push_back(
+                hpx::dataflow(hpx::annotated_function(hpx::unwrapping(&compute_trace_diag), "gradient_compact"),
+                              inverse_tiles[i * n_t + i],
+                              0.0,
+                              compute_tile_size(i, N, n_train)));
+            noise_dots.push_back(hpx::dataflow(
+                hpx::annotated_function(hpx::unwrapping(&compute_dot), "gradient_compact"),
+                alpha_tiles[i],
+                alpha_tiles[i],
+                0.0));
+        }
+
+        // Index 0: lengthscale, 1: vertical_lengthscale, 2: noise_variance
+        std::array<double, 3> trace{ 0.0, 0.0, 0.0 };
+        std::array<double, 3> dot{ 0.0, 0.0, 0.0 };
+        for (const auto &contribution : contributions)
+        {
+            const std::array<double, 4> &tile_contribution = contribution.get();
+            trace[0] += tile_contribution[0];
+            trace[1] += tile_contribution[1];
+            dot[0] += tile_contribution[2];
+            dot[1] += tile_contribution[3];
+        }
+        for (std::size_t i = 0; i < n_t; i++)
+        {
+            trace[2] += noise_traces[i].get();
+            dot[2] += noise_dots[i].get();
+        }
+        losses.push_back(loss_value.get());
+
+        for (std::size_t p = 0; p < sek_params.size(); p++)
+        {
+            if (trainable_params[p])
+            {
+                const bool noise = p == 2;
+                // Chain rule of the softplus constraint
+                const double gradient = compute_sigmoid(to_unconstrained(sek_params.get_param(p), noise))
+                                        * compute_gradient(trace[p], dot[p], n_train);
+                // m_T = beta1 * m_T-1 + (1 - beta1) * g_T
+                sek_params.m_T[p] = update_first_moment(gradient, sek_params.m_T[p], adam_params.beta1);
+                // w_T = beta2 + w_T-1 + (1 - beta2) * g_T^2
+                sek_params.w_T[p] = update_second_moment(gradient, sek_params.w_T[p], adam_params.beta2);
+                const double updated_param = adam_step(to_unconstrained(sek_params.get_param(p), noise),
+                                                       adam_params,
+                                                       sek_params.m_T[p],
+                                                       sek_params.w_T[p],
+                                                       iter);
+                sek_params.set_param(p, to_constrained(updated_param, noise));
+            }
+        }
+    }
+    return losses;
+}
+
+double compute_compact_density(const std::vector<double> &training_input,
+                               const gprat_hyper::SEKParams &sek_params,
+                               int n_tiles,
+                               int n_tile_size,
+                               int n_regressors,
+                               bool reorder)
+{
+    const std::size_t n_reg = static_cast<std::size_t>(n_regressors);
+    const std::size_t N = static_cast<std::size_t>(n_tile_size);
+    const std::size_t n_t = static_cast<std::size_t>(n_tiles);
+    const std::size_t n_train = compute_n_samples(n_t, N, training_input.size(), n_reg);
+
+    const CompactLayout layout = build_layout(training_input, n_t, N, n_train, n_reg, reorder);
+    const std::vector<bool> pattern = add_fill_in(
+        compute_covariance_pattern(layout, layout, n_t, n_t, n_reg, sek_params.lengthscale), n_t);
+    std::size_t n_nonzero = 0;
+    for (std::size_t i = 0; i < n_t; i++)
+    {
+        for (std::size_t j = 0; j <= i; j++)
+        {
+            n_nonzero += pattern[i * n_t + j] ? std::size_t{ 1 } : std::size_t{ 0 };
+        }
+    }
+    return static_cast<double>(n_nonzero) / static_cast<double>(n_t * (n_t + 1) / 2);
+}
+
+}  // end of namespace cpu
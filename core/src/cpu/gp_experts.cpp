@@ -0,0 +1,496 @@
+#include "cpu/gp_experts.hpp"
+
+#include "cpu/adapter_cblas_fp64.hpp"
+#include "cpu/gp_algorithms.hpp"
+#include "cpu/gp_optimizer.hpp"
+#include "cpu/tiled_algorithms.hpp"
+#include <cmath>
+#include <hpx/future.hpp>
+
+namespace cpu
+{
+
+namespace
+{
+
+/**
+ * @brief Independent factorizations of the experts, one per training tile
+ */
+struct ExpertFactors
+{
+    /** @brief Cholesky factor L_k of the diagonal tile K_kk of each expert */
+    Tiled_matrix L;
+    /** @brief alpha_k = K_kk^-1 * y_k of each expert */
+    Tiled_vector alpha;
+    /** @brief Output y_k of each expert */
+    Tiled_vector y;
+};
+
+/**
+ * @brief Launch the asynchronous factorization of the experts.
+ */
+ExpertFactors launch_expert_factors(const std::vector<double> &training_input,
+                                    const std::vector<double> &training_output,
+                                    const gprat_hyper::SEKParams &sek_params,
+                                    std::size_t n_tiles,
+                                    std::size_t N,
+                                    std::size_t n_train,
+                                    std::size_t n_regressors)
+{
+    ExpertFactors factors;
+    factors.L.reserve(n_tiles);
+    factors.alpha.reserve(n_tiles);
+    factors.y.reserve(n_tiles);
+    for (std::size_t k = 0; k < n_tiles; k++)
+    {
+        const int N_k = static_cast<int>(compute_tile_size(k, N, n_train));
+        // POTRF: K_kk = L_k * L_k^T
+        factors.L.push_back(hpx::dataflow(
+            hpx::annotated_function(potrf<double>, "expert_cholesky"),
+            hpx::async(hpx::annotated_function(gen_tile_covariance<double>, "assemble_expert_K"),
+                       k,
+                       k,
+                       N,
+                       n_train,
+                       n_regressors,
+                       sek_params,
+                       training_input),
+            N_k));
+        factors.y.push_back(hpx::async(
+            hpx::annotated_function(gen_tile_output<double>, "assemble_expert_y"), k, N, n_train, training_output));
+        // POTRS: alpha_k = K_kk^-1 * y_k
+        factors.alpha.push_back(hpx::dataflow(
+            hpx::annotated_function(potrs<double>, "expert_alpha"), factors.L[k], factors.y[k], N_k));
+    }
+    return factors;
+}
+
+/**
+ * @brief Combine the expert predictions and uncertainties of a test tile.
+ */
+std::vector<std::vector<double>> combine_tile_predictions(const std::vector<std::vector<double>> &means,
+                                                          const std::vector<std::vector<double>> &reductions,
+                                                          double prior_variance,
+                                                          ExpertAggregation aggregation)
+{
+    // sigma_k^2 = k(x, x) - diag(V_k^T * V_k)
+    std::vector<std::vector<double>> variances = reductions;
+    for (auto &variance : variances)
+    {
+        for (auto &value : variance)
+        {
+            value = prior_variance - value;
+        }
+    }
+    return combine_expert_predictions(means, variances, prior_variance, aggregation);
+}
+
+/**
+ * @brief Compute the predictions of the experts and optionally their uncertainties.
+ */
+std::vector<std::vector<double>> expert_prediction(const std::vector<double> &training_input,
+                                                   const std::vector<double> &training_output,
+                                                   const std::vector<double> &test_input,
+                                                   const gprat_hyper::SEKParams &sek_params,
+                                                   ExpertAggregation aggregation,
+                                                   int n_tiles,
+                                                   int n_tile_size,
+                                                   int m_tiles,
+                                                   int m_tile_size,
+                                                   int n_regressors,
+                                                   bool with_uncertainty)
+{
+    /*
+     * Algorithm:
+     * 1: Factorize each expert: K_kk = L_k * L_k^T and alpha_k = K_kk^-1 * y_k
+     * 2: For each test tile and expert, compute prediction mu_k = K_*k * alpha_k
+     *    and uncertainty sigma_k^2 = diag(K_**) - diag(V_k^T * V_k) with V_k = L_k^-1 * K_k*
+     * 3: Combine the expert predictions, see combine_expert_predictions
+     */
+    const std::size_t n_reg = static_cast<std::size_t>(n_regressors);
+    const std::size_t N = static_cast<std::size_t>(n_tile_size);
+    const std::size_t M = static_cast<std::size_t>(m_tile_size);
+    const std::size_t e_tiles = static_cast<std::size_t>(n_tiles);
+    const std::size_t t_tiles = static_cast<std::size_t>(m_tiles);
+    const std::size_t n_train = compute_n_samples(e_tiles, N, training_input.size(), n_reg);
+    const std::size_t n_test = compute_n_samples(t_tiles, M, test_input.size(), n_reg);
+
+    ExpertFactors factors =
+        launch_expert_factors(training_input, training_output, sek_params, e_tiles, N, n_train, n_reg);
+
+    std::vector<hpx::future<std::vector<std::vector<double>>>> tiles;
+    tiles.reserve(t_tiles);
+    for (std::size_t j = 0; j < t_tiles; j++)
+    {
+        const std::size_t M_j = compute_tile_size(j, M, n_test);
+        Tiled_vector means;
+        Tiled_vector reductions;
+        means.reserve(e_tiles);
+        reductions.reserve(e_tiles);
+        for (std::size_t k = 0; k < e_tiles; k++)
+        {
+            const int N_k = static_cast<int>(compute_tile_size(k, N, n_train));
+            hpx::shared_future<std::vector<double>> cross_covariance = hpx::async(
+                hpx::annotated_function(gen_tile_cross_covariance<double>, "assemble_expert_K_k*"),
+                k,
+                j,
+                N,
+                M,
+                n_train,
+                n_test,
+                n_reg,
+                sek_params,
+                training_input,
+                test_input);
+            // GEMV: mu_k = K_k*^T * alpha_k
+            means.push_back(hpx::dataflow(
+                hpx::annotated_function(gemv<double>, "expert_prediction"),
+                cross_covariance,
+                factors.alpha[k],
+                hpx::async(hpx::annotated_function(gen_tile_zeros<double>, "assemble_expert_prediction"), M_j),
+                N_k,
+                static_cast<int>(M_j),
+                Blas_add,
+                Blas_trans));
+            // TRSM: V_k = L_k^-1 * K_k*, the uncertainties weight the experts in all rules
+            reductions.push_back(hpx::dataflow(
+                hpx::annotated_function(dot_diag_syrk<double>, "expert_uncertainty"),
+                hpx::dataflow(hpx::annotated_function(trsm<double>, "expert_uncertainty"),
+                              factors.L[k],
+                              cross_covariance,
+                              N_k,
+                              static_cast<int>(M_j),
+                              Blas_no_trans,
+                              Blas_left),
+                hpx::async(hpx::annotated_function(gen_tile_zeros<double>, "assemble_expert_uncertainty"), M_j),
+                N_k,
+                static_cast<int>(M_j)));
+        }
+        tiles.push_back(
+            hpx::dataflow(hpx::annotated_function(hpx::unwrapping(&combine_tile_predictions), "combine_experts"),
+                          means,
+                          reductions,
+                          sek_params.vertical_lengthscale,
+                          aggregation));
+    }
+
+    std::vector<double> prediction_result;
+    std::vector<double> uncertainty_result;
+    prediction_result.reserve(n_test);
+    if (with_uncertainty)
+    {
+        uncertainty_result.reserve(n_test);
+    }
+    for (std::size_t j = 0; j < t_tiles; j++)
+    {
+        auto tile = tiles[j].get();
+        prediction_result.insert(prediction_result.end(), tile[0].begin(), tile[0].end());
+        if (with_uncertainty)
+        {
+            uncertainty_result.insert(uncertainty_result.end(), tile[1].begin(), tile[1].end());
+        }
+    }
+    return std::vector<std::vector<double>>{ std::move(prediction_result), std::move(uncertainty_result) };
+}
+
+}  // namespace
+
+std::vector<std::vector<double>> combine_expert_predictions(const std::vector<std::vector<double>> &means,
+                                                            const std::vector<std::vector<double>> &variances,
+                                                            double prior_variance,
+                                                            ExpertAggregation aggregation)
+{
+    /*
+     * With precisions p_k = 1 / sigma_k^2 and weights beta_k:
+     *   1 / sigma^2 = sum_k beta_k * p_k + (1 - sum_k beta_k) / prior_variance
+     *   mu = sigma^2 * sum_k beta_k * p_k * mu_k
+     * - PoE: beta_k = 1 without prior correction
+     * - gPoE: beta_k = 1 / n_experts without prior correction
+     * - BCM: beta_k = 1
+     * - rBCM: beta_k = 0.5 * ( log(prior_variance) - log(sigma_k^2) )
+     */
+    const std::size_t n_experts = means.size();
+    const std::size_t n_points = n_experts == 0 ? 0 : means.front().size();
+    const bool prior_correction = aggregation == ExpertAggregation::BCM || aggregation == ExpertAggregation::rBCM;
+
+    std::vector<double> mean(n_points);
+    std::vector<double> variance(n_points);
+    for (std::size_t i = 0; i < n_points; i++)
+    {
+        double precision = 0.0;
+        double weighted_mean = 0.0;
+        double weight_sum = 0.0;
+        for (std::size_t k = 0; k < n_experts; k++)
+        {
+            double beta = 1.0;
+            if (aggregation == ExpertAggregation::gPoE)
+            {
+                beta = 1.0 / static_cast<double>(n_experts);
+            }
+            else if (aggregation == ExpertAggregation::rBCM)
+            {
+                beta = 0.5 * (std::log(prior_variance) - std::log(variances[k][i]));
+            }
+            precision += beta / variances[k][i];
+            weighted_mean += beta / variances[k][i] * means[k][i];
+            weight_sum += beta;
+        }
+        if (prior_correction)
+        {
+            precision += (1.0 - weight_sum) / prior_variance;
+        }
+        variance[i] = 1.0 / precision;
+        mean[i] = variance[i] * weighted_mean;
+    }
+    return std::vector<std::vector<double>>{ std::move(mean), std::move(variance) };
+}
+
+std::vector<double> predict_experts(const std::vector<double> &training_input,
+                                    const std::vector<double> &training_output,
+                                    const std::vector<double> &test_input,
+                                    const gprat_hyper::SEKParams &sek_params,
+                                    ExpertAggregation aggregation,
+                                    int n_tiles,
+                                    int n_tile_size,
+                                    int m_tiles,
+                                    int m_tile_size,
+                                    int n_regressors)
+{
+    return expert_prediction(training_input,
+                             training_output,
+                             test_input,
+                             sek_params,
+                             aggregation,
+                             n_tiles,
+                             n_tile_size,
+                             m_tiles,
+                             m_tile_size,
+                             n_regressors,
+                             false)
+        .front();
+}
+
+std::vector<std::vector<double>> predict_experts_with_uncertainty(const std::vector<double> &training_input,
+                                                                  const std::vector<double> &training_output,
+                                                                  const std::vector<double> &test_input,
+                                                                  const gprat_hyper::SEKParams &sek_params,
+                                                                  ExpertAggregation aggregation,
+                                                                  int n_tiles,
+                                                                  int n_tile_size,
+                                                                  int m_tiles,
+                                                                  int m_tile_size,
+                                                                  int n_regressors)
+{
+    return expert_prediction(training_input,
+                             training_output,
+                             test_input,
+                             sek_params,
+                             aggregation,
+                             n_tiles,
+                             n_tile_size,
+                             m_tiles,
+                             m_tile_size,
+                             n_regressors,
+                             true);
+}
+
+double compute_loss_experts(const std::vector<double> &training_input,
+                            const std::vector<double> &training_output,
+                            const gprat_hyper::SEKParams &sek_params,
+                            int n_tiles,
+                            int n_tile_size,
+                            int n_regressors)
+{
+    /*
+     * Negative log likelihood loss of the block diagonal covariance of the experts:
+     * loss(theta) = 0.5 * ( sum_k log(det(K_kk)) + y_k^T * K_kk^-1 * y_k + N * log(2 * pi) )
+     */
+    const std::size_t n_reg = static_cast<std::size_t>(n_regressors);
+    const std::size_t N = static_cast<std::size_t>(n_tile_size);
+    const std::size_t e_tiles = static_cast<std::size_t>(n_tiles);
+    const std::size_t n_train = compute_n_samples(e_tiles, N, training_input.size(), n_reg);
+
+    ExpertFactors factors =
+        launch_expert_factors(training_input, training_output, sek_params, e_tiles, N, n_train, n_reg);
+
+    std::vector<hpx::shared_future<double>> losses;
+    losses.reserve(e_tiles);
+    for (std::size_t k = 0; k < e_tiles; k++)
+    {
+        losses.push_back(hpx::dataflow(hpx::annotated_function(hpx::unwrapping(&compute_loss), "expert_loss"),
+                                       factors.L[k],
+                                       factors.alpha[k],
+                                       factors.y[k],
+                                       compute_tile_size(k, N, n_train)));
+    }
+    return hpx::dataflow(hpx::annotated_function(hpx::unwrapping(&add_losses), "expert_loss"), losses, n_train).get();
+}
+
+std::vector<double> optimize_experts(const std::vector<double> &training_input,
+                                     const std::vector<double> &training_output,
+                                     int n_tiles,
+                                     int n_tile_size,
+                                     int n_regressors,
+                                     const gprat_hyper::AdamParams &adam_params,
+                                     gprat_hyper::SEKParams &sek_params,
+                                     std::vector<bool> trainable_params)
+{
+    /*
+     * for opt_iter:
+     *   1: Compute distance, K_kk and gradients delta(K_kk)/delta(theta_i) of each expert
+     *   2: Compute Cholesky factor L_k, K_kk^-1 and alpha_k = K_kk^-1 * y_k of each expert
+     *   3: Compute the loss, the sum of the expert losses
+     *   4: Compute delta(loss)/delta(theta_i), the sum of the expert gradients
+     *       - Compute trace(K_kk^-1 * delta(K_kk)/delta(theta_i))
+     *       - Compute alpha_k^T * delta(K_kk)/delta(theta_i) * alpha_k
+     *   5: Update hyperparameters theta with Adam optimizer, see update_hyperparameter_tiled
+     * endfor
+     */
+    const std::size_t n_reg = static_cast<std::size_t>(n_regressors);
+    const std::size_t N = static_cast<std::size_t>(n_tile_size);
+    const std::size_t e_tiles = static_cast<std::size_t>(n_tiles);
+    const std::size_t n_train = compute_n_samples(e_tiles, N, training_input.size(), n_reg);
+
+    Tiled_vector y_tiles;
+    y_tiles.reserve(e_tiles);
+    for (std::size_t k = 0; k < e_tiles; k++)
+    {
+        y_tiles.push_back(hpx::async(
+            hpx::annotated_function(gen_tile_output<double>, "assemble_expert_y"), k, N, n_train, training_output));
+    }
+
+    std::vector<double> losses;
+    losses.reserve(static_cast<std::size_t>(adam_params.opt_iter));
+    for (std::size_t iter = 0; iter < static_cast<std::size_t>(adam_params.opt_iter); iter++)
+    {
+        std::vector<hpx::shared_future<double>> expert_losses;
+        std::vector<hpx::shared_future<double>> trace(sek_params.size(), hpx::make_ready_future(0.0));
+        std::vector<hpx::shared_future<double>> dot(sek_params.size(), hpx::make_ready_future(0.0));
+        expert_losses.reserve(e_tiles);
+        for (std::size_t k = 0; k < e_tiles; k++)
+        {
+            const std::size_t N_k = compute_tile_size(k, N, n_train);
+            const int N_k_int = static_cast<int>(N_k);
+            // Compute the distance (z_i - z_j) of K_kk entries to reuse
+            hpx::shared_future<std::vector<double>> distance =
+                hpx::async(hpx::annotated_function(gen_tile_distance, "assemble_expert_dist"),
+                           k,
+                           k,
+                           N,
+                           n_train,
+                           n_reg,
+                           sek_params,
+                           training_input);
+            hpx::shared_future<std::vector<double>> L = hpx::dataflow(
+                hpx::annotated_function(potrf<double>, "expert_cholesky"),
+                hpx::dataflow(
+                    hpx::annotated_function(hpx::unwrapping(&gen_tile_covariance_with_distance), "assemble_expert_K"),
+                    k,
+                    k,
+                    N,
+                    n_train,
+                    sek_params,
+                    distance),
+                N_k_int);
+            // K_kk^-1 through L_k * (L_k^T * X) = I
+            hpx::shared_future<std::vector<double>> K_inv = hpx::dataflow(
+                hpx::annotated_function(trsm<double>, "expert_inverse"),
+                L,
+                hpx::dataflow(hpx::annotated_function(trsm<double>, "expert_inverse"),
+                              L,
+                              hpx::async(hpx::annotated_function(gen_tile_identity<double>, "assemble_identity_matrix"),
+                                         N_k),
+                              N_k_int,
+                              N_k_int,
+                              Blas_no_trans,
+                              Blas_left),
+                N_k_int,
+                N_k_int,
+                Blas_trans,
+                Blas_left);
+            hpx::shared_future<std::vector<double>> alpha = hpx::dataflow(
+                hpx::annotated_function(potrs<double>, "expert_alpha"), L, y_tiles[k], N_k_int);
+            expert_losses.push_back(
+                hpx::dataflow(hpx::annotated_function(hpx::unwrapping(&compute_loss), "expert_loss"),
+                              L,
+                              alpha,
+                              y_tiles[k],
+                              N_k));
+
+            for (std::size_t p = 0; p < sek_params.size(); p++)
+            {
+                if (!trainable_params[p])
+                {
+                    continue;
+                }
+                if (p == 2)
+                {
+                    // delta(K_kk)/delta(noise_variance) = I
+                    trace[p] = hpx::dataflow(
+                        hpx::annotated_function(hpx::unwrapping(&compute_trace_diag), "expert_gradient"),
+                        K_inv,
+                        trace[p],
+                        N_k);
+                    dot[p] = hpx::dataflow(hpx::annotated_function(hpx::unwrapping(&compute_dot), "expert_gradient"),
+                                           alpha,
+                                           alpha,
+                                           dot[p]);
+                    continue;
+                }
+                hpx::shared_future<std::vector<double>> grad_K = hpx::dataflow(
+                    hpx::annotated_function(hpx::unwrapping(p == 0 ? &gen_tile_grad_l : &gen_tile_grad_v),
+                                            "assemble_expert_gradient"),
+                    sek_params,
+                    distance);
+                trace[p] = hpx::dataflow(
+                    hpx::annotated_function(hpx::unwrapping(&compute_trace), "expert_gradient"),
+                    hpx::dataflow(hpx::annotated_function(dot_diag_gemm<double>, "expert_gradient"),
+                                  K_inv,
+                                  grad_K,
+                                  hpx::async(hpx::annotated_function(gen_tile_zeros<double>, "assemble"), N_k),
+                                  N_k_int,
+                                  N_k_int),
+                    trace[p]);
+                dot[p] = hpx::dataflow(
+                    hpx::annotated_function(hpx::unwrapping(&compute_dot), "expert_gradient"),
+                    hpx::dataflow(hpx::annotated_function(gemv<double>, "expert_gradient"),
+                                  grad_K,
+                                  alpha,
+                                  hpx::async(hpx::annotated_function(gen_tile_zeros<double>, "assemble"), N_k),
+                                  N_k_int,
+                                  N_k_int,
+                                  Blas_add,
+                                  Blas_no_trans),
+                    alpha,
+                    dot[p]);
+            }
+        }
+        losses.push_back(
+            hpx::dataflow(hpx::annotated_function(hpx::unwrapping(&add_losses), "expert_loss"), expert_losses, n_train)
+                .get());
+
+        for (std::size_t p = 0; p < sek_params.size(); p++)
+        {
+            if (trainable_params[p])
+            {
+                const bool noise = p == 2;
+                // The gradient tiles of the lengthscales contain the chain rule of the softplus constraint
+                const double factor = noise ? compute_sigmoid(to_unconstrained(sek_params.noise_variance, true)) : 1.0;
+                const double gradient = factor * compute_gradient(trace[p].get(), dot[p].get(), n_train);
+                // m_T = beta1 * m_T-1 + (1 - beta1) * g_T
+                sek_params.m_T[p] = update_first_moment(gradient, sek_params.m_T[p], adam_params.beta1);
+                // w_T = beta2 + w_T-1 + (1 - beta2) * g_T^2
+                sek_params.w_T[p] = update_second_moment(gradient, sek_params.w_T[p], adam_params.beta2);
+                const double updated_param = adam_step(to_unconstrained(sek_params.get_param(p), noise),
+                                                       adam_params,
+                                                       sek_params.m_T[p],
+                                                       sek_params.w_T[p],
+                                                       iter);
+                sek_params.set_param(p, to_constrained(updated_param, noise));
+            }
+        }
+    }
+    return losses;
+}
+
+}  // end of namespace cpu
@@ -0,0 +1,276 @@
+#include "cpu/gp_forecast.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <hpx/future.hpp>
+#include <utility>
+
+#ifdef GPRAT_ENABLE_MKL
+// MKL CBLAS
+#include "mkl_cblas.h"
+#else
+#include "cblas.h"
+#endif
+
+namespace cpu
+{
+
+namespace
+{
+
+/**
+ * @brief Number of steps after which the shifted distances are recomputed from scratch,
+ * bounding the rounding error that accumulates over the incremental updates.
+ */
+constexpr std::size_t DISTANCE_REFRESH_STEPS = 16;
+
+/**
+ * @brief Largest factor by which a shifted distance may fall below the distance it was
+ * updated from before the update is recomputed, since the subtraction of the leaving lag
+ * then cancels about log2 of this many bits.
+ */
+constexpr double MAX_DISTANCE_CANCELLATION = 1024.0;
+
+/**
+ * @brief Compute the squared distances of a window to all lagged training features.
+ */
+void compute_distances(const PointPredictionFactor &factor, const std::vector<double> &window, double *distances)
+{
+    const std::size_t N = factor.n_train;
+#pragma omp simd
+    for (std::size_t j = 0; j < N; j++)
+    {
+        distances[j] = 0.0;
+    }
+    for (std::size_t k = 0; k < factor.n_regressors; k++)
+    {
+        const double z_k = window[k];
+        const double *feature_k = factor.features.data() + k * N;
+#pragma omp simd
+        for (std::size_t j = 0; j < N; j++)
+        {
+            const double z_k_minus_z_jk = z_k - feature_k[j];
+            distances[j] += z_k_minus_z_jk * z_k_minus_z_jk;
+        }
+    }
+}
+
+/**
+ * @brief Compute the squared distances of the shifted window (z_1, ..., z_n-1, y) from the
+ * squared distances of the window (z_0, ..., z_n-1).
+ *
+ * Sample j - 1 has the features x_j-1, ..., x_j+n-2 and sample j the features x_j, ..., x_j+n-1,
+ * such that the shifted window shares all but the leaving and the entering lag with them.
+ * Subtracting the leaving lag cancels digits, negative results are clamped to zero.
+ *
+ * @return True if a distance lost too many digits and the distances should be recomputed
+ */
+bool shift_distances(const PointPredictionFactor &factor,
+                     const std::vector<double> &window,
+                     double prediction,
+                     const double *distances,
+                     double *shifted_distances)
+{
+    const std::size_t N = factor.n_train;
+    const double leaving = window.front();
+    const double *first_feature = factor.features.data();
+    const double *last_feature = factor.features.data() + (factor.n_regressors - 1) * N;
+    // Positive if a distance fell by more than the tolerated cancellation or below zero
+    double max_cancellation = 0.0;
+#pragma omp simd reduction(max : max_cancellation)
+    for (std::size_t j = 1; j < N; j++)
+    {
+        const double leaving_difference = leaving - first_feature[j - 1];
+        const double entering_difference = prediction - last_feature[j];
+        const double shifted = distances[j - 1] - leaving_difference * leaving_difference
+                               + entering_difference * entering_difference;
+        max_cancellation = std::max(max_cancellation, distances[j - 1] - MAX_DISTANCE_CANCELLATION * shifted);
+        shifted_distances[j] = std::max(shifted, 0.0);
+    }
+    // The first sample has no predecessor
+    double distance = 0.0;
+    for (std::size_t k = 0; k + 1 < factor.n_regressors; k++)
+    {
+        const double z_k_minus_z_0k = window[k + 1] - factor.features[k * N];
+        distance += z_k_minus_z_0k * z_k_minus_z_0k;
+    }
+    const double entering_difference = prediction - last_feature[0];
+    shifted_distances[0] = distance + entering_difference * entering_difference;
+    return max_cancellation > 0.0;
+}
+
+/**
+ * @brief Compute the gradient of the predictive mean with respect to the window.
+ *
+ * d hat(y) / d z_k = -1 / lengthscale^2 * sum_j alpha_j * k(z, z_j) * (z_k - z_jk)
+ */
+void compute_mean_gradient(const PointPredictionFactor &factor,
+                           const std::vector<double> &window,
+                           const double *kernel_row,
+                           double *weights,
+                           std::vector<double> &gradient)
+{
+    const std::size_t N = factor.n_train;
+    double weight_sum = 0.0;
+#pragma omp simd reduction(+ : weight_sum)
+    for (std::size_t j = 0; j < N; j++)
+    {
+        weights[j] = factor.alpha[j] * kernel_row[j];
+        weight_sum += weights[j];
+    }
+    const double scale = -1.0 / (factor.lengthscale * factor.lengthscale);
+    for (std::size_t k = 0; k < factor.n_regressors; k++)
+    {
+        const double weighted_feature =
+            cblas_ddot(static_cast<int>(N), weights, 1, factor.features.data() + k * N, 1);
+        gradient[k] = scale * (window[k] * weight_sum - weighted_feature);
+    }
+}
+
+}  // namespace
+
+std::vector<std::vector<double>> forecast_rollout(const PointPredictionFactor &factor,
+                                                  const double *window,
+                                                  std::size_t horizon,
+                                                  ForecastUncertainty uncertainty)
+{
+    const std::size_t N = factor.n_train;
+    const std::size_t n_reg = factor.n_regressors;
+    const int N_int = static_cast<int>(N);
+
+    std::vector<double> prediction_result;
+    std::vector<double> uncertainty_result;
+    prediction_result.reserve(horizon);
+    if (uncertainty != ForecastUncertainty::Off)
+    {
+        uncertainty_result.reserve(horizon);
+    }
+
+    // Rollout state, allocated once per rollout
+    std::vector<double> current_window(window, window + n_reg);
+    std::vector<double> distances(N);
+    std::vector<double> shifted_distances(N);
+    std::vector<double> kernel_row(N);
+    std::vector<double> workspace(N);
+    // Linearized propagation: covariance of the window and gradient of the mean
+    std::vector<double> window_covariance;
+    std::vector<double> gradient;
+    std::vector<double> covariance_gradient;
+    if (uncertainty == ForecastUncertainty::Linearized)
+    {
+        // The given window is exact
+        window_covariance.assign(n_reg * n_reg, 0.0);
+        gradient.resize(n_reg);
+        covariance_gradient.resize(n_reg);
+    }
+
+    compute_distances(factor, current_window, distances.data());
+    const double scale = -0.5 / (factor.lengthscale * factor.lengthscale);
+    for (std::size_t step = 0; step < horizon; step++)
+    {
+        // k(z, z_j) = vertical_lengthscale * exp(-0.5 / lengthscale^2 * (z - z_j)^2)
+#pragma omp simd
+        for (std::size_t j = 0; j < N; j++)
+        {
+            kernel_row[j] = factor.vertical_lengthscale * std::exp(scale * distances[j]);
+        }
+        // DOT: hat(y) = k(z)^T * alpha
+        const double prediction = cblas_ddot(N_int, kernel_row.data(), 1, factor.alpha.data(), 1);
+        prediction_result.push_back(prediction);
+
+        if (uncertainty != ForecastUncertainty::Off)
+        {
+            // TRSV: solve L * v = k(z), sigma^2 = k(z, z) - v^T * v
+            std::copy(kernel_row.begin(), kernel_row.end(), workspace.begin());
+            cblas_dtrsv(CblasRowMajor,
+                        CblasLower,
+                        CblasNoTrans,
+                        CblasNonUnit,
+                        N_int,
+                        factor.L.data(),
+                        N_int,
+                        workspace.data(),
+                        1);
+            double variance =
+                factor.vertical_lengthscale - cblas_ddot(N_int, workspace.data(), 1, workspace.data(), 1);
+
+            if (uncertainty == ForecastUncertainty::Linearized)
+            {
+                // First order: Var(hat(y)) += g^T * C * g and Cov(z, hat(y)) = C * g
+                compute_mean_gradient(factor, current_window, kernel_row.data(), workspace.data(), gradient);
+                cblas_dsymv(CblasRowMajor,
+                            CblasLower,
+                            static_cast<int>(n_reg),
+                            1.0,
+                            window_covariance.data(),
+                            static_cast<int>(n_reg),
+                            gradient.data(),
+                            1,
+                            0.0,
+                            covariance_gradient.data(),
+                            1);
+                variance += cblas_ddot(static_cast<int>(n_reg), gradient.data(), 1, covariance_gradient.data(), 1);
+
+                // Shift the window covariance, the prediction enters as the last lag
+                for (std::size_t a = 0; a + 1 < n_reg; a++)
+                {
+                    for (std::size_t b = 0; b <= a; b++)
+                    {
+                        window_covariance[a * n_reg + b] = window_covariance[(a + 1) * n_reg + b + 1];
+                    }
+                }
+                for (std::size_t b = 0; b + 1 < n_reg; b++)
+                {
+                    window_covariance[(n_reg - 1) * n_reg + b] = covariance_gradient[b + 1];
+                }
+                window_covariance[n_reg * n_reg - 1] = variance;
+            }
+            uncertainty_result.push_back(variance);
+        }
+
+        // Shift the prediction into the window
+        if (step + 1 < horizon)
+        {
+            const bool cancelled =
+                shift_distances(factor, current_window, prediction, distances.data(), shifted_distances.data());
+            std::swap(distances, shifted_distances);
+            std::move(current_window.begin() + 1, current_window.end(), current_window.begin());
+            current_window.back() = prediction;
+            // Recompute periodically and after severe cancellation, such that the rounding
+            // errors of the incremental updates do not accumulate over long horizons
+            if (cancelled || (step + 1) % DISTANCE_REFRESH_STEPS == 0)
+            {
+                compute_distances(factor, current_window, distances.data());
+            }
+        }
+    }
+
+    return std::vector<std::vector<double>>{ std::move(prediction_result), std::move(uncertainty_result) };
+}
+
+std::vector<std::vector<std::vector<double>>>
+forecast_rollout_scenarios(const PointPredictionFactor &factor,
+                           const std::vector<std::vector<double>> &windows,
+                           std::size_t horizon,
+                           ForecastUncertainty uncertainty)
+{
+    // One task per scenario, the rollouts only read the factor
+    std::vector<hpx::future<std::vector<std::vector<double>>>> ft_forecasts;
+    ft_forecasts.reserve(windows.size());
+    for (const auto &window : windows)
+    {
+        ft_forecasts.push_back(hpx::async(
+            [&factor, &window, horizon, uncertainty]()
+            { return forecast_rollout(factor, window.data(), horizon, uncertainty); }));
+    }
+
+    std::vector<std::vector<std::vector<double>>> forecasts;
+    forecasts.reserve(windows.size());
+    for (auto &ft_forecast : ft_forecasts)
+    {
+        forecasts.push_back(ft_forecast.get());
+    }
+    return forecasts;
+}
+
+}  // end of namespace cpu
@@ -3,8 +3,18 @@
 #include "apex_utils.hpp"
 #include "cpu/gp_algorithms.hpp"
 #include "cpu/gp_optimizer.hpp"
+#include "cpu/gp_uncertainty.hpp"
 #include "cpu/tiled_algorithms.hpp"
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <functional>
 #include <hpx/future.hpp>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
 
 using Tiled_matrix = std::vector<hpx::shared_future<std::vector<double>>>;
 using Tiled_vector = std::vector<hpx::shared_future<std::vector<double>>>;
@@ -12,6 +22,339 @@ using Tiled_vector = std::vector<hpx::shared_future<std::vector<double>>>;
 namespace cpu
 {
 
+namespace
+{
+
+/**
+ * @brief Convert the tiles of a FP64 tiled vector to FP32.
+ */
+Tiled_vector_t<float> to_fp32_tiled(const Tiled_vector &ft_vector)
+{
+    Tiled_vector_t<float> ft_result;
+    ft_result.reserve(ft_vector.size());
+    for (const auto &ft_tile : ft_vector)
+    {
+        ft_result.push_back(hpx::dataflow(hpx::unwrapping([](const std::vector<double> &tile)
+                                                          { return std::vector<float>(tile.begin(), tile.end()); }),
+                                          ft_tile));
+    }
+    return ft_result;
+}
+
+/**
+ * @brief Add a FP32 tiled correction to a FP64 tiled vector: x = x + d.
+ */
+void add_correction_tiled(Tiled_vector &ft_x, const Tiled_vector_t<float> &ft_correction)
+{
+    for (std::size_t i = 0; i < ft_x.size(); i++)
+    {
+        ft_x[i] = hpx::dataflow(hpx::unwrapping(
+                                    [](std::vector<double> x, const std::vector<float> &d)
+                                    {
+                                        std::transform(x.begin(), x.end(), d.begin(), x.begin(), std::plus<>());
+                                        return x;
+                                    }),
+                                ft_x[i],
+                                ft_correction[i]);
+    }
+}
+
+/**
+ * @brief Synchronize a tiled vector and return its infinity norm, NaN if an entry is NaN.
+ */
+double max_norm_tiled(const Tiled_vector &ft_vector)
+{
+    double norm = 0.0;
+    for (const auto &ft_tile : ft_vector)
+    {
+        for (double value : ft_tile.get())
+        {
+            if (std::isnan(value))
+            {
+                return value;
+            }
+            norm = std::max(norm, std::abs(value));
+        }
+    }
+    return norm;
+}
+
+/**
+ * @brief Return the normwise backward error ||r|| / (||K|| * ||alpha||).
+ *
+ * A zero residual is exact, a nonzero residual of a zero solution is infinite,
+ * and NaN norms of a failed FP32 factorization give NaN.
+ */
+double backward_error(double residual_norm, double solution_norm)
+{
+    if (std::isnan(residual_norm) || std::isnan(solution_norm))
+    {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    if (!(residual_norm > 0.0))
+    {
+        return 0.0;
+    }
+    return solution_norm > 0.0 ? residual_norm / solution_norm : std::numeric_limits<double>::infinity();
+}
+
+/**
+ * @brief Launch the prediction and, with V, the uncertainty of test tile c.
+ *
+ * With uncertainty, the solution tiles hold beta = L^-1 * y and the results are
+ * hat(y)_c = V_c^T * beta and diag(Sigma)_c = diag(prior(K)_c) - diag(V_c^T * V_c)
+ * with L * V_c = cross(K)_c^T. Without uncertainty, they hold alpha = K^-1 * y and
+ * the result is hat(y)_c = cross(K)_c * alpha. The tiles of the block are released
+ * once both results are ready.
+ *
+ * @return The futures of the prediction tile and of the uncertainty tile, the latter
+ *         is empty without uncertainty.
+ */
+template <typename T>
+std::pair<hpx::shared_future<std::vector<T>>, hpx::shared_future<std::vector<T>>>
+predict_test_tile(Tiled_matrix_t<T> &K_tiles,
+                  Tiled_vector_t<T> &solution_tiles,
+                  bool with_uncertainty,
+                  const std::vector<double> &training_input,
+                  const std::vector<double> &test_input,
+                  const gprat_hyper::SEKParams &sek_params,
+                  std::size_t c,
+                  std::size_t n_tiles,
+                  int n_tile_size,
+                  int m_tile_size,
+                  std::size_t n_train,
+                  std::size_t n_test,
+                  int n_regressors)
+{
+    const std::size_t block_size = compute_tile_size(c, static_cast<std::size_t>(m_tile_size), n_test);
+    const int M = static_cast<int>(block_size);
+
+    // The kernel is symmetric, such that cross(K)_c^T is assembled without transposition
+    Tiled_matrix_t<T> block_tiles;  // Tiled transposed cross-covariance block K_NxM_c
+    block_tiles.reserve(n_tiles);
+    for (std::size_t j = 0; j < n_tiles; j++)
+    {
+        block_tiles.push_back(hpx::async(hpx::annotated_function(gen_tile_cross_covariance<T>, "assemble_pred"),
+                                         j,
+                                         c,
+                                         n_tile_size,
+                                         m_tile_size,
+                                         n_train,
+                                         n_test,
+                                         n_regressors,
+                                         sek_params,
+                                         training_input,
+                                         test_input));
+    }
+    Tiled_vector_t<T> prediction_block{ hpx::async(
+        hpx::annotated_function(gen_tile_zeros<T>, "assemble_tiled"), block_size) };
+
+    if (!with_uncertainty)
+    {
+        // hat(y)_c = (cross(K)_c^T)^T * alpha
+        transpose_matrix_vector_tiled(
+            block_tiles, solution_tiles, prediction_block, n_tile_size, M, n_tiles, 1, n_train, block_size);
+        return { prediction_block[0], hpx::make_ready_future(std::vector<T>{}) };
+    }
+
+    Tiled_vector_t<T> uncertainty_block{ hpx::async(
+        hpx::annotated_function(gen_tile_zeros<T>, "assemble_tiled"), block_size) };
+    Tiled_vector_t<T> prior_K_block{ hpx::async(hpx::annotated_function(gen_tile_prior_covariance<T>, "assemble_tiled"),
+                                                c,
+                                                c,
+                                                m_tile_size,
+                                                n_test,
+                                                n_regressors,
+                                                sek_params,
+                                                test_input) };
+
+    // L * V_c = cross(K)_c^T
+    forward_solve_tiled_matrix(K_tiles, block_tiles, n_tile_size, M, n_tiles, 1, n_train, block_size);
+    // hat(y)_c = V_c^T * beta
+    transpose_matrix_vector_tiled(
+        block_tiles, solution_tiles, prediction_block, n_tile_size, M, n_tiles, 1, n_train, block_size);
+    // diag(Sigma)_c = diag(prior(K)_c) - diag(V_c^T * V_c)
+    symmetric_matrix_matrix_diagonal_tiled(
+        block_tiles, uncertainty_block, n_tile_size, M, n_tiles, 1, n_train, block_size);
+    vector_difference_tiled(prior_K_block, uncertainty_block, M, 1, block_size);
+
+    return { prediction_block[0], uncertainty_block[0] };
+}
+
+/**
+ * @brief Launch the prediction hat(y) and the lower triangular part of the posterior covariance
+ * Sigma = prior(K) - cross(K)^T * K^-1 * cross(K), see predict_with_full_cov.
+ *
+ * @param prediction_tiles Tiled prediction output, filled with m_tiles tiles
+ * @param prior_K_tiles Tiled posterior covariance output, resized to m_tiles x m_tiles tiles of
+ *        which only the lower triangular tiles are assigned
+ */
+template <typename T, typename S>
+void launch_posterior_tiled(const std::vector<double> &training_input,
+                            const std::vector<double> &training_output,
+                            const std::vector<double> &test_input,
+                            const gprat_hyper::SEKParams &sek_params,
+                            int n_tiles,
+                            int n_tile_size,
+                            int m_tiles,
+                            int m_tile_size,
+                            int n_regressors,
+                            std::size_t n_train,
+                            std::size_t n_test,
+                            Tiled_vector_t<T> &prediction_tiles,
+                            Tiled_matrix_t<T> &prior_K_tiles)
+{
+    GPRAT_START_STEP(assembly_timer);
+
+    // Tiled future data structures for prediction
+    Tiled_matrix_t<T> K_tiles;     // Tiled covariance matrix K_NxN
+    Tiled_vector_t<T> beta_tiles;  // Tiled intermediate solution
+    // Tiled future data structures for uncertainty
+    Tiled_matrix_t<S> t_cross_covariance_tiles;  // Tiled transposed cross_covariance matrix K_MxN
+
+    // Preallocate memory
+    K_tiles.resize(static_cast<std::size_t>(n_tiles * n_tiles));  // No reserve because of triangular structure
+    prediction_tiles.reserve(static_cast<std::size_t>(m_tiles));
+    beta_tiles.reserve(static_cast<std::size_t>(n_tiles));
+
+    t_cross_covariance_tiles.reserve(static_cast<std::size_t>(n_tiles) * static_cast<std::size_t>(m_tiles));
+    prior_K_tiles.resize(static_cast<std::size_t>(m_tiles * m_tiles));  // No reserve because of triangular structure
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Launch asynchronous assembly
+    for (std::size_t i = 0; i < static_cast<std::size_t>(n_tiles); i++)
+    {
+        for (std::size_t j = 0; j <= i; j++)
+        {
+            K_tiles[i * static_cast<std::size_t>(n_tiles) + j] = hpx::async(
+                hpx::annotated_function(gen_tile_covariance<T>, "assemble_tiled_K"),
+                i,
+                j,
+                n_tile_size,
+                n_train,
+                n_regressors,
+                sek_params,
+                training_input);
+        }
+    }
+
+    for (std::size_t i = 0; i < static_cast<std::size_t>(n_tiles); i++)
+    {
+        beta_tiles.push_back(hpx::async(hpx::annotated_function(gen_tile_output<T>, "assemble_tiled_alpha"),
+                                        i,
+                                        n_tile_size,
+                                        n_train,
+                                        training_output));
+    }
+
+    for (std::size_t i = 0; i < static_cast<std::size_t>(m_tiles); i++)
+    {
+        prediction_tiles.push_back(hpx::async(hpx::annotated_function(gen_tile_zeros<T>, "assemble_tiled"),
+                                              compute_tile_size(i, static_cast<std::size_t>(m_tile_size), n_test)));
+    }
+
+    // Assemble lower triangular part of the prior covariance matrix, Sigma is symmetric
+    for (std::size_t i = 0; i < static_cast<std::size_t>(m_tiles); i++)
+    {
+        for (std::size_t j = 0; j <= i; j++)
+        {
+            prior_K_tiles[i * static_cast<std::size_t>(m_tiles) + j] = hpx::async(
+                hpx::annotated_function(gen_tile_full_prior_covariance<T>, "assemble_prior_tiled"),
+                i,
+                j,
+                m_tile_size,
+                n_test,
+                n_regressors,
+                sek_params,
+                test_input);
+        }
+    }
+
+    // The kernel is symmetric, such that cross(K)^T is assembled without transposition
+    for (std::size_t j = 0; j < static_cast<std::size_t>(n_tiles); j++)
+    {
+        for (std::size_t i = 0; i < static_cast<std::size_t>(m_tiles); i++)
+        {
+            t_cross_covariance_tiles.push_back(hpx::async(
+                hpx::annotated_function(gen_tile_cross_covariance<S>, "assemble_pred"),
+                j,
+                i,
+                n_tile_size,
+                m_tile_size,
+                n_train,
+                n_test,
+                n_regressors,
+                sek_params,
+                training_input,
+                test_input));
+        }
+    }
+
+    GPRAT_END_STEP(
+        assembly_timer,
+        "predict_full_cov_step assembly",
+        K_tiles,
+        beta_tiles,
+        prediction_tiles,
+        prior_K_tiles,
+        t_cross_covariance_tiles);
+    GPRAT_START_STEP(cholesky_timer);
+
+    // Prediction
+    ///////////////////////////////////////////////////////////////////////////
+    // Launch asynchronous Cholesky decomposition: K = L * L^T
+    right_looking_cholesky_tiled(K_tiles, n_tile_size, static_cast<std::size_t>(n_tiles), n_train);
+
+    GPRAT_END_STEP(cholesky_timer, "predict_full_cov_step cholesky", K_tiles);
+    GPRAT_START_STEP(forward_timer);
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Launch asynchronous triangular solve L * [beta | V] = [y | cross(K)^T]
+    forward_solve_tiled_multi_rhs(
+        K_tiles,
+        beta_tiles,
+        t_cross_covariance_tiles,
+        n_tile_size,
+        static_cast<std::size_t>(n_tiles),
+        static_cast<std::size_t>(m_tiles),
+        n_train);
+
+    GPRAT_END_STEP(forward_timer, "predict_full_cov_step forward", beta_tiles, t_cross_covariance_tiles);
+    GPRAT_START_STEP(prediction_timer);
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Launch asynchronous prediction computation: hat(y) = V^T * beta
+    transpose_matrix_vector_tiled(
+        t_cross_covariance_tiles,
+        beta_tiles,
+        prediction_tiles,
+        n_tile_size,
+        m_tile_size,
+        static_cast<std::size_t>(n_tiles),
+        static_cast<std::size_t>(m_tiles),
+        n_train,
+        n_test);
+
+    GPRAT_END_STEP(prediction_timer, "predict_full_cov_step prediction", prediction_tiles);
+    GPRAT_START_STEP(full_cov_timer);
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Launch asynchronous computation of full covariance Sigma = prior(K) - V^T * V
+    symmetric_matrix_matrix_tiled(
+        t_cross_covariance_tiles,
+        prior_K_tiles,
+        n_tile_size,
+        m_tile_size,
+        static_cast<std::size_t>(n_tiles),
+        static_cast<std::size_t>(m_tiles),
+        n_train,
+        n_test);
+
+    GPRAT_END_STEP(full_cov_timer, "predict_full_cov_step full cov", prior_K_tiles);
+}
+
+}  // namespace
+
 ///////////////////////////////////////////////////////////////////////////
 // PREDICT
 std::vector<std::vector<double>>
@@ -21,6 +364,12 @@ cholesky(const std::vector<double> &training_input,
          int n_tile_size,
          int n_regressors)
 {
+    // Number of training samples, the last tile may be smaller
+    const std::size_t n_train = compute_n_samples(static_cast<std::size_t>(n_tiles),
+                                                  static_cast<std::size_t>(n_tile_size),
+                                                  training_input.size(),
+                                                  static_cast<std::size_t>(n_regressors));
+
     std::vector<std::vector<double>> result;
 
 #if GPRAT_APEX_CHOLESKY
@@ -42,10 +391,11 @@ cholesky(const std::vector<double> &training_input,
         for (std::size_t j = 0; j <= i; j++)
         {
             K_tiles[i * static_cast<std::size_t>(n_tiles) + j] = hpx::async(
-                hpx::annotated_function(gen_tile_covariance, "assemble_tiled_K"),
+                hpx::annotated_function(gen_tile_covariance<double>, "assemble_tiled_K"),
                 i,
                 j,
                 n_tile_size,
+                n_train,
                 n_regressors,
                 sek_params,
                 training_input);
@@ -57,7 +407,7 @@ cholesky(const std::vector<double> &training_input,
 
     ///////////////////////////////////////////////////////////////////////////
     // Launch asynchronous Cholesky decomposition: K = L * L^T
-    right_looking_cholesky_tiled(K_tiles, n_tile_size, static_cast<std::size_t>(n_tiles));
+    right_looking_cholesky_tiled(K_tiles, n_tile_size, static_cast<std::size_t>(n_tiles), n_train);
 
     GPRAT_END_STEP(cholesky_timer, "cholesky_step cholesky", K_tiles);
 #if GPRAT_APEX_CHOLESKY
@@ -77,7 +427,8 @@ cholesky(const std::vector<double> &training_input,
     return result;
 }
 
-std::vector<double>
+template <typename T>
+std::vector<T>
 predict(const std::vector<double> &training_input,
         const std::vector<double> &training_output,
         const std::vector<double> &test_input,
@@ -104,14 +455,25 @@ predict(const std::vector<double> &training_input,
      *    - compute hat(y) = cross(K) * alpha
      */
 
+    // Number of training samples, the last tile may be smaller
+    const std::size_t n_train = compute_n_samples(static_cast<std::size_t>(n_tiles),
+                                                  static_cast<std::size_t>(n_tile_size),
+                                                  training_input.size(),
+                                                  static_cast<std::size_t>(n_regressors));
+    // Number of test samples, the last tile may be smaller
+    const std::size_t n_test = compute_n_samples(static_cast<std::size_t>(m_tiles),
+                                                 static_cast<std::size_t>(m_tile_size),
+                                                 test_input.size(),
+                                                 static_cast<std::size_t>(n_regressors));
+
     GPRAT_START_STEP(assembly_timer);
 
-    std::vector<double> prediction_result;
+    std::vector<T> prediction_result;
     // Tiled future data structures
-    Tiled_matrix K_tiles;                 // Tiled covariance matrix
-    Tiled_matrix cross_covariance_tiles;  // Tiled cross_covariance matrix
-    Tiled_vector prediction_tiles;        // Tiled solution
-    Tiled_vector alpha_tiles;             // Tiled intermediate solution
+    Tiled_matrix_t<T> K_tiles;                 // Tiled covariance matrix
+    Tiled_matrix_t<T> cross_covariance_tiles;  // Tiled cross_covariance matrix
+    Tiled_vector_t<T> prediction_tiles;        // Tiled solution
+    Tiled_vector_t<T> alpha_tiles;             // Tiled intermediate solution
 
     // Preallocate memory
     prediction_result.reserve(test_input.size());
@@ -128,10 +490,11 @@ predict(const std::vector<double> &training_input,
         for (std::size_t j = 0; j <= i; j++)
         {
             K_tiles[i * static_cast<std::size_t>(n_tiles) + j] = hpx::async(
-                hpx::annotated_function(gen_tile_covariance, "assemble_tiled_K"),
+                hpx::annotated_function(gen_tile_covariance<T>, "assemble_tiled_K"),
                 i,
                 j,
                 n_tile_size,
+                n_train,
                 n_regressors,
                 sek_params,
                 training_input);
@@ -140,8 +503,11 @@ predict(const std::vector<double> &training_input,
 
     for (std::size_t i = 0; i < static_cast<std::size_t>(n_tiles); i++)
     {
-        alpha_tiles.push_back(hpx::async(
-            hpx::annotated_function(gen_tile_output, "assemble_tiled_alpha"), i, n_tile_size, training_output));
+        alpha_tiles.push_back(hpx::async(hpx::annotated_function(gen_tile_output<T>, "assemble_tiled_alpha"),
+                                         i,
+                                         n_tile_size,
+                                         n_train,
+                                         training_output));
     }
 
     for (std::size_t i = 0; i < static_cast<std::size_t>(m_tiles); i++)
@@ -149,11 +515,13 @@ predict(const std::vector<double> &training_input,
         for (std::size_t j = 0; j < static_cast<std::size_t>(n_tiles); j++)
         {
             cross_covariance_tiles.push_back(hpx::async(
-                hpx::annotated_function(gen_tile_cross_covariance, "assemble_pred"),
+                hpx::annotated_function(gen_tile_cross_covariance<T>, "assemble_pred"),
                 i,
                 j,
                 m_tile_size,
                 n_tile_size,
+                n_test,
+                n_train,
                 n_regressors,
                 sek_params,
                 test_input,
@@ -163,7 +531,8 @@ predict(const std::vector<double> &training_input,
 
     for (std::size_t i = 0; i < static_cast<std::size_t>(m_tiles); i++)
     {
-        prediction_tiles.push_back(hpx::async(hpx::annotated_function(gen_tile_zeros, "assemble_tiled"), m_tile_size));
+        prediction_tiles.push_back(hpx::async(hpx::annotated_function(gen_tile_zeros<T>, "assemble_tiled"),
+                                              compute_tile_size(i, static_cast<std::size_t>(m_tile_size), n_test)));
     }
 
     GPRAT_END_STEP(
@@ -172,7 +541,7 @@ predict(const std::vector<double> &training_input,
 
     ///////////////////////////////////////////////////////////////////////////
     // Launch asynchronous Cholesky decomposition: K = L * L^T
-    right_looking_cholesky_tiled(K_tiles, n_tile_size, static_cast<std::size_t>(n_tiles));
+    right_looking_cholesky_tiled(K_tiles, n_tile_size, static_cast<std::size_t>(n_tiles), n_train);
 
     GPRAT_END_STEP(cholesky_timer, "predict_step cholesky", K_tiles);
     GPRAT_START_STEP(forward_timer);
@@ -180,13 +549,13 @@ predict(const std::vector<double> &training_input,
     ///////////////////////////////////////////////////////////////////////////
     // Launch asynchronous triangular solve  L * (L^T * alpha) = y
     // First, forward solve L * beta = y
-    forward_solve_tiled(K_tiles, alpha_tiles, n_tile_size, static_cast<std::size_t>(n_tiles));
+    forward_solve_tiled(K_tiles, alpha_tiles, n_tile_size, static_cast<std::size_t>(n_tiles), n_train);
 
     GPRAT_END_STEP(forward_timer, "predict_step forward", alpha_tiles);
     GPRAT_START_STEP(backward_timer);
 
     // Second, backward solve L^T * alpha = beta
-    backward_solve_tiled(K_tiles, alpha_tiles, n_tile_size, static_cast<std::size_t>(n_tiles));
+    backward_solve_tiled(K_tiles, alpha_tiles, n_tile_size, static_cast<std::size_t>(n_tiles), n_train);
 
     GPRAT_END_STEP(backward_timer, "predict_step backward", alpha_tiles);
     GPRAT_START_STEP(prediction_timer);
@@ -200,7 +569,9 @@ predict(const std::vector<double> &training_input,
         m_tile_size,
         n_tile_size,
         static_cast<std::size_t>(n_tiles),
-        static_cast<std::size_t>(m_tiles));
+        static_cast<std::size_t>(m_tiles),
+        n_test,
+        n_train);
 
     ///////////////////////////////////////////////////////////////////////////
     // Synchronize prediction
@@ -215,7 +586,228 @@ predict(const std::vector<double> &training_input,
     return prediction_result;
 }
 
-std::vector<std::vector<double>> predict_with_uncertainty(
+std::vector<double> predict_mixed(const std::vector<double> &training_input,
+                                  const std::vector<double> &training_output,
+                                  const std::vector<double> &test_input,
+                                  const gprat_hyper::SEKParams &sek_params,
+                                  int n_tiles,
+                                  int n_tile_size,
+                                  int m_tiles,
+                                  int m_tile_size,
+                                  int n_regressors,
+                                  RefinementReport &report)
+{
+    /*
+     * Prediction: hat(y)_M = cross(K)_MxN * K^-1_NxN * y_N
+     *
+     * Algorithm:
+     * 1: Compute lower triangular part of covariance matrix K in FP32
+     * 2: Compute FP32 Cholesky factor L of K
+     * 3: Refine alpha = K^-1 * y in FP64, starting from alpha = 0:
+     *    - FP32 correction L * L^T * d = r
+     *    - alpha = alpha + d
+     *    - FP64 residual r = y - K * alpha with on the fly FP64 tiles of K
+     *    until the backward error reaches FP64 accuracy
+     * 4: Fall back to the FP64 prediction if the refinement stalls
+     * 5: Compute hat(y) = cross(K) * alpha in FP64
+     */
+
+    // Number of training samples, the last tile may be smaller
+    const std::size_t n_train = compute_n_samples(static_cast<std::size_t>(n_tiles),
+                                                  static_cast<std::size_t>(n_tile_size),
+                                                  training_input.size(),
+                                                  static_cast<std::size_t>(n_regressors));
+    // Number of test samples, the last tile may be smaller
+    const std::size_t n_test = compute_n_samples(static_cast<std::size_t>(m_tiles),
+                                                 static_cast<std::size_t>(m_tile_size),
+                                                 test_input.size(),
+                                                 static_cast<std::size_t>(n_regressors));
+
+    GPRAT_START_STEP(assembly_timer);
+
+    // Tiled future data structures
+    Tiled_matrix_t<float> K_tiles;        // Tiled FP32 covariance matrix
+    Tiled_vector y_tiles;                 // Tiled training output
+    Tiled_vector ones_tiles;              // Tiled vector of ones
+    Tiled_vector row_sum_tiles;           // Tiled negative row sums of K
+    Tiled_vector alpha_tiles;             // Tiled refined solution
+    Tiled_vector residual_tiles;          // Tiled FP64 residual
+    Tiled_matrix cross_covariance_tiles;  // Tiled cross_covariance matrix
+    Tiled_vector prediction_tiles;        // Tiled solution
+
+    // Preallocate memory
+    K_tiles.resize(static_cast<std::size_t>(n_tiles * n_tiles));  // No reserve because of triangular structure
+    y_tiles.reserve(static_cast<std::size_t>(n_tiles));
+    ones_tiles.reserve(static_cast<std::size_t>(n_tiles));
+    row_sum_tiles.reserve(static_cast<std::size_t>(n_tiles));
+    alpha_tiles.reserve(static_cast<std::size_t>(n_tiles));
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Launch asynchronous assembly
+    for (std::size_t i = 0; i < static_cast<std::size_t>(n_tiles); i++)
+    {
+        for (std::size_t j = 0; j <= i; j++)
+        {
+            K_tiles[i * static_cast<std::size_t>(n_tiles) + j] = hpx::async(
+                hpx::annotated_function(gen_tile_covariance<float>, "assemble_tiled_K"),
+                i,
+                j,
+                n_tile_size,
+                n_train,
+                n_regressors,
+                sek_params,
+                training_input);
+        }
+    }
+
+    for (std::size_t i = 0; i < static_cast<std::size_t>(n_tiles); i++)
+    {
+        const std::size_t tile_size = compute_tile_size(i, static_cast<std::size_t>(n_tile_size), n_train);
+        y_tiles.push_back(hpx::async(hpx::annotated_function(gen_tile_output<double>, "assemble_tiled_y"),
+                                     i,
+                                     n_tile_size,
+                                     n_train,
+                                     training_output));
+        ones_tiles.push_back(hpx::make_ready_future(std::vector<double>(tile_size, 1.0)));
+        row_sum_tiles.push_back(hpx::make_ready_future(gen_tile_zeros<double>(tile_size)));
+        alpha_tiles.push_back(hpx::make_ready_future(gen_tile_zeros<double>(tile_size)));
+    }
+
+    GPRAT_END_STEP(assembly_timer, "predict_mixed_step assembly", K_tiles, y_tiles);
+    GPRAT_START_STEP(cholesky_timer);
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Launch asynchronous FP32 Cholesky decomposition: K = L * L^T
+    right_looking_cholesky_tiled(K_tiles, n_tile_size, static_cast<std::size_t>(n_tiles), n_train);
+
+    // Infinity norm of K, the entries of the squared exponential kernel are
+    // positive such that -K * 1 yields the negative absolute row sums
+    covariance_residual_tiled(training_input,
+                              sek_params,
+                              ones_tiles,
+                              row_sum_tiles,
+                              n_tile_size,
+                              static_cast<std::size_t>(n_tiles),
+                              n_train,
+                              static_cast<std::size_t>(n_regressors));
+    const double K_norm = max_norm_tiled(row_sum_tiles);
+
+    GPRAT_END_STEP(cholesky_timer, "predict_mixed_step cholesky", K_tiles);
+    GPRAT_START_STEP(refinement_timer);
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Iterative refinement starting from alpha = 0 with residual r = y
+    residual_tiles = y_tiles;
+
+    // Backward error attainable in FP64
+    const double tolerance = std::sqrt(static_cast<double>(n_train)) * std::numeric_limits<double>::epsilon();
+    double previous_error = std::numeric_limits<double>::infinity();
+    report = RefinementReport{};
+    while (report.iterations < MAX_REFINEMENT_ITERATIONS)
+    {
+        // FP32 correction: L * L^T * d = r
+        Tiled_vector_t<float> correction_tiles = to_fp32_tiled(residual_tiles);
+        forward_solve_tiled(K_tiles, correction_tiles, n_tile_size, static_cast<std::size_t>(n_tiles), n_train);
+        backward_solve_tiled(K_tiles, correction_tiles, n_tile_size, static_cast<std::size_t>(n_tiles), n_train);
+        add_correction_tiled(alpha_tiles, correction_tiles);
+
+        // FP64 residual: r = y - K * alpha
+        residual_tiles = y_tiles;
+        covariance_residual_tiled(training_input,
+                                  sek_params,
+                                  alpha_tiles,
+                                  residual_tiles,
+                                  n_tile_size,
+                                  static_cast<std::size_t>(n_tiles),
+                                  n_train,
+                                  static_cast<std::size_t>(n_regressors));
+        report.iterations++;
+
+        report.backward_error = backward_error(max_norm_tiled(residual_tiles), K_norm * max_norm_tiled(alpha_tiles));
+        if (report.backward_error <= tolerance)
+        {
+            report.converged = true;
+            break;
+        }
+        // Stalled if the error does not halve, NaN if the FP32 factorization failed
+        if (!(report.backward_error < 0.5 * previous_error))
+        {
+            break;
+        }
+        previous_error = report.backward_error;
+    }
+
+    GPRAT_END_STEP(refinement_timer, "predict_mixed_step refinement", alpha_tiles);
+
+    if (!report.converged)
+    {
+        report.fallback = true;
+        return predict<double>(training_input,
+                               training_output,
+                               test_input,
+                               sek_params,
+                               n_tiles,
+                               n_tile_size,
+                               m_tiles,
+                               m_tile_size,
+                               n_regressors);
+    }
+
+    GPRAT_START_STEP(prediction_timer);
+
+    cross_covariance_tiles.reserve(static_cast<std::size_t>(m_tiles) * static_cast<std::size_t>(n_tiles));
+    prediction_tiles.reserve(static_cast<std::size_t>(m_tiles));
+    for (std::size_t i = 0; i < static_cast<std::size_t>(m_tiles); i++)
+    {
+        for (std::size_t j = 0; j < static_cast<std::size_t>(n_tiles); j++)
+        {
+            cross_covariance_tiles.push_back(hpx::async(
+                hpx::annotated_function(gen_tile_cross_covariance<double>, "assemble_pred"),
+                i,
+                j,
+                m_tile_size,
+                n_tile_size,
+                n_test,
+                n_train,
+                n_regressors,
+                sek_params,
+                test_input,
+                training_input));
+        }
+        prediction_tiles.push_back(hpx::async(hpx::annotated_function(gen_tile_zeros<double>, "assemble_tiled"),
+                                              compute_tile_size(i, static_cast<std::size_t>(m_tile_size), n_test)));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Launch asynchronous prediction computation solve: \hat{y} = K_cross_cov * alpha
+    matrix_vector_tiled(
+        cross_covariance_tiles,
+        alpha_tiles,
+        prediction_tiles,
+        m_tile_size,
+        n_tile_size,
+        static_cast<std::size_t>(n_tiles),
+        static_cast<std::size_t>(m_tiles),
+        n_test,
+        n_train);
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Synchronize prediction
+    std::vector<double> prediction_result;
+    prediction_result.reserve(n_test);
+    for (std::size_t i = 0; i < static_cast<std::size_t>(m_tiles); i++)
+    {
+        auto tile = prediction_tiles[i].get();
+        std::copy(tile.begin(), tile.end(), std::back_inserter(prediction_result));
+    }
+
+    GPRAT_END_STEP(prediction_timer, "predict_mixed_step prediction");
+
+    return prediction_result;
+}
+
+template <typename T, typename S>
+std::vector<std::vector<T>> predict_with_uncertainty(
     const std::vector<double> &training_input,
     const std::vector<double> &training_output,
     const std::vector<double> &test_input,
@@ -239,38 +831,46 @@ std::vector<std::vector<double>> predict_with_uncertainty(
      * Algorithm:
      * 1: Compute lower triangular part of covariance matrix K
      * 2: Compute Cholesky factor L of K
-     * 3: Compute prediction hat(y):
-     *    - triangular solve L * beta = y
-     *    - triangular solve L^T * alpha = beta
-     *    - compute hat(y) = cross(K) * alpha
-     * 4: Compute uncertainty diag(Sigma):
-     *    - triangular solve L * V = cross(K)^T
+     * 3: Compute intermediate solutions in a single sweep over L:
+     *    - triangular solve L * [beta | V] = [y | cross(K)^T]
+     * 4: Compute prediction hat(y):
+     *    - compute hat(y) = V^T * beta = cross(K) * K^-1 * y
+     * 5: Compute uncertainty diag(Sigma):
      *    - compute diag(W) = diag(V^T * V)
      *    - compute diag(Sigma) = diag(prior(K)) - diag(W)
      */
 
+    // Number of training samples, the last tile may be smaller
+    const std::size_t n_train = compute_n_samples(static_cast<std::size_t>(n_tiles),
+                                                  static_cast<std::size_t>(n_tile_size),
+                                                  training_input.size(),
+                                                  static_cast<std::size_t>(n_regressors));
+    // Number of test samples, the last tile may be smaller
+    const std::size_t n_test = compute_n_samples(static_cast<std::size_t>(m_tiles),
+                                                 static_cast<std::size_t>(m_tile_size),
+                                                 test_input.size(),
+                                                 static_cast<std::size_t>(n_regressors));
+
     GPRAT_START_STEP(assembly_timer);
 
-    std::vector<double> prediction_result;
-    std::vector<double> uncertainty_result;
+    std::vector<T> prediction_result;
+    std::vector<T> uncertainty_result;
     // Tiled future data structures for prediction
-    Tiled_matrix K_tiles;                 // Tiled covariance matrix K_NxN
-    Tiled_matrix cross_covariance_tiles;  // Tiled cross_covariance matrix K_NxM
-    Tiled_vector prediction_tiles;        // Tiled solution
-    Tiled_vector alpha_tiles;             // Tiled intermediate solution
+    Tiled_matrix_t<T> K_tiles;           // Tiled covariance matrix K_NxN
+    Tiled_vector_t<T> prediction_tiles;  // Tiled solution
+    Tiled_vector_t<T> beta_tiles;        // Tiled intermediate solution
     // Tiled future data structures for uncertainty
-    Tiled_matrix t_cross_covariance_tiles;  // Tiled transposed cross_covariance matrix K_MxN
-    Tiled_vector prior_K_tiles;             // Tiled prior covariance matrix diagonal diag(K_MxM)
-    Tiled_vector uncertainty_tiles;         // Tiled uncertainty solution
+    Tiled_matrix_t<S> t_cross_covariance_tiles;  // Tiled transposed cross_covariance matrix K_MxN
+    Tiled_vector_t<T> prior_K_tiles;             // Tiled prior covariance matrix diagonal diag(K_MxM)
+    Tiled_vector_t<T> uncertainty_tiles;         // Tiled uncertainty solution
 
     // Preallocate memory
     prediction_result.reserve(test_input.size());
     uncertainty_result.reserve(test_input.size());
 
     K_tiles.resize(static_cast<std::size_t>(n_tiles * n_tiles));  // No reserve because of triangular structure
-    cross_covariance_tiles.reserve(static_cast<std::size_t>(m_tiles) * static_cast<std::size_t>(n_tiles));
     prediction_tiles.reserve(static_cast<std::size_t>(m_tiles));
-    alpha_tiles.reserve(static_cast<std::size_t>(n_tiles));
+    beta_tiles.reserve(static_cast<std::size_t>(n_tiles));
 
     t_cross_covariance_tiles.reserve(static_cast<std::size_t>(n_tiles) * static_cast<std::size_t>(m_tiles));
     prior_K_tiles.reserve(static_cast<std::size_t>(m_tiles));
@@ -283,10 +883,11 @@ std::vector<std::vector<double>> predict_with_uncertainty(
         for (std::size_t j = 0; j <= i; j++)
         {
             K_tiles[i * static_cast<std::size_t>(n_tiles) + j] = hpx::async(
-                hpx::annotated_function(gen_tile_covariance, "assemble_tiled_K"),
+                hpx::annotated_function(gen_tile_covariance<T>, "assemble_tiled_K"),
                 i,
                 j,
                 n_tile_size,
+                n_train,
                 n_regressors,
                 sek_params,
                 training_input);
@@ -295,121 +896,105 @@ std::vector<std::vector<double>> predict_with_uncertainty(
 
     for (std::size_t i = 0; i < static_cast<std::size_t>(n_tiles); i++)
     {
-        alpha_tiles.push_back(hpx::async(
-            hpx::annotated_function(gen_tile_output, "assemble_tiled_alpha"), i, n_tile_size, training_output));
+        beta_tiles.push_back(hpx::async(hpx::annotated_function(gen_tile_output<T>, "assemble_tiled_alpha"),
+                                        i,
+                                        n_tile_size,
+                                        n_train,
+                                        training_output));
     }
 
     for (std::size_t i = 0; i < static_cast<std::size_t>(m_tiles); i++)
     {
-        for (std::size_t j = 0; j < static_cast<std::size_t>(n_tiles); j++)
-        {
-            cross_covariance_tiles.push_back(hpx::async(
-                hpx::annotated_function(gen_tile_cross_covariance, "assemble_pred"),
-                i,
-                j,
-                m_tile_size,
-                n_tile_size,
-                n_regressors,
-                sek_params,
-                test_input,
-                training_input));
-        }
-    }
-
-    for (std::size_t i = 0; i < static_cast<std::size_t>(m_tiles); i++)
-    {
-        prediction_tiles.push_back(hpx::async(hpx::annotated_function(gen_tile_zeros, "assemble_tiled"), m_tile_size));
+        prediction_tiles.push_back(hpx::async(hpx::annotated_function(gen_tile_zeros<T>, "assemble_tiled"),
+                                              compute_tile_size(i, static_cast<std::size_t>(m_tile_size), n_test)));
     }
 
     for (std::size_t i = 0; i < static_cast<std::size_t>(m_tiles); i++)
     {
         prior_K_tiles.push_back(hpx::async(
-            hpx::annotated_function(gen_tile_prior_covariance, "assemble_tiled"),
+            hpx::annotated_function(gen_tile_prior_covariance<T>, "assemble_tiled"),
             i,
             i,
             m_tile_size,
+            n_test,
             n_regressors,
             sek_params,
             test_input));
     }
 
+    // The kernel is symmetric, such that cross(K)^T is assembled without transposition
     for (std::size_t j = 0; j < static_cast<std::size_t>(n_tiles); j++)
     {
         for (std::size_t i = 0; i < static_cast<std::size_t>(m_tiles); i++)
         {
-            t_cross_covariance_tiles.push_back(hpx::dataflow(
-                hpx::annotated_function(hpx::unwrapping(&gen_tile_transpose), "assemble_pred"),
-                m_tile_size,
+            t_cross_covariance_tiles.push_back(hpx::async(
+                hpx::annotated_function(gen_tile_cross_covariance<S>, "assemble_pred"),
+                j,
+                i,
                 n_tile_size,
-                cross_covariance_tiles[i * static_cast<std::size_t>(n_tiles) + j]));
+                m_tile_size,
+                n_train,
+                n_test,
+                n_regressors,
+                sek_params,
+                training_input,
+                test_input));
         }
     }
 
     for (std::size_t i = 0; i < static_cast<std::size_t>(m_tiles); i++)
     {
-        uncertainty_tiles.push_back(
-            hpx::async(hpx::annotated_function(gen_tile_zeros, "assemble_prior_inter"), m_tile_size));
+        uncertainty_tiles.push_back(hpx::async(hpx::annotated_function(gen_tile_zeros<T>, "assemble_prior_inter"),
+                                               compute_tile_size(i, static_cast<std::size_t>(m_tile_size), n_test)));
     }
 
     GPRAT_END_STEP(
         assembly_timer,
         "predict_uncer_step assembly",
         K_tiles,
-        alpha_tiles,
-        cross_covariance_tiles,
+        beta_tiles,
         prediction_tiles,
         prior_K_tiles,
         uncertainty_tiles,
-        t_cross_covariance_tiles);
-    GPRAT_START_STEP(cholesky_timer);
-
-    // Prediction
-    ///////////////////////////////////////////////////////////////////////////
-    // Launch asynchronous Cholesky decomposition: K = L * L^T
-    right_looking_cholesky_tiled(K_tiles, n_tile_size, static_cast<std::size_t>(n_tiles));
-
-    GPRAT_END_STEP(cholesky_timer, "predict_uncer_step cholesky", K_tiles);
-    GPRAT_START_STEP(forward_timer);
-
-    ///////////////////////////////////////////////////////////////////////////
-    // Launch asynchronous triangular solve  L * (L^T * alpha) = y
-    // First, forward solve L * beta = y
-    forward_solve_tiled(K_tiles, alpha_tiles, n_tile_size, static_cast<std::size_t>(n_tiles));
-
-    GPRAT_END_STEP(forward_timer, "predict_uncer_step forward", alpha_tiles);
-    GPRAT_START_STEP(backward_timer);
+        t_cross_covariance_tiles);
+    GPRAT_START_STEP(cholesky_timer);
 
-    // Second, backward solve L^T * alpha = beta
-    backward_solve_tiled(K_tiles, alpha_tiles, n_tile_size, static_cast<std::size_t>(n_tiles));
+    // Prediction
+    ///////////////////////////////////////////////////////////////////////////
+    // Launch asynchronous Cholesky decomposition: K = L * L^T
+    right_looking_cholesky_tiled(K_tiles, n_tile_size, static_cast<std::size_t>(n_tiles), n_train);
 
-    GPRAT_END_STEP(backward_timer, "predict_uncer_step backward", alpha_tiles);
-    GPRAT_START_STEP(prediction_timer);
+    GPRAT_END_STEP(cholesky_timer, "predict_uncer_step cholesky", K_tiles);
+    GPRAT_START_STEP(forward_timer);
 
     ///////////////////////////////////////////////////////////////////////////
-    // Launch asynchronous prediction computation solve: hat(y) = cross(K) * alpha
-    matrix_vector_tiled(
-        cross_covariance_tiles,
-        alpha_tiles,
-        prediction_tiles,
-        m_tile_size,
+    // Launch asynchronous triangular solve L * [beta | V] = [y | cross(K)^T]
+    forward_solve_tiled_multi_rhs(
+        K_tiles,
+        beta_tiles,
+        t_cross_covariance_tiles,
         n_tile_size,
         static_cast<std::size_t>(n_tiles),
-        static_cast<std::size_t>(m_tiles));
+        static_cast<std::size_t>(m_tiles),
+        n_train);
 
-    GPRAT_END_STEP(prediction_timer, "predict_uncer_step prediction", prediction_tiles);
-    GPRAT_START_STEP(uncertainty_timer);
+    GPRAT_END_STEP(forward_timer, "predict_uncer_step forward", beta_tiles, t_cross_covariance_tiles);
+    GPRAT_START_STEP(prediction_timer);
 
     ///////////////////////////////////////////////////////////////////////////
-    // Launch asynchronous triangular solve L * V = cross(K)^T
-    forward_solve_tiled_matrix(
-        K_tiles,
+    // Launch asynchronous prediction computation: hat(y) = V^T * beta
+    transpose_matrix_vector_tiled(
         t_cross_covariance_tiles,
+        beta_tiles,
+        prediction_tiles,
         n_tile_size,
         m_tile_size,
         static_cast<std::size_t>(n_tiles),
-        static_cast<std::size_t>(m_tiles));
+        static_cast<std::size_t>(m_tiles),
+        n_train,
+        n_test);
 
-    GPRAT_END_STEP(uncertainty_timer, "predict_uncer_step forward KcK", t_cross_covariance_tiles);
+    GPRAT_END_STEP(prediction_timer, "predict_uncer_step prediction", prediction_tiles);
     GPRAT_START_STEP(posterior_covariance_timer);
 
     ///////////////////////////////////////////////////////////////////////////
@@ -420,14 +1005,16 @@ std::vector<std::vector<double>> predict_with_uncertainty(
         n_tile_size,
         m_tile_size,
         static_cast<std::size_t>(n_tiles),
-        static_cast<std::size_t>(m_tiles));
+        static_cast<std::size_t>(m_tiles),
+        n_train,
+        n_test);
 
     GPRAT_END_STEP(posterior_covariance_timer, "predict_uncer_step posterior covariance", uncertainty_tiles);
     GPRAT_START_STEP(prediction_uncertainty_timer);
 
     ///////////////////////////////////////////////////////////////////////////
     // Launch asynchronous computation diag(Sigma) = diag(prior(K)) - diag(W)
-    vector_difference_tiled(prior_K_tiles, uncertainty_tiles, m_tile_size, static_cast<std::size_t>(m_tiles));
+    vector_difference_tiled(prior_K_tiles, uncertainty_tiles, m_tile_size, static_cast<std::size_t>(m_tiles), n_test);
 
     GPRAT_END_STEP(prediction_uncertainty_timer, "predict_uncer_step prediction uncertainty", uncertainty_tiles);
 
@@ -446,10 +1033,11 @@ std::vector<std::vector<double>> predict_with_uncertainty(
         std::copy(tile.begin(), tile.end(), std::back_inserter(uncertainty_result));
     }
 
-    return std::vector<std::vector<double>>{ std::move(prediction_result), std::move(uncertainty_result) };
+    return std::vector<std::vector<T>>{ std::move(prediction_result), std::move(uncertainty_result) };
 }
 
-std::vector<std::vector<double>> predict_with_full_cov(
+template <typename T, typename S>
+std::vector<std::vector<T>> predict_with_full_cov(
     const std::vector<double> &training_input,
     const std::vector<double> &training_output,
     const std::vector<double> &test_input,
@@ -473,44 +1061,147 @@ std::vector<std::vector<double>> predict_with_full_cov(
      * Algorithm:
      * 1: Compute lower triangular part of covariance matrix K
      * 2: Compute Cholesky factor L of K
-     * 3: Compute intermediate solutions (alpha and V):
-     * - triangular solve L * beta = y
-     * - triangular solve L^T * alpha = beta
-     * - triangular solve L * V = cross(K)^T
+     * 3: Compute intermediate solutions (beta and V) in a single sweep over L:
+     * - triangular solve L * [beta | V] = [y | cross(K)^T]
      * 4: Compute prediction hat(y):
-     * - compute hat(y) = cross(K) * alpha
-     * 5: Compute full covariance matrix Sigma:
+     * - compute hat(y) = V^T * beta = cross(K) * K^-1 * y
+     * 5: Compute lower triangular part of full covariance matrix Sigma:
      * - compute W = V^T * V
      * - compute Sigma = prior(K) - W
      * 6: Compute diag(Sigma)
      */
 
-    GPRAT_START_STEP(assembly_timer);
-
-    std::vector<double> prediction_result;
-    std::vector<double> uncertainty_result;
-    // Tiled future data structures for prediction
-    Tiled_matrix K_tiles;                 // Tiled covariance matrix K_NxN
-    Tiled_matrix cross_covariance_tiles;  // Tiled cross_covariance matrix K_NxM
-    Tiled_vector prediction_tiles;        // Tiled solution
-    Tiled_vector alpha_tiles;             // Tiled intermediate solution
-    // Tiled future data structures for uncertainty
-    Tiled_matrix t_cross_covariance_tiles;  // Tiled transposed cross_covariance matrix K_MxN
-    Tiled_matrix prior_K_tiles;             // Tiled prior covariance matrix K_MxM
-    Tiled_vector uncertainty_tiles;         // Tiled uncertainty solution
+    // Number of training samples, the last tile may be smaller
+    const std::size_t n_train = compute_n_samples(static_cast<std::size_t>(n_tiles),
+                                                  static_cast<std::size_t>(n_tile_size),
+                                                  training_input.size(),
+                                                  static_cast<std::size_t>(n_regressors));
+    // Number of test samples, the last tile may be smaller
+    const std::size_t n_test = compute_n_samples(static_cast<std::size_t>(m_tiles),
+                                                 static_cast<std::size_t>(m_tile_size),
+                                                 test_input.size(),
+                                                 static_cast<std::size_t>(n_regressors));
+
+    std::vector<T> prediction_result;
+    std::vector<T> uncertainty_result;
+    Tiled_vector_t<T> prediction_tiles;   // Tiled solution
+    Tiled_matrix_t<T> prior_K_tiles;      // Tiled posterior covariance matrix Sigma_MxM
+    Tiled_vector_t<T> uncertainty_tiles;  // Tiled uncertainty solution
 
     // Preallocate memory
     prediction_result.reserve(test_input.size());
     uncertainty_result.reserve(test_input.size());
+    uncertainty_tiles.reserve(static_cast<std::size_t>(m_tiles));
 
-    K_tiles.resize(static_cast<std::size_t>(n_tiles * n_tiles));  // No reserve because of triangular structure
-    cross_covariance_tiles.reserve(static_cast<std::size_t>(m_tiles) * static_cast<std::size_t>(n_tiles));
-    prediction_tiles.reserve(static_cast<std::size_t>(m_tiles));
-    alpha_tiles.reserve(static_cast<std::size_t>(n_tiles));
+    ///////////////////////////////////////////////////////////////////////////
+    // Launch asynchronous computation of hat(y) and Sigma
+    launch_posterior_tiled<T, S>(training_input,
+                                 training_output,
+                                 test_input,
+                                 sek_params,
+                                 n_tiles,
+                                 n_tile_size,
+                                 m_tiles,
+                                 m_tile_size,
+                                 n_regressors,
+                                 n_train,
+                                 n_test,
+                                 prediction_tiles,
+                                 prior_K_tiles);
 
-    t_cross_covariance_tiles.reserve(static_cast<std::size_t>(n_tiles) * static_cast<std::size_t>(m_tiles));
-    prior_K_tiles.resize(static_cast<std::size_t>(m_tiles * m_tiles));
-    uncertainty_tiles.reserve(static_cast<std::size_t>(m_tiles));
+    for (std::size_t i = 0; i < static_cast<std::size_t>(m_tiles); i++)
+    {
+        uncertainty_tiles.push_back(hpx::async(hpx::annotated_function(gen_tile_zeros<T>, "assemble_tiled"),
+                                               compute_tile_size(i, static_cast<std::size_t>(m_tile_size), n_test)));
+    }
+
+    GPRAT_START_STEP(prediction_uncertainty_timer);
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Launch asynchronous computation of uncertainty diag(Sigma)
+    matrix_diagonal_tiled(prior_K_tiles, uncertainty_tiles, m_tile_size, static_cast<std::size_t>(m_tiles), n_test);
+
+    GPRAT_END_STEP(prediction_uncertainty_timer, "predict_full_cov_step pred uncer", uncertainty_tiles);
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Synchronize prediction
+    for (std::size_t i = 0; i < static_cast<std::size_t>(m_tiles); i++)
+    {
+        auto tile = prediction_tiles[i].get();
+        std::copy(tile.begin(), tile.end(), std::back_inserter(prediction_result));
+    }
+
+    // Synchronize uncertainty
+    for (std::size_t i = 0; i < static_cast<std::size_t>(m_tiles); i++)
+    {
+        auto tile = uncertainty_tiles[i].get();
+        std::copy(tile.begin(), tile.end(), std::back_inserter(uncertainty_result));
+    }
+
+    return std::vector<std::vector<T>>{ std::move(prediction_result), std::move(uncertainty_result) };
+}
+
+template <typename T>
+std::vector<std::vector<T>> predict_with_uncertainty_streaming(
+    const std::vector<double> &training_input,
+    const std::vector<double> &training_output,
+    const std::vector<double> &test_input,
+    const gprat_hyper::SEKParams &sek_params,
+    int n_tiles,
+    int n_tile_size,
+    int m_tiles,
+    int m_tile_size,
+    int n_regressors)
+{
+    /*
+     * Prediction: hat(y) = cross(K) * K^-1 * y
+     * Uncertainty: diag(Sigma) = diag(prior(K)) * diag(cross(K)^T * K^-1 * cross(K))
+     * - Covariance matrix K_NxN
+     * - Cross-covariance cross(K)_MxN, assembled per block of test tiles
+     * - Training ouput y_N
+     * - Prediction output hat(y)_M
+     *
+     * Algorithm:
+     * 1: Compute lower triangular part of covariance matrix K
+     * 2: Compute Cholesky factor L of K
+     * 3: triangular solve L * beta = y
+     * 4: For each test tile c:
+     *    - assemble cross(K)_c^T
+     *    - triangular solve L * V_c = cross(K)_c^T
+     *    - compute hat(y)_c = V_c^T * beta
+     *    - compute diag(Sigma)_c = diag(prior(K)_c) - diag(V_c^T * V_c)
+     *    - release V_c
+     */
+
+    // Number of training samples, the last tile may be smaller
+    const std::size_t n_train = compute_n_samples(static_cast<std::size_t>(n_tiles),
+                                                  static_cast<std::size_t>(n_tile_size),
+                                                  training_input.size(),
+                                                  static_cast<std::size_t>(n_regressors));
+    // Number of test samples, the last tile may be smaller
+    const std::size_t n_test = compute_n_samples(static_cast<std::size_t>(m_tiles),
+                                                 static_cast<std::size_t>(m_tile_size),
+                                                 test_input.size(),
+                                                 static_cast<std::size_t>(n_regressors));
+
+    GPRAT_START_STEP(assembly_timer);
+
+    std::vector<T> prediction_result;
+    std::vector<T> uncertainty_result;
+    // Tiled future data structures, only the results span all test tiles
+    Tiled_matrix_t<T> K_tiles;            // Tiled covariance matrix K_NxN
+    Tiled_vector_t<T> beta_tiles;         // Tiled intermediate solution
+    Tiled_vector_t<T> prediction_tiles;   // Tiled solution
+    Tiled_vector_t<T> uncertainty_tiles;  // Tiled uncertainty solution
+
+    // Preallocate memory
+    prediction_result.reserve(n_test);
+    uncertainty_result.reserve(n_test);
+
+    K_tiles.resize(static_cast<std::size_t>(n_tiles * n_tiles));  // No reserve because of triangular structure
+    beta_tiles.reserve(static_cast<std::size_t>(n_tiles));
+    prediction_tiles.resize(static_cast<std::size_t>(m_tiles));
+    uncertainty_tiles.resize(static_cast<std::size_t>(m_tiles));
 
     ///////////////////////////////////////////////////////////////////////////
     // Launch asynchronous assembly
@@ -519,10 +1210,11 @@ std::vector<std::vector<double>> predict_with_full_cov(
         for (std::size_t j = 0; j <= i; j++)
         {
             K_tiles[i * static_cast<std::size_t>(n_tiles) + j] = hpx::async(
-                hpx::annotated_function(gen_tile_covariance, "assemble_tiled_K"),
+                hpx::annotated_function(gen_tile_covariance<T>, "assemble_tiled_K"),
                 i,
                 j,
                 n_tile_size,
+                n_train,
                 n_regressors,
                 sek_params,
                 training_input);
@@ -531,168 +1223,312 @@ std::vector<std::vector<double>> predict_with_full_cov(
 
     for (std::size_t i = 0; i < static_cast<std::size_t>(n_tiles); i++)
     {
-        alpha_tiles.push_back(hpx::async(
-            hpx::annotated_function(gen_tile_output, "assemble_tiled_alpha"), i, n_tile_size, training_output));
+        beta_tiles.push_back(hpx::async(hpx::annotated_function(gen_tile_output<T>, "assemble_tiled_alpha"),
+                                        i,
+                                        n_tile_size,
+                                        n_train,
+                                        training_output));
     }
 
-    for (std::size_t i = 0; i < static_cast<std::size_t>(m_tiles); i++)
+    GPRAT_END_STEP(assembly_timer, "predict_stream_step assembly", K_tiles, beta_tiles);
+    GPRAT_START_STEP(cholesky_timer);
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Launch asynchronous Cholesky decomposition: K = L * L^T
+    right_looking_cholesky_tiled(K_tiles, n_tile_size, static_cast<std::size_t>(n_tiles), n_train);
+
+    GPRAT_END_STEP(cholesky_timer, "predict_stream_step cholesky", K_tiles);
+    GPRAT_START_STEP(forward_timer);
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Launch asynchronous triangular solve L * beta = y
+    forward_solve_tiled(K_tiles, beta_tiles, n_tile_size, static_cast<std::size_t>(n_tiles), n_train);
+
+    GPRAT_END_STEP(forward_timer, "predict_stream_step forward", beta_tiles);
+    GPRAT_START_STEP(blocks_timer);
+
+    for (std::size_t c = 0; c < static_cast<std::size_t>(m_tiles); c++)
     {
-        for (std::size_t j = 0; j < static_cast<std::size_t>(n_tiles); j++)
+        // Bound the memory: the V tiles of a block are released once its results are ready
+        if (c >= STREAMING_BLOCKS_IN_FLIGHT)
         {
-            cross_covariance_tiles.push_back(hpx::async(
-                hpx::annotated_function(gen_tile_cross_covariance, "assemble_pred"),
-                i,
-                j,
-                m_tile_size,
-                n_tile_size,
-                n_regressors,
-                sek_params,
-                test_input,
-                training_input));
+            prediction_tiles[c - STREAMING_BLOCKS_IN_FLIGHT].wait();
+            uncertainty_tiles[c - STREAMING_BLOCKS_IN_FLIGHT].wait();
         }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Launch asynchronous assembly, solve and reductions of the block
+        std::tie(prediction_tiles[c], uncertainty_tiles[c]) = predict_test_tile(K_tiles,
+                                                                                beta_tiles,
+                                                                                true,
+                                                                                training_input,
+                                                                                test_input,
+                                                                                sek_params,
+                                                                                c,
+                                                                                static_cast<std::size_t>(n_tiles),
+                                                                                n_tile_size,
+                                                                                m_tile_size,
+                                                                                n_train,
+                                                                                n_test,
+                                                                                n_regressors);
     }
 
+    GPRAT_END_STEP(blocks_timer, "predict_stream_step blocks", prediction_tiles, uncertainty_tiles);
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Synchronize prediction
     for (std::size_t i = 0; i < static_cast<std::size_t>(m_tiles); i++)
     {
-        prediction_tiles.push_back(hpx::async(hpx::annotated_function(gen_tile_zeros, "assemble_tiled"), m_tile_size));
+        auto tile = prediction_tiles[i].get();
+        std::copy(tile.begin(), tile.end(), std::back_inserter(prediction_result));
     }
 
-    // Assemble prior covariance matrix vector
+    // Synchronize uncertainty
     for (std::size_t i = 0; i < static_cast<std::size_t>(m_tiles); i++)
+    {
+        auto tile = uncertainty_tiles[i].get();
+        std::copy(tile.begin(), tile.end(), std::back_inserter(uncertainty_result));
+    }
+
+    return std::vector<std::vector<T>>{ std::move(prediction_result), std::move(uncertainty_result) };
+}
+
+template <typename T>
+std::size_t predict_chunked(const std::vector<double> &training_input,
+                            const std::vector<double> &training_output,
+                            const gprat_hyper::SEKParams &sek_params,
+                            int n_tiles,
+                            int n_tile_size,
+                            int n_regressors,
+                            const TestChunkSource &next_test_chunk,
+                            const PredictionChunkSink<T> &consume_chunk,
+                            bool with_uncertainty)
+{
+    /*
+     * Algorithm:
+     * 1: Compute lower triangular part of covariance matrix K
+     * 2: Compute Cholesky factor L of K
+     * 3: triangular solve L * beta = y
+     *    - without uncertainty: triangular solve L^T * alpha = beta
+     * 4: For each test chunk, see predict_test_tile:
+     *    - with uncertainty: hat(y)_c = V_c^T * beta and diag(Sigma)_c
+     *    - without uncertainty: hat(y)_c = cross(K)_c * alpha
+     */
+
+    // Number of training samples, the last tile may be smaller
+    const std::size_t n_train = compute_n_samples(static_cast<std::size_t>(n_tiles),
+                                                  static_cast<std::size_t>(n_tile_size),
+                                                  training_input.size(),
+                                                  static_cast<std::size_t>(n_regressors));
+
+    // Tiled future data structures of the training factor, reused by all chunks
+    Tiled_matrix_t<T> K_tiles;         // Tiled covariance matrix K_NxN
+    Tiled_vector_t<T> solution_tiles;  // Tiled intermediate solution beta or alpha
+
+    K_tiles.resize(static_cast<std::size_t>(n_tiles * n_tiles));  // No reserve because of triangular structure
+    solution_tiles.reserve(static_cast<std::size_t>(n_tiles));
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Launch asynchronous assembly
+    for (std::size_t i = 0; i < static_cast<std::size_t>(n_tiles); i++)
     {
         for (std::size_t j = 0; j <= i; j++)
         {
-            prior_K_tiles[i * static_cast<std::size_t>(m_tiles) + j] = hpx::async(
-                hpx::annotated_function(gen_tile_full_prior_covariance, "assemble_prior_tiled"),
+            K_tiles[i * static_cast<std::size_t>(n_tiles) + j] = hpx::async(
+                hpx::annotated_function(gen_tile_covariance<T>, "assemble_tiled_K"),
                 i,
                 j,
-                m_tile_size,
+                n_tile_size,
+                n_train,
                 n_regressors,
                 sek_params,
-                test_input);
-
-            if (i != j)
-            {
-                prior_K_tiles[j * static_cast<std::size_t>(m_tiles) + i] = hpx::dataflow(
-                    hpx::annotated_function(hpx::unwrapping(&gen_tile_transpose), "assemble_prior_tiled"),
-                    m_tile_size,
-                    m_tile_size,
-                    prior_K_tiles[i * static_cast<std::size_t>(m_tiles) + j]);
-            }
+                training_input);
         }
     }
 
-    for (std::size_t j = 0; j < static_cast<std::size_t>(n_tiles); j++)
+    for (std::size_t i = 0; i < static_cast<std::size_t>(n_tiles); i++)
     {
-        for (std::size_t i = 0; i < static_cast<std::size_t>(m_tiles); i++)
-        {
-            t_cross_covariance_tiles.push_back(hpx::dataflow(
-                hpx::annotated_function(hpx::unwrapping(&gen_tile_transpose), "assemble_pred"),
-                m_tile_size,
-                n_tile_size,
-                cross_covariance_tiles[i * static_cast<std::size_t>(n_tiles) + j]));
-        }
+        solution_tiles.push_back(hpx::async(hpx::annotated_function(gen_tile_output<T>, "assemble_tiled_alpha"),
+                                            i,
+                                            n_tile_size,
+                                            n_train,
+                                            training_output));
     }
 
-    for (std::size_t i = 0; i < static_cast<std::size_t>(m_tiles); i++)
+    ///////////////////////////////////////////////////////////////////////////
+    // Launch asynchronous Cholesky decomposition K = L * L^T and triangular solves
+    right_looking_cholesky_tiled(K_tiles, n_tile_size, static_cast<std::size_t>(n_tiles), n_train);
+    forward_solve_tiled(K_tiles, solution_tiles, n_tile_size, static_cast<std::size_t>(n_tiles), n_train);
+    if (!with_uncertainty)
     {
-        uncertainty_tiles.push_back(hpx::async(hpx::annotated_function(gen_tile_zeros, "assemble_tiled"), m_tile_size));
+        backward_solve_tiled(K_tiles, solution_tiles, n_tile_size, static_cast<std::size_t>(n_tiles), n_train);
     }
 
-    GPRAT_END_STEP(
-        assembly_timer,
-        "predict_full_cov_step assembly",
-        K_tiles,
-        alpha_tiles,
-        cross_covariance_tiles,
-        prediction_tiles,
-        prior_K_tiles,
-        uncertainty_tiles,
-        t_cross_covariance_tiles);
-    GPRAT_START_STEP(cholesky_timer);
-
-    // Prediction
     ///////////////////////////////////////////////////////////////////////////
-    // Launch asynchronous Cholesky decomposition: K = L * L^T
-    right_looking_cholesky_tiled(K_tiles, n_tile_size, static_cast<std::size_t>(n_tiles));
+    // Launch the chunks, the next chunk is assembled while the previous ones are computed
+    std::deque<std::pair<hpx::shared_future<std::vector<T>>, hpx::shared_future<std::vector<T>>>> ft_in_flight;
+    const auto deliver_oldest_chunk = [&]()
+    {
+        auto [ft_prediction, ft_uncertainty] = std::move(ft_in_flight.front());
+        ft_in_flight.pop_front();
+        consume_chunk(ft_prediction.get(), ft_uncertainty.get());
+    };
 
-    GPRAT_END_STEP(cholesky_timer, "predict_full_cov_step cholesky", K_tiles);
-    GPRAT_START_STEP(forward_timer);
+    std::size_t n_chunks = 0;
+    for (std::vector<double> test_input = next_test_chunk(); !test_input.empty(); test_input = next_test_chunk())
+    {
+        // A chunk is a single test tile holding all of its samples
+        if (test_input.size() < static_cast<std::size_t>(n_regressors))
+        {
+            throw std::invalid_argument("Error: A test chunk of " + std::to_string(test_input.size())
+                                        + " entries holds no sample for " + std::to_string(n_regressors)
+                                        + " regressors.");
+        }
+        const std::size_t n_test = test_input.size() - static_cast<std::size_t>(n_regressors) + 1;
+        ft_in_flight.push_back(predict_test_tile(K_tiles,
+                                                 solution_tiles,
+                                                 with_uncertainty,
+                                                 training_input,
+                                                 test_input,
+                                                 sek_params,
+                                                 0,
+                                                 static_cast<std::size_t>(n_tiles),
+                                                 n_tile_size,
+                                                 static_cast<int>(n_test),
+                                                 n_train,
+                                                 n_test,
+                                                 n_regressors));
+        n_chunks++;
+
+        // Bound the memory: the tiles of a chunk are released once it is delivered
+        while (ft_in_flight.size() >= STREAMING_BLOCKS_IN_FLIGHT)
+        {
+            deliver_oldest_chunk();
+        }
+    }
 
     ///////////////////////////////////////////////////////////////////////////
-    // Launch asynchronous triangular solve  L * (L^T * alpha) = y
-    forward_solve_tiled(K_tiles, alpha_tiles, n_tile_size, static_cast<std::size_t>(n_tiles));
-
-    GPRAT_END_STEP(forward_timer, "predict_full_cov_step forward", alpha_tiles);
-    GPRAT_START_STEP(backward_timer);
+    // Synchronize the remaining chunks in order
+    while (!ft_in_flight.empty())
+    {
+        deliver_oldest_chunk();
+    }
+    return n_chunks;
+}
 
-    backward_solve_tiled(K_tiles, alpha_tiles, n_tile_size, static_cast<std::size_t>(n_tiles));
+std::vector<std::vector<double>> sample_posterior(const std::vector<double> &training_input,
+                                                  const std::vector<double> &training_output,
+                                                  const std::vector<double> &test_input,
+                                                  const gprat_hyper::SEKParams &sek_params,
+                                                  int n_tiles,
+                                                  int n_tile_size,
+                                                  int m_tiles,
+                                                  int m_tile_size,
+                                                  int n_regressors,
+                                                  int n_samples,
+                                                  std::uint64_t seed)
+{
+    /*
+     * Posterior samples: f_s = hat(y) + L_Sigma * z_s with z_s ~ N(0, I)
+     * - Posterior covariance matrix Sigma_MxM = L_Sigma * L_Sigma^T
+     * - Standard normal matrix Z_MxS
+     * - Posterior sample matrix F_MxS
+     *
+     * Algorithm:
+     * 1: Compute hat(y) and lower triangular part of Sigma, see predict_with_full_cov
+     * 2: Compute Cholesky factor L_Sigma of Sigma + jitter * I
+     * 3: Generate Z tile by tile
+     * 4: Compute F = hat(y) * 1^T - L_Sigma * Z, z_s and -z_s have the same distribution
+     */
 
-    GPRAT_END_STEP(backward_timer, "predict_full_cov_step backward", alpha_tiles);
-    GPRAT_START_STEP(forward_KcK_timer);
+    // Number of training samples, the last tile may be smaller
+    const std::size_t n_train = compute_n_samples(static_cast<std::size_t>(n_tiles),
+                                                  static_cast<std::size_t>(n_tile_size),
+                                                  training_input.size(),
+                                                  static_cast<std::size_t>(n_regressors));
+    // Number of test samples, the last tile may be smaller
+    const std::size_t n_test = compute_n_samples(static_cast<std::size_t>(m_tiles),
+                                                 static_cast<std::size_t>(m_tile_size),
+                                                 test_input.size(),
+                                                 static_cast<std::size_t>(n_regressors));
+    const std::size_t n_draws = static_cast<std::size_t>(n_samples);
+
+    Tiled_vector prediction_tiles;  // Tiled solution
+    Tiled_matrix sigma_tiles;       // Tiled posterior covariance matrix Sigma_MxM
+    Tiled_matrix normal_tiles;      // Tiled standard normal matrix Z_MxS
+    Tiled_matrix sample_tiles;      // Tiled posterior sample matrix F_MxS
 
     ///////////////////////////////////////////////////////////////////////////
-    // Launch asynchronous triangular solve L * V = cross(K)^T
-    forward_solve_tiled_matrix(
-        K_tiles,
-        t_cross_covariance_tiles,
-        n_tile_size,
-        m_tile_size,
-        static_cast<std::size_t>(n_tiles),
-        static_cast<std::size_t>(m_tiles));
-
-    GPRAT_END_STEP(forward_KcK_timer, "predict_full_cov_step forward KcK", t_cross_covariance_tiles);
-    GPRAT_START_STEP(prediction_timer);
+    // Launch asynchronous computation of hat(y) and Sigma
+    launch_posterior_tiled<double, double>(training_input,
+                                           training_output,
+                                           test_input,
+                                           sek_params,
+                                           n_tiles,
+                                           n_tile_size,
+                                           m_tiles,
+                                           m_tile_size,
+                                           n_regressors,
+                                           n_train,
+                                           n_test,
+                                           prediction_tiles,
+                                           sigma_tiles);
 
     ///////////////////////////////////////////////////////////////////////////
-    // Launch asynchronous prediction computation solve: hat(y) = K_cross_cov * alpha
-    matrix_vector_tiled(
-        cross_covariance_tiles,
-        alpha_tiles,
-        prediction_tiles,
-        m_tile_size,
-        n_tile_size,
-        static_cast<std::size_t>(n_tiles),
-        static_cast<std::size_t>(m_tiles));
-
-    GPRAT_END_STEP(prediction_timer, "predict_full_cov_step prediction", prediction_tiles);
-    GPRAT_START_STEP(full_cov_timer);
+    // Launch asynchronous Cholesky decomposition: Sigma + jitter * I = L_Sigma * L_Sigma^T
+    for (std::size_t i = 0; i < static_cast<std::size_t>(m_tiles); i++)
+    {
+        sigma_tiles[i * static_cast<std::size_t>(m_tiles) + i] =
+            hpx::dataflow(hpx::annotated_function(add_matrix_diagonal<double>, "sample_posterior"),
+                          sigma_tiles[i * static_cast<std::size_t>(m_tiles) + i],
+                          compute_tile_size(i, static_cast<std::size_t>(m_tile_size), n_test),
+                          POSTERIOR_SAMPLING_JITTER * sek_params.vertical_lengthscale);
+    }
+    right_looking_cholesky_tiled(sigma_tiles, m_tile_size, static_cast<std::size_t>(m_tiles), n_test);
 
     ///////////////////////////////////////////////////////////////////////////
-    // Launch asynchronous computation of full covariance Sigma = prior(K) - V^T * V
-    symmetric_matrix_matrix_tiled(
-        t_cross_covariance_tiles,
-        prior_K_tiles,
-        n_tile_size,
-        m_tile_size,
-        static_cast<std::size_t>(n_tiles),
-        static_cast<std::size_t>(m_tiles));
-
-    GPRAT_END_STEP(full_cov_timer, "predict_full_cov_step full cov", prior_K_tiles);
-    GPRAT_START_STEP(prediction_uncertainty_timer);
+    // Launch asynchronous generation of Z and of the sample mean hat(y) * 1^T
+    normal_tiles.reserve(static_cast<std::size_t>(m_tiles));
+    sample_tiles.reserve(static_cast<std::size_t>(m_tiles));
+    for (std::size_t i = 0; i < static_cast<std::size_t>(m_tiles); i++)
+    {
+        normal_tiles.push_back(hpx::async(hpx::annotated_function(gen_tile_standard_normal, "sample_posterior"),
+                                          i,
+                                          static_cast<std::size_t>(m_tile_size),
+                                          n_test,
+                                          n_draws,
+                                          seed));
+        sample_tiles.push_back(hpx::dataflow(
+            hpx::annotated_function(hpx::unwrapping(&gen_tile_repeated_column), "sample_posterior"),
+            prediction_tiles[i],
+            n_draws));
+    }
 
     ///////////////////////////////////////////////////////////////////////////
-    // Launch asynchronous computation of uncertainty diag(Sigma)
-    matrix_diagonal_tiled(prior_K_tiles, uncertainty_tiles, m_tile_size, static_cast<std::size_t>(m_tiles));
-
-    GPRAT_END_STEP(prediction_uncertainty_timer, "predict_full_cov_step pred uncer", uncertainty_tiles);
+    // Launch asynchronous computation of F = hat(y) * 1^T - L_Sigma * Z
+    triangular_matrix_matrix_tiled(
+        sigma_tiles, normal_tiles, sample_tiles, m_tile_size, n_samples, static_cast<std::size_t>(m_tiles), n_test);
 
     ///////////////////////////////////////////////////////////////////////////
-    // Synchronize prediction
-    for (std::size_t i = 0; i < static_cast<std::size_t>(m_tiles); i++)
+    // Synchronize samples, the tiles hold the samples as columns
+    std::vector<std::vector<double>> samples(n_draws);
+    for (auto &sample : samples)
     {
-        auto tile = prediction_tiles[i].get();
-        std::copy(tile.begin(), tile.end(), std::back_inserter(prediction_result));
+        sample.reserve(n_test);
     }
-
-    // Synchronize uncertainty
     for (std::size_t i = 0; i < static_cast<std::size_t>(m_tiles); i++)
     {
-        auto tile = uncertainty_tiles[i].get();
-        std::copy(tile.begin(), tile.end(), std::back_inserter(uncertainty_result));
+        const std::vector<double> &tile = sample_tiles[i].get();
+        const std::size_t M_i = compute_tile_size(i, static_cast<std::size_t>(m_tile_size), n_test);
+        for (std::size_t row = 0; row < M_i; row++)
+        {
+            for (std::size_t s = 0; s < n_draws; s++)
+            {
+                samples[s].push_back(tile[row * n_draws + s]);
+            }
+        }
     }
-
-    return std::vector<std::vector<double>>{ std::move(prediction_result), std::move(uncertainty_result) };
+    return samples;
 }
 
 ///////////////////////////////////////////////////////////////////////////
@@ -724,6 +1560,12 @@ double compute_loss(const std::vector<double> &training_input,
      *    - Add constant N * log (2 * pi)
      */
 
+    // Number of training samples, the last tile may be smaller
+    const std::size_t n_train = compute_n_samples(static_cast<std::size_t>(n_tiles),
+                                                  static_cast<std::size_t>(n_tile_size),
+                                                  training_input.size(),
+                                                  static_cast<std::size_t>(n_regressors));
+
     hpx::shared_future<double> loss_value;
     // Tiled future data structures
     Tiled_matrix K_tiles;      // Tiled covariance matrix K_NxN
@@ -742,10 +1584,11 @@ double compute_loss(const std::vector<double> &training_input,
         for (std::size_t j = 0; j <= i; j++)
         {
             K_tiles[i * static_cast<std::size_t>(n_tiles) + j] = hpx::async(
-                hpx::annotated_function(gen_tile_covariance, "assemble_tiled_K"),
+                hpx::annotated_function(gen_tile_covariance<double>, "assemble_tiled_K"),
                 i,
                 j,
                 n_tile_size,
+                n_train,
                 n_regressors,
                 sek_params,
                 training_input);
@@ -754,28 +1597,35 @@ double compute_loss(const std::vector<double> &training_input,
 
     for (std::size_t i = 0; i < static_cast<std::size_t>(n_tiles); i++)
     {
-        y_tiles.push_back(
-            hpx::async(hpx::annotated_function(gen_tile_output, "assemble_tiled_y"), i, n_tile_size, training_output));
+        y_tiles.push_back(hpx::async(hpx::annotated_function(gen_tile_output<double>, "assemble_tiled_y"),
+                                     i,
+                                     n_tile_size,
+                                     n_train,
+                                     training_output));
     }
 
     for (std::size_t i = 0; i < static_cast<std::size_t>(n_tiles); i++)
     {
-        alpha_tiles.push_back(hpx::async(
-            hpx::annotated_function(gen_tile_output, "assemble_tiled_alpha"), i, n_tile_size, training_output));
+        alpha_tiles.push_back(hpx::async(hpx::annotated_function(gen_tile_output<double>, "assemble_tiled_alpha"),
+                                         i,
+                                         n_tile_size,
+                                         n_train,
+                                         training_output));
     }
 
     ///////////////////////////////////////////////////////////////////////////
     // Launch asynchronous Cholesky decomposition: K = L * L^T
-    right_looking_cholesky_tiled(K_tiles, n_tile_size, static_cast<std::size_t>(n_tiles));
+    right_looking_cholesky_tiled(K_tiles, n_tile_size, static_cast<std::size_t>(n_tiles), n_train);
 
     ///////////////////////////////////////////////////////////////////////////
     // Launch asynchronous triangular solve  L * (L^T * alpha) = y
-    forward_solve_tiled(K_tiles, alpha_tiles, n_tile_size, static_cast<std::size_t>(n_tiles));
-    backward_solve_tiled(K_tiles, alpha_tiles, n_tile_size, static_cast<std::size_t>(n_tiles));
+    forward_solve_tiled(K_tiles, alpha_tiles, n_tile_size, static_cast<std::size_t>(n_tiles), n_train);
+    backward_solve_tiled(K_tiles, alpha_tiles, n_tile_size, static_cast<std::size_t>(n_tiles), n_train);
 
     ///////////////////////////////////////////////////////////////////////////
     // Launch asynchronous loss computation
-    compute_loss_tiled(K_tiles, alpha_tiles, y_tiles, loss_value, n_tile_size, static_cast<std::size_t>(n_tiles));
+    compute_loss_tiled(
+        K_tiles, alpha_tiles, y_tiles, loss_value, n_tile_size, static_cast<std::size_t>(n_tiles), n_train);
 
     return loss_value.get();
 }
@@ -823,6 +1673,12 @@ optimize(const std::vector<double> &training_input,
      * endfor
      */
 
+    // Number of training samples, the last tile may be smaller
+    const std::size_t n_train = compute_n_samples(static_cast<std::size_t>(n_tiles),
+                                                  static_cast<std::size_t>(n_tile_size),
+                                                  training_input.size(),
+                                                  static_cast<std::size_t>(n_regressors));
+
     // data holder for loss
     hpx::shared_future<double> loss_value;
     // data holder for computed loss values
@@ -852,8 +1708,8 @@ optimize(const std::vector<double> &training_input,
     // Launch asynchronous assembly of output y
     for (std::size_t i = 0; i < static_cast<std::size_t>(n_tiles); i++)
     {
-        y_tiles.push_back(
-            hpx::async(hpx::annotated_function(gen_tile_output, "assemble_y"), i, n_tile_size, training_output));
+        y_tiles.push_back(hpx::async(
+            hpx::annotated_function(gen_tile_output<double>, "assemble_y"), i, n_tile_size, n_train, training_output));
     }
 
     //////////////////////////////////////////////////////////////////////////////
@@ -874,6 +1730,7 @@ optimize(const std::vector<double> &training_input,
                     i,
                     j,
                     n_tile_size,
+                    n_train,
                     n_regressors,
                     sek_params,
                     training_input);
@@ -883,21 +1740,21 @@ optimize(const std::vector<double> &training_input,
                     i,
                     j,
                     n_tile_size,
+                    n_train,
                     sek_params,
                     cov_dists);
                 if (trainable_params[0])
                 {
                     grad_l_tiles[i * static_cast<std::size_t>(n_tiles) + j] = hpx::dataflow(
                         hpx::annotated_function(hpx::unwrapping(&gen_tile_grad_l), "assemble_gradl"),
-                        n_tile_size,
                         sek_params,
                         cov_dists);
                     if (i != j)
                     {
                         grad_l_tiles[j * static_cast<std::size_t>(n_tiles) + i] = hpx::dataflow(
-                            hpx::annotated_function(hpx::unwrapping(&gen_tile_transpose), "assemble_gradl_t"),
-                            n_tile_size,
-                            n_tile_size,
+                            hpx::annotated_function(hpx::unwrapping(&gen_tile_transpose<double>), "assemble_gradl_t"),
+                            compute_tile_size(i, static_cast<std::size_t>(n_tile_size), n_train),
+                            compute_tile_size(j, static_cast<std::size_t>(n_tile_size), n_train),
                             grad_l_tiles[i * static_cast<std::size_t>(n_tiles) + j]);
                     }
                 }
@@ -906,15 +1763,14 @@ optimize(const std::vector<double> &training_input,
                 {
                     grad_v_tiles[i * static_cast<std::size_t>(n_tiles) + j] = hpx::dataflow(
                         hpx::annotated_function(hpx::unwrapping(&gen_tile_grad_v), "assemble_gradv"),
-                        n_tile_size,
                         sek_params,
                         cov_dists);
                     if (i != j)
                     {
                         grad_v_tiles[j * static_cast<std::size_t>(n_tiles) + i] = hpx::dataflow(
-                            hpx::annotated_function(hpx::unwrapping(&gen_tile_transpose), "assemble_gradv_t"),
-                            n_tile_size,
-                            n_tile_size,
+                            hpx::annotated_function(hpx::unwrapping(&gen_tile_transpose<double>), "assemble_gradv_t"),
+                            compute_tile_size(i, static_cast<std::size_t>(n_tile_size), n_train),
+                            compute_tile_size(j, static_cast<std::size_t>(n_tile_size), n_train),
                             grad_v_tiles[i * static_cast<std::size_t>(n_tiles) + j]);
                     }
                 }
@@ -924,7 +1780,8 @@ optimize(const std::vector<double> &training_input,
         // Assembly with reallocation -> optimize to only set existing values
         for (std::size_t i = 0; i < static_cast<std::size_t>(n_tiles); i++)
         {
-            alpha_tiles[i] = hpx::async(hpx::annotated_function(gen_tile_zeros, "assemble_tiled"), n_tile_size);
+            alpha_tiles[i] = hpx::async(hpx::annotated_function(gen_tile_zeros<double>, "assemble_tiled"),
+                                         compute_tile_size(i, static_cast<std::size_t>(n_tile_size), n_train));
         }
 
         for (std::size_t i = 0; i < static_cast<std::size_t>(n_tiles); i++)
@@ -934,19 +1791,22 @@ optimize(const std::vector<double> &training_input,
                 if (i == j)
                 {
                     K_inv_tiles[i * static_cast<std::size_t>(n_tiles) + j] =
-                        hpx::async(hpx::annotated_function(gen_tile_identity, "assemble_identity_matrix"), n_tile_size);
+                        hpx::async(hpx::annotated_function(gen_tile_identity<double>, "assemble_identity_matrix"),
+                                   compute_tile_size(i, static_cast<std::size_t>(n_tile_size), n_train));
                 }
                 else
                 {
                     K_inv_tiles[i * static_cast<std::size_t>(n_tiles) + j] = hpx::async(
-                        hpx::annotated_function(gen_tile_zeros, "assemble_identity_matrix"), n_tile_size * n_tile_size);
+                        hpx::annotated_function(gen_tile_zeros<double>, "assemble_identity_matrix"),
+                        compute_tile_size(i, static_cast<std::size_t>(n_tile_size), n_train)
+                            * compute_tile_size(j, static_cast<std::size_t>(n_tile_size), n_train));
                 }
             }
         }
 
         ///////////////////////////////////////////////////////////////////////////
         // Launch asynchronous Cholesky decomposition: K = L * L^T
-        right_looking_cholesky_tiled(K_tiles, n_tile_size, static_cast<std::size_t>(n_tiles));
+        right_looking_cholesky_tiled(K_tiles, n_tile_size, static_cast<std::size_t>(n_tiles), n_train);
 
         ///////////////////////////////////////////////////////////////////////////
         // Launch asynchronous compute K^-1 through L* (L^T * X) = I
@@ -956,14 +1816,18 @@ optimize(const std::vector<double> &training_input,
             n_tile_size,
             n_tile_size,
             static_cast<std::size_t>(n_tiles),
-            static_cast<std::size_t>(n_tiles));
+            static_cast<std::size_t>(n_tiles),
+            n_train,
+            n_train);
         backward_solve_tiled_matrix(
             K_tiles,
             K_inv_tiles,
             n_tile_size,
             n_tile_size,
             static_cast<std::size_t>(n_tiles),
-            static_cast<std::size_t>(n_tiles));
+            static_cast<std::size_t>(n_tiles),
+            n_train,
+            n_train);
 
         ///////////////////////////////////////////////////////////////////////////
         // Launch asynchronous compute beta = inv(K) * y
@@ -974,12 +1838,15 @@ optimize(const std::vector<double> &training_input,
             n_tile_size,
             n_tile_size,
             static_cast<std::size_t>(n_tiles),
-            static_cast<std::size_t>(n_tiles));
+            static_cast<std::size_t>(n_tiles),
+            n_train,
+            n_train);
 
         ///////////////////////////////////////////////////////////////////////////
         // Launch asynchronous loss computation where
         // loss(theta) = 0.5 * ( log(det(K)) - y^T * K^-1 * y - N * log(2 * pi) )
-        compute_loss_tiled(K_tiles, alpha_tiles, y_tiles, loss_value, n_tile_size, static_cast<std::size_t>(n_tiles));
+        compute_loss_tiled(
+            K_tiles, alpha_tiles, y_tiles, loss_value, n_tile_size, static_cast<std::size_t>(n_tiles), n_train);
 
         ///////////////////////////////////////////////////////////////////////////
         // Launch asynchronous update of the hyperparameters
@@ -993,6 +1860,7 @@ optimize(const std::vector<double> &training_input,
                 sek_params,
                 n_tile_size,
                 static_cast<std::size_t>(n_tiles),
+                n_train,
                 iter,
                 0);
         }
@@ -1006,6 +1874,7 @@ optimize(const std::vector<double> &training_input,
                 sek_params,
                 n_tile_size,
                 static_cast<std::size_t>(n_tiles),
+                n_train,
                 iter,
                 1);
         }
@@ -1019,6 +1888,7 @@ optimize(const std::vector<double> &training_input,
                 sek_params,
                 n_tile_size,
                 static_cast<std::size_t>(n_tiles),
+                n_train,
                 iter,
                 2);
         }
@@ -1070,6 +1940,12 @@ double optimize_step(const std::vector<double> &training_input,
      *     - theta_T = theta_T-1 - nu_T * m_T / (sqrt(w_T) + epsilon)
      */
 
+    // Number of training samples, the last tile may be smaller
+    const std::size_t n_train = compute_n_samples(static_cast<std::size_t>(n_tiles),
+                                                  static_cast<std::size_t>(n_tile_size),
+                                                  training_input.size(),
+                                                  static_cast<std::size_t>(n_regressors));
+
     // data holder for loss
     hpx::shared_future<double> loss_value;
 
@@ -1096,8 +1972,8 @@ double optimize_step(const std::vector<double> &training_input,
     // Launch asynchronous assembly of output y
     for (std::size_t i = 0; i < static_cast<std::size_t>(n_tiles); i++)
     {
-        y_tiles.push_back(
-            hpx::async(hpx::annotated_function(gen_tile_output, "assemble_y"), i, n_tile_size, training_output));
+        y_tiles.push_back(hpx::async(
+            hpx::annotated_function(gen_tile_output<double>, "assemble_y"), i, n_tile_size, n_train, training_output));
     }
 
     //////////////////////////////////////////////////////////////////////////////
@@ -1116,6 +1992,7 @@ double optimize_step(const std::vector<double> &training_input,
                 i,
                 j,
                 n_tile_size,
+                n_train,
                 n_regressors,
                 sek_params,
                 training_input);
@@ -1125,6 +2002,7 @@ double optimize_step(const std::vector<double> &training_input,
                 i,
                 j,
                 n_tile_size,
+                n_train,
                 sek_params,
                 cov_dists);
 
@@ -1132,15 +2010,14 @@ double optimize_step(const std::vector<double> &training_input,
             {
                 grad_l_tiles[i * static_cast<std::size_t>(n_tiles) + j] = hpx::dataflow(
                     hpx::annotated_function(hpx::unwrapping(&gen_tile_grad_l), "assemble_gradl"),
-                    n_tile_size,
                     sek_params,
                     cov_dists);
                 if (i != j)
                 {
                     grad_l_tiles[j * static_cast<std::size_t>(n_tiles) + i] = hpx::dataflow(
-                        hpx::annotated_function(hpx::unwrapping(&gen_tile_transpose), "assemble_gradl_t"),
-                        n_tile_size,
-                        n_tile_size,
+                        hpx::annotated_function(hpx::unwrapping(&gen_tile_transpose<double>), "assemble_gradl_t"),
+                        compute_tile_size(i, static_cast<std::size_t>(n_tile_size), n_train),
+                        compute_tile_size(j, static_cast<std::size_t>(n_tile_size), n_train),
                         grad_l_tiles[i * static_cast<std::size_t>(n_tiles) + j]);
                 }
             }
@@ -1149,15 +2026,14 @@ double optimize_step(const std::vector<double> &training_input,
             {
                 grad_v_tiles[i * static_cast<std::size_t>(n_tiles) + j] = hpx::dataflow(
                     hpx::annotated_function(hpx::unwrapping(&gen_tile_grad_v), "assemble_gradv"),
-                    n_tile_size,
                     sek_params,
                     cov_dists);
                 if (i != j)
                 {
                     grad_v_tiles[j * static_cast<std::size_t>(n_tiles) + i] = hpx::dataflow(
-                        hpx::annotated_function(hpx::unwrapping(&gen_tile_transpose), "assemble_gradv_t"),
-                        n_tile_size,
-                        n_tile_size,
+                        hpx::annotated_function(hpx::unwrapping(&gen_tile_transpose<double>), "assemble_gradv_t"),
+                        compute_tile_size(i, static_cast<std::size_t>(n_tile_size), n_train),
+                        compute_tile_size(j, static_cast<std::size_t>(n_tile_size), n_train),
                         grad_v_tiles[i * static_cast<std::size_t>(n_tiles) + j]);
                 }
             }
@@ -1167,7 +2043,8 @@ double optimize_step(const std::vector<double> &training_input,
     // Assembly with reallocation -> optimize to only set existing values
     for (std::size_t i = 0; i < static_cast<std::size_t>(n_tiles); i++)
     {
-        alpha_tiles[i] = hpx::async(hpx::annotated_function(gen_tile_zeros, "assemble_tiled"), n_tile_size);
+        alpha_tiles[i] = hpx::async(hpx::annotated_function(gen_tile_zeros<double>, "assemble_tiled"),
+                                     compute_tile_size(i, static_cast<std::size_t>(n_tile_size), n_train));
     }
 
     for (std::size_t i = 0; i < static_cast<std::size_t>(n_tiles); i++)
@@ -1177,19 +2054,22 @@ double optimize_step(const std::vector<double> &training_input,
             if (i == j)
             {
                 K_inv_tiles[i * static_cast<std::size_t>(n_tiles) + j] =
-                    hpx::async(hpx::annotated_function(gen_tile_identity, "assemble_identity_matrix"), n_tile_size);
+                    hpx::async(hpx::annotated_function(gen_tile_identity<double>, "assemble_identity_matrix"),
+                               compute_tile_size(i, static_cast<std::size_t>(n_tile_size), n_train));
             }
             else
             {
                 K_inv_tiles[i * static_cast<std::size_t>(n_tiles) + j] = hpx::async(
-                    hpx::annotated_function(gen_tile_zeros, "assemble_identity_matrix"), n_tile_size * n_tile_size);
+                    hpx::annotated_function(gen_tile_zeros<double>, "assemble_identity_matrix"),
+                    compute_tile_size(i, static_cast<std::size_t>(n_tile_size), n_train)
+                        * compute_tile_size(j, static_cast<std::size_t>(n_tile_size), n_train));
             }
         }
     }
 
     ///////////////////////////////////////////////////////////////////////////
     // Launch asynchronous Cholesky decomposition: K = L * L^T
-    right_looking_cholesky_tiled(K_tiles, n_tile_size, static_cast<std::size_t>(n_tiles));
+    right_looking_cholesky_tiled(K_tiles, n_tile_size, static_cast<std::size_t>(n_tiles), n_train);
 
     ///////////////////////////////////////////////////////////////////////////
     // Launch asynchronous compute K^-1 through L* (L^T * X) = I
@@ -1199,14 +2079,18 @@ double optimize_step(const std::vector<double> &training_input,
         n_tile_size,
         n_tile_size,
         static_cast<std::size_t>(n_tiles),
-        static_cast<std::size_t>(n_tiles));
+        static_cast<std::size_t>(n_tiles),
+        n_train,
+        n_train);
     backward_solve_tiled_matrix(
         K_tiles,
         K_inv_tiles,
         n_tile_size,
         n_tile_size,
         static_cast<std::size_t>(n_tiles),
-        static_cast<std::size_t>(n_tiles));
+        static_cast<std::size_t>(n_tiles),
+        n_train,
+        n_train);
 
     ///////////////////////////////////////////////////////////////////////////
     // Launch asynchronous compute beta = inv(K) * y
@@ -1217,12 +2101,15 @@ double optimize_step(const std::vector<double> &training_input,
         n_tile_size,
         n_tile_size,
         static_cast<std::size_t>(n_tiles),
-        static_cast<std::size_t>(n_tiles));
+        static_cast<std::size_t>(n_tiles),
+        n_train,
+        n_train);
 
     ///////////////////////////////////////////////////////////////////////////
     // Launch asynchronous loss computation where
     // loss(theta) = 0.5 * ( log(det(K)) - y^T * K^-1 * y - N * log(2 * pi) )
-    compute_loss_tiled(K_tiles, alpha_tiles, y_tiles, loss_value, n_tile_size, static_cast<std::size_t>(n_tiles));
+    compute_loss_tiled(
+        K_tiles, alpha_tiles, y_tiles, loss_value, n_tile_size, static_cast<std::size_t>(n_tiles), n_train);
 
     ///////////////////////////////////////////////////////////////////////////
     // Launch asynchronous update of the hyperparameters
@@ -1236,6 +2123,7 @@ double optimize_step(const std::vector<double> &training_input,
             sek_params,
             n_tile_size,
             static_cast<std::size_t>(n_tiles),
+            n_train,
             static_cast<std::size_t>(iter),
             0);
     }
@@ -1249,6 +2137,7 @@ double optimize_step(const std::vector<double> &training_input,
             sek_params,
             n_tile_size,
             static_cast<std::size_t>(n_tiles),
+            n_train,
             static_cast<std::size_t>(iter),
             1);
     }
@@ -1262,10 +2151,139 @@ double optimize_step(const std::vector<double> &training_input,
             sek_params,
             n_tile_size,
             static_cast<std::size_t>(n_tiles),
+            n_train,
             static_cast<std::size_t>(iter),
             2);
     }
     return loss_value.get();
 }
 
+// Explicit instantiations for the supported precisions
+
+template std::vector<float> predict<float>(
+    const std::vector<double> &,
+    const std::vector<double> &,
+    const std::vector<double> &,
+    const gprat_hyper::SEKParams &,
+    int,
+    int,
+    int,
+    int,
+    int);
+template std::vector<std::vector<float>> predict_with_uncertainty<float>(
+    const std::vector<double> &,
+    const std::vector<double> &,
+    const std::vector<double> &,
+    const gprat_hyper::SEKParams &,
+    int,
+    int,
+    int,
+    int,
+    int);
+template std::vector<std::vector<float>> predict_with_full_cov<float>(
+    const std::vector<double> &,
+    const std::vector<double> &,
+    const std::vector<double> &,
+    const gprat_hyper::SEKParams &,
+    int,
+    int,
+    int,
+    int,
+    int);
+
+template std::vector<std::vector<float>> predict_with_uncertainty_streaming<float>(
+    const std::vector<double> &,
+    const std::vector<double> &,
+    const std::vector<double> &,
+    const gprat_hyper::SEKParams &,
+    int,
+    int,
+    int,
+    int,
+    int);
+
+template std::size_t predict_chunked<float>(const std::vector<double> &,
+                                             const std::vector<double> &,
+                                             const gprat_hyper::SEKParams &,
+                                             int,
+                                             int,
+                                             int,
+                                             const TestChunkSource &,
+                                             const PredictionChunkSink<float> &,
+                                             bool);
+
+template std::vector<double> predict<double>(
+    const std::vector<double> &,
+    const std::vector<double> &,
+    const std::vector<double> &,
+    const gprat_hyper::SEKParams &,
+    int,
+    int,
+    int,
+    int,
+    int);
+template std::vector<std::vector<double>> predict_with_uncertainty<double>(
+    const std::vector<double> &,
+    const std::vector<double> &,
+    const std::vector<double> &,
+    const gprat_hyper::SEKParams &,
+    int,
+    int,
+    int,
+    int,
+    int);
+template std::vector<std::vector<double>> predict_with_full_cov<double>(
+    const std::vector<double> &,
+    const std::vector<double> &,
+    const std::vector<double> &,
+    const gprat_hyper::SEKParams &,
+    int,
+    int,
+    int,
+    int,
+    int);
+
+template std::vector<std::vector<double>> predict_with_uncertainty_streaming<double>(
+    const std::vector<double> &,
+    const std::vector<double> &,
+    const std::vector<double> &,
+    const gprat_hyper::SEKParams &,
+    int,
+    int,
+    int,
+    int,
+    int);
+
+template std::size_t predict_chunked<double>(const std::vector<double> &,
+                                             const std::vector<double> &,
+                                             const gprat_hyper::SEKParams &,
+                                             int,
+                                             int,
+                                             int,
+                                             const TestChunkSource &,
+                                             const PredictionChunkSink<double> &,
+                                             bool);
+
+// FP64 predictions with the cross-covariance tiles stored in FP32
+template std::vector<std::vector<double>> predict_with_uncertainty<double, float>(
+    const std::vector<double> &,
+    const std::vector<double> &,
+    const std::vector<double> &,
+    const gprat_hyper::SEKParams &,
+    int,
+    int,
+    int,
+    int,
+    int);
+template std::vector<std::vector<double>> predict_with_full_cov<double, float>(
+    const std::vector<double> &,
+    const std::vector<double> &,
+    const std::vector<double> &,
+    const gprat_hyper::SEKParams &,
+    int,
+    int,
+    int,
+    int,
+    int);
+
 }  // end of namespace cpu
@@ -0,0 +1,173 @@
+#include "cpu/gp_functions_contiguous.hpp"
+
+#include "cpu/adapter_cblas_fp64.hpp"
+#include "cpu/gp_algorithms.hpp"
+#include "cpu/gp_optimizer.hpp"
+#include "cpu/gp_uncertainty.hpp"
+#include "cpu/tiled_algorithms.hpp"
+#include <hpx/future.hpp>
+
+namespace cpu
+{
+
+namespace
+{
+
+/**
+ * @brief Assemble the covariance matrix K and compute its Cholesky factor L.
+ */
+vector_future compute_cholesky_factor(const std::vector<double> &training_input,
+                                      const gprat_hyper::SEKParams &sek_params,
+                                      int n_train,
+                                      int n_regressors)
+{
+    const std::size_t N = static_cast<std::size_t>(n_train);
+    const std::size_t n_reg = static_cast<std::size_t>(n_regressors);
+    // POTRF: K = L * L^T, no other tasks compete for the worker threads
+    return hpx::make_ready_future(potrf_threaded<double>(
+        hpx::make_ready_future(gen_tile_covariance(0, 0, N, N, n_reg, sek_params, training_input)),
+        n_train,
+        compute_blas_threads(0)));
+}
+
+/**
+ * @brief Compute alpha = K^-1 * y with the Cholesky factor L of K.
+ */
+vector_future compute_alpha(const vector_future &f_L, const std::vector<double> &training_output, int n_train)
+{
+    const std::size_t N = static_cast<std::size_t>(n_train);
+    // POTRS: L * L^T * alpha = y
+    return hpx::make_ready_future(
+        potrs<double>(f_L, hpx::make_ready_future(gen_tile_output(0, N, N, training_output)), n_train));
+}
+
+}  // namespace
+
+std::vector<double> predict_contiguous(const std::vector<double> &training_input,
+                                       const std::vector<double> &training_output,
+                                       const std::vector<double> &test_input,
+                                       const gprat_hyper::SEKParams &sek_params,
+                                       int n_train,
+                                       int n_test,
+                                       int n_regressors)
+{
+    const std::size_t N = static_cast<std::size_t>(n_train);
+    const std::size_t M = static_cast<std::size_t>(n_test);
+    const std::size_t n_reg = static_cast<std::size_t>(n_regressors);
+
+    vector_future f_L = compute_cholesky_factor(training_input, sek_params, n_train, n_regressors);
+    vector_future f_alpha = compute_alpha(f_L, training_output, n_train);
+
+    // GEMV: hat(y) = cross(K) * alpha
+    return gemv<double>(hpx::make_ready_future(
+                            gen_tile_cross_covariance(0, 0, M, N, M, N, n_reg, sek_params, test_input, training_input)),
+                        f_alpha,
+                        hpx::make_ready_future(gen_tile_zeros(M)),
+                        n_test,
+                        n_train,
+                        Blas_add,
+                        Blas_no_trans);
+}
+
+std::vector<std::vector<double>> predict_with_uncertainty_contiguous(
+    const std::vector<double> &training_input,
+    const std::vector<double> &training_output,
+    const std::vector<double> &test_input,
+    const gprat_hyper::SEKParams &sek_params,
+    int n_train,
+    int n_test,
+    int n_regressors)
+{
+    const std::size_t N = static_cast<std::size_t>(n_train);
+    const std::size_t M = static_cast<std::size_t>(n_test);
+    const std::size_t n_reg = static_cast<std::size_t>(n_regressors);
+
+    vector_future f_L = compute_cholesky_factor(training_input, sek_params, n_train, n_regressors);
+    vector_future f_alpha = compute_alpha(f_L, training_output, n_train);
+    // The kernel is symmetric, such that cross(K)^T is assembled without transposition
+    vector_future f_t_cross_covariance = hpx::make_ready_future(
+        gen_tile_cross_covariance(0, 0, N, M, N, M, n_reg, sek_params, training_input, test_input));
+
+    // GEMV: hat(y) = (cross(K)^T)^T * alpha
+    std::vector<double> prediction = gemv<double>(f_t_cross_covariance,
+                                                  f_alpha,
+                                                  hpx::make_ready_future(gen_tile_zeros(M)),
+                                                  n_train,
+                                                  n_test,
+                                                  Blas_add,
+                                                  Blas_trans);
+
+    // TRSM: L * V = cross(K)^T
+    vector_future f_V = hpx::make_ready_future(
+        trsm<double>(f_L, f_t_cross_covariance, n_train, n_test, Blas_no_trans, Blas_left));
+    // diag(W) = diag(V^T * V)
+    vector_future f_W = hpx::make_ready_future(
+        dot_diag_syrk<double>(f_V, hpx::make_ready_future(gen_tile_zeros(M)), n_train, n_test));
+    // diag(Sigma) = diag(prior(K)) - diag(W)
+    std::vector<double> uncertainty = axpy<double>(
+        hpx::make_ready_future(gen_tile_prior_covariance(0, 0, M, M, n_reg, sek_params, test_input)), f_W, n_test);
+
+    return std::vector<std::vector<double>>{ std::move(prediction), std::move(uncertainty) };
+}
+
+std::vector<std::vector<double>> predict_with_full_cov_contiguous(
+    const std::vector<double> &training_input,
+    const std::vector<double> &training_output,
+    const std::vector<double> &test_input,
+    const gprat_hyper::SEKParams &sek_params,
+    int n_train,
+    int n_test,
+    int n_regressors)
+{
+    const std::size_t N = static_cast<std::size_t>(n_train);
+    const std::size_t M = static_cast<std::size_t>(n_test);
+    const std::size_t n_reg = static_cast<std::size_t>(n_regressors);
+
+    vector_future f_L = compute_cholesky_factor(training_input, sek_params, n_train, n_regressors);
+    vector_future f_alpha = compute_alpha(f_L, training_output, n_train);
+    // The kernel is symmetric, such that cross(K)^T is assembled without transposition
+    vector_future f_t_cross_covariance = hpx::make_ready_future(
+        gen_tile_cross_covariance(0, 0, N, M, N, M, n_reg, sek_params, training_input, test_input));
+
+    // GEMV: hat(y) = (cross(K)^T)^T * alpha
+    std::vector<double> prediction = gemv<double>(f_t_cross_covariance,
+                                                  f_alpha,
+                                                  hpx::make_ready_future(gen_tile_zeros(M)),
+                                                  n_train,
+                                                  n_test,
+                                                  Blas_add,
+                                                  Blas_trans);
+
+    // TRSM: L * V = cross(K)^T
+    vector_future f_V = hpx::make_ready_future(
+        trsm<double>(f_L, f_t_cross_covariance, n_train, n_test, Blas_no_trans, Blas_left));
+    // SYRK: Sigma = prior(K) - V^T * V, only the lower triangle is updated
+    vector_future f_Sigma = hpx::make_ready_future(
+        syrk<double>(hpx::make_ready_future(gen_tile_full_prior_covariance(0, 0, M, M, n_reg, sek_params, test_input)),
+                     f_V,
+                     n_test,
+                     n_train,
+                     Blas_trans));
+    // diag(Sigma)
+    std::vector<double> uncertainty = get_matrix_diagonal(f_Sigma, M).get();
+
+    return std::vector<std::vector<double>>{ std::move(prediction), std::move(uncertainty) };
+}
+
+double compute_loss_contiguous(const std::vector<double> &training_input,
+                               const std::vector<double> &training_output,
+                               const gprat_hyper::SEKParams &sek_params,
+                               int n_train,
+                               int n_regressors)
+{
+    const std::size_t N = static_cast<std::size_t>(n_train);
+
+    vector_future f_L = compute_cholesky_factor(training_input, sek_params, n_train, n_regressors);
+    vector_future f_alpha = compute_alpha(f_L, training_output, n_train);
+
+    // loss = 0.5 * ( y^T * alpha + sum_i^N log(L_ii^2) + N * log(2 * pi) ) / N
+    const double loss = compute_loss(f_L.get(), f_alpha.get(), gen_tile_output(0, N, N, training_output), N);
+    return add_losses(std::vector<double>{ loss }, N);
+}
+
+}  // end of namespace cpu
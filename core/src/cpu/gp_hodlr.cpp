@@ -0,0 +1,490 @@
+#include "cpu/gp_hodlr.hpp"
+
+#include "cpu/gp_algorithms.hpp"
+#include "cpu/gp_optimizer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <hpx/future.hpp>
+#include <stdexcept>
+
+#ifdef GPRAT_ENABLE_MKL
+// MKL CBLAS and LAPACKE
+#include "mkl_cblas.h"
+#include "mkl_lapacke.h"
+#else
+#include "cblas.h"
+#include "lapacke.h"
+#endif
+
+namespace cpu
+{
+
+HODLRMatrix::HODLRMatrix(const std::vector<double> &input,
+                         const gprat_hyper::SEKParams &sek_params,
+                         int n_tiles,
+                         int n_tile_size,
+                         int n_regressors,
+                         double tolerance) :
+    tile_size_(static_cast<std::size_t>(n_tile_size))
+{
+    const std::size_t n_reg = static_cast<std::size_t>(n_regressors);
+    const std::size_t n_t = static_cast<std::size_t>(n_tiles);
+    const std::size_t n_samples = compute_n_samples(n_t, tile_size_, input.size(), n_reg);
+    nodes_.reserve(2 * n_t);
+    build(0, n_t, n_samples);
+    factorize(0, input, sek_params, n_reg, tolerance);
+}
+
+std::size_t HODLRMatrix::build(std::size_t first_tile, std::size_t last_tile, std::size_t n_samples)
+{
+    const std::size_t index = nodes_.size();
+    Node node;
+    node.begin = first_tile * tile_size_;
+    node.end = std::min(last_tile * tile_size_, n_samples);
+    node.left = 0;
+    node.right = 0;
+    node.log_det = 0.0;
+    nodes_.push_back(std::move(node));
+    if (last_tile - first_tile > 1)
+    {
+        const std::size_t middle_tile = (first_tile + last_tile) / 2;
+        const std::size_t left = build(first_tile, middle_tile, n_samples);
+        const std::size_t right = build(middle_tile, last_tile, n_samples);
+        nodes_[index].left = left;
+        nodes_[index].right = right;
+    }
+    return index;
+}
+
+void HODLRMatrix::factorize(std::size_t index,
+                            const std::vector<double> &input,
+                            const gprat_hyper::SEKParams &sek_params,
+                            std::size_t n_regressors,
+                            double tolerance)
+{
+    Node &node = nodes_[index];
+    const std::size_t n = node.end - node.begin;
+    if (node.left == 0)
+    {
+        // Leaf: dense Cholesky decomposition of the diagonal tile
+        const std::size_t tile = node.begin / tile_size_;
+        node.L = gen_tile_covariance<double>(tile, tile, tile_size_, size(), n_regressors, sek_params, input);
+        LAPACKE_dpotrf(LAPACK_ROW_MAJOR, 'L', static_cast<int>(n), node.L.data(), static_cast<int>(n));
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            node.log_det += 2.0 * std::log(node.L[i * n + i]);
+        }
+        return;
+    }
+
+    // The children and the off-diagonal block are independent
+    hpx::future<void> left_done = hpx::async(
+        hpx::annotated_function([&]() { factorize(node.left, input, sek_params, n_regressors, tolerance); },
+                                "hodlr_factorize"));
+    hpx::future<void> right_done = hpx::async(
+        hpx::annotated_function([&]() { factorize(node.right, input, sek_params, n_regressors, tolerance); },
+                                "hodlr_factorize"));
+    const std::size_t middle = nodes_[node.left].end;
+    const std::size_t n_left = middle - node.begin;
+    const std::size_t n_right = node.end - middle;
+    node.off_diagonal = gen_block_cross_covariance_low_rank(
+        middle, node.begin, n_right, n_left, n_regressors, sek_params, input, input, tolerance);
+    left_done.get();
+    right_done.get();
+
+    node.log_det = nodes_[node.left].log_det + nodes_[node.right].log_det;
+    const std::size_t r = node.off_diagonal.rank;
+    if (r == 0)
+    {
+        // Block diagonal
+        return;
+    }
+
+    // Y_left = K_1^-1 * V and Y_right = K_2^-1 * U
+    hpx::future<std::vector<double>> Y_left =
+        hpx::async(hpx::annotated_function([&]() { return solve(node.left, node.off_diagonal.V, r); }, "hodlr_solve"));
+    node.Y_right = solve(node.right, node.off_diagonal.U, r);
+    node.Y_left = Y_left.get();
+
+    // S = [V^T * K_1^-1 * V, I; I, U^T * K_2^-1 * U]
+    const std::size_t s = 2 * r;
+    node.S.assign(s * s, 0.0);
+    cblas_dgemm(CblasRowMajor,
+                CblasTrans,
+                CblasNoTrans,
+                static_cast<int>(r),
+                static_cast<int>(r),
+                static_cast<int>(n_left),
+                1.0,
+                node.off_diagonal.V.data(),
+                static_cast<int>(r),
+                node.Y_left.data(),
+                static_cast<int>(r),
+                0.0,
+                node.S.data(),
+                static_cast<int>(s));
+    cblas_dgemm(CblasRowMajor,
+                CblasTrans,
+                CblasNoTrans,
+                static_cast<int>(r),
+                static_cast<int>(r),
+                static_cast<int>(n_right),
+                1.0,
+                node.off_diagonal.U.data(),
+                static_cast<int>(r),
+                node.Y_right.data(),
+                static_cast<int>(r),
+                0.0,
+                node.S.data() + r * s + r,
+                static_cast<int>(s));
+    for (std::size_t i = 0; i < r; ++i)
+    {
+        node.S[i * s + r + i] = 1.0;
+        node.S[(r + i) * s + i] = 1.0;
+    }
+    node.pivots.resize(s);
+    LAPACKE_dgetrf(LAPACK_ROW_MAJOR,
+                   static_cast<int>(s),
+                   static_cast<int>(s),
+                   node.S.data(),
+                   static_cast<int>(s),
+                   node.pivots.data());
+
+    // Matrix determinant lemma: |det(K)| = det(K_1) * det(K_2) * |det(S)|
+    for (std::size_t i = 0; i < s; ++i)
+    {
+        node.log_det += std::log(std::abs(node.S[i * s + i]));
+    }
+}
+
+std::vector<double> HODLRMatrix::solve(std::size_t index, std::vector<double> B, std::size_t n_columns) const
+{
+    const Node &node = nodes_[index];
+    const std::size_t k = n_columns;
+    if (node.left == 0)
+    {
+        // Leaf: L * L^T * X = B
+        const std::size_t n = node.end - node.begin;
+        for (const CBLAS_TRANSPOSE transpose : { CblasNoTrans, CblasTrans })
+        {
+            cblas_dtrsm(CblasRowMajor,
+                        CblasLeft,
+                        CblasLower,
+                        transpose,
+                        CblasNonUnit,
+                        static_cast<int>(n),
+                        static_cast<int>(k),
+                        1.0,
+                        node.L.data(),
+                        static_cast<int>(n),
+                        B.data(),
+                        static_cast<int>(k));
+        }
+        return B;
+    }
+
+    // Y = diag(K_1, K_2)^-1 * B, the children in parallel
+    const std::size_t n_left = nodes_[node.left].end - node.begin;
+    const std::size_t n_right = node.end - nodes_[node.left].end;
+    const auto split = B.begin() + static_cast<std::ptrdiff_t>(n_left * k);
+    std::vector<double> B_left(B.begin(), split);
+    std::vector<double> B_right(split, B.end());
+    hpx::future<std::vector<double>> Y_left = hpx::async(hpx::annotated_function(
+        [&, B_left = std::move(B_left)]() mutable { return solve(node.left, std::move(B_left), k); }, "hodlr_solve"));
+    std::vector<double> Y_right = solve(node.right, std::move(B_right), k);
+    std::vector<double> X = Y_left.get();
+    X.insert(X.end(), Y_right.begin(), Y_right.end());
+
+    const std::size_t r = node.off_diagonal.rank;
+    if (r == 0)
+    {
+        return X;
+    }
+
+    // Woodbury identity: X = Y - diag(K_1^-1 * V, K_2^-1 * U) * S^-1 * [V^T * Y_1; U^T * Y_2]
+    const std::size_t s = 2 * r;
+    std::vector<double> T(s * k);
+    cblas_dgemm(CblasRowMajor,
+                CblasTrans,
+                CblasNoTrans,
+                static_cast<int>(r),
+                static_cast<int>(k),
+                static_cast<int>(n_left),
+                1.0,
+                node.off_diagonal.V.data(),
+                static_cast<int>(r),
+                X.data(),
+                static_cast<int>(k),
+                0.0,
+                T.data(),
+                static_cast<int>(k));
+    cblas_dgemm(CblasRowMajor,
+                CblasTrans,
+                CblasNoTrans,
+                static_cast<int>(r),
+                static_cast<int>(k),
+                static_cast<int>(n_right),
+                1.0,
+                node.off_diagonal.U.data(),
+                static_cast<int>(r),
+                X.data() + n_left * k,
+                static_cast<int>(k),
+                0.0,
+                T.data() + r * k,
+                static_cast<int>(k));
+    LAPACKE_dgetrs(LAPACK_ROW_MAJOR,
+                   'N',
+                   static_cast<int>(s),
+                   static_cast<int>(k),
+                   node.S.data(),
+                   static_cast<int>(s),
+                   node.pivots.data(),
+                   T.data(),
+                   static_cast<int>(k));
+    cblas_dgemm(CblasRowMajor,
+                CblasNoTrans,
+                CblasNoTrans,
+                static_cast<int>(n_left),
+                static_cast<int>(k),
+                static_cast<int>(r),
+                -1.0,
+                node.Y_left.data(),
+                static_cast<int>(r),
+                T.data(),
+                static_cast<int>(k),
+                1.0,
+                X.data(),
+                static_cast<int>(k));
+    cblas_dgemm(CblasRowMajor,
+                CblasNoTrans,
+                CblasNoTrans,
+                static_cast<int>(n_right),
+                static_cast<int>(k),
+                static_cast<int>(r),
+                -1.0,
+                node.Y_right.data(),
+                static_cast<int>(r),
+                T.data() + r * k,
+                static_cast<int>(k),
+                1.0,
+                X.data() + n_left * k,
+                static_cast<int>(k));
+    return X;
+}
+
+std::vector<double> HODLRMatrix::solve(const std::vector<double> &B, std::size_t n_columns) const
+{
+    if (B.size() != size() * n_columns)
+    {
+        throw std::invalid_argument("The right-hand side does not match the size of the HODLR matrix");
+    }
+    return solve(0, B, n_columns);
+}
+
+double HODLRMatrix::log_determinant() const { return nodes_.front().log_det; }
+
+std::size_t HODLRMatrix::size() const { return nodes_.front().end; }
+
+namespace
+{
+
+/**
+ * @brief Assemble the dense cross-covariance matrix between the training and test samples
+ * in row-major order.
+ */
+std::vector<double> assemble_cross_covariance(const std::vector<double> &training_input,
+                                              const std::vector<double> &test_input,
+                                              const gprat_hyper::SEKParams &sek_params,
+                                              std::size_t n_tiles,
+                                              std::size_t N,
+                                              std::size_t n_train,
+                                              std::size_t m_tiles,
+                                              std::size_t M,
+                                              std::size_t n_test,
+                                              std::size_t n_regressors)
+{
+    std::vector<hpx::future<std::vector<double>>> tiles;
+    tiles.reserve(n_tiles * m_tiles);
+    for (std::size_t i = 0; i < n_tiles; i++)
+    {
+        for (std::size_t j = 0; j < m_tiles; j++)
+        {
+            tiles.push_back(hpx::async(hpx::annotated_function(gen_tile_cross_covariance<double>, "assemble_pred"),
+                                       i,
+                                       j,
+                                       N,
+                                       M,
+                                       n_train,
+                                       n_test,
+                                       n_regressors,
+                                       sek_params,
+                                       training_input,
+                                       test_input));
+        }
+    }
+
+    std::vector<double> cross_covariance(n_train * n_test);
+    for (std::size_t i = 0; i < n_tiles; i++)
+    {
+        const std::size_t N_i = compute_tile_size(i, N, n_train);
+        for (std::size_t j = 0; j < m_tiles; j++)
+        {
+            const std::size_t M_j = compute_tile_size(j, M, n_test);
+            const std::vector<double> tile = tiles[i * m_tiles + j].get();
+            for (std::size_t k = 0; k < N_i; k++)
+            {
+                std::copy(tile.begin() + static_cast<std::ptrdiff_t>(k * M_j),
+                          tile.begin() + static_cast<std::ptrdiff_t>((k + 1) * M_j),
+                          cross_covariance.begin() + static_cast<std::ptrdiff_t>((i * N + k) * n_test + j * M));
+            }
+        }
+    }
+    return cross_covariance;
+}
+
+/**
+ * @brief Compute alpha = K^-1 * y with the HODLR solver.
+ */
+std::vector<double> solve_training_output(const HODLRMatrix &K, const std::vector<double> &training_output)
+{
+    const std::vector<double> y(training_output.begin(),
+                                training_output.begin() + static_cast<std::ptrdiff_t>(K.size()));
+    return K.solve(y, 1);
+}
+
+}  // namespace
+
+std::vector<double> predict_hodlr(const std::vector<double> &training_input,
+                                  const std::vector<double> &training_output,
+                                  const std::vector<double> &test_input,
+                                  const gprat_hyper::SEKParams &sek_params,
+                                  int n_tiles,
+                                  int n_tile_size,
+                                  int m_tiles,
+                                  int m_tile_size,
+                                  int n_regressors,
+                                  double tolerance)
+{
+    /*
+     * Algorithm:
+     * 1: Compute the HODLR factorization of K
+     * 2: Compute alpha = K^-1 * y
+     * 3: Compute hat(y) = cross(K) * alpha
+     */
+    const std::size_t n_reg = static_cast<std::size_t>(n_regressors);
+    const std::size_t N = static_cast<std::size_t>(n_tile_size);
+    const std::size_t M = static_cast<std::size_t>(m_tile_size);
+    const std::size_t n_t = static_cast<std::size_t>(n_tiles);
+    const std::size_t m_t = static_cast<std::size_t>(m_tiles);
+    const std::size_t n_test = compute_n_samples(m_t, M, test_input.size(), n_reg);
+
+    const HODLRMatrix K(training_input, sek_params, n_tiles, n_tile_size, n_regressors, tolerance);
+    const std::size_t n_train = K.size();
+    const std::vector<double> alpha = solve_training_output(K, training_output);
+    const std::vector<double> cross_covariance =
+        assemble_cross_covariance(training_input, test_input, sek_params, n_t, N, n_train, m_t, M, n_test, n_reg);
+
+    std::vector<double> prediction(n_test);
+    cblas_dgemv(CblasRowMajor,
+                CblasTrans,
+                static_cast<int>(n_train),
+                static_cast<int>(n_test),
+                1.0,
+                cross_covariance.data(),
+                static_cast<int>(n_test),
+                alpha.data(),
+                1,
+                0.0,
+                prediction.data(),
+                1);
+    return prediction;
+}
+
+std::vector<std::vector<double>> predict_hodlr_with_uncertainty(const std::vector<double> &training_input,
+                                                                const std::vector<double> &training_output,
+                                                                const std::vector<double> &test_input,
+                                                                const gprat_hyper::SEKParams &sek_params,
+                                                                int n_tiles,
+                                                                int n_tile_size,
+                                                                int m_tiles,
+                                                                int m_tile_size,
+                                                                int n_regressors,
+                                                                double tolerance)
+{
+    /*
+     * Algorithm:
+     * 1: Compute the HODLR factorization of K
+     * 2: Compute alpha = K^-1 * y and hat(y) = cross(K) * alpha
+     * 3: Compute X = K^-1 * cross(K)^T with all test samples as right-hand sides
+     * 4: Compute diag(Sigma) = diag(prior(K)) - diag(cross(K) * X)
+     */
+    const std::size_t n_reg = static_cast<std::size_t>(n_regressors);
+    const std::size_t N = static_cast<std::size_t>(n_tile_size);
+    const std::size_t M = static_cast<std::size_t>(m_tile_size);
+    const std::size_t n_t = static_cast<std::size_t>(n_tiles);
+    const std::size_t m_t = static_cast<std::size_t>(m_tiles);
+    const std::size_t n_test = compute_n_samples(m_t, M, test_input.size(), n_reg);
+
+    const HODLRMatrix K(training_input, sek_params, n_tiles, n_tile_size, n_regressors, tolerance);
+    const std::size_t n_train = K.size();
+    hpx::future<std::vector<double>> alpha =
+        hpx::async(hpx::annotated_function(&solve_training_output, "hodlr_solve"), std::cref(K), training_output);
+    const std::vector<double> cross_covariance =
+        assemble_cross_covariance(training_input, test_input, sek_params, n_t, N, n_train, m_t, M, n_test, n_reg);
+    const std::vector<double> X = K.solve(cross_covariance, n_test);
+
+    std::vector<double> prediction(n_test);
+    cblas_dgemv(CblasRowMajor,
+                CblasTrans,
+                static_cast<int>(n_train),
+                static_cast<int>(n_test),
+                1.0,
+                cross_covariance.data(),
+                static_cast<int>(n_test),
+                alpha.get().data(),
+                1,
+                0.0,
+                prediction.data(),
+                1);
+
+    std::vector<double> uncertainty;
+    uncertainty.reserve(n_test);
+    for (std::size_t j = 0; j < m_t; j++)
+    {
+        const std::vector<double> prior_K =
+            gen_tile_prior_covariance<double>(j, j, M, n_test, n_reg, sek_params, test_input);
+        uncertainty.insert(uncertainty.end(), prior_K.begin(), prior_K.end());
+    }
+    for (std::size_t i = 0; i < n_train; i++)
+    {
+        for (std::size_t j = 0; j < n_test; j++)
+        {
+            uncertainty[j] -= cross_covariance[i * n_test + j] * X[i * n_test + j];
+        }
+    }
+    return std::vector<std::vector<double>>{ prediction, uncertainty };
+}
+
+double compute_loss_hodlr(const std::vector<double> &training_input,
+                          const std::vector<double> &training_output,
+                          const gprat_hyper::SEKParams &sek_params,
+                          int n_tiles,
+                          int n_tile_size,
+                          int n_regressors,
+                          double tolerance)
+{
+    /*
+     * Algorithm:
+     * 1: Compute the HODLR factorization of K
+     * 2: Compute alpha = K^-1 * y
+     * 3: Compute the loss from y^T * alpha and log(det(K)), see compute_loss
+     */
+    const HODLRMatrix K(training_input, sek_params, n_tiles, n_tile_size, n_regressors, tolerance);
+    const std::size_t n_train = K.size();
+    const std::vector<double> alpha = solve_training_output(K, training_output);
+    const double data_fit = cblas_ddot(static_cast<int>(n_train), training_output.data(), 1, alpha.data(), 1);
+    return add_losses(std::vector<double>{ data_fit + K.log_determinant() }, n_train);
+}
+
+}  // end of namespace cpu
@@ -1,6 +1,7 @@
 #include "cpu/gp_optimizer.hpp"
 
 #include "cpu/adapter_cblas_fp64.hpp"
+#include "cpu/gp_algorithms.hpp"
 #include <numbers>
 #include <numeric>
 
@@ -60,18 +61,21 @@ std::vector<double> gen_tile_distance(
     std::size_t row,
     std::size_t col,
     std::size_t N,
+    std::size_t n_samples,
     std::size_t n_regressors,
     const gprat_hyper::SEKParams &sek_params,
     const std::vector<double> &input)
 {
     std::size_t i_global, j_global;
+    const std::size_t N_row = compute_tile_size(row, N, n_samples);
+    const std::size_t N_col = compute_tile_size(col, N, n_samples);
     // Preallocate memory
     std::vector<double> tile;
-    tile.reserve(N * N);
-    for (std::size_t i = 0; i < N; i++)
+    tile.reserve(N_row * N_col);
+    for (std::size_t i = 0; i < N_row; i++)
     {
         i_global = N * row + i;
-        for (std::size_t j = 0; j < N; j++)
+        for (std::size_t j = 0; j < N_col; j++)
         {
             j_global = N * col + j;
             // compute covariance function
@@ -85,22 +89,25 @@ std::vector<double> gen_tile_covariance_with_distance(
     std::size_t row,
     std::size_t col,
     std::size_t N,
+    std::size_t n_samples,
     const gprat_hyper::SEKParams &sek_params,
     const std::vector<double> &distance)
 {
     std::size_t i_global, j_global;
     double covariance;
+    const std::size_t N_row = compute_tile_size(row, N, n_samples);
+    const std::size_t N_col = compute_tile_size(col, N, n_samples);
     // Preallocate required memory
     std::vector<double> tile;
-    tile.reserve(N * N);
-    for (std::size_t i = 0; i < N; i++)
+    tile.reserve(N_row * N_col);
+    for (std::size_t i = 0; i < N_row; i++)
     {
         i_global = N * row + i;
-        for (std::size_t j = 0; j < N; j++)
+        for (std::size_t j = 0; j < N_col; j++)
         {
             j_global = N * col + j;
             // compute covariance function
-            covariance = sek_params.vertical_lengthscale * exp(distance[i * N + j]);
+            covariance = sek_params.vertical_lengthscale * exp(distance[i * N_col + j]);
             if (i_global == j_global)
             {
                 // noise variance on diagonal
@@ -112,39 +119,31 @@ std::vector<double> gen_tile_covariance_with_distance(
     return tile;
 }
 
-std::vector<double>
-gen_tile_grad_v(std::size_t N, const gprat_hyper::SEKParams &sek_params, const std::vector<double> &distance)
+std::vector<double> gen_tile_grad_v(const gprat_hyper::SEKParams &sek_params, const std::vector<double> &distance)
 {
     // Preallocate required memory
     std::vector<double> tile;
-    tile.reserve(N * N);
+    tile.reserve(distance.size());
     double hyperparam_der = compute_sigmoid(to_unconstrained(sek_params.vertical_lengthscale, false));
-    for (std::size_t i = 0; i < N; i++)
+    for (std::size_t i = 0; i < distance.size(); i++)
     {
-        for (std::size_t j = 0; j < N; j++)
-        {
-            // compute derivative
-            tile.push_back(exp(distance[i * N + j]) * hyperparam_der);
-        }
+        // compute derivative
+        tile.push_back(exp(distance[i]) * hyperparam_der);
     }
     return tile;
 }
 
-std::vector<double>
-gen_tile_grad_l(std::size_t N, const gprat_hyper::SEKParams &sek_params, const std::vector<double> &distance)
+std::vector<double> gen_tile_grad_l(const gprat_hyper::SEKParams &sek_params, const std::vector<double> &distance)
 {
     // Preallocate required memory
     std::vector<double> tile;
-    tile.reserve(N * N);
+    tile.reserve(distance.size());
     double hyperparam_der = compute_sigmoid(to_unconstrained(sek_params.lengthscale, false));
     double factor = -2.0 * sek_params.vertical_lengthscale / sek_params.lengthscale;
-    for (std::size_t i = 0; i < N; i++)
+    for (std::size_t i = 0; i < distance.size(); i++)
     {
-        for (std::size_t j = 0; j < N; j++)
-        {
-            // compute derivative
-            tile.push_back(factor * distance[i * N + j] * exp(distance[i * N + j]) * hyperparam_der);
-        }
+        // compute derivative
+        tile.push_back(factor * distance[i] * exp(distance[i]) * hyperparam_der);
     }
     return tile;
 }
@@ -202,12 +201,12 @@ double compute_loss(const std::vector<double> &K_diag_tile,
     return l;
 }
 
-double add_losses(const std::vector<double> &losses, std::size_t N, std::size_t n_tiles)
+double add_losses(const std::vector<double> &losses, std::size_t n_samples)
 {
     // 0.5 * \sum losses + const
     double l = 0.0;
-    double Nn = static_cast<double>(N * n_tiles);
-    for (std::size_t i = 0; i < n_tiles; i++)
+    double Nn = static_cast<double>(n_samples);
+    for (std::size_t i = 0; i < losses.size(); i++)
     {
         // Add the squared difference to the error
         l += losses[i];
@@ -219,9 +218,9 @@ double add_losses(const std::vector<double> &losses, std::size_t N, std::size_t
 
 /////////////////////////////////////////////////////////////////////////
 // Gradient
-double compute_gradient(double trace, double dot, std::size_t N, std::size_t n_tiles)
+double compute_gradient(double trace, double dot, std::size_t n_samples)
 {
-    return 0.5 / static_cast<double>(N * n_tiles) * (trace - dot);
+    return 0.5 / static_cast<double>(n_samples) * (trace - dot);
 }
 
 double compute_trace(const std::vector<double> &diagonal, double trace)
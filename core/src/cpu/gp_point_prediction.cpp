@@ -0,0 +1,132 @@
+#include "cpu/gp_point_prediction.hpp"
+
+#include "cpu/adapter_cblas_fp64.hpp"
+#include "cpu/gp_algorithms.hpp"
+#include "cpu/tiled_algorithms.hpp"
+#include <cmath>
+#include <hpx/future.hpp>
+
+#ifdef GPRAT_ENABLE_MKL
+// MKL CBLAS
+#include "mkl_cblas.h"
+#else
+#include "cblas.h"
+#endif
+
+namespace cpu
+{
+
+namespace
+{
+
+/**
+ * @brief Compute the kernel row k(x) of a test point into the n_train entries of kernel_row.
+ *
+ * The squared distances are accumulated feature by feature over all training samples,
+ * such that the inner loops are contiguous and vectorize.
+ */
+void compute_kernel_row(const PointPredictionFactor &factor, const double *features, double *kernel_row)
+{
+    const std::size_t N = factor.n_train;
+#pragma omp simd
+    for (std::size_t j = 0; j < N; j++)
+    {
+        kernel_row[j] = 0.0;
+    }
+    for (std::size_t k = 0; k < factor.n_regressors; k++)
+    {
+        const double z_k = features[k];
+        const double *feature_k = factor.features.data() + k * N;
+#pragma omp simd
+        for (std::size_t j = 0; j < N; j++)
+        {
+            const double z_k_minus_z_jk = z_k - feature_k[j];
+            kernel_row[j] += z_k_minus_z_jk * z_k_minus_z_jk;
+        }
+    }
+    // k(z, z_j) = vertical_lengthscale * exp(-0.5 / lengthscale^2 * (z - z_j)^2)
+    const double scale = -0.5 / (factor.lengthscale * factor.lengthscale);
+#pragma omp simd
+    for (std::size_t j = 0; j < N; j++)
+    {
+        kernel_row[j] = factor.vertical_lengthscale * std::exp(scale * kernel_row[j]);
+    }
+}
+
+}  // namespace
+
+PointPredictionFactor compute_point_prediction_factor(const std::vector<double> &training_input,
+                                                      const std::vector<double> &training_output,
+                                                      const gprat_hyper::SEKParams &sek_params,
+                                                      int n_train,
+                                                      int n_regressors)
+{
+    const std::size_t N = static_cast<std::size_t>(n_train);
+    const std::size_t n_reg = static_cast<std::size_t>(n_regressors);
+
+    PointPredictionFactor factor;
+    factor.n_train = N;
+    factor.n_regressors = n_reg;
+    factor.lengthscale = sek_params.lengthscale;
+    factor.vertical_lengthscale = sek_params.vertical_lengthscale;
+
+    // Gather the lagged features of sample j, input[j + k], feature by feature
+    factor.features.resize(n_reg * N);
+    for (std::size_t k = 0; k < n_reg; k++)
+    {
+        for (std::size_t j = 0; j < N; j++)
+        {
+            factor.features[k * N + j] = training_input[j + k];
+        }
+    }
+
+    // POTRF: K = L * L^T, stored contiguously such that a prediction is a single TRSV.
+    // No other tasks compete for the worker threads.
+    vector_future f_L = hpx::make_ready_future(potrf_threaded<double>(
+        hpx::make_ready_future(gen_tile_covariance(0, 0, N, N, n_reg, sek_params, training_input)),
+        n_train,
+        compute_blas_threads(0)));
+    // POTRS: L * L^T * alpha = y
+    factor.alpha = potrs<double>(f_L, hpx::make_ready_future(gen_tile_output(0, N, N, training_output)), n_train);
+    factor.L = f_L.get();
+    return factor;
+}
+
+bool is_point_prediction_factor_current(const PointPredictionFactor &factor,
+                                        std::size_t params_generation,
+                                        int n_regressors)
+{
+    return factor.n_train != 0 && factor.params_generation == params_generation
+           && factor.n_regressors == static_cast<std::size_t>(n_regressors);
+}
+
+double predict_point(const PointPredictionFactor &factor, const double *features, double *workspace)
+{
+    compute_kernel_row(factor, features, workspace);
+    // DOT: hat(y) = k(x)^T * alpha
+    return cblas_ddot(static_cast<int>(factor.n_train), workspace, 1, factor.alpha.data(), 1);
+}
+
+std::pair<double, double>
+predict_point_with_uncertainty(const PointPredictionFactor &factor, const double *features, double *workspace)
+{
+    const int N = static_cast<int>(factor.n_train);
+    compute_kernel_row(factor, features, workspace);
+    // DOT: hat(y) = k(x)^T * alpha
+    const double prediction = cblas_ddot(N, workspace, 1, factor.alpha.data(), 1);
+    // TRSV: in-place solve L * v = k(x)
+    cblas_dtrsv(CblasRowMajor,
+                CblasLower,
+                CblasNoTrans,
+                CblasNonUnit,
+                N,
+                factor.L.data(),
+                N,
+                workspace,
+                1);
+    // sigma^2 = k(x, x) - v^T * v
+    const double uncertainty = factor.vertical_lengthscale - cblas_ddot(N, workspace, 1, workspace, 1);
+    return { prediction, uncertainty };
+}
+
+}  // end of namespace cpu
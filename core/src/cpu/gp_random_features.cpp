@@ -0,0 +1,339 @@
+#include "cpu/gp_random_features.hpp"
+
+#include "cpu/gp_algorithms.hpp"
+#include "cpu/gp_uncertainty.hpp"
+#include "cpu/tiled_algorithms.hpp"
+#include <cmath>
+#include <hpx/future.hpp>
+#include <numbers>
+#include <random>
+
+namespace cpu
+{
+
+namespace
+{
+
+/**
+ * @brief Scale a vector tile by a constant.
+ */
+std::vector<double> scale_tile(const std::vector<double> &tile, double value)
+{
+    std::vector<double> scaled(tile.size());
+    for (std::size_t i = 0; i < tile.size(); i++)
+    {
+        scaled[i] = value * tile[i];
+    }
+    return scaled;
+}
+
+/**
+ * @brief Compute the predictions and optionally the uncertainties of the random feature approximation.
+ */
+std::vector<std::vector<double>> random_feature_prediction(const std::vector<double> &training_input,
+                                                           const std::vector<double> &training_output,
+                                                           const std::vector<double> &test_input,
+                                                           const gprat_hyper::SEKParams &sek_params,
+                                                           int n_tiles,
+                                                           int n_tile_size,
+                                                           int d_tiles,
+                                                           int d_tile_size,
+                                                           int m_tiles,
+                                                           int m_tile_size,
+                                                           int n_regressors,
+                                                           int n_features,
+                                                           std::uint64_t seed,
+                                                           bool with_uncertainty)
+{
+    /*
+     * Bayesian linear regression on the features Phi_NxD:
+     * 1: Compute lower triangular part of A = Phi^T * Phi + noise_variance * I
+     * 2: Compute Cholesky factor L of A
+     * 3: Compute alpha = A^-1 * Phi^T * y
+     * 4: Compute prediction hat(y) = Phi_*^T * alpha
+     * 5: Compute uncertainty noise_variance * diag(V^T * V) with V = L^-1 * Phi_*^T
+     */
+    const std::size_t n_reg = static_cast<std::size_t>(n_regressors);
+    const std::size_t n_train = compute_n_samples(
+        static_cast<std::size_t>(n_tiles), static_cast<std::size_t>(n_tile_size), training_input.size(), n_reg);
+    const std::size_t n_test = compute_n_samples(
+        static_cast<std::size_t>(m_tiles), static_cast<std::size_t>(m_tile_size), test_input.size(), n_reg);
+    const std::size_t D = static_cast<std::size_t>(n_features);
+    const std::size_t N = static_cast<std::size_t>(n_tile_size);
+    const std::size_t M = static_cast<std::size_t>(m_tile_size);
+    const std::size_t F = static_cast<std::size_t>(d_tile_size);
+    const std::size_t f_tiles = static_cast<std::size_t>(d_tiles);
+    const std::size_t t_tiles = static_cast<std::size_t>(m_tiles);
+    const std::size_t s_tiles = static_cast<std::size_t>(n_tiles);
+
+    const RandomFeatureBasis basis = gen_random_feature_basis(D, n_reg, sek_params, seed);
+
+    // Tiled future data structures
+    Tiled_matrix features_tiles;       // Tiled Phi^T_DxN
+    Tiled_matrix A_tiles;              // Tiled A_DxD, afterwards containing its Cholesky factor
+    Tiled_vector alpha_tiles;          // Tiled weights alpha
+    Tiled_matrix test_features_tiles;  // Tiled Phi_*^T_DxM
+    Tiled_vector prediction_tiles;     // Tiled prediction
+
+    // Preallocate memory
+    features_tiles.reserve(f_tiles * s_tiles);
+    A_tiles.resize(f_tiles * f_tiles);  // No reserve because of triangular structure
+    alpha_tiles.reserve(f_tiles);
+    test_features_tiles.reserve(f_tiles * t_tiles);
+    prediction_tiles.reserve(t_tiles);
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Launch asynchronous assembly
+    for (std::size_t k = 0; k < f_tiles; k++)
+    {
+        for (std::size_t i = 0; i < s_tiles; i++)
+        {
+            features_tiles.push_back(
+                hpx::async(hpx::annotated_function(gen_tile_random_features, "assemble_tiled_features"),
+                           k,
+                           i,
+                           F,
+                           N,
+                           D,
+                           n_train,
+                           basis,
+                           training_input));
+        }
+        for (std::size_t l = 0; l <= k; l++)
+        {
+            A_tiles[k * f_tiles + l] =
+                hpx::async(hpx::annotated_function(gen_tile_zeros<double>, "assemble_tiled_A"),
+                           compute_tile_size(k, F, D) * compute_tile_size(l, F, D));
+        }
+        alpha_tiles.push_back(
+            hpx::async(hpx::annotated_function(gen_tile_zeros<double>, "assemble_tiled_alpha"),
+                       compute_tile_size(k, F, D)));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Launch asynchronous assembly of A = noise_variance * I - (-Phi^T * Phi)
+    symmetric_matrix_matrix_transpose_tiled(
+        features_tiles, A_tiles, d_tile_size, n_tile_size, f_tiles, s_tiles, D, n_train);
+    for (std::size_t k = 0; k < f_tiles; k++)
+    {
+        for (std::size_t l = 0; l <= k; l++)
+        {
+            A_tiles[k * f_tiles + l] =
+                hpx::dataflow(hpx::annotated_function(negate_matrix_add_diagonal<double>, "assemble_tiled_A"),
+                              A_tiles[k * f_tiles + l],
+                              k == l ? compute_tile_size(k, F, D) : 0,
+                              sek_params.noise_variance);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Launch asynchronous Cholesky decomposition: A = L * L^T
+    right_looking_cholesky_tiled(A_tiles, d_tile_size, f_tiles, D);
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Launch asynchronous triangular solve L * (L^T * alpha) = Phi^T * y
+    Tiled_vector y_tiles;
+    y_tiles.reserve(s_tiles);
+    for (std::size_t i = 0; i < s_tiles; i++)
+    {
+        y_tiles.push_back(hpx::async(hpx::annotated_function(gen_tile_output<double>, "assemble_tiled_y"),
+                                     i,
+                                     N,
+                                     n_train,
+                                     training_output));
+    }
+    matrix_vector_tiled(features_tiles, y_tiles, alpha_tiles, d_tile_size, n_tile_size, s_tiles, f_tiles, D, n_train);
+    forward_solve_tiled(A_tiles, alpha_tiles, d_tile_size, f_tiles, D);
+    backward_solve_tiled(A_tiles, alpha_tiles, d_tile_size, f_tiles, D);
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Launch asynchronous prediction: hat(y) = Phi_* * alpha
+    for (std::size_t k = 0; k < f_tiles; k++)
+    {
+        for (std::size_t t = 0; t < t_tiles; t++)
+        {
+            test_features_tiles.push_back(
+                hpx::async(hpx::annotated_function(gen_tile_random_features, "assemble_tiled_test_features"),
+                           k,
+                           t,
+                           F,
+                           M,
+                           D,
+                           n_test,
+                           basis,
+                           test_input));
+        }
+    }
+    for (std::size_t t = 0; t < t_tiles; t++)
+    {
+        prediction_tiles.push_back(
+            hpx::async(hpx::annotated_function(gen_tile_zeros<double>, "assemble_prediction"),
+                       compute_tile_size(t, M, n_test)));
+    }
+    transpose_matrix_vector_tiled(
+        test_features_tiles, alpha_tiles, prediction_tiles, d_tile_size, m_tile_size, f_tiles, t_tiles, D, n_test);
+
+    std::vector<double> prediction_result;
+    prediction_result.reserve(n_test);
+    std::vector<double> uncertainty_result;
+
+    if (with_uncertainty)
+    {
+        ///////////////////////////////////////////////////////////////////////////
+        // Launch asynchronous uncertainty: noise_variance * diag(V^T * V) with L * V = Phi_*^T
+        Tiled_vector uncertainty_tiles;
+        uncertainty_tiles.reserve(t_tiles);
+        for (std::size_t t = 0; t < t_tiles; t++)
+        {
+            uncertainty_tiles.push_back(
+                hpx::async(hpx::annotated_function(gen_tile_zeros<double>, "assemble_uncertainty"),
+                           compute_tile_size(t, M, n_test)));
+        }
+        forward_solve_tiled_matrix(
+            A_tiles, test_features_tiles, d_tile_size, m_tile_size, f_tiles, t_tiles, D, n_test);
+        symmetric_matrix_matrix_diagonal_tiled(
+            test_features_tiles, uncertainty_tiles, d_tile_size, m_tile_size, f_tiles, t_tiles, D, n_test);
+
+        uncertainty_result.reserve(n_test);
+        for (std::size_t t = 0; t < t_tiles; t++)
+        {
+            auto tile = hpx::dataflow(hpx::annotated_function(hpx::unwrapping(&scale_tile), "uncertainty_tiled"),
+                                      uncertainty_tiles[t],
+                                      sek_params.noise_variance)
+                            .get();
+            uncertainty_result.insert(uncertainty_result.end(), tile.begin(), tile.end());
+        }
+    }
+
+    for (std::size_t t = 0; t < t_tiles; t++)
+    {
+        auto tile = prediction_tiles[t].get();
+        prediction_result.insert(prediction_result.end(), tile.begin(), tile.end());
+    }
+    return std::vector<std::vector<double>>{ std::move(prediction_result), std::move(uncertainty_result) };
+}
+
+}  // namespace
+
+RandomFeatureBasis gen_random_feature_basis(std::size_t n_features,
+                                            std::size_t n_regressors,
+                                            const gprat_hyper::SEKParams &sek_params,
+                                            std::uint64_t seed)
+{
+    RandomFeatureBasis basis;
+    basis.n_features = n_features;
+    basis.n_regressors = n_regressors;
+    basis.amplitude = std::sqrt(2.0 * sek_params.vertical_lengthscale / static_cast<double>(n_features));
+    basis.frequencies.reserve(n_features * n_regressors);
+    basis.phases.reserve(n_features);
+
+    std::seed_seq seed_sequence{ seed };
+    std::mt19937_64 generator(seed_sequence);
+    std::normal_distribution<double> normal_distribution(0.0, 1.0);
+    std::uniform_real_distribution<double> uniform_distribution(0.0, 2.0 * std::numbers::pi);
+    // The spectral density of the squared exponential kernel is N(0, I / lengthscale^2)
+    for (std::size_t i = 0; i < n_features * n_regressors; i++)
+    {
+        basis.frequencies.push_back(normal_distribution(generator) / sek_params.lengthscale);
+    }
+    for (std::size_t i = 0; i < n_features; i++)
+    {
+        basis.phases.push_back(uniform_distribution(generator));
+    }
+    return basis;
+}
+
+std::vector<double> gen_tile_random_features(std::size_t row,
+                                             std::size_t col,
+                                             std::size_t N_row,
+                                             std::size_t N_col,
+                                             std::size_t n_row_samples,
+                                             std::size_t n_col_samples,
+                                             const RandomFeatureBasis &basis,
+                                             const std::vector<double> &input)
+{
+    const std::size_t tile_rows = compute_tile_size(row, N_row, n_row_samples);
+    const std::size_t tile_cols = compute_tile_size(col, N_col, n_col_samples);
+    // Preallocate required memory
+    std::vector<double> tile(tile_rows * tile_cols);
+    for (std::size_t i = 0; i < tile_rows; i++)
+    {
+        const std::size_t k = N_row * row + i;
+        const double *omega = basis.frequencies.data() + k * basis.n_regressors;
+        for (std::size_t j = 0; j < tile_cols; j++)
+        {
+            const std::size_t j_global = N_col * col + j;
+            // omega_k^T * z_j with the lagged features z_j
+            double projection = basis.phases[k];
+            for (std::size_t l = 0; l < basis.n_regressors; l++)
+            {
+                projection += omega[l] * input[j_global + l];
+            }
+            tile[i * tile_cols + j] = basis.amplitude * std::cos(projection);
+        }
+    }
+    return tile;
+}
+
+std::vector<double> predict_random_features(const std::vector<double> &training_input,
+                                            const std::vector<double> &training_output,
+                                            const std::vector<double> &test_input,
+                                            const gprat_hyper::SEKParams &sek_params,
+                                            int n_tiles,
+                                            int n_tile_size,
+                                            int d_tiles,
+                                            int d_tile_size,
+                                            int m_tiles,
+                                            int m_tile_size,
+                                            int n_regressors,
+                                            int n_features,
+                                            std::uint64_t seed)
+{
+    return random_feature_prediction(training_input,
+                                     training_output,
+                                     test_input,
+                                     sek_params,
+                                     n_tiles,
+                                     n_tile_size,
+                                     d_tiles,
+                                     d_tile_size,
+                                     m_tiles,
+                                     m_tile_size,
+                                     n_regressors,
+                                     n_features,
+                                     seed,
+                                     false)
+        .front();
+}
+
+std::vector<std::vector<double>> predict_random_features_with_uncertainty(const std::vector<double> &training_input,
+                                                                          const std::vector<double> &training_output,
+                                                                          const std::vector<double> &test_input,
+                                                                          const gprat_hyper::SEKParams &sek_params,
+                                                                          int n_tiles,
+                                                                          int n_tile_size,
+                                                                          int d_tiles,
+                                                                          int d_tile_size,
+                                                                          int m_tiles,
+                                                                          int m_tile_size,
+                                                                          int n_regressors,
+                                                                          int n_features,
+                                                                          std::uint64_t seed)
+{
+    return random_feature_prediction(training_input,
+                                     training_output,
+                                     test_input,
+                                     sek_params,
+                                     n_tiles,
+                                     n_tile_size,
+                                     d_tiles,
+                                     d_tile_size,
+                                     m_tiles,
+                                     m_tile_size,
+                                     n_regressors,
+                                     n_features,
+                                     seed,
+                                     true);
+}
+
+}  // end of namespace cpu
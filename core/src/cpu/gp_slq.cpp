@@ -0,0 +1,340 @@
+#include "cpu/gp_slq.hpp"
+
+#include "cpu/gp_algorithms.hpp"
+#include "cpu/gp_cg.hpp"
+#include "cpu/gp_optimizer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#ifdef GPRAT_ENABLE_MKL
+// MKL LAPACKE
+#include "mkl_lapacke.h"
+#else
+#include "lapacke.h"
+#endif
+
+namespace cpu
+{
+
+namespace
+{
+
+/**
+ * @brief Estimates of the loss and of the gradient terms of the hyperparameters
+ */
+struct SLQEstimate
+{
+    double loss;
+    /** @brief Estimates of trace(K^-1 * dK/dtheta_p) */
+    std::vector<double> trace;
+    /** @brief alpha^T * dK/dtheta_p * alpha */
+    std::vector<double> dot;
+};
+
+/**
+ * @brief Draw t Rademacher probe vectors, the columns of a row-major n x t matrix.
+ */
+std::vector<double> gen_rademacher_probes(std::size_t n, std::size_t t, std::mt19937_64 &generator)
+{
+    // The lowest bit of the generator, such that the probes are reproducible across standard libraries
+    std::vector<double> Z(n * t);
+    for (double &z : Z)
+    {
+        z = (generator() & 1U) != 0 ? 1.0 : -1.0;
+    }
+    return Z;
+}
+
+/**
+ * @brief Compute the column-wise dot products of two row-major matrices.
+ */
+std::vector<double>
+column_dots(const std::vector<double> &A, const std::vector<double> &B, std::size_t n_rows, std::size_t n_columns)
+{
+    std::vector<double> dots(n_columns, 0.0);
+    for (std::size_t i = 0; i < n_rows; i++)
+    {
+        for (std::size_t j = 0; j < n_columns; j++)
+        {
+            dots[j] += A[i * n_columns + j] * B[i * n_columns + j];
+        }
+    }
+    return dots;
+}
+
+/**
+ * @brief Estimate log(det(K)) by Lanczos quadrature started at the probe vectors, for
+ * all probe vectors at once.
+ */
+double estimate_log_determinant(const MatrixFreeCovariance &K,
+                                const std::vector<double> &Z,
+                                std::size_t t,
+                                std::size_t lanczos_steps)
+{
+    const std::size_t N = K.size();
+    const std::size_t m = std::min(lanczos_steps, N);
+
+    // q_1 = z / ||z||
+    const std::vector<double> z_norm = column_dots(Z, Z, N, t);
+    std::vector<double> Q = Z;
+    std::vector<double> Q_previous(N * t, 0.0);
+    for (std::size_t i = 0; i < N; i++)
+    {
+        for (std::size_t j = 0; j < t; j++)
+        {
+            Q[i * t + j] /= std::sqrt(z_norm[j]);
+        }
+    }
+
+    // Coefficients of the tridiagonal matrices T, column j stops at steps[j] on breakdown
+    std::vector<std::vector<double>> alpha(t);
+    std::vector<std::vector<double>> beta(t);
+    std::vector<std::size_t> steps(t, m);
+    std::vector<double> beta_previous(t, 0.0);
+    for (std::size_t s = 0; s < m; s++)
+    {
+        // w = K * q - alpha * q - beta_previous * q_previous
+        std::vector<double> W = K.apply(Q, t);
+        const std::vector<double> a = column_dots(Q, W, N, t);
+        for (std::size_t i = 0; i < N; i++)
+        {
+            for (std::size_t j = 0; j < t; j++)
+            {
+                W[i * t + j] -= a[j] * Q[i * t + j] + beta_previous[j] * Q_previous[i * t + j];
+            }
+        }
+        const std::vector<double> w_norm = column_dots(W, W, N, t);
+        for (std::size_t j = 0; j < t; j++)
+        {
+            if (s >= steps[j])
+            {
+                continue;
+            }
+            alpha[j].push_back(a[j]);
+            const double b = std::sqrt(w_norm[j]);
+            if (b <= 1e-12 * std::abs(a[j]))
+            {
+                // Invariant subspace, the quadrature is exact
+                steps[j] = s + 1;
+                continue;
+            }
+            beta[j].push_back(b);
+            beta_previous[j] = b;
+        }
+        // q_previous = q, q = w / beta
+        Q_previous.swap(Q);
+        for (std::size_t i = 0; i < N; i++)
+        {
+            for (std::size_t j = 0; j < t; j++)
+            {
+                Q[i * t + j] = s + 1 < steps[j] ? W[i * t + j] / beta_previous[j] : 0.0;
+            }
+        }
+    }
+
+    // Gauss quadrature: e_1^T * log(T) * e_1 = sum_k (first component of eigenvector k)^2 * log(theta_k)
+    double log_det = 0.0;
+    for (std::size_t j = 0; j < t; j++)
+    {
+        const std::size_t m_j = steps[j];
+        std::vector<double> eigenvalues = alpha[j];
+        std::vector<double> off_diagonal(beta[j].begin(), beta[j].begin() + static_cast<std::ptrdiff_t>(m_j - 1));
+        std::vector<double> eigenvectors(m_j * m_j);
+        LAPACKE_dstev(LAPACK_ROW_MAJOR,
+                      'V',
+                      static_cast<int>(m_j),
+                      eigenvalues.data(),
+                      off_diagonal.data(),
+                      eigenvectors.data(),
+                      static_cast<int>(m_j));
+        double quadrature = 0.0;
+        for (std::size_t k = 0; k < m_j; k++)
+        {
+            quadrature += eigenvectors[k] * eigenvectors[k] * std::log(eigenvalues[k]);
+        }
+        log_det += z_norm[j] * quadrature;
+    }
+    return log_det / static_cast<double>(t);
+}
+
+/**
+ * @brief Estimate the loss and optionally the gradient terms, see SLQEstimate.
+ */
+SLQEstimate estimate_loss(const std::vector<double> &training_input,
+                          const std::vector<double> &training_output,
+                          const gprat_hyper::SEKParams &sek_params,
+                          int n_tiles,
+                          int n_tile_size,
+                          int n_regressors,
+                          const SLQParams &slq_params,
+                          std::mt19937_64 &generator,
+                          bool with_gradient)
+{
+    const MatrixFreeCovariance K(training_input, sek_params, n_tiles, n_tile_size, n_regressors);
+    const PivotedCholeskyPreconditioner preconditioner(K, static_cast<std::size_t>(slq_params.preconditioner_rank));
+    const std::size_t N = K.size();
+    const std::size_t t = static_cast<std::size_t>(slq_params.n_probes);
+    const std::vector<double> Z = gen_rademacher_probes(N, t, generator);
+    const std::vector<double> y(training_output.begin(), training_output.begin() + static_cast<std::ptrdiff_t>(N));
+
+    SLQEstimate estimate;
+    const double log_det = estimate_log_determinant(K, Z, t, static_cast<std::size_t>(slq_params.lanczos_steps));
+    if (!with_gradient)
+    {
+        const std::vector<double> alpha =
+            solve_pcg(K, preconditioner, y, 1, slq_params.cg_tolerance, slq_params.cg_max_iterations);
+        estimate.loss = add_losses(std::vector<double>{ column_dots(y, alpha, N, 1)[0] + log_det }, N);
+        return estimate;
+    }
+
+    // [alpha, U] = K^-1 * [y, Z] with PCG for all columns at once
+    const std::size_t k = t + 1;
+    std::vector<double> B(N * k);
+    for (std::size_t i = 0; i < N; i++)
+    {
+        B[i * k] = y[i];
+        for (std::size_t j = 0; j < t; j++)
+        {
+            B[i * k + j + 1] = Z[i * t + j];
+        }
+    }
+    const std::vector<double> X =
+        solve_pcg(K, preconditioner, B, k, slq_params.cg_tolerance, slq_params.cg_max_iterations);
+    std::vector<double> A(N * k);
+    for (std::size_t i = 0; i < N; i++)
+    {
+        A[i * k] = X[i * k];
+        for (std::size_t j = 0; j < t; j++)
+        {
+            A[i * k + j + 1] = Z[i * t + j];
+        }
+    }
+
+    // dK * [alpha, Z] contains dK * alpha and the probes dK * z_i of the trace estimates
+    const auto [lengthscale_products, vertical_lengthscale_products] = K.apply_derivatives(A, k);
+    const std::vector<double> *products[2] = { &lengthscale_products, &vertical_lengthscale_products };
+    estimate.trace.assign(3, 0.0);
+    estimate.dot.assign(3, 0.0);
+    for (std::size_t i = 0; i < N; i++)
+    {
+        for (std::size_t p = 0; p < 2; p++)
+        {
+            const std::vector<double> &product = *products[p];
+            estimate.dot[p] += X[i * k] * product[i * k];
+            for (std::size_t j = 1; j < k; j++)
+            {
+                estimate.trace[p] += X[i * k + j] * product[i * k + j];
+            }
+        }
+        // dK/dnoise_variance = I
+        estimate.dot[2] += X[i * k] * X[i * k];
+        for (std::size_t j = 1; j < k; j++)
+        {
+            estimate.trace[2] += X[i * k + j] * A[i * k + j];
+        }
+    }
+    for (double &trace : estimate.trace)
+    {
+        trace /= static_cast<double>(t);
+    }
+    double data_fit = 0.0;
+    for (std::size_t i = 0; i < N; i++)
+    {
+        data_fit += y[i] * X[i * k];
+    }
+    estimate.loss = add_losses(std::vector<double>{ data_fit + log_det }, N);
+    return estimate;
+}
+
+}  // namespace
+
+double compute_loss_slq(const std::vector<double> &training_input,
+                        const std::vector<double> &training_output,
+                        const gprat_hyper::SEKParams &sek_params,
+                        int n_tiles,
+                        int n_tile_size,
+                        int n_regressors,
+                        const SLQParams &slq_params)
+{
+    std::seed_seq seed_sequence{ slq_params.seed };
+    std::mt19937_64 generator(seed_sequence);
+    return estimate_loss(training_input,
+                         training_output,
+                         sek_params,
+                         n_tiles,
+                         n_tile_size,
+                         n_regressors,
+                         slq_params,
+                         generator,
+                         false)
+        .loss;
+}
+
+std::vector<double> optimize_slq(const std::vector<double> &training_input,
+                                 const std::vector<double> &training_output,
+                                 int n_tiles,
+                                 int n_tile_size,
+                                 int n_regressors,
+                                 const gprat_hyper::AdamParams &adam_params,
+                                 gprat_hyper::SEKParams &sek_params,
+                                 std::vector<bool> trainable_params,
+                                 const SLQParams &slq_params)
+{
+    /*
+     * for opt_iter:
+     *   1: Draw new probe vectors z_i
+     *   2: Estimate log(det(K)) by Lanczos quadrature
+     *   3: Compute [alpha, K^-1 * z_i] with PCG
+     *   4: Compute dK/dtheta_p * [alpha, z_i] matrix-free
+     *   5: Estimate delta(loss)/delta(theta_p) = 0.5 / N * (trace(K^-1 * dK/dtheta_p) - alpha^T * dK/dtheta_p * alpha)
+     *   6: Update hyperparameters theta with Adam optimizer, see update_hyperparameter_tiled
+     * endfor
+     */
+    std::seed_seq seed_sequence{ slq_params.seed };
+    std::mt19937_64 generator(seed_sequence);
+    const std::size_t n_train = compute_n_samples(static_cast<std::size_t>(n_tiles),
+                                                  static_cast<std::size_t>(n_tile_size),
+                                                  training_input.size(),
+                                                  static_cast<std::size_t>(n_regressors));
+
+    std::vector<double> losses;
+    losses.reserve(static_cast<std::size_t>(adam_params.opt_iter));
+    for (std::size_t iter = 0; iter < static_cast<std::size_t>(adam_params.opt_iter); iter++)
+    {
+        const SLQEstimate estimate = estimate_loss(training_input,
+                                                   training_output,
+                                                   sek_params,
+                                                   n_tiles,
+                                                   n_tile_size,
+                                                   n_regressors,
+                                                   slq_params,
+                                                   generator,
+                                                   true);
+        losses.push_back(estimate.loss);
+
+        for (std::size_t p = 0; p < sek_params.size(); p++)
+        {
+            if (trainable_params[p])
+            {
+                const bool noise = p == 2;
+                // Chain rule of the softplus constraint
+                const double gradient = compute_sigmoid(to_unconstrained(sek_params.get_param(p), noise))
+                                        * compute_gradient(estimate.trace[p], estimate.dot[p], n_train);
+                // m_T = beta1 * m_T-1 + (1 - beta1) * g_T
+                sek_params.m_T[p] = update_first_moment(gradient, sek_params.m_T[p], adam_params.beta1);
+                // w_T = beta2 + w_T-1 + (1 - beta2) * g_T^2
+                sek_params.w_T[p] = update_second_moment(gradient, sek_params.w_T[p], adam_params.beta2);
+                const double updated_param = adam_step(to_unconstrained(sek_params.get_param(p), noise),
+                                                       adam_params,
+                                                       sek_params.m_T[p],
+                                                       sek_params.w_T[p],
+                                                       iter);
+                sek_params.set_param(p, to_constrained(updated_param, noise));
+            }
+        }
+    }
+    return losses;
+}
+
+}  // end of namespace cpu
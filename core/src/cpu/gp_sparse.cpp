@@ -0,0 +1,658 @@
+#include "cpu/gp_sparse.hpp"
+
+#include "cpu/gp_algorithms.hpp"
+#include "cpu/gp_optimizer.hpp"
+#include "cpu/gp_uncertainty.hpp"
+#include "cpu/tiled_algorithms.hpp"
+#include <cmath>
+#include <hpx/future.hpp>
+
+namespace cpu
+{
+
+namespace
+{
+
+/**
+ * @brief Tiled factorization of the sparse approximation of the training covariance
+ */
+struct SparseFactor
+{
+    /** @brief Cholesky factor L_m of K_mm */
+    Tiled_matrix L_m;
+    /** @brief Cholesky factor L_B of B = I + A * Lambda^-1 * A^T with A = L_m^-1 * K_mn */
+    Tiled_matrix L_B;
+    /** @brief c = L_B^-1 * A * Lambda^-1 * y */
+    Tiled_vector c;
+    /** @brief Unnormalized losses of the training and the inducing tiles */
+    std::vector<hpx::shared_future<double>> losses;
+};
+
+/**
+ * @brief Compute the scaling Lambda^-1/2 of a training tile by the approximate noise variance.
+ *
+ * FITC corrects the noise variance by the exact diagonal of K - Q.
+ */
+std::vector<double> compute_noise_scale(const std::vector<double> &prior_diagonal,
+                                        const std::vector<double> &inducing_diagonal,
+                                        double noise_variance,
+                                        bool fitc)
+{
+    std::vector<double> scale(prior_diagonal.size());
+    for (std::size_t i = 0; i < scale.size(); i++)
+    {
+        const double lambda = fitc ? noise_variance + prior_diagonal[i] - inducing_diagonal[i] : noise_variance;
+        scale[i] = 1.0 / std::sqrt(lambda);
+    }
+    return scale;
+}
+
+/**
+ * @brief Scale the columns of a tile of size N_row x N_col.
+ */
+std::vector<double> scale_tile_columns(const std::vector<double> &tile,
+                                       const std::vector<double> &scale,
+                                       std::size_t N_row,
+                                       std::size_t N_col)
+{
+    std::vector<double> scaled(tile.size());
+    for (std::size_t i = 0; i < N_row; i++)
+    {
+        for (std::size_t j = 0; j < N_col; j++)
+        {
+            scaled[i * N_col + j] = tile[i * N_col + j] * scale[j];
+        }
+    }
+    return scaled;
+}
+
+/**
+ * @brief Compute the loss of a training tile: log(det(Lambda)) + r^T * r with r = Lambda^-1/2 * y,
+ * and for VFE the trace of K - Q divided by the noise variance.
+ */
+double compute_training_loss(const std::vector<double> &scale,
+                             const std::vector<double> &scaled_output,
+                             const std::vector<double> &prior_diagonal,
+                             const std::vector<double> &inducing_diagonal,
+                             double trace_weight)
+{
+    double loss = 0.0;
+    for (std::size_t i = 0; i < scale.size(); i++)
+    {
+        loss += -2.0 * std::log(scale[i]) + scaled_output[i] * scaled_output[i]
+                + trace_weight * (prior_diagonal[i] - inducing_diagonal[i]);
+    }
+    return loss;
+}
+
+/**
+ * @brief Compute the loss of an inducing tile: log(det(B)) - c^T * c.
+ */
+double compute_inducing_loss(const std::vector<double> &L_B_diagonal_tile, const std::vector<double> &c, std::size_t N)
+{
+    double loss = 0.0;
+    for (std::size_t i = 0; i < N; i++)
+    {
+        loss += std::log(L_B_diagonal_tile[i * N + i] * L_B_diagonal_tile[i * N + i]) - c[i] * c[i];
+    }
+    return loss;
+}
+
+/**
+ * @brief Launch the asynchronous factorization of the sparse approximation.
+ */
+SparseFactor launch_sparse_factor(const std::vector<double> &training_input,
+                                  const std::vector<double> &training_output,
+                                  const std::vector<double> &inducing_input,
+                                  const gprat_hyper::SEKParams &sek_params,
+                                  SparseApproximation approximation,
+                                  std::size_t n_tiles,
+                                  int n_tile_size,
+                                  std::size_t u_tiles,
+                                  int u_tile_size,
+                                  std::size_t n_regressors,
+                                  std::size_t n_train,
+                                  std::size_t n_inducing)
+{
+    /*
+     * Algorithm:
+     * 1: Compute Cholesky factor L_m of K_mm + jitter * I
+     * 2: Compute A = L_m^-1 * K_mn and the diagonal of Q = A^T * A
+     * 3: Compute the scaling s = Lambda^-1/2 of the noise variance:
+     *    - FITC: Lambda = noise_variance * I + diag(K - Q)
+     *    - else: Lambda = noise_variance * I
+     * 4: Scale r = s * y and A = A * diag(s)
+     * 5: Compute Cholesky factor L_B of B = I + A * A^T
+     * 6: Compute c = L_B^-1 * A * r
+     */
+    const std::size_t N = static_cast<std::size_t>(n_tile_size);
+    const std::size_t U = static_cast<std::size_t>(u_tile_size);
+    const bool fitc = approximation == SparseApproximation::FITC;
+    const double trace_weight = approximation == SparseApproximation::VFE ? 1.0 / sek_params.noise_variance : 0.0;
+
+    SparseFactor factor;
+    Tiled_matrix A_tiles;      // Tiled A_mxn, afterwards scaled by s
+    Tiled_vector prior_tiles;  // Tiled diagonal of K_nn
+    Tiled_vector q_tiles;      // Tiled diagonal of Q_nn
+    Tiled_vector scale_tiles;  // Tiled scaling s
+    Tiled_vector r_tiles;      // Tiled scaled output r
+
+    factor.L_m.resize(u_tiles * u_tiles);
+    factor.L_B.resize(u_tiles * u_tiles);
+    factor.c.reserve(u_tiles);
+    factor.losses.reserve(n_tiles + u_tiles);
+    A_tiles.reserve(u_tiles * n_tiles);
+    prior_tiles.reserve(n_tiles);
+    q_tiles.reserve(n_tiles);
+    scale_tiles.reserve(n_tiles);
+    r_tiles.reserve(n_tiles);
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Launch asynchronous assembly and Cholesky decomposition: K_mm = L_m * L_m^T
+    for (std::size_t i = 0; i < u_tiles; i++)
+    {
+        for (std::size_t j = 0; j <= i; j++)
+        {
+            factor.L_m[i * u_tiles + j] = hpx::async(
+                hpx::annotated_function(gen_tile_full_prior_covariance<double>, "assemble_tiled_K_mm"),
+                i,
+                j,
+                U,
+                n_inducing,
+                n_regressors,
+                sek_params,
+                inducing_input);
+        }
+        factor.L_m[i * u_tiles + i] = hpx::dataflow(
+            hpx::annotated_function(add_matrix_diagonal<double>, "assemble_tiled_K_mm"),
+            factor.L_m[i * u_tiles + i],
+            compute_tile_size(i, U, n_inducing),
+            SPARSE_INDUCING_JITTER * sek_params.vertical_lengthscale);
+    }
+    right_looking_cholesky_tiled(factor.L_m, u_tile_size, u_tiles, n_inducing);
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Launch asynchronous triangular solve L_m * A = K_mn
+    for (std::size_t i = 0; i < u_tiles; i++)
+    {
+        for (std::size_t j = 0; j < n_tiles; j++)
+        {
+            A_tiles.push_back(hpx::async(
+                hpx::annotated_function(gen_tile_cross_covariance<double>, "assemble_tiled_K_mn"),
+                i,
+                j,
+                U,
+                N,
+                n_inducing,
+                n_train,
+                n_regressors,
+                sek_params,
+                inducing_input,
+                training_input));
+        }
+    }
+    forward_solve_tiled_matrix(factor.L_m, A_tiles, u_tile_size, n_tile_size, u_tiles, n_tiles, n_inducing, n_train);
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Launch asynchronous computation of diag(Q) = diag(A^T * A) and the scaling
+    for (std::size_t j = 0; j < n_tiles; j++)
+    {
+        const std::size_t N_j = compute_tile_size(j, N, n_train);
+        prior_tiles.push_back(hpx::async(
+            hpx::annotated_function(gen_tile_prior_covariance<double>, "assemble_tiled_prior_diagonal"),
+            j,
+            j,
+            N,
+            n_train,
+            n_regressors,
+            sek_params,
+            training_input));
+        q_tiles.push_back(hpx::async(hpx::annotated_function(gen_tile_zeros<double>, "assemble_tiled_q"), N_j));
+    }
+    symmetric_matrix_matrix_diagonal_tiled(
+        A_tiles, q_tiles, u_tile_size, n_tile_size, u_tiles, n_tiles, n_inducing, n_train);
+
+    for (std::size_t j = 0; j < n_tiles; j++)
+    {
+        const std::size_t N_j = compute_tile_size(j, N, n_train);
+        scale_tiles.push_back(
+            hpx::dataflow(hpx::annotated_function(hpx::unwrapping(&compute_noise_scale), "sparse_noise_scale"),
+                          prior_tiles[j],
+                          q_tiles[j],
+                          sek_params.noise_variance,
+                          fitc));
+        r_tiles.push_back(hpx::dataflow(
+            hpx::annotated_function(hpx::unwrapping(&scale_tile_columns), "sparse_noise_scale"),
+            hpx::async(hpx::annotated_function(gen_tile_output<double>, "assemble_tiled_y"),
+                       j,
+                       N,
+                       n_train,
+                       training_output),
+            scale_tiles[j],
+            1,
+            N_j));
+        factor.losses.push_back(
+            hpx::dataflow(hpx::annotated_function(hpx::unwrapping(&compute_training_loss), "sparse_loss"),
+                          scale_tiles[j],
+                          r_tiles[j],
+                          prior_tiles[j],
+                          q_tiles[j],
+                          trace_weight));
+        for (std::size_t i = 0; i < u_tiles; i++)
+        {
+            A_tiles[i * n_tiles + j] = hpx::dataflow(
+                hpx::annotated_function(hpx::unwrapping(&scale_tile_columns), "sparse_noise_scale"),
+                A_tiles[i * n_tiles + j],
+                scale_tiles[j],
+                compute_tile_size(i, U, n_inducing),
+                N_j);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Launch asynchronous assembly and Cholesky decomposition: I + A * A^T = L_B * L_B^T
+    for (std::size_t i = 0; i < u_tiles; i++)
+    {
+        for (std::size_t j = 0; j <= i; j++)
+        {
+            factor.L_B[i * u_tiles + j] =
+                hpx::async(hpx::annotated_function(gen_tile_zeros<double>, "assemble_tiled_B"),
+                           compute_tile_size(i, U, n_inducing) * compute_tile_size(j, U, n_inducing));
+        }
+    }
+    // C = -A * A^T
+    symmetric_matrix_matrix_transpose_tiled(
+        A_tiles, factor.L_B, u_tile_size, n_tile_size, u_tiles, n_tiles, n_inducing, n_train);
+    for (std::size_t i = 0; i < u_tiles; i++)
+    {
+        for (std::size_t j = 0; j <= i; j++)
+        {
+            // B = I - C
+            factor.L_B[i * u_tiles + j] =
+                hpx::dataflow(hpx::annotated_function(negate_matrix_add_diagonal<double>, "assemble_tiled_B"),
+                              factor.L_B[i * u_tiles + j],
+                              i == j ? compute_tile_size(i, U, n_inducing) : 0,
+                              1.0);
+        }
+    }
+    right_looking_cholesky_tiled(factor.L_B, u_tile_size, u_tiles, n_inducing);
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Launch asynchronous computation of c = L_B^-1 * A * r
+    for (std::size_t i = 0; i < u_tiles; i++)
+    {
+        factor.c.push_back(hpx::async(hpx::annotated_function(gen_tile_zeros<double>, "assemble_tiled_c"),
+                                      compute_tile_size(i, U, n_inducing)));
+    }
+    matrix_vector_tiled(A_tiles, r_tiles, factor.c, u_tile_size, n_tile_size, n_tiles, u_tiles, n_inducing, n_train);
+    forward_solve_tiled(factor.L_B, factor.c, u_tile_size, u_tiles, n_inducing);
+
+    for (std::size_t i = 0; i < u_tiles; i++)
+    {
+        factor.losses.push_back(
+            hpx::dataflow(hpx::annotated_function(hpx::unwrapping(&compute_inducing_loss), "sparse_loss"),
+                          factor.L_B[i * u_tiles + i],
+                          factor.c[i],
+                          compute_tile_size(i, U, n_inducing)));
+    }
+    return factor;
+}
+
+/**
+ * @brief Compute the sparse predictions and optionally their uncertainties.
+ */
+std::vector<std::vector<double>> sparse_prediction(const std::vector<double> &training_input,
+                                                   const std::vector<double> &training_output,
+                                                   const std::vector<double> &inducing_input,
+                                                   const std::vector<double> &test_input,
+                                                   const gprat_hyper::SEKParams &sek_params,
+                                                   SparseApproximation approximation,
+                                                   int n_tiles,
+                                                   int n_tile_size,
+                                                   int inducing_tiles,
+                                                   int inducing_tile_size,
+                                                   int m_tiles,
+                                                   int m_tile_size,
+                                                   int n_regressors,
+                                                   bool with_uncertainty)
+{
+    /*
+     * Algorithm:
+     * 1: Factorize the sparse approximation, see launch_sparse_factor
+     * 2: Compute A_* = L_m^-1 * K_m*
+     * 3: Compute w = L_B^-T * c and prediction hat(y) = A_*^T * w
+     * 4: Compute D_* = L_B^-1 * A_* and uncertainty
+     *    - SoR: diag(D_*^T * D_*)
+     *    - else: diag(K_**) - diag(A_*^T * A_*) + diag(D_*^T * D_*)
+     */
+    const std::size_t n_reg = static_cast<std::size_t>(n_regressors);
+    const std::size_t n_train = compute_n_samples(
+        static_cast<std::size_t>(n_tiles), static_cast<std::size_t>(n_tile_size), training_input.size(), n_reg);
+    const std::size_t n_inducing = compute_n_samples(static_cast<std::size_t>(inducing_tiles),
+                                                     static_cast<std::size_t>(inducing_tile_size),
+                                                     inducing_input.size(),
+                                                     n_reg);
+    const std::size_t n_test = compute_n_samples(
+        static_cast<std::size_t>(m_tiles), static_cast<std::size_t>(m_tile_size), test_input.size(), n_reg);
+    const std::size_t u_tiles = static_cast<std::size_t>(inducing_tiles);
+    const std::size_t t_tiles = static_cast<std::size_t>(m_tiles);
+    const std::size_t U = static_cast<std::size_t>(inducing_tile_size);
+    const std::size_t M = static_cast<std::size_t>(m_tile_size);
+
+    SparseFactor factor = launch_sparse_factor(
+        training_input,
+        training_output,
+        inducing_input,
+        sek_params,
+        approximation,
+        static_cast<std::size_t>(n_tiles),
+        n_tile_size,
+        u_tiles,
+        inducing_tile_size,
+        n_reg,
+        n_train,
+        n_inducing);
+
+    // Tiled future data structures
+    Tiled_matrix cross_tiles;       // Tiled A_*: inducing x test
+    Tiled_vector prediction_tiles;  // Tiled prediction
+    cross_tiles.reserve(u_tiles * t_tiles);
+    prediction_tiles.reserve(t_tiles);
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Launch asynchronous triangular solve L_m * A_* = K_m*
+    for (std::size_t i = 0; i < u_tiles; i++)
+    {
+        for (std::size_t j = 0; j < t_tiles; j++)
+        {
+            cross_tiles.push_back(hpx::async(
+                hpx::annotated_function(gen_tile_cross_covariance<double>, "assemble_tiled_K_m*"),
+                i,
+                j,
+                U,
+                M,
+                n_inducing,
+                n_test,
+                n_reg,
+                sek_params,
+                inducing_input,
+                test_input));
+        }
+    }
+    forward_solve_tiled_matrix(
+        factor.L_m, cross_tiles, inducing_tile_size, m_tile_size, u_tiles, t_tiles, n_inducing, n_test);
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Launch asynchronous prediction: hat(y) = A_*^T * L_B^-T * c
+    backward_solve_tiled(factor.L_B, factor.c, inducing_tile_size, u_tiles, n_inducing);
+    for (std::size_t j = 0; j < t_tiles; j++)
+    {
+        prediction_tiles.push_back(
+            hpx::async(hpx::annotated_function(gen_tile_zeros<double>, "assemble_prediction"),
+                       compute_tile_size(j, M, n_test)));
+    }
+    transpose_matrix_vector_tiled(
+        cross_tiles, factor.c, prediction_tiles, inducing_tile_size, m_tile_size, u_tiles, t_tiles, n_inducing, n_test);
+
+    std::vector<double> prediction_result;
+    prediction_result.reserve(n_test);
+    std::vector<double> uncertainty_result;
+
+    if (with_uncertainty)
+    {
+        Tiled_vector uncertainty_tiles;  // Tiled uncertainty
+        uncertainty_tiles.reserve(t_tiles);
+        for (std::size_t j = 0; j < t_tiles; j++)
+        {
+            const std::size_t M_j = compute_tile_size(j, M, n_test);
+            uncertainty_tiles.push_back(
+                hpx::async(hpx::annotated_function(gen_tile_zeros<double>, "assemble_uncertainty"), M_j));
+        }
+        if (approximation != SparseApproximation::SoR)
+        {
+            // diag(K_**) - diag(A_*^T * A_*)
+            Tiled_vector prior_tiles;
+            prior_tiles.reserve(t_tiles);
+            for (std::size_t j = 0; j < t_tiles; j++)
+            {
+                prior_tiles.push_back(hpx::async(
+                    hpx::annotated_function(gen_tile_prior_covariance<double>, "assemble_prior_diagonal"),
+                    j,
+                    j,
+                    M,
+                    n_test,
+                    n_reg,
+                    sek_params,
+                    test_input));
+            }
+            symmetric_matrix_matrix_diagonal_tiled(
+                cross_tiles, uncertainty_tiles, inducing_tile_size, m_tile_size, u_tiles, t_tiles, n_inducing, n_test);
+            vector_difference_tiled(prior_tiles, uncertainty_tiles, m_tile_size, t_tiles, n_test);
+        }
+        // diag(D_*^T * D_*) with D_* = L_B^-1 * A_*
+        Tiled_matrix solved_cross_tiles = cross_tiles;
+        forward_solve_tiled_matrix(
+            factor.L_B, solved_cross_tiles, inducing_tile_size, m_tile_size, u_tiles, t_tiles, n_inducing, n_test);
+        symmetric_matrix_matrix_diagonal_tiled(solved_cross_tiles,
+                                               uncertainty_tiles,
+                                               inducing_tile_size,
+                                               m_tile_size,
+                                               u_tiles,
+                                               t_tiles,
+                                               n_inducing,
+                                               n_test);
+
+        uncertainty_result.reserve(n_test);
+        for (std::size_t j = 0; j < t_tiles; j++)
+        {
+            auto tile = uncertainty_tiles[j].get();
+            uncertainty_result.insert(uncertainty_result.end(), tile.begin(), tile.end());
+        }
+    }
+
+    for (std::size_t j = 0; j < t_tiles; j++)
+    {
+        auto tile = prediction_tiles[j].get();
+        prediction_result.insert(prediction_result.end(), tile.begin(), tile.end());
+    }
+    return std::vector<std::vector<double>>{ std::move(prediction_result), std::move(uncertainty_result) };
+}
+
+}  // namespace
+
+std::vector<double> predict_sparse(const std::vector<double> &training_input,
+                                   const std::vector<double> &training_output,
+                                   const std::vector<double> &inducing_input,
+                                   const std::vector<double> &test_input,
+                                   const gprat_hyper::SEKParams &sek_params,
+                                   SparseApproximation approximation,
+                                   int n_tiles,
+                                   int n_tile_size,
+                                   int inducing_tiles,
+                                   int inducing_tile_size,
+                                   int m_tiles,
+                                   int m_tile_size,
+                                   int n_regressors)
+{
+    return sparse_prediction(training_input,
+                             training_output,
+                             inducing_input,
+                             test_input,
+                             sek_params,
+                             approximation,
+                             n_tiles,
+                             n_tile_size,
+                             inducing_tiles,
+                             inducing_tile_size,
+                             m_tiles,
+                             m_tile_size,
+                             n_regressors,
+                             false)
+        .front();
+}
+
+std::vector<std::vector<double>> predict_sparse_with_uncertainty(const std::vector<double> &training_input,
+                                                                 const std::vector<double> &training_output,
+                                                                 const std::vector<double> &inducing_input,
+                                                                 const std::vector<double> &test_input,
+                                                                 const gprat_hyper::SEKParams &sek_params,
+                                                                 SparseApproximation approximation,
+                                                                 int n_tiles,
+                                                                 int n_tile_size,
+                                                                 int inducing_tiles,
+                                                                 int inducing_tile_size,
+                                                                 int m_tiles,
+                                                                 int m_tile_size,
+                                                                 int n_regressors)
+{
+    return sparse_prediction(training_input,
+                             training_output,
+                             inducing_input,
+                             test_input,
+                             sek_params,
+                             approximation,
+                             n_tiles,
+                             n_tile_size,
+                             inducing_tiles,
+                             inducing_tile_size,
+                             m_tiles,
+                             m_tile_size,
+                             n_regressors,
+                             true);
+}
+
+double compute_loss_sparse(const std::vector<double> &training_input,
+                           const std::vector<double> &training_output,
+                           const std::vector<double> &inducing_input,
+                           const gprat_hyper::SEKParams &sek_params,
+                           SparseApproximation approximation,
+                           int n_tiles,
+                           int n_tile_size,
+                           int inducing_tiles,
+                           int inducing_tile_size,
+                           int n_regressors)
+{
+    /*
+     * Negative log likelihood loss of the approximate prior Q + Lambda:
+     * loss(theta) = 0.5 * ( log(det(Lambda)) + log(det(B)) + r^T * r - c^T * c + N * log(2 * pi) )
+     * - VFE adds the trace of K - Q divided by the noise variance
+     */
+    const std::size_t n_reg = static_cast<std::size_t>(n_regressors);
+    const std::size_t n_train = compute_n_samples(
+        static_cast<std::size_t>(n_tiles), static_cast<std::size_t>(n_tile_size), training_input.size(), n_reg);
+    const std::size_t n_inducing = compute_n_samples(static_cast<std::size_t>(inducing_tiles),
+                                                     static_cast<std::size_t>(inducing_tile_size),
+                                                     inducing_input.size(),
+                                                     n_reg);
+
+    SparseFactor factor = launch_sparse_factor(
+        training_input,
+        training_output,
+        inducing_input,
+        sek_params,
+        approximation,
+        static_cast<std::size_t>(n_tiles),
+        n_tile_size,
+        static_cast<std::size_t>(inducing_tiles),
+        inducing_tile_size,
+        n_reg,
+        n_train,
+        n_inducing);
+
+    std::vector<double> losses;
+    losses.reserve(factor.losses.size());
+    for (auto &loss : factor.losses)
+    {
+        losses.push_back(loss.get());
+    }
+    return add_losses(losses, n_train);
+}
+
+std::vector<double> optimize_sparse(const std::vector<double> &training_input,
+                                    const std::vector<double> &training_output,
+                                    const std::vector<double> &inducing_input,
+                                    SparseApproximation approximation,
+                                    int n_tiles,
+                                    int n_tile_size,
+                                    int inducing_tiles,
+                                    int inducing_tile_size,
+                                    int n_regressors,
+                                    const gprat_hyper::AdamParams &adam_params,
+                                    gprat_hyper::SEKParams &sek_params,
+                                    std::vector<bool> trainable_params)
+{
+    /*
+     * for opt_iter:
+     *   1: Compute the sparse loss and, for each trainable hyperparameter theta_i,
+     *      the sparse losses at softplus(u_i +- h) with u_i the unconstrained theta_i
+     *   2: Compute gradient g_i = (loss(u_i + h) - loss(u_i - h)) / (2 * h)
+     *   3: Update hyperparameters theta with Adam optimizer, see update_hyperparameter_tiled
+     * endfor
+     */
+    auto launch_loss = [&](const gprat_hyper::SEKParams &params)
+    {
+        return hpx::async(
+            [&, params]()
+            {
+                return compute_loss_sparse(
+                    training_input,
+                    training_output,
+                    inducing_input,
+                    params,
+                    approximation,
+                    n_tiles,
+                    n_tile_size,
+                    inducing_tiles,
+                    inducing_tile_size,
+                    n_regressors);
+            });
+    };
+
+    std::vector<double> losses;
+    losses.reserve(static_cast<std::size_t>(adam_params.opt_iter));
+    for (std::size_t iter = 0; iter < static_cast<std::size_t>(adam_params.opt_iter); iter++)
+    {
+        // The loss evaluations of all perturbed hyperparameters run concurrently
+        hpx::future<double> loss = launch_loss(sek_params);
+        std::vector<hpx::future<double>> forward_losses(sek_params.size());
+        std::vector<hpx::future<double>> backward_losses(sek_params.size());
+        for (std::size_t p = 0; p < sek_params.size(); p++)
+        {
+            if (trainable_params[p])
+            {
+                const bool noise = p == 2;
+                const double unconstrained_param = to_unconstrained(sek_params.get_param(p), noise);
+                gprat_hyper::SEKParams forward_params = sek_params;
+                gprat_hyper::SEKParams backward_params = sek_params;
+                forward_params.set_param(p, to_constrained(unconstrained_param + SPARSE_GRADIENT_STEP, noise));
+                backward_params.set_param(p, to_constrained(unconstrained_param - SPARSE_GRADIENT_STEP, noise));
+                forward_losses[p] = launch_loss(forward_params);
+                backward_losses[p] = launch_loss(backward_params);
+            }
+        }
+        losses.push_back(loss.get());
+
+        for (std::size_t p = 0; p < sek_params.size(); p++)
+        {
+            if (trainable_params[p])
+            {
+                const bool noise = p == 2;
+                const double gradient =
+                    (forward_losses[p].get() - backward_losses[p].get()) / (2.0 * SPARSE_GRADIENT_STEP);
+                // m_T = beta1 * m_T-1 + (1 - beta1) * g_T
+                sek_params.m_T[p] = update_first_moment(gradient, sek_params.m_T[p], adam_params.beta1);
+                // w_T = beta2 + w_T-1 + (1 - beta2) * g_T^2
+                sek_params.w_T[p] = update_second_moment(gradient, sek_params.w_T[p], adam_params.beta2);
+                const double updated_param = adam_step(to_unconstrained(sek_params.get_param(p), noise),
+                                                       adam_params,
+                                                       sek_params.m_T[p],
+                                                       sek_params.w_T[p],
+                                                       iter);
+                sek_params.set_param(p, to_constrained(updated_param, noise));
+            }
+        }
+    }
+    return losses;
+}
+
+}  // end of namespace cpu
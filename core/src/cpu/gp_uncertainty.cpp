@@ -3,11 +3,12 @@
 namespace cpu
 {
 
-hpx::shared_future<std::vector<double>> get_matrix_diagonal(hpx::shared_future<std::vector<double>> f_A, std::size_t M)
+template <typename T>
+hpx::shared_future<std::vector<T>> get_matrix_diagonal(hpx::shared_future<std::vector<T>> f_A, std::size_t M)
 {
     auto A = f_A.get();
     // Preallocate memory
-    std::vector<double> tile;
+    std::vector<T> tile;
     tile.reserve(M);
     // Add elements
     for (std::size_t i = 0; i < M; ++i)
@@ -18,4 +19,44 @@ hpx::shared_future<std::vector<double>> get_matrix_diagonal(hpx::shared_future<s
     return hpx::make_ready_future(std::move(tile));
 }
 
+template <typename T>
+std::vector<T> add_matrix_diagonal(hpx::shared_future<std::vector<T>> f_A, std::size_t M, T value)
+{
+    auto A = f_A.get();
+    // Shift diagonal elements
+    for (std::size_t i = 0; i < M; ++i)
+    {
+        A[i * M + i] += value;
+    }
+    return A;
+}
+
+template <typename T>
+std::vector<T> negate_matrix_add_diagonal(hpx::shared_future<std::vector<T>> f_A, std::size_t M, T value)
+{
+    auto A = f_A.get();
+    for (auto &element : A)
+    {
+        element = -element;
+    }
+    // Shift diagonal elements
+    for (std::size_t i = 0; i < M; ++i)
+    {
+        A[i * M + i] += value;
+    }
+    return A;
+}
+
+// Explicit instantiations for the supported precisions
+template hpx::shared_future<std::vector<float>>
+get_matrix_diagonal<float>(hpx::shared_future<std::vector<float>>, std::size_t);
+template hpx::shared_future<std::vector<double>>
+get_matrix_diagonal<double>(hpx::shared_future<std::vector<double>>, std::size_t);
+template std::vector<float> add_matrix_diagonal<float>(hpx::shared_future<std::vector<float>>, std::size_t, float);
+template std::vector<double> add_matrix_diagonal<double>(hpx::shared_future<std::vector<double>>, std::size_t, double);
+template std::vector<float>
+negate_matrix_add_diagonal<float>(hpx::shared_future<std::vector<float>>, std::size_t, float);
+template std::vector<double>
+negate_matrix_add_diagonal<double>(hpx::shared_future<std::vector<double>>, std::size_t, double);
+
 }  // end of namespace cpu
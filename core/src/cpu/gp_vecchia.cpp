@@ -0,0 +1,680 @@
+#include "cpu/gp_vecchia.hpp"
+
+#include "cpu/gp_algorithms.hpp"
+#include "cpu/gp_optimizer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <hpx/future.hpp>
+#include <numeric>
+
+#ifdef GPRAT_ENABLE_MKL
+// MKL CBLAS and LAPACKE
+#include "mkl_cblas.h"
+#include "mkl_lapacke.h"
+#else
+#include "cblas.h"
+#include "lapacke.h"
+#endif
+
+namespace cpu
+{
+
+///////////////////////////////////////////////////////////
+// KD-tree
+KDTree::KDTree(const std::vector<double> &input, std::size_t n_samples, std::size_t n_regressors) :
+    n_regressors_(n_regressors),
+    features_(n_samples * n_regressors),
+    order_(n_samples)
+{
+    // Gather the lagged features of sample i, input[i + k]
+    for (std::size_t i = 0; i < n_samples; i++)
+    {
+        for (std::size_t k = 0; k < n_regressors; k++)
+        {
+            features_[i * n_regressors + k] = input[i + k];
+        }
+    }
+    std::iota(order_.begin(), order_.end(), 0);
+    if (n_samples > 0)
+    {
+        nodes_.reserve(2 * (n_samples / KD_TREE_LEAF_SIZE) + 1);
+        build(0, n_samples);
+    }
+}
+
+std::size_t KDTree::build(std::size_t begin, std::size_t end)
+{
+    const std::size_t index = nodes_.size();
+    nodes_.push_back(Node{ begin,
+                           end,
+                           *std::min_element(order_.begin() + static_cast<std::ptrdiff_t>(begin),
+                                             order_.begin() + static_cast<std::ptrdiff_t>(end)),
+                           0,
+                           0.0,
+                           0,
+                           0 });
+    if (end - begin <= KD_TREE_LEAF_SIZE)
+    {
+        return index;
+    }
+
+    // Split at the median of the feature with the largest spread
+    std::size_t split_feature = 0;
+    double max_spread = 0.0;
+    for (std::size_t k = 0; k < n_regressors_; k++)
+    {
+        double min_value = features_[order_[begin] * n_regressors_ + k];
+        double max_value = min_value;
+        for (std::size_t p = begin + 1; p < end; p++)
+        {
+            const double value = features_[order_[p] * n_regressors_ + k];
+            min_value = std::min(min_value, value);
+            max_value = std::max(max_value, value);
+        }
+        if (max_value - min_value > max_spread)
+        {
+            max_spread = max_value - min_value;
+            split_feature = k;
+        }
+    }
+    if (!(max_spread > 0.0))
+    {
+        // All feature vectors coincide
+        return index;
+    }
+
+    const std::size_t middle = begin + (end - begin) / 2;
+    std::nth_element(order_.begin() + static_cast<std::ptrdiff_t>(begin),
+                     order_.begin() + static_cast<std::ptrdiff_t>(middle),
+                     order_.begin() + static_cast<std::ptrdiff_t>(end),
+                     [this, split_feature](std::size_t a, std::size_t b)
+                     {
+                         return features_[a * n_regressors_ + split_feature]
+                                < features_[b * n_regressors_ + split_feature];
+                     });
+    const double split_value = features_[order_[middle] * n_regressors_ + split_feature];
+    const std::size_t left = build(begin, middle);
+    const std::size_t right = build(middle, end);
+    nodes_[index].split_feature = split_feature;
+    nodes_[index].split_value = split_value;
+    nodes_[index].left = left;
+    nodes_[index].right = right;
+    return index;
+}
+
+void KDTree::search(std::size_t node,
+                    const double *query,
+                    std::size_t n_neighbours,
+                    std::size_t limit,
+                    std::vector<std::pair<double, std::size_t>> &heap) const
+{
+    const Node &current = nodes_[node];
+    if (current.min_index >= limit)
+    {
+        return;
+    }
+    if (current.left == 0)
+    {
+        for (std::size_t p = current.begin; p < current.end; p++)
+        {
+            const std::size_t sample = order_[p];
+            if (sample >= limit)
+            {
+                continue;
+            }
+            double distance = 0.0;
+            for (std::size_t k = 0; k < n_regressors_; k++)
+            {
+                const double difference = query[k] - features_[sample * n_regressors_ + k];
+                distance += difference * difference;
+            }
+            // Ties are resolved by the smaller sample index
+            const std::pair<double, std::size_t> candidate{ distance, sample };
+            if (heap.size() < n_neighbours)
+            {
+                heap.push_back(candidate);
+                std::push_heap(heap.begin(), heap.end());
+            }
+            else if (candidate < heap.front())
+            {
+                std::pop_heap(heap.begin(), heap.end());
+                heap.back() = candidate;
+                std::push_heap(heap.begin(), heap.end());
+            }
+        }
+        return;
+    }
+
+    // Descend into the half containing the query first
+    const double difference = query[current.split_feature] - current.split_value;
+    const std::size_t near_child = difference < 0.0 ? current.left : current.right;
+    const std::size_t far_child = difference < 0.0 ? current.right : current.left;
+    search(near_child, query, n_neighbours, limit, heap);
+    if (heap.size() < n_neighbours || difference * difference <= heap.front().first)
+    {
+        search(far_child, query, n_neighbours, limit, heap);
+    }
+}
+
+std::vector<std::size_t> KDTree::find_nearest(const double *query, std::size_t n_neighbours, std::size_t limit) const
+{
+    std::vector<std::size_t> neighbours;
+    if (n_neighbours == 0 || limit == 0 || nodes_.empty())
+    {
+        return neighbours;
+    }
+    std::vector<std::pair<double, std::size_t>> heap;
+    heap.reserve(n_neighbours);
+    search(0, query, n_neighbours, limit, heap);
+
+    neighbours.reserve(heap.size());
+    for (const auto &entry : heap)
+    {
+        neighbours.push_back(entry.second);
+    }
+    std::sort(neighbours.begin(), neighbours.end());
+    return neighbours;
+}
+
+namespace
+{
+
+/**
+ * @brief Conditioning sets of the samples of a tile
+ */
+using ConditioningSets = std::vector<std::vector<std::size_t>>;
+
+/**
+ * @brief Sum of the conditional losses of a tile and their gradient terms
+ */
+struct VecchiaTerms
+{
+    /** @brief Sum of log(sigma_i^2) + r_i^2 / sigma_i^2 over the conditionals */
+    double loss = 0.0;
+    /** @brief Trace terms of the gradient per hyperparameter */
+    std::vector<double> trace;
+    /** @brief Dot terms of the gradient per hyperparameter */
+    std::vector<double> dot;
+};
+
+/**
+ * @brief Search the nearest earlier training samples of each sample of a tile.
+ */
+ConditioningSets gen_tile_conditioning_sets(const KDTree &tree,
+                                            std::size_t tile,
+                                            std::size_t N,
+                                            std::size_t n_samples,
+                                            std::size_t n_neighbours,
+                                            const std::vector<double> &input)
+{
+    const std::size_t N_tile = compute_tile_size(tile, N, n_samples);
+    ConditioningSets sets(N_tile);
+    for (std::size_t i = 0; i < N_tile; i++)
+    {
+        const std::size_t i_global = N * tile + i;
+        // The lagged feature vector of sample i starts at input[i]
+        sets[i] = tree.find_nearest(input.data() + i_global, n_neighbours, i_global);
+    }
+    return sets;
+}
+
+/**
+ * @brief Compute the conditional losses of a tile and optionally their gradient terms.
+ *
+ * The conditional of sample i is computed from the Cholesky factor L of the covariance
+ * C of the set S = c(i) + {i}, with the sample i last. With z = L^-1 * y_S, the last row
+ * w of L^-1 and a = C_c^-1 * y_c, the conditional loss and its gradient read
+ *   loss_i = log(L_ii^2) + z_i^2
+ *   grad_i = w^T * dC * w - (z_i^2 * w^T * dC * w + 2 * z_i * w^T * dC * a)
+ * since C_S^-1 differs from C_c^-1 by w * w^T.
+ */
+VecchiaTerms compute_tile_vecchia_terms(const ConditioningSets &sets,
+                                        std::size_t tile,
+                                        std::size_t N,
+                                        std::size_t n_regressors,
+                                        const gprat_hyper::SEKParams &sek_params,
+                                        const std::vector<double> &training_input,
+                                        const std::vector<double> &training_output,
+                                        bool with_gradient)
+{
+    VecchiaTerms terms;
+    if (with_gradient)
+    {
+        terms.trace.assign(3, 0.0);
+        terms.dot.assign(3, 0.0);
+    }
+    const double dl_factor = -2.0 * sek_params.vertical_lengthscale / sek_params.lengthscale;
+
+    std::vector<std::size_t> set;
+    std::vector<double> distance;
+    std::vector<double> L;
+    std::vector<double> z;
+    std::vector<double> w;
+    std::vector<double> a;
+    for (std::size_t i = 0; i < sets.size(); i++)
+    {
+        set = sets[i];
+        set.push_back(N * tile + i);
+        const std::size_t S = set.size();
+        const int S_int = static_cast<int>(S);
+
+        // C = K + noise_variance * I on the set, lower triangle
+        distance.assign(S * S, 0.0);
+        L.assign(S * S, 0.0);
+        for (std::size_t r = 0; r < S; r++)
+        {
+            for (std::size_t c = 0; c <= r; c++)
+            {
+                distance[r * S + c] = compute_covariance_distance(
+                    set[r], set[c], n_regressors, sek_params, training_input, training_input);
+                L[r * S + c] = sek_params.vertical_lengthscale * std::exp(distance[r * S + c]);
+            }
+            L[r * S + r] += sek_params.noise_variance;
+        }
+        // POTRF: C = L * L^T
+        LAPACKE_dpotrf2(LAPACK_ROW_MAJOR, 'L', S_int, L.data(), S_int);
+        // TRSV: z = L^-1 * y_S
+        z.resize(S);
+        for (std::size_t r = 0; r < S; r++)
+        {
+            z[r] = training_output[set[r]];
+        }
+        cblas_dtrsv(CblasRowMajor, CblasLower, CblasNoTrans, CblasNonUnit, S_int, L.data(), S_int, z.data(), 1);
+
+        const double L_ii = L[S * S - 1];
+        const double z_i = z[S - 1];
+        terms.loss += std::log(L_ii * L_ii) + z_i * z_i;
+
+        if (!with_gradient)
+        {
+            continue;
+        }
+        // TRSV: w = L^-T * e_i
+        w.assign(S, 0.0);
+        w[S - 1] = 1.0;
+        cblas_dtrsv(CblasRowMajor, CblasLower, CblasTrans, CblasNonUnit, S_int, L.data(), S_int, w.data(), 1);
+        // TRSV: a = L_c^-T * z_c with the leading block L_c of L
+        a.assign(z.begin(), z.end());
+        a[S - 1] = 0.0;
+        if (S > 1)
+        {
+            cblas_dtrsv(CblasRowMajor, CblasLower, CblasTrans, CblasNonUnit, S_int - 1, L.data(), S_int, a.data(), 1);
+        }
+
+        // w^T * dC * w and w^T * dC * a for the lengthscale and the vertical lengthscale
+        double ww_l = 0.0;
+        double ww_v = 0.0;
+        double wa_l = 0.0;
+        double wa_v = 0.0;
+        for (std::size_t r = 0; r < S; r++)
+        {
+            for (std::size_t c = 0; c <= r; c++)
+            {
+                const double grad_v = std::exp(distance[r * S + c]);
+                const double grad_l = dl_factor * distance[r * S + c] * grad_v;
+                // Off-diagonal entries appear twice in the symmetric forms
+                const double weight = r == c ? 1.0 : 2.0;
+                const double ww = weight * w[r] * w[c];
+                const double wa = r == c ? w[r] * a[r] : w[r] * a[c] + w[c] * a[r];
+                ww_l += grad_l * ww;
+                ww_v += grad_v * ww;
+                wa_l += grad_l * wa;
+                wa_v += grad_v * wa;
+            }
+        }
+        // dC / d(noise_variance) = I
+        const double ww_n = std::inner_product(w.begin(), w.end(), w.begin(), 0.0);
+        const double wa_n = std::inner_product(w.begin(), w.end(), a.begin(), 0.0);
+
+        terms.trace[0] += ww_l;
+        terms.trace[1] += ww_v;
+        terms.trace[2] += ww_n;
+        terms.dot[0] += z_i * z_i * ww_l + 2.0 * z_i * wa_l;
+        terms.dot[1] += z_i * z_i * ww_v + 2.0 * z_i * wa_v;
+        terms.dot[2] += z_i * z_i * ww_n + 2.0 * z_i * wa_n;
+    }
+    return terms;
+}
+
+/**
+ * @brief Compute the predictions and optionally the uncertainties of a test tile,
+ * each test point conditioned on its nearest training samples.
+ */
+std::vector<std::vector<double>> predict_tile_vecchia(const KDTree &tree,
+                                                      std::size_t tile,
+                                                      std::size_t M,
+                                                      std::size_t n_test,
+                                                      std::size_t n_train,
+                                                      std::size_t n_regressors,
+                                                      std::size_t n_neighbours,
+                                                      const gprat_hyper::SEKParams &sek_params,
+                                                      const std::vector<double> &training_input,
+                                                      const std::vector<double> &training_output,
+                                                      const std::vector<double> &test_input,
+                                                      bool with_uncertainty)
+{
+    const std::size_t M_tile = compute_tile_size(tile, M, n_test);
+    std::vector<double> prediction(M_tile);
+    std::vector<double> uncertainty;
+    if (with_uncertainty)
+    {
+        uncertainty.resize(M_tile);
+    }
+
+    std::vector<double> L;
+    std::vector<double> z;
+    std::vector<double> v;
+    for (std::size_t j = 0; j < M_tile; j++)
+    {
+        const std::size_t j_global = M * tile + j;
+        const std::vector<std::size_t> set = tree.find_nearest(test_input.data() + j_global, n_neighbours, n_train);
+        const std::size_t S = set.size();
+        const int S_int = static_cast<int>(S);
+
+        // C = K_cc + noise_variance * I, z = y_c and v = k_c*
+        L.assign(S * S, 0.0);
+        z.resize(S);
+        v.resize(S);
+        for (std::size_t r = 0; r < S; r++)
+        {
+            for (std::size_t c = 0; c <= r; c++)
+            {
+                L[r * S + c] = compute_covariance_function(
+                    set[r], set[c], n_regressors, sek_params, training_input, training_input);
+            }
+            L[r * S + r] += sek_params.noise_variance;
+            z[r] = training_output[set[r]];
+            v[r] = compute_covariance_function(set[r], j_global, n_regressors, sek_params, training_input, test_input);
+        }
+        if (S > 0)
+        {
+            // POTRF: C = L * L^T
+            LAPACKE_dpotrf2(LAPACK_ROW_MAJOR, 'L', S_int, L.data(), S_int);
+            // TRSV: z = L^-1 * y_c and v = L^-1 * k_c*
+            cblas_dtrsv(CblasRowMajor, CblasLower, CblasNoTrans, CblasNonUnit, S_int, L.data(), S_int, z.data(), 1);
+            cblas_dtrsv(CblasRowMajor, CblasLower, CblasNoTrans, CblasNonUnit, S_int, L.data(), S_int, v.data(), 1);
+        }
+        // hat(y) = k_*c * C^-1 * y_c = v^T * z
+        prediction[j] = std::inner_product(v.begin(), v.end(), z.begin(), 0.0);
+        if (with_uncertainty)
+        {
+            // sigma^2 = k(x, x) - v^T * v
+            uncertainty[j] = sek_params.vertical_lengthscale - std::inner_product(v.begin(), v.end(), v.begin(), 0.0);
+        }
+    }
+    return std::vector<std::vector<double>>{ std::move(prediction), std::move(uncertainty) };
+}
+
+/**
+ * @brief Launch the asynchronous search of the conditioning sets of all training tiles.
+ */
+std::vector<hpx::shared_future<ConditioningSets>> launch_conditioning_sets(const KDTree &tree,
+                                                                           const std::vector<double> &training_input,
+                                                                           std::size_t n_tiles,
+                                                                           std::size_t N,
+                                                                           std::size_t n_train,
+                                                                           std::size_t n_neighbours)
+{
+    std::vector<hpx::shared_future<ConditioningSets>> sets;
+    sets.reserve(n_tiles);
+    for (std::size_t i = 0; i < n_tiles; i++)
+    {
+        sets.push_back(hpx::async(hpx::annotated_function(&gen_tile_conditioning_sets, "vecchia_neighbours"),
+                                  std::cref(tree),
+                                  i,
+                                  N,
+                                  n_train,
+                                  n_neighbours,
+                                  training_input));
+    }
+    return sets;
+}
+
+/**
+ * @brief Launch the asynchronous computation of the conditional losses of all training tiles.
+ */
+std::vector<hpx::shared_future<VecchiaTerms>>
+launch_vecchia_terms(const std::vector<hpx::shared_future<ConditioningSets>> &sets,
+                     std::size_t N,
+                     std::size_t n_regressors,
+                     const gprat_hyper::SEKParams &sek_params,
+                     const std::vector<double> &training_input,
+                     const std::vector<double> &training_output,
+                     bool with_gradient)
+{
+    std::vector<hpx::shared_future<VecchiaTerms>> terms;
+    terms.reserve(sets.size());
+    for (std::size_t i = 0; i < sets.size(); i++)
+    {
+        terms.push_back(
+            hpx::dataflow(hpx::annotated_function(hpx::unwrapping(&compute_tile_vecchia_terms), "vecchia_conditionals"),
+                          sets[i],
+                          i,
+                          N,
+                          n_regressors,
+                          sek_params,
+                          training_input,
+                          training_output,
+                          with_gradient));
+    }
+    return terms;
+}
+
+/**
+ * @brief Compute the Vecchia predictions and optionally their uncertainties.
+ */
+std::vector<std::vector<double>> vecchia_prediction(const std::vector<double> &training_input,
+                                                    const std::vector<double> &training_output,
+                                                    const std::vector<double> &test_input,
+                                                    const gprat_hyper::SEKParams &sek_params,
+                                                    int n_tiles,
+                                                    int n_tile_size,
+                                                    int m_tiles,
+                                                    int m_tile_size,
+                                                    int n_regressors,
+                                                    int n_neighbours,
+                                                    bool with_uncertainty)
+{
+    const std::size_t n_reg = static_cast<std::size_t>(n_regressors);
+    const std::size_t n_train = compute_n_samples(
+        static_cast<std::size_t>(n_tiles), static_cast<std::size_t>(n_tile_size), training_input.size(), n_reg);
+    const std::size_t n_test = compute_n_samples(
+        static_cast<std::size_t>(m_tiles), static_cast<std::size_t>(m_tile_size), test_input.size(), n_reg);
+    const std::size_t t_tiles = static_cast<std::size_t>(m_tiles);
+
+    const KDTree tree(training_input, n_train, n_reg);
+
+    // The test points are independent given the training data
+    std::vector<hpx::future<std::vector<std::vector<double>>>> tiles;
+    tiles.reserve(t_tiles);
+    for (std::size_t j = 0; j < t_tiles; j++)
+    {
+        tiles.push_back(hpx::async(hpx::annotated_function(&predict_tile_vecchia, "vecchia_prediction"),
+                                   std::cref(tree),
+                                   j,
+                                   static_cast<std::size_t>(m_tile_size),
+                                   n_test,
+                                   n_train,
+                                   n_reg,
+                                   static_cast<std::size_t>(n_neighbours),
+                                   sek_params,
+                                   training_input,
+                                   training_output,
+                                   test_input,
+                                   with_uncertainty));
+    }
+
+    std::vector<double> prediction_result;
+    std::vector<double> uncertainty_result;
+    prediction_result.reserve(n_test);
+    if (with_uncertainty)
+    {
+        uncertainty_result.reserve(n_test);
+    }
+    for (std::size_t j = 0; j < t_tiles; j++)
+    {
+        auto tile = tiles[j].get();
+        prediction_result.insert(prediction_result.end(), tile[0].begin(), tile[0].end());
+        uncertainty_result.insert(uncertainty_result.end(), tile[1].begin(), tile[1].end());
+    }
+    return std::vector<std::vector<double>>{ std::move(prediction_result), std::move(uncertainty_result) };
+}
+
+}  // namespace
+
+std::vector<double> predict_vecchia(const std::vector<double> &training_input,
+                                    const std::vector<double> &training_output,
+                                    const std::vector<double> &test_input,
+                                    const gprat_hyper::SEKParams &sek_params,
+                                    int n_tiles,
+                                    int n_tile_size,
+                                    int m_tiles,
+                                    int m_tile_size,
+                                    int n_regressors,
+                                    int n_neighbours)
+{
+    return vecchia_prediction(training_input,
+                              training_output,
+                              test_input,
+                              sek_params,
+                              n_tiles,
+                              n_tile_size,
+                              m_tiles,
+                              m_tile_size,
+                              n_regressors,
+                              n_neighbours,
+                              false)
+        .front();
+}
+
+std::vector<std::vector<double>> predict_vecchia_with_uncertainty(const std::vector<double> &training_input,
+                                                                  const std::vector<double> &training_output,
+                                                                  const std::vector<double> &test_input,
+                                                                  const gprat_hyper::SEKParams &sek_params,
+                                                                  int n_tiles,
+                                                                  int n_tile_size,
+                                                                  int m_tiles,
+                                                                  int m_tile_size,
+                                                                  int n_regressors,
+                                                                  int n_neighbours)
+{
+    return vecchia_prediction(training_input,
+                              training_output,
+                              test_input,
+                              sek_params,
+                              n_tiles,
+                              n_tile_size,
+                              m_tiles,
+                              m_tile_size,
+                              n_regressors,
+                              n_neighbours,
+                              true);
+}
+
+double compute_loss_vecchia(const std::vector<double> &training_input,
+                            const std::vector<double> &training_output,
+                            const gprat_hyper::SEKParams &sek_params,
+                            int n_tiles,
+                            int n_tile_size,
+                            int n_regressors,
+                            int n_neighbours)
+{
+    /*
+     * Negative log likelihood loss of the Vecchia approximation:
+     * loss(theta) = 0.5 * ( sum_i log(sigma_i^2) + r_i^2 / sigma_i^2 + N * log(2 * pi) )
+     * with the mean mu_i and variance sigma_i^2 of y_i given y_c(i) and r_i = y_i - mu_i
+     */
+    const std::size_t n_reg = static_cast<std::size_t>(n_regressors);
+    const std::size_t N = static_cast<std::size_t>(n_tile_size);
+    const std::size_t n_train =
+        compute_n_samples(static_cast<std::size_t>(n_tiles), N, training_input.size(), n_reg);
+
+    const KDTree tree(training_input, n_train, n_reg);
+    auto sets = launch_conditioning_sets(
+        tree, training_input, static_cast<std::size_t>(n_tiles), N, n_train, static_cast<std::size_t>(n_neighbours));
+    auto terms = launch_vecchia_terms(sets, N, n_reg, sek_params, training_input, training_output, false);
+
+    std::vector<double> losses;
+    losses.reserve(terms.size());
+    for (auto &tile_terms : terms)
+    {
+        losses.push_back(tile_terms.get().loss);
+    }
+    return add_losses(losses, n_train);
+}
+
+std::vector<double> optimize_vecchia(const std::vector<double> &training_input,
+                                     const std::vector<double> &training_output,
+                                     int n_tiles,
+                                     int n_tile_size,
+                                     int n_regressors,
+                                     int n_neighbours,
+                                     const gprat_hyper::AdamParams &adam_params,
+                                     gprat_hyper::SEKParams &sek_params,
+                                     std::vector<bool> trainable_params)
+{
+    /*
+     * 1: Search the conditioning sets c(i) once
+     * for opt_iter:
+     *   2: Compute the conditional losses and their gradient terms per tile
+     *   3: Compute gradient = 0.5 / N * sum_i ( trace_i - dot_i ), see compute_tile_vecchia_terms
+     *   4: Update hyperparameters theta with Adam optimizer, see update_hyperparameter_tiled
+     * endfor
+     */
+    const std::size_t n_reg = static_cast<std::size_t>(n_regressors);
+    const std::size_t N = static_cast<std::size_t>(n_tile_size);
+    const std::size_t n_train =
+        compute_n_samples(static_cast<std::size_t>(n_tiles), N, training_input.size(), n_reg);
+
+    const KDTree tree(training_input, n_train, n_reg);
+    auto sets = launch_conditioning_sets(
+        tree, training_input, static_cast<std::size_t>(n_tiles), N, n_train, static_cast<std::size_t>(n_neighbours));
+
+    std::vector<double> losses;
+    losses.reserve(static_cast<std::size_t>(adam_params.opt_iter));
+    for (std::size_t iter = 0; iter < static_cast<std::size_t>(adam_params.opt_iter); iter++)
+    {
+        auto terms = launch_vecchia_terms(sets, N, n_reg, sek_params, training_input, training_output, true);
+
+        std::vector<double> tile_losses;
+        std::vector<double> trace(sek_params.size(), 0.0);
+        std::vector<double> dot(sek_params.size(), 0.0);
+        tile_losses.reserve(terms.size());
+        for (auto &tile_terms : terms)
+        {
+            const VecchiaTerms &result = tile_terms.get();
+            tile_losses.push_back(result.loss);
+            for (std::size_t p = 0; p < sek_params.size(); p++)
+            {
+                trace[p] += result.trace[p];
+                dot[p] += result.dot[p];
+            }
+        }
+        losses.push_back(add_losses(tile_losses, n_train));
+
+        for (std::size_t p = 0; p < sek_params.size(); p++)
+        {
+            if (trainable_params[p])
+            {
+                const bool noise = p == 2;
+                // Chain rule of the softplus constraint
+                const double gradient = compute_sigmoid(to_unconstrained(sek_params.get_param(p), noise))
+                                        * compute_gradient(trace[p], dot[p], n_train);
+                // m_T = beta1 * m_T-1 + (1 - beta1) * g_T
+                sek_params.m_T[p] = update_first_moment(gradient, sek_params.m_T[p], adam_params.beta1);
+                // w_T = beta2 + w_T-1 + (1 - beta2) * g_T^2
+                sek_params.w_T[p] = update_second_moment(gradient, sek_params.w_T[p], adam_params.beta2);
+                const double updated_param = adam_step(to_unconstrained(sek_params.get_param(p), noise),
+                                                       adam_params,
+                                                       sek_params.m_T[p],
+                                                       sek_params.w_T[p],
+                                                       iter);
+                sek_params.set_param(p, to_constrained(updated_param, noise));
+            }
+        }
+    }
+    return losses;
+}
+
+}  // end of namespace cpu
@@ -1,54 +1,326 @@
 #include "cpu/tiled_algorithms.hpp"
 
+#include "cpu/adapter_cblas_fp32.hpp"
 #include "cpu/adapter_cblas_fp64.hpp"
+#include "cpu/adapter_low_rank.hpp"
 #include "cpu/gp_algorithms.hpp"
 #include "cpu/gp_optimizer.hpp"
 #include "cpu/gp_uncertainty.hpp"
+#include <algorithm>
 #include <hpx/future.hpp>
+#include <hpx/runtime.hpp>
+#include <type_traits>
 
 namespace cpu
 {
 
+namespace
+{
+
+/**
+ * @brief Returns a stored tile in the compute type T, without copy if the types match.
+ */
+template <typename T, typename S>
+hpx::shared_future<std::vector<T>> load_tile(const hpx::shared_future<std::vector<S>> &f_tile)
+{
+    if constexpr (std::is_same_v<T, S>)
+    {
+        return f_tile;
+    }
+    else
+    {
+        const std::vector<S> &tile = f_tile.get();
+        return hpx::make_ready_future(std::vector<T>(tile.begin(), tile.end()));
+    }
+}
+
+/**
+ * @brief Returns a computed tile in the storage type S, without copy if the types match.
+ */
+template <typename S, typename T>
+std::vector<S> store_tile(std::vector<T> &&tile)
+{
+    if constexpr (std::is_same_v<T, S>)
+    {
+        return std::move(tile);
+    }
+    else
+    {
+        return std::vector<S>(tile.begin(), tile.end());
+    }
+}
+
+// Tile operations that compute in T on tiles stored in S, see the BLAS adapters for the documentation
+
+template <typename T, typename SA, typename SB, typename SC>
+std::vector<SC> gemm_stored(hpx::shared_future<std::vector<SA>> f_A,
+                            hpx::shared_future<std::vector<SB>> f_B,
+                            hpx::shared_future<std::vector<SC>> f_C,
+                            const int N,
+                            const int M,
+                            const int K,
+                            const BLAS_TRANSPOSE transpose_A,
+                            const BLAS_TRANSPOSE transpose_B)
+{
+    return store_tile<SC>(
+        gemm<T>(load_tile<T>(f_A), load_tile<T>(f_B), load_tile<T>(f_C), N, M, K, transpose_A, transpose_B));
+}
+
+template <typename T, typename S>
+std::vector<T> gemv_stored(hpx::shared_future<std::vector<S>> f_A,
+                           hpx::shared_future<std::vector<T>> f_a,
+                           hpx::shared_future<std::vector<T>> f_b,
+                           const int N,
+                           const int M,
+                           const BLAS_ALPHA alpha,
+                           const BLAS_TRANSPOSE transpose_A)
+{
+    return gemv<T>(load_tile<T>(f_A), f_a, f_b, N, M, alpha, transpose_A);
+}
+
+template <typename T, typename S>
+std::vector<T> syrk_stored(hpx::shared_future<std::vector<T>> f_A,
+                           hpx::shared_future<std::vector<S>> f_B,
+                           const int N,
+                           const int M,
+                           const BLAS_TRANSPOSE transpose_B)
+{
+    return syrk<T>(f_A, load_tile<T>(f_B), N, M, transpose_B);
+}
+
+template <typename T, typename S>
+std::vector<T> dot_diag_syrk_stored(hpx::shared_future<std::vector<S>> f_A,
+                                    hpx::shared_future<std::vector<T>> f_r,
+                                    const int N,
+                                    const int M)
+{
+    return dot_diag_syrk<T>(load_tile<T>(f_A), f_r, N, M);
+}
+
+/**
+ * @brief Solve L * [x | X_1 ... X_c] = [a | A_1 ... A_c] for a chunk of columns with one wide TRSM.
+ *
+ * The vector tile is only part of the first chunk, such that ft_a holds zero or one tiles.
+ */
+template <typename T, typename S>
+std::vector<std::vector<T>> trsm_multi_rhs(hpx::shared_future<std::vector<T>> f_L,
+                                           Tiled_vector_t<T> ft_a,
+                                           std::vector<hpx::shared_future<std::vector<S>>> ft_A,
+                                           const int N)
+{
+    // The vector is the first tile of the panel with a single column
+    Tiled_matrix_t<T> ft_panel = std::move(ft_a);
+    ft_panel.reserve(ft_panel.size() + ft_A.size());
+    for (const auto &f_A : ft_A)
+    {
+        ft_panel.push_back(load_tile<T>(f_A));
+    }
+    return trsm_panel_packed<T>(f_L, std::move(ft_panel), N);
+}
+
+/**
+ * @brief Update [b | B_1 ... B_c] = [b | B_1 ... B_c] - A * [a | A_1 ... A_c] for a chunk of columns with one wide
+ * GEMM on the N x M tile A.
+ *
+ * The vector tiles are only part of the first chunk, such that ft_a and ft_b hold zero or one tiles.
+ */
+template <typename T, typename S>
+std::vector<std::vector<T>> gemm_multi_rhs(hpx::shared_future<std::vector<T>> f_A,
+                                           Tiled_vector_t<T> ft_a,
+                                           std::vector<hpx::shared_future<std::vector<S>>> ft_A,
+                                           Tiled_vector_t<T> ft_b,
+                                           std::vector<hpx::shared_future<std::vector<S>>> ft_B,
+                                           const int N,
+                                           const int M)
+{
+    // The vectors are the first tiles of the panels with a single column
+    Tiled_matrix_t<T> ft_update = std::move(ft_a);
+    Tiled_matrix_t<T> ft_base = std::move(ft_b);
+    ft_update.reserve(ft_update.size() + ft_A.size());
+    ft_base.reserve(ft_base.size() + ft_B.size());
+    for (std::size_t c = 0; c < ft_B.size(); c++)
+    {
+        ft_update.push_back(load_tile<T>(ft_A[c]));
+        ft_base.push_back(load_tile<T>(ft_B[c]));
+    }
+    return gemm_panel_packed<T>(f_A, std::move(ft_update), std::move(ft_base), N, M);
+}
+
+/**
+ * @brief Returns the tiles [c_begin, c_end) of row k of a tiled matrix with m_tiles tiles per row.
+ */
+template <typename S>
+Tiled_matrix_t<S> get_row_tiles(const Tiled_matrix_t<S> &ft_matrix,
+                                std::size_t k,
+                                std::size_t m_tiles,
+                                std::size_t c_begin,
+                                std::size_t c_end)
+{
+    return Tiled_matrix_t<S>(ft_matrix.begin() + static_cast<std::ptrdiff_t>(k * m_tiles + c_begin),
+                             ft_matrix.begin() + static_cast<std::ptrdiff_t>(k * m_tiles + c_end));
+}
+
+/**
+ * @brief Returns the vector tile k for the first chunk of columns and no tile otherwise.
+ */
+template <typename T>
+Tiled_vector_t<T> get_chunk_vector(const Tiled_vector_t<T> &ft_vector, std::size_t k, std::size_t c_begin)
+{
+    return c_begin == 0 ? Tiled_vector_t<T>{ ft_vector[k] } : Tiled_vector_t<T>{};
+}
+
+/**
+ * @brief Distribute the result of a multi right-hand side task to the vector tile, for the first chunk, and the
+ * matrix tiles [c_begin, c_end) of row k.
+ */
+template <typename T, typename S>
+void set_multi_rhs_tiles(hpx::future<std::vector<std::vector<T>>> f_panel,
+                         Tiled_vector_t<T> &ft_vector,
+                         Tiled_matrix_t<S> &ft_matrix,
+                         std::size_t k,
+                         std::size_t m_tiles,
+                         std::size_t c_begin,
+                         std::size_t c_end)
+{
+    const std::size_t n_vector = c_begin == 0 ? 1 : 0;
+    auto ft_solved = hpx::split_future(std::move(f_panel), n_vector + c_end - c_begin);
+    if (n_vector == 1)
+    {
+        ft_vector[k] = std::move(ft_solved[0]);
+    }
+    for (std::size_t c = c_begin; c < c_end; c++)
+    {
+        auto &f_solved = ft_solved[n_vector + c - c_begin];
+        if constexpr (std::is_same_v<T, S>)
+        {
+            ft_matrix[k * m_tiles + c] = std::move(f_solved);
+        }
+        else
+        {
+            ft_matrix[k * m_tiles + c] =
+                hpx::dataflow(hpx::unwrapping([](std::vector<T> tile) { return store_tile<S>(std::move(tile)); }),
+                              std::move(f_solved));
+        }
+    }
+}
+
+}  // namespace
+
+// Task Granularity
+
+std::size_t compute_panel_chunk_size(std::size_t tile_flops, std::size_t n_panel)
+{
+    if (n_panel <= 1 || tile_flops >= MIN_TASK_FLOPS)
+    {
+        return 1;
+    }
+    // Number of tiles required to reach the minimum work per task
+    std::size_t chunk = (MIN_TASK_FLOPS + tile_flops - 1) / tile_flops;
+    // Keep at least one task per worker thread: rounding down guarantees
+    // ceil(n_panel / chunk) >= n_threads, panels with fewer tiles are not fused
+    const std::size_t n_threads =
+        std::max(std::size_t{ 1 }, static_cast<std::size_t>(hpx::get_num_worker_threads()));
+    const std::size_t max_chunk = n_panel / n_threads;
+    return std::max(std::size_t{ 1 }, std::min(chunk, max_chunk));
+}
+
+int compute_blas_threads(std::size_t n_concurrent_tasks)
+{
+    const std::size_t n_threads =
+        std::max(std::size_t{ 1 }, static_cast<std::size_t>(hpx::get_num_worker_threads()));
+    return static_cast<int>(std::max(std::size_t{ 1 }, n_threads / (n_concurrent_tasks + 1)));
+}
+
+// Tile Sizes
+
+int get_tile_size(std::size_t k, int N, std::size_t n_total)
+{
+    return static_cast<int>(compute_tile_size(k, static_cast<std::size_t>(N), n_total));
+}
+
 // Tiled Cholesky Algorithm
 
-void right_looking_cholesky_tiled(Tiled_matrix &ft_tiles, int N, std::size_t n_tiles)
+template <typename T>
+void right_looking_cholesky_tiled(Tiled_matrix_t<T> &ft_tiles, int N, std::size_t n_tiles, std::size_t n_total)
 {
+    const std::size_t tile_size = static_cast<std::size_t>(N);
+    const std::size_t n_trsm_flops = tile_size * tile_size * tile_size;
     for (std::size_t k = 0; k < n_tiles; k++)
     {
+        const int N_k = get_tile_size(k, N, n_total);
+#ifdef GPRAT_ENABLE_HYBRID_BLAS
+        // POTRF: Compute Cholesky factor L with the BLAS threads left over by
+        // the concurrent trailing updates of the previous step
+        const std::size_t n_trailing = n_tiles - k;
+        ft_tiles[k * n_tiles + k] = hpx::dataflow(
+            hpx::annotated_function(potrf_threaded<T>, "cholesky_tiled"),
+            ft_tiles[k * n_tiles + k],
+            N_k,
+            compute_blas_threads(k == 0 ? 0 : n_trailing * (n_trailing + 1) / 2 - 1));
+#else
         // POTRF: Compute Cholesky factor L
         ft_tiles[k * n_tiles + k] =
-            hpx::dataflow(hpx::annotated_function(potrf, "cholesky_tiled"), ft_tiles[k * n_tiles + k], N);
-        for (std::size_t m = k + 1; m < n_tiles; m++)
+            hpx::dataflow(hpx::annotated_function(potrf<T>, "cholesky_tiled"), ft_tiles[k * n_tiles + k], N_k);
+#endif
+        const std::size_t chunk = compute_panel_chunk_size(n_trsm_flops, n_tiles - k - 1);
+        for (std::size_t m_begin = k + 1; m_begin < n_tiles; m_begin += chunk)
         {
-            // TRSM:  Solve X * L^T = A
-            ft_tiles[m * n_tiles + k] = hpx::dataflow(
-                hpx::annotated_function(trsm, "cholesky_tiled"),
-                ft_tiles[k * n_tiles + k],
-                ft_tiles[m * n_tiles + k],
-                N,
-                N,
-                Blas_trans,
-                Blas_right);
+            const std::size_t m_end = std::min(m_begin + chunk, n_tiles);
+            if (chunk == 1)
+            {
+                // TRSM:  Solve X * L^T = A
+                ft_tiles[m_begin * n_tiles + k] = hpx::dataflow(
+                    hpx::annotated_function(trsm<T>, "cholesky_tiled"),
+                    ft_tiles[k * n_tiles + k],
+                    ft_tiles[m_begin * n_tiles + k],
+                    get_tile_size(m_begin, N, n_total),
+                    N_k,
+                    Blas_trans,
+                    Blas_right);
+                continue;
+            }
+            // Fused TRSM: Solve X_m * L^T = A_m for all tiles of the chunk
+            Tiled_matrix_t<T> ft_panel;
+            ft_panel.reserve(m_end - m_begin);
+            for (std::size_t m = m_begin; m < m_end; m++)
+            {
+                ft_panel.push_back(ft_tiles[m * n_tiles + k]);
+            }
+            auto ft_solved = hpx::split_future(
+                hpx::dataflow(hpx::annotated_function(trsm_panel<T>, "cholesky_tiled"),
+                              ft_tiles[k * n_tiles + k],
+                              ft_panel,
+                              N_k,
+                              Blas_trans,
+                              Blas_right),
+                m_end - m_begin);
+            for (std::size_t m = m_begin; m < m_end; m++)
+            {
+                ft_tiles[m * n_tiles + k] = std::move(ft_solved[m - m_begin]);
+            }
         }
         for (std::size_t m = k + 1; m < n_tiles; m++)
         {
+            const int N_m = get_tile_size(m, N, n_total);
             // SYRK:  A = A - B * B^T
             ft_tiles[m * n_tiles + m] = hpx::dataflow(
-                hpx::annotated_function(syrk, "cholesky_tiled"),
+                hpx::annotated_function(syrk<T>, "cholesky_tiled"),
                 ft_tiles[m * n_tiles + m],
                 ft_tiles[m * n_tiles + k],
-                N);
+                N_m,
+                N_k,
+                Blas_no_trans);
             for (std::size_t n = k + 1; n < m; n++)
             {
                 // GEMM: C = C - A * B^T
                 ft_tiles[m * n_tiles + n] = hpx::dataflow(
-                    hpx::annotated_function(gemm, "cholesky_tiled"),
+                    hpx::annotated_function(gemm<T>, "cholesky_tiled"),
                     ft_tiles[m * n_tiles + k],
                     ft_tiles[n * n_tiles + k],
                     ft_tiles[m * n_tiles + n],
-                    N,
-                    N,
-                    N,
+                    N_k,
+                    get_tile_size(n, N, n_total),
+                    N_m,
                     Blas_no_trans,
                     Blas_trans);
             }
@@ -58,89 +330,161 @@ void right_looking_cholesky_tiled(Tiled_matrix &ft_tiles, int N, std::size_t n_t
 
 // Tiled Triangular Solve Algorithms
 
-void forward_solve_tiled(Tiled_matrix &ft_tiles, Tiled_vector &ft_rhs, int N, std::size_t n_tiles)
+template <typename T>
+void forward_solve_tiled(
+    Tiled_matrix_t<T> &ft_tiles, Tiled_vector_t<T> &ft_rhs, int N, std::size_t n_tiles, std::size_t n_total)
 {
+    const std::size_t n_gemv_flops = 2 * static_cast<std::size_t>(N) * static_cast<std::size_t>(N);
     for (std::size_t k = 0; k < n_tiles; k++)
     {
+        const int N_k = get_tile_size(k, N, n_total);
         // TRSM: Solve L * x = a
         ft_rhs[k] = hpx::dataflow(
-            hpx::annotated_function(trsv, "triangular_solve_tiled"),
+            hpx::annotated_function(trsv<T>, "triangular_solve_tiled"),
             ft_tiles[k * n_tiles + k],
             ft_rhs[k],
-            N,
+            N_k,
             Blas_no_trans);
-        for (std::size_t m = k + 1; m < n_tiles; m++)
+        const std::size_t chunk = compute_panel_chunk_size(n_gemv_flops, n_tiles - k - 1);
+        for (std::size_t m_begin = k + 1; m_begin < n_tiles; m_begin += chunk)
         {
-            // GEMV: b = b - A * a
-            ft_rhs[m] = hpx::dataflow(
-                hpx::annotated_function(gemv, "triangular_solve_tiled"),
-                ft_tiles[m * n_tiles + k],
-                ft_rhs[k],
-                ft_rhs[m],
-                N,
-                N,
-                Blas_substract,
-                Blas_no_trans);
+            const std::size_t m_end = std::min(m_begin + chunk, n_tiles);
+            if (chunk == 1)
+            {
+                // GEMV: b = b - A * a
+                ft_rhs[m_begin] = hpx::dataflow(
+                    hpx::annotated_function(gemv<T>, "triangular_solve_tiled"),
+                    ft_tiles[m_begin * n_tiles + k],
+                    ft_rhs[k],
+                    ft_rhs[m_begin],
+                    get_tile_size(m_begin, N, n_total),
+                    N_k,
+                    Blas_substract,
+                    Blas_no_trans);
+                continue;
+            }
+            // Fused GEMV: b_m = b_m - A_m * a for all tiles of the chunk
+            Tiled_matrix_t<T> ft_panel;
+            Tiled_vector_t<T> ft_panel_rhs;
+            ft_panel.reserve(m_end - m_begin);
+            ft_panel_rhs.reserve(m_end - m_begin);
+            for (std::size_t m = m_begin; m < m_end; m++)
+            {
+                ft_panel.push_back(ft_tiles[m * n_tiles + k]);
+                ft_panel_rhs.push_back(ft_rhs[m]);
+            }
+            auto ft_updated = hpx::split_future(
+                hpx::dataflow(hpx::annotated_function(gemv_panel<T>, "triangular_solve_tiled"),
+                              ft_panel,
+                              ft_rhs[k],
+                              ft_panel_rhs,
+                              Blas_substract,
+                              Blas_no_trans),
+                m_end - m_begin);
+            for (std::size_t m = m_begin; m < m_end; m++)
+            {
+                ft_rhs[m] = std::move(ft_updated[m - m_begin]);
+            }
         }
     }
 }
 
-void backward_solve_tiled(Tiled_matrix &ft_tiles, Tiled_vector &ft_rhs, int N, std::size_t n_tiles)
+template <typename T>
+void backward_solve_tiled(
+    Tiled_matrix_t<T> &ft_tiles, Tiled_vector_t<T> &ft_rhs, int N, std::size_t n_tiles, std::size_t n_total)
 {
+    const std::size_t n_gemv_flops = 2 * static_cast<std::size_t>(N) * static_cast<std::size_t>(N);
     for (int k_ = static_cast<int>(n_tiles) - 1; k_ >= 0; k_--)  // int instead of std::size_t for last comparison
     {
         std::size_t k = static_cast<std::size_t>(k_);
+        const int N_k = get_tile_size(k, N, n_total);
         // TRSM: Solve L^T * x = a
         ft_rhs[k] = hpx::dataflow(
-            hpx::annotated_function(trsv, "triangular_solve_tiled"),
+            hpx::annotated_function(trsv<T>, "triangular_solve_tiled"),
             ft_tiles[k * n_tiles + k],
             ft_rhs[k],
-            N,
+            N_k,
             Blas_trans);
-        for (int m_ = k_ - 1; m_ >= 0; m_--)  // int instead of std::size_t for last comparison
+        const std::size_t chunk = compute_panel_chunk_size(n_gemv_flops, k);
+        for (std::size_t m_begin = 0; m_begin < k; m_begin += chunk)
         {
-            std::size_t m = static_cast<std::size_t>(m_);
-            // GEMV:b = b - A^T * a
-            ft_rhs[m] = hpx::dataflow(
-                hpx::annotated_function(gemv, "triangular_solve_tiled"),
-                ft_tiles[k * n_tiles + m],
-                ft_rhs[k],
-                ft_rhs[m],
-                N,
-                N,
-                Blas_substract,
-                Blas_trans);
+            const std::size_t m_end = std::min(m_begin + chunk, k);
+            if (chunk == 1)
+            {
+                // GEMV:b = b - A^T * a
+                ft_rhs[m_begin] = hpx::dataflow(
+                    hpx::annotated_function(gemv<T>, "triangular_solve_tiled"),
+                    ft_tiles[k * n_tiles + m_begin],
+                    ft_rhs[k],
+                    ft_rhs[m_begin],
+                    N_k,
+                    get_tile_size(m_begin, N, n_total),
+                    Blas_substract,
+                    Blas_trans);
+                continue;
+            }
+            // Fused GEMV: b_m = b_m - A_m^T * a for all tiles of the chunk
+            Tiled_matrix_t<T> ft_panel;
+            Tiled_vector_t<T> ft_panel_rhs;
+            ft_panel.reserve(m_end - m_begin);
+            ft_panel_rhs.reserve(m_end - m_begin);
+            for (std::size_t m = m_begin; m < m_end; m++)
+            {
+                ft_panel.push_back(ft_tiles[k * n_tiles + m]);
+                ft_panel_rhs.push_back(ft_rhs[m]);
+            }
+            auto ft_updated = hpx::split_future(
+                hpx::dataflow(hpx::annotated_function(gemv_panel<T>, "triangular_solve_tiled"),
+                              ft_panel,
+                              ft_rhs[k],
+                              ft_panel_rhs,
+                              Blas_substract,
+                              Blas_trans),
+                m_end - m_begin);
+            for (std::size_t m = m_begin; m < m_end; m++)
+            {
+                ft_rhs[m] = std::move(ft_updated[m - m_begin]);
+            }
         }
     }
 }
 
-void forward_solve_tiled_matrix(
-    Tiled_matrix &ft_tiles, Tiled_matrix &ft_rhs, int N, int M, std::size_t n_tiles, std::size_t m_tiles)
+template <typename T>
+void forward_solve_tiled_matrix(Tiled_matrix_t<T> &ft_tiles,
+                                Tiled_matrix_t<T> &ft_rhs,
+                                int N,
+                                int M,
+                                std::size_t n_tiles,
+                                std::size_t m_tiles,
+                                std::size_t n_total,
+                                std::size_t m_total)
 {
     for (std::size_t c = 0; c < m_tiles; c++)
     {
+        const int M_c = get_tile_size(c, M, m_total);
         for (std::size_t k = 0; k < n_tiles; k++)
         {
+            const int N_k = get_tile_size(k, N, n_total);
             // TRSM: solve L * X = A
             ft_rhs[k * m_tiles + c] = hpx::dataflow(
-                hpx::annotated_function(trsm, "triangular_solve_tiled_matrix"),
+                hpx::annotated_function(trsm<T>, "triangular_solve_tiled_matrix"),
                 ft_tiles[k * n_tiles + k],
                 ft_rhs[k * m_tiles + c],
-                N,
-                M,
+                N_k,
+                M_c,
                 Blas_no_trans,
                 Blas_left);
             for (std::size_t m = k + 1; m < n_tiles; m++)
             {
                 // GEMM: C = C - A * B
                 ft_rhs[m * m_tiles + c] = hpx::dataflow(
-                    hpx::annotated_function(gemm, "triangular_solve_tiled_matrix"),
+                    hpx::annotated_function(gemm<T>, "triangular_solve_tiled_matrix"),
                     ft_tiles[m * n_tiles + k],
                     ft_rhs[k * m_tiles + c],
                     ft_rhs[m * m_tiles + c],
-                    N,
-                    M,
-                    N,
+                    N_k,
+                    M_c,
+                    get_tile_size(m, N, n_total),
                     Blas_no_trans,
                     Blas_no_trans);
             }
@@ -148,21 +492,30 @@ void forward_solve_tiled_matrix(
     }
 }
 
-void backward_solve_tiled_matrix(
-    Tiled_matrix &ft_tiles, Tiled_matrix &ft_rhs, int N, int M, std::size_t n_tiles, std::size_t m_tiles)
+template <typename T>
+void backward_solve_tiled_matrix(Tiled_matrix_t<T> &ft_tiles,
+                                 Tiled_matrix_t<T> &ft_rhs,
+                                 int N,
+                                 int M,
+                                 std::size_t n_tiles,
+                                 std::size_t m_tiles,
+                                 std::size_t n_total,
+                                 std::size_t m_total)
 {
     for (std::size_t c = 0; c < m_tiles; c++)
     {
+        const int M_c = get_tile_size(c, M, m_total);
         for (int k_ = static_cast<int>(n_tiles) - 1; k_ >= 0; k_--)  // int instead of std::size_t for last comparison
         {
             std::size_t k = static_cast<std::size_t>(k_);
+            const int N_k = get_tile_size(k, N, n_total);
             // TRSM: solve L^T * X = A
             ft_rhs[k * m_tiles + c] = hpx::dataflow(
-                hpx::annotated_function(trsm, "triangular_solve_tiled_matrix"),
+                hpx::annotated_function(trsm<T>, "triangular_solve_tiled_matrix"),
                 ft_tiles[k * n_tiles + k],
                 ft_rhs[k * m_tiles + c],
-                N,
-                M,
+                N_k,
+                M_c,
                 Blas_trans,
                 Blas_left);
             for (int m_ = k_ - 1; m_ >= 0; m_--)  // int instead of std::size_t for last comparison
@@ -170,13 +523,13 @@ void backward_solve_tiled_matrix(
                 std::size_t m = static_cast<std::size_t>(m_);
                 // GEMM: C = C - A^T * B
                 ft_rhs[m * m_tiles + c] = hpx::dataflow(
-                    hpx::annotated_function(gemm, "triangular_solve_tiled_matrix"),
+                    hpx::annotated_function(gemm<T>, "triangular_solve_tiled_matrix"),
                     ft_tiles[k * n_tiles + m],
                     ft_rhs[k * m_tiles + c],
                     ft_rhs[m * m_tiles + c],
-                    N,
-                    M,
-                    N,
+                    N_k,
+                    M_c,
+                    get_tile_size(m, N, n_total),
                     Blas_trans,
                     Blas_no_trans);
             }
@@ -184,33 +537,133 @@ void backward_solve_tiled_matrix(
     }
 }
 
-void matrix_vector_tiled(Tiled_matrix &ft_tiles,
-                         Tiled_vector &ft_vector,
-                         Tiled_vector &ft_rhs,
+template <typename T, typename S>
+void forward_solve_tiled_multi_rhs(Tiled_matrix_t<T> &ft_tiles,
+                                   Tiled_vector_t<T> &ft_vector,
+                                   Tiled_matrix_t<S> &ft_rhs,
+                                   int N,
+                                   std::size_t n_tiles,
+                                   std::size_t m_tiles,
+                                   std::size_t n_total)
+{
+    // Fuse the right-hand side tiles into column chunks, estimating the work per tile with square tiles
+    const std::size_t tile_size = static_cast<std::size_t>(N);
+    const std::size_t chunk = compute_panel_chunk_size(tile_size * tile_size * tile_size, m_tiles);
+    // The vector is part of the first chunk, such that there is at least one chunk
+    const std::size_t n_chunks = std::max(std::size_t{ 1 }, (m_tiles + chunk - 1) / chunk);
+    for (std::size_t k = 0; k < n_tiles; k++)
+    {
+        const int N_k = get_tile_size(k, N, n_total);
+        for (std::size_t i = 0; i < n_chunks; i++)
+        {
+            const std::size_t c_begin = i * chunk;
+            const std::size_t c_end = std::min(m_tiles, c_begin + chunk);
+            // Wide TRSM: Solve L * [x | X] = [a | A] for a chunk of tiles of row k
+            set_multi_rhs_tiles(
+                hpx::dataflow(hpx::annotated_function(trsm_multi_rhs<T, S>, "triangular_solve_tiled_multi_rhs"),
+                              ft_tiles[k * n_tiles + k],
+                              get_chunk_vector(ft_vector, k, c_begin),
+                              get_row_tiles(ft_rhs, k, m_tiles, c_begin, c_end),
+                              N_k),
+                ft_vector,
+                ft_rhs,
+                k,
+                m_tiles,
+                c_begin,
+                c_end);
+        }
+        for (std::size_t m = k + 1; m < n_tiles; m++)
+        {
+            for (std::size_t i = 0; i < n_chunks; i++)
+            {
+                const std::size_t c_begin = i * chunk;
+                const std::size_t c_end = std::min(m_tiles, c_begin + chunk);
+                // Wide GEMM: [b | B] = [b | B] - A * [a | A] for a chunk of tiles of row m
+                set_multi_rhs_tiles(
+                    hpx::dataflow(hpx::annotated_function(gemm_multi_rhs<T, S>, "triangular_solve_tiled_multi_rhs"),
+                                  ft_tiles[m * n_tiles + k],
+                                  get_chunk_vector(ft_vector, k, c_begin),
+                                  get_row_tiles(ft_rhs, k, m_tiles, c_begin, c_end),
+                                  get_chunk_vector(ft_vector, m, c_begin),
+                                  get_row_tiles(ft_rhs, m, m_tiles, c_begin, c_end),
+                                  get_tile_size(m, N, n_total),
+                                  N_k),
+                    ft_vector,
+                    ft_rhs,
+                    m,
+                    m_tiles,
+                    c_begin,
+                    c_end);
+            }
+        }
+    }
+}
+
+template <typename T>
+void matrix_vector_tiled(Tiled_matrix_t<T> &ft_tiles,
+                         Tiled_vector_t<T> &ft_vector,
+                         Tiled_vector_t<T> &ft_rhs,
                          int N_row,
                          int N_col,
                          std::size_t n_tiles,
-                         std::size_t m_tiles)
+                         std::size_t m_tiles,
+                         std::size_t n_row_total,
+                         std::size_t n_col_total)
 {
     for (std::size_t k = 0; k < m_tiles; k++)
     {
         for (std::size_t m = 0; m < n_tiles; m++)
         {
             ft_rhs[k] = hpx::dataflow(
-                hpx::annotated_function(gemv, "prediction_tiled"),
+                hpx::annotated_function(gemv<T>, "prediction_tiled"),
                 ft_tiles[k * n_tiles + m],
                 ft_vector[m],
                 ft_rhs[k],
-                N_row,
-                N_col,
+                get_tile_size(k, N_row, n_row_total),
+                get_tile_size(m, N_col, n_col_total),
                 Blas_add,
                 Blas_no_trans);
         }
     }
 }
 
-void symmetric_matrix_matrix_diagonal_tiled(
-    Tiled_matrix &ft_tiles, Tiled_vector &ft_vector, int N, int M, std::size_t n_tiles, std::size_t m_tiles)
+template <typename T, typename S>
+void transpose_matrix_vector_tiled(Tiled_matrix_t<S> &ft_tiles,
+                                   Tiled_vector_t<T> &ft_vector,
+                                   Tiled_vector_t<T> &ft_rhs,
+                                   int N,
+                                   int M,
+                                   std::size_t n_tiles,
+                                   std::size_t m_tiles,
+                                   std::size_t n_total,
+                                   std::size_t m_total)
+{
+    for (std::size_t c = 0; c < m_tiles; c++)
+    {
+        for (std::size_t k = 0; k < n_tiles; k++)
+        {
+            // GEMV: b = b + A^T * a
+            ft_rhs[c] = hpx::dataflow(hpx::annotated_function(gemv_stored<T, S>, "prediction_tiled"),
+                                      ft_tiles[k * m_tiles + c],
+                                      ft_vector[k],
+                                      ft_rhs[c],
+                                      get_tile_size(k, N, n_total),
+                                      get_tile_size(c, M, m_total),
+                                      Blas_add,
+                                      Blas_trans);
+        }
+    }
+}
+
+template <typename T, typename S>
+void symmetric_matrix_matrix_diagonal_tiled(Tiled_matrix_t<S> &ft_tiles,
+                                            Tiled_vector_t<T> &ft_vector,
+                                            int N,
+                                            int M,
+                                            std::size_t n_tiles,
+                                            std::size_t m_tiles,
+                                            std::size_t n_total,
+                                            std::size_t m_total)
 {
     for (std::size_t i = 0; i < m_tiles; ++i)
     {
@@ -218,34 +671,52 @@ void symmetric_matrix_matrix_diagonal_tiled(
         {  // Compute inner product to obtain diagonal elements of
            // V^T * V  <=> cross(K) * K^-1 * cross(K)^T
             ft_vector[i] = hpx::dataflow(
-                hpx::annotated_function(dot_diag_syrk, "posterior_tiled"),
+                hpx::annotated_function(dot_diag_syrk_stored<T, S>, "posterior_tiled"),
                 ft_tiles[n * m_tiles + i],
                 ft_vector[i],
-                N,
-                M);
+                get_tile_size(n, N, n_total),
+                get_tile_size(i, M, m_total));
         }
     }
 }
 
-void symmetric_matrix_matrix_tiled(
-    Tiled_matrix &ft_tiles, Tiled_matrix &ft_result, int N, int M, std::size_t n_tiles, std::size_t m_tiles)
+template <typename T, typename S>
+void symmetric_matrix_matrix_tiled(Tiled_matrix_t<S> &ft_tiles,
+                                   Tiled_matrix_t<T> &ft_result,
+                                   int N,
+                                   int M,
+                                   std::size_t n_tiles,
+                                   std::size_t m_tiles,
+                                   std::size_t n_total,
+                                   std::size_t m_total)
 {
     for (std::size_t c = 0; c < m_tiles; c++)
     {
-        for (std::size_t k = 0; k < m_tiles; k++)
+        const int M_c = get_tile_size(c, M, m_total);
+        for (std::size_t m = 0; m < n_tiles; m++)
+        {
+            // SYRK: C = C - A^T * A
+            ft_result[c * m_tiles + c] = hpx::dataflow(
+                hpx::annotated_function(syrk_stored<T, S>, "triangular_solve_tiled_matrix"),
+                ft_result[c * m_tiles + c],
+                ft_tiles[m * m_tiles + c],
+                M_c,
+                get_tile_size(m, N, n_total),
+                Blas_trans);
+        }
+        for (std::size_t k = 0; k < c; k++)
         {
             for (std::size_t m = 0; m < n_tiles; m++)
             {
-                // (SYRK for (c == k) possible)
                 // GEMM:  C = C - A^T * B
                 ft_result[c * m_tiles + k] = hpx::dataflow(
-                    hpx::annotated_function(&gemm, "triangular_solve_tiled_matrix"),
+                    hpx::annotated_function(gemm_stored<T, S, S, T>, "triangular_solve_tiled_matrix"),
                     ft_tiles[m * m_tiles + c],
                     ft_tiles[m * m_tiles + k],
                     ft_result[c * m_tiles + k],
-                    N,
-                    M,
-                    M,
+                    get_tile_size(m, N, n_total),
+                    get_tile_size(k, M, m_total),
+                    M_c,
                     Blas_trans,
                     Blas_no_trans);
             }
@@ -253,21 +724,147 @@ void symmetric_matrix_matrix_tiled(
     }
 }
 
-void vector_difference_tiled(Tiled_vector &ft_minuend, Tiled_vector &ft_subtrahend, int M, std::size_t m_tiles)
+void symmetric_matrix_matrix_transpose_tiled(Tiled_matrix &ft_tiles,
+                                             Tiled_matrix &ft_result,
+                                             int M,
+                                             int N,
+                                             std::size_t m_tiles,
+                                             std::size_t n_tiles,
+                                             std::size_t m_total,
+                                             std::size_t n_total)
+{
+    for (std::size_t c = 0; c < m_tiles; c++)
+    {
+        const int M_c = get_tile_size(c, M, m_total);
+        for (std::size_t m = 0; m < n_tiles; m++)
+        {
+            // SYRK: C = C - A * A^T
+            ft_result[c * m_tiles + c] = hpx::dataflow(hpx::annotated_function(syrk<double>, "outer_product_tiled"),
+                                                       ft_result[c * m_tiles + c],
+                                                       ft_tiles[c * n_tiles + m],
+                                                       M_c,
+                                                       get_tile_size(m, N, n_total),
+                                                       Blas_no_trans);
+        }
+        for (std::size_t k = 0; k < c; k++)
+        {
+            for (std::size_t m = 0; m < n_tiles; m++)
+            {
+                // GEMM: C = C - A * B^T
+                ft_result[c * m_tiles + k] =
+                    hpx::dataflow(hpx::annotated_function(gemm<double>, "outer_product_tiled"),
+                                  ft_tiles[c * n_tiles + m],
+                                  ft_tiles[k * n_tiles + m],
+                                  ft_result[c * m_tiles + k],
+                                  get_tile_size(m, N, n_total),
+                                  get_tile_size(k, M, m_total),
+                                  M_c,
+                                  Blas_no_trans,
+                                  Blas_trans);
+            }
+        }
+    }
+}
+
+template <typename T>
+void vector_difference_tiled(
+    Tiled_vector_t<T> &ft_minuend, Tiled_vector_t<T> &ft_subtrahend, int M, std::size_t m_tiles, std::size_t m_total)
+{
+    for (std::size_t i = 0; i < m_tiles; i++)
+    {
+        ft_subtrahend[i] = hpx::dataflow(hpx::annotated_function(axpy<T>, "uncertainty_tiled"),
+                                         ft_minuend[i],
+                                         ft_subtrahend[i],
+                                         get_tile_size(i, M, m_total));
+    }
+}
+
+template <typename T>
+void matrix_diagonal_tiled(
+    Tiled_matrix_t<T> &ft_tiles, Tiled_vector_t<T> &ft_vector, int M, std::size_t m_tiles, std::size_t m_total)
 {
     for (std::size_t i = 0; i < m_tiles; i++)
     {
-        ft_subtrahend[i] =
-            hpx::dataflow(hpx::annotated_function(&axpy, "uncertainty_tiled"), ft_minuend[i], ft_subtrahend[i], M);
+        ft_vector[i] = hpx::dataflow(hpx::annotated_function(get_matrix_diagonal<T>, "uncertainty_tiled"),
+                                     ft_tiles[i * m_tiles + i],
+                                     static_cast<std::size_t>(get_tile_size(i, M, m_total)));
     }
 }
 
-void matrix_diagonal_tiled(Tiled_matrix &ft_tiles, Tiled_vector &ft_vector, int M, std::size_t m_tiles)
+void triangular_matrix_matrix_tiled(Tiled_matrix &ft_tiles,
+                                    Tiled_matrix &ft_matrix,
+                                    Tiled_matrix &ft_result,
+                                    int M,
+                                    int n_columns,
+                                    std::size_t m_tiles,
+                                    std::size_t m_total)
 {
     for (std::size_t i = 0; i < m_tiles; i++)
     {
-        ft_vector[i] = hpx::dataflow(
-            hpx::annotated_function(get_matrix_diagonal, "uncertainty_tiled"), ft_tiles[i * m_tiles + i], M);
+        const int M_i = get_tile_size(i, M, m_total);
+        for (std::size_t j = 0; j < i; j++)
+        {
+            // GEMM: C = C - L * B
+            ft_result[i] = hpx::dataflow(hpx::annotated_function(gemm<double>, "triangular_product_tiled"),
+                                         ft_tiles[i * m_tiles + j],
+                                         ft_matrix[j],
+                                         ft_result[i],
+                                         get_tile_size(j, M, m_total),
+                                         n_columns,
+                                         M_i,
+                                         Blas_no_trans,
+                                         Blas_no_trans);
+        }
+        // TRMM: the upper triangle of the diagonal tile is not referenced
+        hpx::shared_future<std::vector<double>> product =
+            hpx::dataflow(hpx::annotated_function(trmm<double>, "triangular_product_tiled"),
+                          ft_tiles[i * m_tiles + i],
+                          ft_matrix[i],
+                          M_i,
+                          n_columns,
+                          Blas_no_trans,
+                          Blas_left);
+        // AXPY: C = C - L * B
+        ft_result[i] = hpx::dataflow(
+            hpx::annotated_function(axpy<double>, "triangular_product_tiled"), ft_result[i], product, M_i * n_columns);
+    }
+}
+
+void covariance_residual_tiled(const std::vector<double> &input,
+                               const gprat_hyper::SEKParams &sek_params,
+                               Tiled_vector &ft_x,
+                               Tiled_vector &ft_residual,
+                               int N,
+                               std::size_t n_tiles,
+                               std::size_t n_total,
+                               std::size_t n_regressors)
+{
+    const std::size_t tile_size = static_cast<std::size_t>(N);
+    for (std::size_t i = 0; i < n_tiles; i++)
+    {
+        for (std::size_t j = 0; j < n_tiles; j++)
+        {
+            // r_i = r_i - K_ij * x_j with K_ij generated in FP64
+            ft_residual[i] = hpx::dataflow(
+                hpx::annotated_function(
+                    [i, j, tile_size, n_total, n_regressors, N, &sek_params, &input](
+                        const hpx::shared_future<std::vector<double>> &f_x,
+                        const hpx::shared_future<std::vector<double>> &f_r)
+                    {
+                        return gemv<double>(
+                            hpx::make_ready_future(gen_tile_covariance<double>(
+                                i, j, tile_size, n_total, n_regressors, sek_params, input)),
+                            f_x,
+                            f_r,
+                            get_tile_size(i, N, n_total),
+                            get_tile_size(j, N, n_total),
+                            Blas_substract,
+                            Blas_no_trans);
+                    },
+                    "residual_tiled"),
+                ft_x[j],
+                ft_residual[i]);
+        }
     }
 }
 
@@ -276,7 +873,8 @@ void compute_loss_tiled(Tiled_matrix &ft_tiles,
                         Tiled_vector &ft_y,
                         hpx::shared_future<double> &loss,
                         int N,
-                        std::size_t n_tiles)
+                        std::size_t n_tiles,
+                        std::size_t n_total)
 {
     std::vector<hpx::shared_future<double>> loss_tiled;
     loss_tiled.reserve(n_tiles);
@@ -287,10 +885,10 @@ void compute_loss_tiled(Tiled_matrix &ft_tiles,
             ft_tiles[k * n_tiles + k],
             ft_alpha[k],
             ft_y[k],
-            N));
+            compute_tile_size(k, static_cast<std::size_t>(N), n_total)));
     }
 
-    loss = hpx::dataflow(hpx::annotated_function(hpx::unwrapping(&add_losses), "loss_tiled"), loss_tiled, N, n_tiles);
+    loss = hpx::dataflow(hpx::annotated_function(hpx::unwrapping(&add_losses), "loss_tiled"), loss_tiled, n_total);
 }
 
 void update_hyperparameter_tiled(
@@ -301,6 +899,7 @@ void update_hyperparameter_tiled(
     gprat_hyper::SEKParams &sek_params,
     int N,
     std::size_t n_tiles,
+    std::size_t n_total,
     std::size_t iter,
     std::size_t param_idx)
 {
@@ -333,8 +932,9 @@ void update_hyperparameter_tiled(
         // Asynchrnonous initialization
         for (std::size_t d = 0; d < n_tiles; d++)
         {
-            diag_tiles.push_back(hpx::async(hpx::annotated_function(gen_tile_zeros, "assemble"), N));
-            inter_alpha.push_back(hpx::async(hpx::annotated_function(gen_tile_zeros, "assemble"), N));
+            const std::size_t N_d = compute_tile_size(d, static_cast<std::size_t>(N), n_total);
+            diag_tiles.push_back(hpx::async(hpx::annotated_function(gen_tile_zeros<double>, "assemble"), N_d));
+            inter_alpha.push_back(hpx::async(hpx::annotated_function(gen_tile_zeros<double>, "assemble"), N_d));
         }
 
         ////////////////////////////////////
@@ -346,12 +946,12 @@ void update_hyperparameter_tiled(
             for (std::size_t j = 0; j < n_tiles; ++j)
             {
                 diag_tiles[i] = hpx::dataflow(
-                    hpx::annotated_function(dot_diag_gemm, "trace"),
+                    hpx::annotated_function(dot_diag_gemm<double>, "trace"),
                     ft_invK[i * n_tiles + j],
                     ft_gradK_param[j * n_tiles + i],
                     diag_tiles[i],
-                    N,
-                    N);
+                    get_tile_size(i, N, n_total),
+                    get_tile_size(j, N, n_total));
             }
         }
         // Compute the trace of the diagonal tiles
@@ -368,12 +968,12 @@ void update_hyperparameter_tiled(
             for (std::size_t m = 0; m < n_tiles; m++)
             {
                 inter_alpha[k] = hpx::dataflow(
-                    hpx::annotated_function(gemv, "gemv"),
+                    hpx::annotated_function(gemv<double>, "gemv"),
                     ft_gradK_param[k * n_tiles + m],
                     ft_alpha[m],
                     inter_alpha[k],
-                    N,
-                    N,
+                    get_tile_size(k, N, n_total),
+                    get_tile_size(m, N, n_total),
                     Blas_add,
                     Blas_no_trans);
             }
@@ -398,7 +998,7 @@ void update_hyperparameter_tiled(
             trace = hpx::dataflow(hpx::annotated_function(hpx::unwrapping(&compute_trace_diag), "grad_left_tiled"),
                                   ft_invK[j * n_tiles + j],
                                   trace,
-                                  N);
+                                  compute_tile_size(j, static_cast<std::size_t>(N), n_total));
         }
         ////////////////////////////////////
         // Step 2: Compute the alpha^T * alpha * noise_variance
@@ -422,7 +1022,7 @@ void update_hyperparameter_tiled(
     double gradient =
         factor
         * hpx::dataflow(
-              hpx::annotated_function(hpx::unwrapping(&compute_gradient), "update_hyperparam"), trace, dot, N, n_tiles)
+              hpx::annotated_function(hpx::unwrapping(&compute_gradient), "update_hyperparam"), trace, dot, n_total)
               .get();
 
     ////////////////////////////////////
@@ -447,4 +1047,584 @@ void update_hyperparameter_tiled(
     sek_params.set_param(param_idx, to_constrained(updated_param, jitter));
 }
 
+// Block Low-Rank Tiled Algorithms
+
+void right_looking_cholesky_tiled(Tiled_matrix &ft_tiles,
+                                  Tiled_low_rank_matrix &ft_low_rank_tiles,
+                                  int N,
+                                  std::size_t n_tiles,
+                                  std::size_t n_total,
+                                  double tolerance)
+{
+    for (std::size_t k = 0; k < n_tiles; k++)
+    {
+        // POTRF: Compute Cholesky factor L of the dense diagonal tile
+        ft_tiles[k * n_tiles + k] = hpx::dataflow(hpx::annotated_function(potrf<double>, "cholesky_tiled_blr"),
+                                                  ft_tiles[k * n_tiles + k],
+                                                  get_tile_size(k, N, n_total));
+        for (std::size_t m = k + 1; m < n_tiles; m++)
+        {
+            // TRSM: Solve X * L^T = U * V^T on the right factor V only
+            ft_low_rank_tiles[m * n_tiles + k] =
+                hpx::dataflow(hpx::annotated_function(trsm_low_rank, "cholesky_tiled_blr"),
+                              ft_tiles[k * n_tiles + k],
+                              ft_low_rank_tiles[m * n_tiles + k]);
+        }
+        for (std::size_t m = k + 1; m < n_tiles; m++)
+        {
+            // SYRK: A = A - B * B^T on the dense diagonal tile
+            ft_tiles[m * n_tiles + m] = hpx::dataflow(hpx::annotated_function(syrk_low_rank, "cholesky_tiled_blr"),
+                                                      ft_tiles[m * n_tiles + m],
+                                                      ft_low_rank_tiles[m * n_tiles + k]);
+            for (std::size_t n = k + 1; n < m; n++)
+            {
+                // GEMM: C = C - A * B^T with recompression
+                ft_low_rank_tiles[m * n_tiles + n] =
+                    hpx::dataflow(hpx::annotated_function(gemm_low_rank, "cholesky_tiled_blr"),
+                                  ft_low_rank_tiles[m * n_tiles + k],
+                                  ft_low_rank_tiles[n * n_tiles + k],
+                                  ft_low_rank_tiles[m * n_tiles + n],
+                                  tolerance);
+            }
+        }
+    }
+}
+
+void forward_solve_tiled(Tiled_matrix &ft_tiles,
+                         Tiled_low_rank_matrix &ft_low_rank_tiles,
+                         Tiled_vector &ft_rhs,
+                         int N,
+                         std::size_t n_tiles,
+                         std::size_t n_total)
+{
+    for (std::size_t k = 0; k < n_tiles; k++)
+    {
+        // TRSM: Solve L * x = a
+        ft_rhs[k] = hpx::dataflow(hpx::annotated_function(trsv<double>, "triangular_solve_tiled_blr"),
+                                  ft_tiles[k * n_tiles + k],
+                                  ft_rhs[k],
+                                  get_tile_size(k, N, n_total),
+                                  Blas_no_trans);
+        for (std::size_t m = k + 1; m < n_tiles; m++)
+        {
+            // GEMV: b = b - U * (V^T * a)
+            ft_rhs[m] = hpx::dataflow(hpx::annotated_function(gemv_low_rank, "triangular_solve_tiled_blr"),
+                                      ft_low_rank_tiles[m * n_tiles + k],
+                                      ft_rhs[k],
+                                      ft_rhs[m],
+                                      Blas_substract,
+                                      Blas_no_trans);
+        }
+    }
+}
+
+void backward_solve_tiled(Tiled_matrix &ft_tiles,
+                          Tiled_low_rank_matrix &ft_low_rank_tiles,
+                          Tiled_vector &ft_rhs,
+                          int N,
+                          std::size_t n_tiles,
+                          std::size_t n_total)
+{
+    for (int k_ = static_cast<int>(n_tiles) - 1; k_ >= 0; k_--)  // int instead of std::size_t for last comparison
+    {
+        std::size_t k = static_cast<std::size_t>(k_);
+        // TRSM: Solve L^T * x = a
+        ft_rhs[k] = hpx::dataflow(hpx::annotated_function(trsv<double>, "triangular_solve_tiled_blr"),
+                                  ft_tiles[k * n_tiles + k],
+                                  ft_rhs[k],
+                                  get_tile_size(k, N, n_total),
+                                  Blas_trans);
+        for (std::size_t m = 0; m < k; m++)
+        {
+            // GEMV: b = b - V * (U^T * a)
+            ft_rhs[m] = hpx::dataflow(hpx::annotated_function(gemv_low_rank, "triangular_solve_tiled_blr"),
+                                      ft_low_rank_tiles[k * n_tiles + m],
+                                      ft_rhs[k],
+                                      ft_rhs[m],
+                                      Blas_substract,
+                                      Blas_trans);
+        }
+    }
+}
+
+void forward_solve_tiled_matrix(Tiled_matrix &ft_tiles,
+                                Tiled_low_rank_matrix &ft_low_rank_tiles,
+                                Tiled_matrix &ft_rhs,
+                                int N,
+                                int M,
+                                std::size_t n_tiles,
+                                std::size_t m_tiles,
+                                std::size_t n_total,
+                                std::size_t m_total)
+{
+    for (std::size_t c = 0; c < m_tiles; c++)
+    {
+        const int M_c = get_tile_size(c, M, m_total);
+        for (std::size_t k = 0; k < n_tiles; k++)
+        {
+            // TRSM: solve L * X = A
+            ft_rhs[k * m_tiles + c] =
+                hpx::dataflow(hpx::annotated_function(trsm<double>, "triangular_solve_tiled_matrix_blr"),
+                              ft_tiles[k * n_tiles + k],
+                              ft_rhs[k * m_tiles + c],
+                              get_tile_size(k, N, n_total),
+                              M_c,
+                              Blas_no_trans,
+                              Blas_left);
+            for (std::size_t m = k + 1; m < n_tiles; m++)
+            {
+                // GEMM: C = C - U * (V^T * B)
+                ft_rhs[m * m_tiles + c] =
+                    hpx::dataflow(hpx::annotated_function(gemm_low_rank_dense, "triangular_solve_tiled_matrix_blr"),
+                                  ft_low_rank_tiles[m * n_tiles + k],
+                                  ft_rhs[k * m_tiles + c],
+                                  ft_rhs[m * m_tiles + c],
+                                  M_c);
+            }
+        }
+    }
+}
+
+void matrix_vector_tiled(Tiled_low_rank_matrix &ft_tiles,
+                         Tiled_vector &ft_vector,
+                         Tiled_vector &ft_rhs,
+                         std::size_t n_tiles,
+                         std::size_t m_tiles)
+{
+    for (std::size_t k = 0; k < m_tiles; k++)
+    {
+        for (std::size_t m = 0; m < n_tiles; m++)
+        {
+            // GEMV: b = b + U * (V^T * a)
+            ft_rhs[k] = hpx::dataflow(hpx::annotated_function(gemv_low_rank, "prediction_tiled_blr"),
+                                      ft_tiles[k * n_tiles + m],
+                                      ft_vector[m],
+                                      ft_rhs[k],
+                                      Blas_add,
+                                      Blas_no_trans);
+        }
+    }
+}
+
+// Sparse Tiled Algorithms
+
+void right_looking_cholesky_tiled(
+    Tiled_matrix &ft_tiles, const std::vector<bool> &pattern, int N, std::size_t n_tiles, std::size_t n_total)
+{
+    for (std::size_t k = 0; k < n_tiles; k++)
+    {
+        const int N_k = get_tile_size(k, N, n_total);
+        // POTRF: Compute Cholesky factor L
+        ft_tiles[k * n_tiles + k] = hpx::dataflow(
+            hpx::annotated_function(potrf<double>, "cholesky_tiled_sparse"), ft_tiles[k * n_tiles + k], N_k);
+        for (std::size_t m = k + 1; m < n_tiles; m++)
+        {
+            if (!pattern[m * n_tiles + k])
+            {
+                continue;
+            }
+            // TRSM:  Solve X * L^T = A
+            ft_tiles[m * n_tiles + k] = hpx::dataflow(hpx::annotated_function(trsm<double>, "cholesky_tiled_sparse"),
+                                                      ft_tiles[k * n_tiles + k],
+                                                      ft_tiles[m * n_tiles + k],
+                                                      get_tile_size(m, N, n_total),
+                                                      N_k,
+                                                      Blas_trans,
+                                                      Blas_right);
+        }
+        for (std::size_t m = k + 1; m < n_tiles; m++)
+        {
+            if (!pattern[m * n_tiles + k])
+            {
+                continue;
+            }
+            const int N_m = get_tile_size(m, N, n_total);
+            // SYRK:  A = A - B * B^T
+            ft_tiles[m * n_tiles + m] = hpx::dataflow(hpx::annotated_function(syrk<double>, "cholesky_tiled_sparse"),
+                                                      ft_tiles[m * n_tiles + m],
+                                                      ft_tiles[m * n_tiles + k],
+                                                      N_m,
+                                                      N_k,
+                                                      Blas_no_trans);
+            for (std::size_t n = k + 1; n < m; n++)
+            {
+                if (!pattern[n * n_tiles + k])
+                {
+                    continue;
+                }
+                // GEMM: C = C - A * B^T, where C is part of the pattern by the fill-in
+                ft_tiles[m * n_tiles + n] =
+                    hpx::dataflow(hpx::annotated_function(gemm<double>, "cholesky_tiled_sparse"),
+                                  ft_tiles[m * n_tiles + k],
+                                  ft_tiles[n * n_tiles + k],
+                                  ft_tiles[m * n_tiles + n],
+                                  N_k,
+                                  get_tile_size(n, N, n_total),
+                                  N_m,
+                                  Blas_no_trans,
+                                  Blas_trans);
+            }
+        }
+    }
+}
+
+void forward_solve_tiled(Tiled_matrix &ft_tiles,
+                         const std::vector<bool> &pattern,
+                         Tiled_vector &ft_rhs,
+                         int N,
+                         std::size_t n_tiles,
+                         std::size_t n_total)
+{
+    for (std::size_t k = 0; k < n_tiles; k++)
+    {
+        const int N_k = get_tile_size(k, N, n_total);
+        // TRSM: Solve L * x = a
+        ft_rhs[k] = hpx::dataflow(hpx::annotated_function(trsv<double>, "triangular_solve_tiled_sparse"),
+                                  ft_tiles[k * n_tiles + k],
+                                  ft_rhs[k],
+                                  N_k,
+                                  Blas_no_trans);
+        for (std::size_t m = k + 1; m < n_tiles; m++)
+        {
+            if (!pattern[m * n_tiles + k])
+            {
+                continue;
+            }
+            // GEMV: b = b - A * a
+            ft_rhs[m] = hpx::dataflow(hpx::annotated_function(gemv<double>, "triangular_solve_tiled_sparse"),
+                                      ft_tiles[m * n_tiles + k],
+                                      ft_rhs[k],
+                                      ft_rhs[m],
+                                      get_tile_size(m, N, n_total),
+                                      N_k,
+                                      Blas_substract,
+                                      Blas_no_trans);
+        }
+    }
+}
+
+void backward_solve_tiled(Tiled_matrix &ft_tiles,
+                          const std::vector<bool> &pattern,
+                          Tiled_vector &ft_rhs,
+                          int N,
+                          std::size_t n_tiles,
+                          std::size_t n_total)
+{
+    for (int k_ = static_cast<int>(n_tiles) - 1; k_ >= 0; k_--)  // int instead of std::size_t for last comparison
+    {
+        std::size_t k = static_cast<std::size_t>(k_);
+        const int N_k = get_tile_size(k, N, n_total);
+        // TRSM: Solve L^T * x = a
+        ft_rhs[k] = hpx::dataflow(hpx::annotated_function(trsv<double>, "triangular_solve_tiled_sparse"),
+                                  ft_tiles[k * n_tiles + k],
+                                  ft_rhs[k],
+                                  N_k,
+                                  Blas_trans);
+        for (std::size_t m = 0; m < k; m++)
+        {
+            if (!pattern[k * n_tiles + m])
+            {
+                continue;
+            }
+            // GEMV: b = b - A^T * a
+            ft_rhs[m] = hpx::dataflow(hpx::annotated_function(gemv<double>, "triangular_solve_tiled_sparse"),
+                                      ft_tiles[k * n_tiles + m],
+                                      ft_rhs[k],
+                                      ft_rhs[m],
+                                      N_k,
+                                      get_tile_size(m, N, n_total),
+                                      Blas_substract,
+                                      Blas_trans);
+        }
+    }
+}
+
+void forward_solve_tiled_matrix(Tiled_matrix &ft_tiles,
+                                const std::vector<bool> &pattern,
+                                Tiled_matrix &ft_rhs,
+                                std::vector<bool> &rhs_pattern,
+                                int N,
+                                int M,
+                                std::size_t n_tiles,
+                                std::size_t m_tiles,
+                                std::size_t n_total,
+                                std::size_t m_total)
+{
+    for (std::size_t c = 0; c < m_tiles; c++)
+    {
+        const int M_c = get_tile_size(c, M, m_total);
+        for (std::size_t k = 0; k < n_tiles; k++)
+        {
+            if (!rhs_pattern[k * m_tiles + c])
+            {
+                // The solution of a zero tile remains zero
+                continue;
+            }
+            const int N_k = get_tile_size(k, N, n_total);
+            // TRSM: solve L * X = A
+            ft_rhs[k * m_tiles + c] =
+                hpx::dataflow(hpx::annotated_function(trsm<double>, "triangular_solve_tiled_matrix_sparse"),
+                              ft_tiles[k * n_tiles + k],
+                              ft_rhs[k * m_tiles + c],
+                              N_k,
+                              M_c,
+                              Blas_no_trans,
+                              Blas_left);
+            for (std::size_t m = k + 1; m < n_tiles; m++)
+            {
+                if (!pattern[m * n_tiles + k])
+                {
+                    continue;
+                }
+                // GEMM: C = C - A * B
+                ft_rhs[m * m_tiles + c] =
+                    hpx::dataflow(hpx::annotated_function(gemm<double>, "triangular_solve_tiled_matrix_sparse"),
+                                  ft_tiles[m * n_tiles + k],
+                                  ft_rhs[k * m_tiles + c],
+                                  ft_rhs[m * m_tiles + c],
+                                  N_k,
+                                  M_c,
+                                  get_tile_size(m, N, n_total),
+                                  Blas_no_trans,
+                                  Blas_no_trans);
+                rhs_pattern[m * m_tiles + c] = true;
+            }
+        }
+    }
+}
+
+void matrix_vector_tiled(Tiled_matrix &ft_tiles,
+                         const std::vector<bool> &pattern,
+                         Tiled_vector &ft_vector,
+                         Tiled_vector &ft_rhs,
+                         int N_row,
+                         int N_col,
+                         std::size_t n_tiles,
+                         std::size_t m_tiles,
+                         std::size_t n_row_total,
+                         std::size_t n_col_total)
+{
+    for (std::size_t k = 0; k < m_tiles; k++)
+    {
+        for (std::size_t m = 0; m < n_tiles; m++)
+        {
+            if (!pattern[k * n_tiles + m])
+            {
+                continue;
+            }
+            ft_rhs[k] = hpx::dataflow(hpx::annotated_function(gemv<double>, "prediction_tiled_sparse"),
+                                      ft_tiles[k * n_tiles + m],
+                                      ft_vector[m],
+                                      ft_rhs[k],
+                                      get_tile_size(k, N_row, n_row_total),
+                                      get_tile_size(m, N_col, n_col_total),
+                                      Blas_add,
+                                      Blas_no_trans);
+        }
+    }
+}
+
+void selected_inverse_tiled(Tiled_matrix &ft_tiles,
+                            const std::vector<bool> &pattern,
+                            Tiled_matrix &ft_inverse,
+                            int N,
+                            std::size_t n_tiles,
+                            std::size_t n_total)
+{
+    for (int j_ = static_cast<int>(n_tiles) - 1; j_ >= 0; j_--)  // int instead of std::size_t for last comparison
+    {
+        std::size_t j = static_cast<std::size_t>(j_);
+        const int N_j = get_tile_size(j, N, n_total);
+        for (std::size_t i = j + 1; i < n_tiles; i++)
+        {
+            if (!pattern[i * n_tiles + j])
+            {
+                continue;
+            }
+            const int N_i = get_tile_size(i, N, n_total);
+            ft_inverse[i * n_tiles + j] = hpx::async(hpx::annotated_function(gen_tile_zeros<double>, "assemble"),
+                                                     static_cast<std::size_t>(N_i * N_j));
+            for (std::size_t k = j + 1; k < n_tiles; k++)
+            {
+                if (!pattern[k * n_tiles + j])
+                {
+                    continue;
+                }
+                // GEMM: Z_ij = Z_ij - Z_ik * L_kj with Z_ik = Z_ki^T above the diagonal
+                const bool lower = k <= i;
+                ft_inverse[i * n_tiles + j] =
+                    hpx::dataflow(hpx::annotated_function(gemm<double>, "selected_inverse_tiled"),
+                                  lower ? ft_inverse[i * n_tiles + k] : ft_inverse[k * n_tiles + i],
+                                  ft_tiles[k * n_tiles + j],
+                                  ft_inverse[i * n_tiles + j],
+                                  get_tile_size(k, N, n_total),
+                                  N_j,
+                                  N_i,
+                                  lower ? Blas_no_trans : Blas_trans,
+                                  Blas_no_trans);
+            }
+            // TRSM: Solve Z_ij * L_jj = C
+            ft_inverse[i * n_tiles + j] = hpx::dataflow(hpx::annotated_function(trsm<double>, "selected_inverse_tiled"),
+                                                        ft_tiles[j * n_tiles + j],
+                                                        ft_inverse[i * n_tiles + j],
+                                                        N_i,
+                                                        N_j,
+                                                        Blas_no_trans,
+                                                        Blas_right);
+        }
+        // TRSM: Solve L_jj^T * C = I
+        ft_inverse[j * n_tiles + j] = hpx::dataflow(
+            hpx::annotated_function(trsm<double>, "selected_inverse_tiled"),
+            ft_tiles[j * n_tiles + j],
+            hpx::async(hpx::annotated_function(gen_tile_identity<double>, "assemble"), static_cast<std::size_t>(N_j)),
+            N_j,
+            N_j,
+            Blas_trans,
+            Blas_left);
+        for (std::size_t k = j + 1; k < n_tiles; k++)
+        {
+            if (!pattern[k * n_tiles + j])
+            {
+                continue;
+            }
+            // GEMM: Z_jj = Z_jj - Z_kj^T * L_kj
+            ft_inverse[j * n_tiles + j] = hpx::dataflow(hpx::annotated_function(gemm<double>, "selected_inverse_tiled"),
+                                                        ft_inverse[k * n_tiles + j],
+                                                        ft_tiles[k * n_tiles + j],
+                                                        ft_inverse[j * n_tiles + j],
+                                                        get_tile_size(k, N, n_total),
+                                                        N_j,
+                                                        N_j,
+                                                        Blas_trans,
+                                                        Blas_no_trans);
+        }
+        // TRSM: Solve Z_jj * L_jj = C
+        ft_inverse[j * n_tiles + j] = hpx::dataflow(hpx::annotated_function(trsm<double>, "selected_inverse_tiled"),
+                                                    ft_tiles[j * n_tiles + j],
+                                                    ft_inverse[j * n_tiles + j],
+                                                    N_j,
+                                                    N_j,
+                                                    Blas_no_trans,
+                                                    Blas_right);
+    }
+}
+
+// Explicit instantiations for the supported precisions
+
+template void right_looking_cholesky_tiled<float>(Tiled_matrix_t<float> &, int, std::size_t, std::size_t);
+template void forward_solve_tiled<float>(
+    Tiled_matrix_t<float> &, Tiled_vector_t<float> &, int, std::size_t, std::size_t);
+template void backward_solve_tiled<float>(
+    Tiled_matrix_t<float> &, Tiled_vector_t<float> &, int, std::size_t, std::size_t);
+template void forward_solve_tiled_matrix<float>(
+    Tiled_matrix_t<float> &, Tiled_matrix_t<float> &, int, int, std::size_t, std::size_t, std::size_t, std::size_t);
+template void backward_solve_tiled_matrix<float>(
+    Tiled_matrix_t<float> &, Tiled_matrix_t<float> &, int, int, std::size_t, std::size_t, std::size_t, std::size_t);
+template void matrix_vector_tiled<float>(
+    Tiled_matrix_t<float> &,
+    Tiled_vector_t<float> &,
+    Tiled_vector_t<float> &,
+    int,
+    int,
+    std::size_t,
+    std::size_t,
+    std::size_t,
+    std::size_t);
+template void forward_solve_tiled_multi_rhs<float>(
+    Tiled_matrix_t<float> &,
+    Tiled_vector_t<float> &,
+    Tiled_matrix_t<float> &,
+    int,
+    std::size_t,
+    std::size_t,
+    std::size_t);
+template void transpose_matrix_vector_tiled<float>(
+    Tiled_matrix_t<float> &,
+    Tiled_vector_t<float> &,
+    Tiled_vector_t<float> &,
+    int,
+    int,
+    std::size_t,
+    std::size_t,
+    std::size_t,
+    std::size_t);
+template void symmetric_matrix_matrix_diagonal_tiled<float>(
+    Tiled_matrix_t<float> &, Tiled_vector_t<float> &, int, int, std::size_t, std::size_t, std::size_t, std::size_t);
+template void symmetric_matrix_matrix_tiled<float>(
+    Tiled_matrix_t<float> &, Tiled_matrix_t<float> &, int, int, std::size_t, std::size_t, std::size_t, std::size_t);
+template void vector_difference_tiled<float>(
+    Tiled_vector_t<float> &, Tiled_vector_t<float> &, int, std::size_t, std::size_t);
+template void matrix_diagonal_tiled<float>(
+    Tiled_matrix_t<float> &, Tiled_vector_t<float> &, int, std::size_t, std::size_t);
+
+template void right_looking_cholesky_tiled<double>(Tiled_matrix_t<double> &, int, std::size_t, std::size_t);
+template void forward_solve_tiled<double>(
+    Tiled_matrix_t<double> &, Tiled_vector_t<double> &, int, std::size_t, std::size_t);
+template void backward_solve_tiled<double>(
+    Tiled_matrix_t<double> &, Tiled_vector_t<double> &, int, std::size_t, std::size_t);
+template void forward_solve_tiled_matrix<double>(
+    Tiled_matrix_t<double> &, Tiled_matrix_t<double> &, int, int, std::size_t, std::size_t, std::size_t, std::size_t);
+template void backward_solve_tiled_matrix<double>(
+    Tiled_matrix_t<double> &, Tiled_matrix_t<double> &, int, int, std::size_t, std::size_t, std::size_t, std::size_t);
+template void matrix_vector_tiled<double>(
+    Tiled_matrix_t<double> &,
+    Tiled_vector_t<double> &,
+    Tiled_vector_t<double> &,
+    int,
+    int,
+    std::size_t,
+    std::size_t,
+    std::size_t,
+    std::size_t);
+template void forward_solve_tiled_multi_rhs<double>(
+    Tiled_matrix_t<double> &,
+    Tiled_vector_t<double> &,
+    Tiled_matrix_t<double> &,
+    int,
+    std::size_t,
+    std::size_t,
+    std::size_t);
+template void transpose_matrix_vector_tiled<double>(
+    Tiled_matrix_t<double> &,
+    Tiled_vector_t<double> &,
+    Tiled_vector_t<double> &,
+    int,
+    int,
+    std::size_t,
+    std::size_t,
+    std::size_t,
+    std::size_t);
+template void symmetric_matrix_matrix_diagonal_tiled<double>(
+    Tiled_matrix_t<double> &, Tiled_vector_t<double> &, int, int, std::size_t, std::size_t, std::size_t, std::size_t);
+template void symmetric_matrix_matrix_tiled<double>(
+    Tiled_matrix_t<double> &, Tiled_matrix_t<double> &, int, int, std::size_t, std::size_t, std::size_t, std::size_t);
+template void vector_difference_tiled<double>(
+    Tiled_vector_t<double> &, Tiled_vector_t<double> &, int, std::size_t, std::size_t);
+template void matrix_diagonal_tiled<double>(
+    Tiled_matrix_t<double> &, Tiled_vector_t<double> &, int, std::size_t, std::size_t);
+
+// FP64 computations on tiles stored in FP32
+template void forward_solve_tiled_multi_rhs<double, float>(
+    Tiled_matrix_t<double> &,
+    Tiled_vector_t<double> &,
+    Tiled_matrix_t<float> &,
+    int,
+    std::size_t,
+    std::size_t,
+    std::size_t);
+template void transpose_matrix_vector_tiled<double, float>(
+    Tiled_matrix_t<float> &,
+    Tiled_vector_t<double> &,
+    Tiled_vector_t<double> &,
+    int,
+    int,
+    std::size_t,
+    std::size_t,
+    std::size_t,
+    std::size_t);
+template void symmetric_matrix_matrix_diagonal_tiled<double, float>(
+    Tiled_matrix_t<float> &, Tiled_vector_t<double> &, int, int, std::size_t, std::size_t, std::size_t, std::size_t);
+template void symmetric_matrix_matrix_tiled<double, float>(
+    Tiled_matrix_t<float> &, Tiled_matrix_t<double> &, int, int, std::size_t, std::size_t, std::size_t, std::size_t);
+
 }  // end of namespace cpu
@@ -1,6 +1,8 @@
 #include "gprat_c.hpp"
 
+#include "cpu/gp_algorithms.hpp"
 #include "cpu/gp_functions.hpp"
+#include "cpu/gp_functions_contiguous.hpp"
 #include "utils_c.hpp"
 #include <cstdio>
 
@@ -12,6 +14,113 @@
 namespace gprat
 {
 
+namespace
+{
+
+/**
+ * @brief Return the number of samples covered by the tiles, the last tile may be smaller.
+ */
+int count_samples(const std::vector<double> &data, int n_tiles, int n_tile_size, int n_regressors)
+{
+    return static_cast<int>(cpu::compute_n_samples(static_cast<std::size_t>(n_tiles),
+                                                   static_cast<std::size_t>(n_tile_size),
+                                                   data.size(),
+                                                   static_cast<std::size_t>(n_regressors)));
+}
+
+/**
+ * @brief Throw if a test point does not consist of the lagged features of one sample.
+ */
+void check_point_features(const std::vector<double> &features, int n_regressors)
+{
+    if (features.size() != static_cast<std::size_t>(n_regressors))
+    {
+        throw std::invalid_argument("Error: A test point requires " + std::to_string(n_regressors)
+                                    + " lagged features, got " + std::to_string(features.size()) + ".");
+    }
+}
+
+/**
+ * @brief Throw if the forecast horizon is negative.
+ */
+void check_horizon(int horizon)
+{
+    if (horizon < 0)
+    {
+        throw std::invalid_argument("Error: The forecast horizon must not be negative, got " + std::to_string(horizon)
+                                    + ".");
+    }
+}
+
+#if GPRAT_WITH_CUDA
+/**
+ * @brief Throw if the last tile is smaller, which the GPU implementation does not support.
+ */
+void check_full_tiles(int n_samples, int n_tiles, int n_tile_size)
+{
+    if (n_samples != n_tiles * n_tile_size)
+    {
+        throw std::invalid_argument("Error: The GPU implementation requires " + std::to_string(n_tiles)
+                                    + " full tiles of size " + std::to_string(n_tile_size) + " but got "
+                                    + std::to_string(n_samples) + " samples.");
+    }
+}
+#endif
+
+/**
+ * @brief Returns the name of a precision as used in the Python bindings.
+ */
+std::string precision_name(Precision precision)
+{
+    switch (precision)
+    {
+        case Precision::FP64: return "FP64";
+        case Precision::FP32: return "FP32";
+        case Precision::Mixed: return "Mixed";
+    }
+    throw std::invalid_argument("Error: Unknown precision.");
+}
+
+/**
+ * @brief Convert a single precision result to double precision.
+ */
+std::vector<double> to_fp64(const std::vector<float> &result)
+{
+    return std::vector<double>(result.begin(), result.end());
+}
+
+/**
+ * @brief Convert single precision results to double precision.
+ */
+std::vector<std::vector<double>> to_fp64(const std::vector<std::vector<float>> &results)
+{
+    std::vector<std::vector<double>> converted;
+    converted.reserve(results.size());
+    for (const auto &result : results)
+    {
+        converted.push_back(to_fp64(result));
+    }
+    return converted;
+}
+
+/**
+ * @brief Return the size of a feature tile of the random feature approximation.
+ *
+ * The number of features is checked before the tiles, such that the error names
+ * the actual problem. compute_train_tile_size rejects feature tile counts that
+ * leave the last tile empty.
+ */
+int compute_feature_tile_size(int n_features, int n_feature_tiles)
+{
+    if (n_features <= 0)
+    {
+        throw std::invalid_argument("Error: Please specify a positive number of random features.");
+    }
+    return utils::compute_train_tile_size(n_features, n_feature_tiles);
+}
+
+}  // namespace
+
 GP_data::GP_data(const std::string &f_path, int n, int n_reg) :
     file_path(f_path),
     n_samples(n),
@@ -32,10 +141,28 @@ GP::GP(std::vector<double> input,
     training_output_(output),
     n_tiles_(n_tiles),
     n_tile_size_(n_tile_size),
+    params_generation_(0),
+    inducing_tiles_(0),
+    inducing_tile_size_(0),
     trainable_params_(trainable_bool),
     target_(target),
     n_reg(n_regressors),
-    kernel_params(kernel_hyperparams[0], kernel_hyperparams[1], kernel_hyperparams[2])
+    kernel_params(kernel_hyperparams[0], kernel_hyperparams[1], kernel_hyperparams[2]),
+    small_problem_threshold(DEFAULT_SMALL_PROBLEM_THRESHOLD),
+    precision(Precision::FP64),
+    cross_covariance_storage(StoragePrecision::FP64),
+    sparse_approximation(cpu::SparseApproximation::VFE),
+    vecchia_neighbours(DEFAULT_VECCHIA_NEIGHBOURS),
+    expert_aggregation(cpu::ExpertAggregation::rBCM),
+    blr_tolerance(DEFAULT_BLR_TOLERANCE),
+    hodlr_tolerance(DEFAULT_HODLR_TOLERANCE),
+    cg_tolerance(DEFAULT_CG_TOLERANCE),
+    cg_max_iterations(DEFAULT_CG_MAX_ITERATIONS),
+    cg_preconditioner_rank(DEFAULT_CG_PRECONDITIONER_RANK),
+    slq_probes(DEFAULT_SLQ_PROBES),
+    slq_lanczos_steps(DEFAULT_SLQ_LANCZOS_STEPS),
+    slq_seed(0),
+    compact_reorder(true)
 { }
 
 GP::GP(std::vector<double> input,
@@ -49,10 +176,61 @@ GP::GP(std::vector<double> input,
     training_output_(output),
     n_tiles_(n_tiles),
     n_tile_size_(n_tile_size),
+    params_generation_(0),
+    inducing_tiles_(0),
+    inducing_tile_size_(0),
     trainable_params_(trainable_bool),
     target_(std::make_shared<CPU>()),
     n_reg(n_regressors),
-    kernel_params(kernel_hyperparams[0], kernel_hyperparams[1], kernel_hyperparams[2])
+    kernel_params(kernel_hyperparams[0], kernel_hyperparams[1], kernel_hyperparams[2]),
+    small_problem_threshold(DEFAULT_SMALL_PROBLEM_THRESHOLD),
+    precision(Precision::FP64),
+    cross_covariance_storage(StoragePrecision::FP64),
+    sparse_approximation(cpu::SparseApproximation::VFE),
+    vecchia_neighbours(DEFAULT_VECCHIA_NEIGHBOURS),
+    expert_aggregation(cpu::ExpertAggregation::rBCM),
+    blr_tolerance(DEFAULT_BLR_TOLERANCE),
+    hodlr_tolerance(DEFAULT_HODLR_TOLERANCE),
+    cg_tolerance(DEFAULT_CG_TOLERANCE),
+    cg_max_iterations(DEFAULT_CG_MAX_ITERATIONS),
+    cg_preconditioner_rank(DEFAULT_CG_PRECONDITIONER_RANK),
+    slq_probes(DEFAULT_SLQ_PROBES),
+    slq_lanczos_steps(DEFAULT_SLQ_LANCZOS_STEPS),
+    slq_seed(0),
+    compact_reorder(true)
+{ }
+
+GP::GP(std::vector<double> input,
+       std::vector<double> output,
+       int n_regressors,
+       std::vector<double> kernel_hyperparams,
+       std::vector<bool> trainable_bool) :
+    training_input_(input),
+    training_output_(output),
+    n_tiles_(0),
+    n_tile_size_(0),
+    params_generation_(0),
+    inducing_tiles_(0),
+    inducing_tile_size_(0),
+    trainable_params_(trainable_bool),
+    target_(std::make_shared<CPU>()),
+    n_reg(n_regressors),
+    kernel_params(kernel_hyperparams[0], kernel_hyperparams[1], kernel_hyperparams[2]),
+    small_problem_threshold(DEFAULT_SMALL_PROBLEM_THRESHOLD),
+    precision(Precision::FP64),
+    cross_covariance_storage(StoragePrecision::FP64),
+    sparse_approximation(cpu::SparseApproximation::VFE),
+    vecchia_neighbours(DEFAULT_VECCHIA_NEIGHBOURS),
+    expert_aggregation(cpu::ExpertAggregation::rBCM),
+    blr_tolerance(DEFAULT_BLR_TOLERANCE),
+    hodlr_tolerance(DEFAULT_HODLR_TOLERANCE),
+    cg_tolerance(DEFAULT_CG_TOLERANCE),
+    cg_max_iterations(DEFAULT_CG_MAX_ITERATIONS),
+    cg_preconditioner_rank(DEFAULT_CG_PRECONDITIONER_RANK),
+    slq_probes(DEFAULT_SLQ_PROBES),
+    slq_lanczos_steps(DEFAULT_SLQ_LANCZOS_STEPS),
+    slq_seed(0),
+    compact_reorder(true)
 { }
 
 GP::GP(std::vector<double> input,
@@ -68,6 +246,9 @@ GP::GP(std::vector<double> input,
     training_output_(output),
     n_tiles_(n_tiles),
     n_tile_size_(n_tile_size),
+    params_generation_(0),
+    inducing_tiles_(0),
+    inducing_tile_size_(0),
     trainable_params_(trainable_bool),
 #if GPRAT_WITH_CUDA
     target_(std::make_shared<CUDA_GPU>(CUDA_GPU(gpu_id, n_streams))),
@@ -75,7 +256,22 @@ GP::GP(std::vector<double> input,
     target_(std::make_shared<CPU>()),
 #endif
     n_reg(n_regressors),
-    kernel_params(kernel_hyperparams[0], kernel_hyperparams[1], kernel_hyperparams[2])
+    kernel_params(kernel_hyperparams[0], kernel_hyperparams[1], kernel_hyperparams[2]),
+    small_problem_threshold(DEFAULT_SMALL_PROBLEM_THRESHOLD),
+    precision(Precision::FP64),
+    cross_covariance_storage(StoragePrecision::FP64),
+    sparse_approximation(cpu::SparseApproximation::VFE),
+    vecchia_neighbours(DEFAULT_VECCHIA_NEIGHBOURS),
+    expert_aggregation(cpu::ExpertAggregation::rBCM),
+    blr_tolerance(DEFAULT_BLR_TOLERANCE),
+    hodlr_tolerance(DEFAULT_HODLR_TOLERANCE),
+    cg_tolerance(DEFAULT_CG_TOLERANCE),
+    cg_max_iterations(DEFAULT_CG_MAX_ITERATIONS),
+    cg_preconditioner_rank(DEFAULT_CG_PRECONDITIONER_RANK),
+    slq_probes(DEFAULT_SLQ_PROBES),
+    slq_lanczos_steps(DEFAULT_SLQ_LANCZOS_STEPS),
+    slq_seed(0),
+    compact_reorder(true)
 {
 #if !GPRAT_WITH_CUDA
     throw std::runtime_error(
@@ -87,6 +283,33 @@ GP::GP(std::vector<double> input,
 #endif
 }
 
+bool GP::use_contiguous_path(int n_train) const { return n_train <= small_problem_threshold; }
+
+std::pair<int, int> GP::train_tiles(TiledOperation operation)
+{
+    if (n_tiles_ > 0)
+    {
+        return { n_tiles_, n_tile_size_ };
+    }
+    const int n_samples = static_cast<int>(training_input_.size()) - n_reg + 1;
+    if (use_contiguous_path(n_samples))
+    {
+        // No tiling required
+        return { 1, n_samples };
+    }
+    auto tuned = tuned_tiles_.find(operation);
+    if (tuned == tuned_tiles_.end())
+    {
+        tuned = tuned_tiles_.emplace(operation, utils::compute_tuned_train_tiles(n_samples, n_reg, operation)).first;
+    }
+    return tuned->second;
+}
+
+std::pair<int, int> GP::get_train_tiles(TiledOperation operation)
+{
+    return hpx::async([this, operation]() { return train_tiles(operation); }).get();
+}
+
 std::string GP::repr() const
 {
     std::ostringstream oss;
@@ -95,7 +318,11 @@ std::string GP::repr() const
         << kernel_params.vertical_lengthscale << ", noise_variance=" << kernel_params.noise_variance
         << ", n_regressors=" << n_reg << "], Trainable_Params: [trainable_params l=" << trainable_params_[0]
         << ", trainable_params v=" << trainable_params_[1] << ", trainable_params n=" << trainable_params_[2]
-        << "], Target: [" << target_->repr() << "], n_tiles=" << n_tiles_ << ", n_tile_size=" << n_tile_size_;
+        << "], Target: [" << target_->repr() << "], n_tiles=" << (n_tiles_ > 0 ? std::to_string(n_tiles_) : "auto")
+        << ", n_tile_size=" << (n_tile_size_ > 0 ? std::to_string(n_tile_size_) : "auto")
+        << ", small_problem_threshold=" << small_problem_threshold
+        << ", precision=" << precision_name(precision) << ", cross_covariance_storage="
+        << (cross_covariance_storage == StoragePrecision::FP32 ? "FP32" : "FP64");
     return oss.str();
 }
 
@@ -103,51 +330,256 @@ std::vector<double> GP::get_training_input() const { return training_input_; }
 
 std::vector<double> GP::get_training_output() const { return training_output_; }
 
+cpu::RefinementReport GP::get_refinement_report() const { return refinement_report_; }
+
+const cpu::PointPredictionFactor &GP::point_prediction_factor()
+{
+    if (!cpu::is_point_prediction_factor_current(point_factor_, params_generation_, n_reg))
+    {
+        // Tuning the tiles may launch tasks, the predictions afterwards run inline
+        point_factor_ = hpx::async(
+                            [this]()
+                            {
+                                const auto [n_tiles, n_tile_size] = train_tiles(TiledOperation::Predict);
+                                const int n_train = count_samples(training_input_, n_tiles, n_tile_size, n_reg);
+                                return cpu::compute_point_prediction_factor(
+                                    training_input_, training_output_, kernel_params, n_train, n_reg);
+                            })
+                            .get();
+        point_factor_.params_generation = params_generation_;
+        point_workspace_.resize(point_factor_.n_train);
+    }
+    return point_factor_;
+}
+
+void GP::invalidate_point_prediction_factor() { ++params_generation_; }
+
+std::vector<double>
+GP::predict_cpu(const std::vector<double> &test_input, int n_tiles, int n_tile_size, int m_tiles, int m_tile_size)
+{
+    const int n_train = count_samples(training_input_, n_tiles, n_tile_size, n_reg);
+    const int n_test = count_samples(test_input, m_tiles, m_tile_size, n_reg);
+    if (use_contiguous_path(n_train))
+    {
+        return cpu::predict_contiguous(
+            training_input_, training_output_, test_input, kernel_params, n_train, n_test, n_reg);
+    }
+    if (precision == Precision::Mixed)
+    {
+        return cpu::predict_mixed(training_input_,
+                                  training_output_,
+                                  test_input,
+                                  kernel_params,
+                                  n_tiles,
+                                  n_tile_size,
+                                  m_tiles,
+                                  m_tile_size,
+                                  n_reg,
+                                  refinement_report_);
+    }
+    if (precision == Precision::FP32)
+    {
+        return to_fp64(cpu::predict<float>(training_input_,
+                                           training_output_,
+                                           test_input,
+                                           kernel_params,
+                                           n_tiles,
+                                           n_tile_size,
+                                           m_tiles,
+                                           m_tile_size,
+                                           n_reg));
+    }
+    return cpu::predict(training_input_,
+                        training_output_,
+                        test_input,
+                        kernel_params,
+                        n_tiles,
+                        n_tile_size,
+                        m_tiles,
+                        m_tile_size,
+                        n_reg);
+}
+
+std::vector<std::vector<double>> GP::predict_with_uncertainty_cpu(const std::vector<double> &test_input,
+                                                                  int n_tiles,
+                                                                  int n_tile_size,
+                                                                  int m_tiles,
+                                                                  int m_tile_size)
+{
+    const int n_train = count_samples(training_input_, n_tiles, n_tile_size, n_reg);
+    const int n_test = count_samples(test_input, m_tiles, m_tile_size, n_reg);
+    if (use_contiguous_path(n_train))
+    {
+        return cpu::predict_with_uncertainty_contiguous(
+            training_input_, training_output_, test_input, kernel_params, n_train, n_test, n_reg);
+    }
+    if (precision == Precision::FP32)
+    {
+        return to_fp64(cpu::predict_with_uncertainty<float>(training_input_,
+                                                            training_output_,
+                                                            test_input,
+                                                            kernel_params,
+                                                            n_tiles,
+                                                            n_tile_size,
+                                                            m_tiles,
+                                                            m_tile_size,
+                                                            n_reg));
+    }
+    if (cross_covariance_storage == StoragePrecision::FP32)
+    {
+        return cpu::predict_with_uncertainty<double, float>(training_input_,
+                                                            training_output_,
+                                                            test_input,
+                                                            kernel_params,
+                                                            n_tiles,
+                                                            n_tile_size,
+                                                            m_tiles,
+                                                            m_tile_size,
+                                                            n_reg);
+    }
+    return cpu::predict_with_uncertainty(training_input_,
+                                         training_output_,
+                                         test_input,
+                                         kernel_params,
+                                         n_tiles,
+                                         n_tile_size,
+                                         m_tiles,
+                                         m_tile_size,
+                                         n_reg);
+}
+
+std::vector<std::vector<double>> GP::predict_with_full_cov_cpu(const std::vector<double> &test_input,
+                                                               int n_tiles,
+                                                               int n_tile_size,
+                                                               int m_tiles,
+                                                               int m_tile_size)
+{
+    const int n_train = count_samples(training_input_, n_tiles, n_tile_size, n_reg);
+    const int n_test = count_samples(test_input, m_tiles, m_tile_size, n_reg);
+    if (use_contiguous_path(n_train))
+    {
+        return cpu::predict_with_full_cov_contiguous(
+            training_input_, training_output_, test_input, kernel_params, n_train, n_test, n_reg);
+    }
+    if (precision == Precision::FP32)
+    {
+        return to_fp64(cpu::predict_with_full_cov<float>(training_input_,
+                                                         training_output_,
+                                                         test_input,
+                                                         kernel_params,
+                                                         n_tiles,
+                                                         n_tile_size,
+                                                         m_tiles,
+                                                         m_tile_size,
+                                                         n_reg));
+    }
+    if (cross_covariance_storage == StoragePrecision::FP32)
+    {
+        return cpu::predict_with_full_cov<double, float>(training_input_,
+                                                         training_output_,
+                                                         test_input,
+                                                         kernel_params,
+                                                         n_tiles,
+                                                         n_tile_size,
+                                                         m_tiles,
+                                                         m_tile_size,
+                                                         n_reg);
+    }
+    return cpu::predict_with_full_cov(training_input_,
+                                      training_output_,
+                                      test_input,
+                                      kernel_params,
+                                      n_tiles,
+                                      n_tile_size,
+                                      m_tiles,
+                                      m_tile_size,
+                                      n_reg);
+}
+
+double GP::predict_point(const std::vector<double> &features)
+{
+    check_point_features(features, n_reg);
+    const cpu::PointPredictionFactor &factor = point_prediction_factor();
+    return cpu::predict_point(factor, features.data(), point_workspace_.data());
+}
+
+std::pair<double, double> GP::predict_point_with_uncertainty(const std::vector<double> &features)
+{
+    check_point_features(features, n_reg);
+    const cpu::PointPredictionFactor &factor = point_prediction_factor();
+    return cpu::predict_point_with_uncertainty(factor, features.data(), point_workspace_.data());
+}
+
+std::vector<double> GP::predict_small_batch(const std::vector<double> &test_input)
+{
+    if (test_input.size() < static_cast<std::size_t>(n_reg))
+    {
+        throw std::invalid_argument("Error: The test input contains less than " + std::to_string(n_reg)
+                                    + " entries for the lagged features.");
+    }
+    const cpu::PointPredictionFactor &factor = point_prediction_factor();
+    // The lagged features of test sample i are the n_reg entries starting at i
+    std::vector<double> prediction(test_input.size() + 1 - static_cast<std::size_t>(n_reg));
+    for (std::size_t i = 0; i < prediction.size(); i++)
+    {
+        prediction[i] = cpu::predict_point(factor, test_input.data() + i, point_workspace_.data());
+    }
+    return prediction;
+}
+
+std::vector<std::vector<double>>
+GP::forecast(const std::vector<double> &window, int horizon, cpu::ForecastUncertainty uncertainty)
+{
+    check_point_features(window, n_reg);
+    check_horizon(horizon);
+    return cpu::forecast_rollout(
+        point_prediction_factor(), window.data(), static_cast<std::size_t>(horizon), uncertainty);
+}
+
+std::vector<std::vector<std::vector<double>>> GP::forecast_scenarios(
+    const std::vector<std::vector<double>> &windows, int horizon, cpu::ForecastUncertainty uncertainty)
+{
+    for (const auto &window : windows)
+    {
+        check_point_features(window, n_reg);
+    }
+    check_horizon(horizon);
+    const cpu::PointPredictionFactor &factor = point_prediction_factor();
+    return hpx::async([&factor, &windows, horizon, uncertainty]()
+                      {
+                          return cpu::forecast_rollout_scenarios(
+                              factor, windows, static_cast<std::size_t>(horizon), uncertainty);
+                      })
+        .get();
+}
+
 std::vector<double> GP::predict(const std::vector<double> &test_input, int m_tiles, int m_tile_size)
 {
     return hpx::async(
                [this, &test_input, m_tiles, m_tile_size]()
                {
+                   const auto [n_tiles, n_tile_size] = train_tiles(TiledOperation::Predict);
 #if GPRAT_WITH_CUDA
                    if (target_->is_gpu())
                    {
+                       const int n_train = count_samples(training_input_, n_tiles, n_tile_size, n_reg);
+                       const int n_test = count_samples(test_input, m_tiles, m_tile_size, n_reg);
+                       check_full_tiles(n_train, n_tiles, n_tile_size);
+                       check_full_tiles(n_test, m_tiles, m_tile_size);
                        return gpu::predict(
                            training_input_,
                            training_output_,
                            test_input,
                            kernel_params,
-                           n_tiles_,
-                           n_tile_size_,
+                           n_tiles,
+                           n_tile_size,
                            m_tiles,
                            m_tile_size,
                            n_reg,
                            *std::dynamic_pointer_cast<gprat::CUDA_GPU>(target_));
                    }
-                   else
-                   {
-                       return cpu::predict(
-                           training_input_,
-                           training_output_,
-                           test_input,
-                           kernel_params,
-                           n_tiles_,
-                           n_tile_size_,
-                           m_tiles,
-                           m_tile_size,
-                           n_reg);
-                   }
-#else
-                   return cpu::predict(
-                       training_input_,
-                       training_output_,
-                       test_input,
-                       kernel_params,
-                       n_tiles_,
-                       n_tile_size_,
-                       m_tiles,
-                       m_tile_size,
-                       n_reg);
 #endif
+                   return predict_cpu(test_input, n_tiles, n_tile_size, m_tiles, m_tile_size);
                })
         .get();
 }
@@ -158,46 +590,109 @@ GP::predict_with_uncertainty(const std::vector<double> &test_input, int m_tiles,
     return hpx::async(
                [this, &test_input, m_tiles, m_tile_size]()
                {
+                   const auto [n_tiles, n_tile_size] = train_tiles(TiledOperation::Predict);
 #if GPRAT_WITH_CUDA
                    if (target_->is_gpu())
                    {
+                       const int n_train = count_samples(training_input_, n_tiles, n_tile_size, n_reg);
+                       const int n_test = count_samples(test_input, m_tiles, m_tile_size, n_reg);
+                       check_full_tiles(n_train, n_tiles, n_tile_size);
+                       check_full_tiles(n_test, m_tiles, m_tile_size);
                        return gpu::predict_with_uncertainty(
                            training_input_,
                            training_output_,
                            test_input,
                            kernel_params,
-                           n_tiles_,
-                           n_tile_size_,
+                           n_tiles,
+                           n_tile_size,
                            m_tiles,
                            m_tile_size,
                            n_reg,
                            *std::dynamic_pointer_cast<gprat::CUDA_GPU>(target_));
                    }
-                   else
+#endif
+                   return predict_with_uncertainty_cpu(test_input, n_tiles, n_tile_size, m_tiles, m_tile_size);
+               })
+        .get();
+}
+
+std::vector<std::vector<double>>
+GP::predict_with_uncertainty_streaming(const std::vector<double> &test_input, int m_tiles, int m_tile_size)
+{
+    return hpx::async(
+               [this, &test_input, m_tiles, m_tile_size]()
+               {
+#if GPRAT_WITH_CUDA
+                   if (target_->is_gpu())
                    {
-                       return cpu::predict_with_uncertainty(
-                           training_input_,
-                           training_output_,
-                           test_input,
-                           kernel_params,
-                           n_tiles_,
-                           n_tile_size_,
-                           m_tiles,
-                           m_tile_size,
-                           n_reg);
+                       throw std::runtime_error(
+                           "Error: The streaming predictions with uncertainty are only available on the CPU.");
                    }
-#else
-                   return cpu::predict_with_uncertainty(
+#endif
+                   const auto [n_tiles, n_tile_size] = train_tiles(TiledOperation::Predict);
+                   if (precision == Precision::FP32)
+                   {
+                       return to_fp64(cpu::predict_with_uncertainty_streaming<float>(training_input_,
+                                                                                     training_output_,
+                                                                                     test_input,
+                                                                                     kernel_params,
+                                                                                     n_tiles,
+                                                                                     n_tile_size,
+                                                                                     m_tiles,
+                                                                                     m_tile_size,
+                                                                                     n_reg));
+                   }
+                   return cpu::predict_with_uncertainty_streaming(
                        training_input_,
                        training_output_,
                        test_input,
                        kernel_params,
-                       n_tiles_,
-                       n_tile_size_,
+                       n_tiles,
+                       n_tile_size,
                        m_tiles,
                        m_tile_size,
                        n_reg);
+               })
+        .get();
+}
+
+std::size_t GP::predict_chunked(const cpu::TestChunkSource &next_test_chunk,
+                               const cpu::PredictionChunkSink<double> &consume_chunk,
+                               bool with_uncertainty)
+{
+    return hpx::async(
+               [this, &next_test_chunk, &consume_chunk, with_uncertainty]()
+               {
+#if GPRAT_WITH_CUDA
+                   if (target_->is_gpu())
+                   {
+                       throw std::runtime_error("Error: The chunked predictions are only available on the CPU.");
+                   }
 #endif
+                   const auto [n_tiles, n_tile_size] = train_tiles(TiledOperation::Predict);
+                   if (precision == Precision::FP32)
+                   {
+                       return cpu::predict_chunked<float>(
+                           training_input_,
+                           training_output_,
+                           kernel_params,
+                           n_tiles,
+                           n_tile_size,
+                           n_reg,
+                           next_test_chunk,
+                           [&consume_chunk](std::vector<float> prediction, std::vector<float> uncertainty)
+                           { consume_chunk(to_fp64(prediction), to_fp64(uncertainty)); },
+                           with_uncertainty);
+                   }
+                   return cpu::predict_chunked(training_input_,
+                                               training_output_,
+                                               kernel_params,
+                                               n_tiles,
+                                               n_tile_size,
+                                               n_reg,
+                                               next_test_chunk,
+                                               consume_chunk,
+                                               with_uncertainty);
                })
         .get();
 }
@@ -208,55 +703,73 @@ GP::predict_with_full_cov(const std::vector<double> &test_input, int m_tiles, in
     return hpx::async(
                [this, &test_input, m_tiles, m_tile_size]()
                {
+                   const auto [n_tiles, n_tile_size] = train_tiles(TiledOperation::Predict);
 #if GPRAT_WITH_CUDA
                    if (target_->is_gpu())
                    {
+                       const int n_train = count_samples(training_input_, n_tiles, n_tile_size, n_reg);
+                       const int n_test = count_samples(test_input, m_tiles, m_tile_size, n_reg);
+                       check_full_tiles(n_train, n_tiles, n_tile_size);
+                       check_full_tiles(n_test, m_tiles, m_tile_size);
                        return gpu::predict_with_full_cov(
                            training_input_,
                            training_output_,
                            test_input,
                            kernel_params,
-                           n_tiles_,
-                           n_tile_size_,
+                           n_tiles,
+                           n_tile_size,
                            m_tiles,
                            m_tile_size,
                            n_reg,
                            *std::dynamic_pointer_cast<gprat::CUDA_GPU>(target_));
                    }
-                   else
+#endif
+                   return predict_with_full_cov_cpu(test_input, n_tiles, n_tile_size, m_tiles, m_tile_size);
+               })
+        .get();
+}
+
+std::vector<std::vector<double>> GP::sample_posterior(
+    const std::vector<double> &test_input, int m_tiles, int m_tile_size, int n_samples, std::uint64_t seed)
+{
+    if (n_samples <= 0)
+    {
+        throw std::invalid_argument("Error: The number of posterior samples must be positive.");
+    }
+    return hpx::async(
+               [this, &test_input, m_tiles, m_tile_size, n_samples, seed]()
+               {
+#if GPRAT_WITH_CUDA
+                   if (target_->is_gpu())
                    {
-                       return cpu::predict_with_full_cov(
-                           training_input_,
-                           training_output_,
-                           test_input,
-                           kernel_params,
-                           n_tiles_,
-                           n_tile_size_,
-                           m_tiles,
-                           m_tile_size,
-                           n_reg);
+                       throw std::runtime_error("Error: The posterior sampling is only available on the CPU.");
                    }
-#else
-                   return cpu::predict_with_full_cov(
+#endif
+                   const auto [n_tiles, n_tile_size] = train_tiles(TiledOperation::Predict);
+                   return cpu::sample_posterior(
                        training_input_,
                        training_output_,
                        test_input,
                        kernel_params,
-                       n_tiles_,
-                       n_tile_size_,
+                       n_tiles,
+                       n_tile_size,
                        m_tiles,
                        m_tile_size,
-                       n_reg);
-#endif
+                       n_reg,
+                       n_samples,
+                       seed);
                })
         .get();
 }
 
 std::vector<double> GP::optimize(const gprat_hyper::AdamParams &adam_params)
 {
+    // The optimizers update kernel_params in place
+    invalidate_point_prediction_factor();
     return hpx::async(
                [this, &adam_params]()
                {
+                   const auto [n_tiles, n_tile_size] = train_tiles(TiledOperation::Optimize);
 #if GPRAT_WITH_CUDA
                    if (target_->is_gpu())
                    {
@@ -267,8 +780,8 @@ std::vector<double> GP::optimize(const gprat_hyper::AdamParams &adam_params)
                    return cpu::optimize(
                        training_input_,
                        training_output_,
-                       n_tiles_,
-                       n_tile_size_,
+                       n_tiles,
+                       n_tile_size,
                        n_reg,
                        adam_params,
                        kernel_params,
@@ -279,9 +792,11 @@ std::vector<double> GP::optimize(const gprat_hyper::AdamParams &adam_params)
 
 double GP::optimize_step(gprat_hyper::AdamParams &adam_params, int iter)
 {
+    invalidate_point_prediction_factor();
     return hpx::async(
                [this, &adam_params, iter]()
                {
+                   const auto [n_tiles, n_tile_size] = train_tiles(TiledOperation::Optimize);
 #if GPRAT_WITH_CUDA
                    if (target_->is_gpu())
                    {
@@ -292,8 +807,8 @@ double GP::optimize_step(gprat_hyper::AdamParams &adam_params, int iter)
                    return cpu::optimize_step(
                        training_input_,
                        training_output_,
-                       n_tiles_,
-                       n_tile_size_,
+                       n_tiles,
+                       n_tile_size,
                        n_reg,
                        adam_params,
                        kernel_params,
@@ -308,54 +823,847 @@ double GP::calculate_loss()
     return hpx::async(
                [this]()
                {
+                   const auto [n_tiles, n_tile_size] = train_tiles(TiledOperation::Optimize);
+                   const int n_train = count_samples(training_input_, n_tiles, n_tile_size, n_reg);
 #if GPRAT_WITH_CUDA
                    if (target_->is_gpu())
                    {
+                       check_full_tiles(n_train, n_tiles, n_tile_size);
                        return gpu::compute_loss(
                            training_input_,
                            training_output_,
                            kernel_params,
-                           n_tiles_,
-                           n_tile_size_,
+                           n_tiles,
+                           n_tile_size,
                            n_reg,
                            *std::dynamic_pointer_cast<gprat::CUDA_GPU>(target_));
                    }
                    else
                    {
+                       if (use_contiguous_path(n_train))
+                       {
+                           return cpu::compute_loss_contiguous(
+                               training_input_, training_output_, kernel_params, n_train, n_reg);
+                       }
                        return cpu::compute_loss(
-                           training_input_, training_output_, kernel_params, n_tiles_, n_tile_size_, n_reg);
+                           training_input_, training_output_, kernel_params, n_tiles, n_tile_size, n_reg);
                    }
 #else
+                   if (use_contiguous_path(n_train))
+                   {
+                       return cpu::compute_loss_contiguous(
+                           training_input_, training_output_, kernel_params, n_train, n_reg);
+                   }
                    return cpu::compute_loss(
-                       training_input_, training_output_, kernel_params, n_tiles_, n_tile_size_, n_reg);
+                       training_input_, training_output_, kernel_params, n_tiles, n_tile_size, n_reg);
 #endif
                })
         .get();
 }
 
-std::vector<std::vector<double>> GP::cholesky()
+void GP::set_inducing_points(const std::vector<double> &inducing_input, int inducing_tiles, int inducing_tile_size)
+{
+    // Throws if the tiles do not match the inducing points
+    count_samples(inducing_input, inducing_tiles, inducing_tile_size, n_reg);
+    inducing_input_ = inducing_input;
+    inducing_tiles_ = inducing_tiles;
+    inducing_tile_size_ = inducing_tile_size;
+}
+
+void GP::check_sparse() const
+{
+    if (inducing_input_.empty())
+    {
+        throw std::runtime_error("Error: The sparse computations require inducing points, see set_inducing_points.");
+    }
+#if GPRAT_WITH_CUDA
+    if (target_->is_gpu())
+    {
+        throw std::runtime_error("Error: The sparse computations are only available on the CPU.");
+    }
+#endif
+}
+
+std::vector<double> GP::predict_sparse(const std::vector<double> &test_input, int m_tiles, int m_tile_size)
+{
+    check_sparse();
+    return hpx::async(
+               [this, &test_input, m_tiles, m_tile_size]()
+               {
+                   const auto [n_tiles, n_tile_size] = train_tiles(TiledOperation::Predict);
+                   return cpu::predict_sparse(
+                       training_input_,
+                       training_output_,
+                       inducing_input_,
+                       test_input,
+                       kernel_params,
+                       sparse_approximation,
+                       n_tiles,
+                       n_tile_size,
+                       inducing_tiles_,
+                       inducing_tile_size_,
+                       m_tiles,
+                       m_tile_size,
+                       n_reg);
+               })
+        .get();
+}
+
+std::vector<std::vector<double>>
+GP::predict_sparse_with_uncertainty(const std::vector<double> &test_input, int m_tiles, int m_tile_size)
+{
+    check_sparse();
+    return hpx::async(
+               [this, &test_input, m_tiles, m_tile_size]()
+               {
+                   const auto [n_tiles, n_tile_size] = train_tiles(TiledOperation::Predict);
+                   return cpu::predict_sparse_with_uncertainty(
+                       training_input_,
+                       training_output_,
+                       inducing_input_,
+                       test_input,
+                       kernel_params,
+                       sparse_approximation,
+                       n_tiles,
+                       n_tile_size,
+                       inducing_tiles_,
+                       inducing_tile_size_,
+                       m_tiles,
+                       m_tile_size,
+                       n_reg);
+               })
+        .get();
+}
+
+double GP::calculate_sparse_loss()
 {
+    check_sparse();
     return hpx::async(
                [this]()
                {
+                   const auto [n_tiles, n_tile_size] = train_tiles(TiledOperation::Optimize);
+                   return cpu::compute_loss_sparse(
+                       training_input_,
+                       training_output_,
+                       inducing_input_,
+                       kernel_params,
+                       sparse_approximation,
+                       n_tiles,
+                       n_tile_size,
+                       inducing_tiles_,
+                       inducing_tile_size_,
+                       n_reg);
+               })
+        .get();
+}
+
+std::vector<double> GP::optimize_sparse(const gprat_hyper::AdamParams &adam_params)
+{
+    check_sparse();
+    invalidate_point_prediction_factor();
+    return hpx::async(
+               [this, &adam_params]()
+               {
+                   const auto [n_tiles, n_tile_size] = train_tiles(TiledOperation::Optimize);
+                   return cpu::optimize_sparse(
+                       training_input_,
+                       training_output_,
+                       inducing_input_,
+                       sparse_approximation,
+                       n_tiles,
+                       n_tile_size,
+                       inducing_tiles_,
+                       inducing_tile_size_,
+                       n_reg,
+                       adam_params,
+                       kernel_params,
+                       trainable_params_);
+               })
+        .get();
+}
+
+void GP::check_vecchia() const
+{
+    if (vecchia_neighbours < 0)
+    {
+        throw std::invalid_argument("Error: The number of Vecchia neighbours must not be negative.");
+    }
 #if GPRAT_WITH_CUDA
-                   if (target_->is_gpu())
-                   {
-                       return gpu::cholesky(
-                           training_input_,
-                           kernel_params,
-                           n_tiles_,
-                           n_tile_size_,
-                           n_reg,
-                           *std::dynamic_pointer_cast<gprat::CUDA_GPU>(target_));
-                   }
-                   else
-                   {
-                       return cpu::cholesky(training_input_, kernel_params, n_tiles_, n_tile_size_, n_reg);
-                   }
-#else
-                   return cpu::cholesky(training_input_, kernel_params, n_tiles_, n_tile_size_, n_reg);
+    if (target_->is_gpu())
+    {
+        throw std::runtime_error("Error: The Vecchia computations are only available on the CPU.");
+    }
 #endif
+}
+
+std::vector<double> GP::predict_vecchia(const std::vector<double> &test_input, int m_tiles, int m_tile_size)
+{
+    check_vecchia();
+    return hpx::async(
+               [this, &test_input, m_tiles, m_tile_size]()
+               {
+                   const auto [n_tiles, n_tile_size] = train_tiles(TiledOperation::Predict);
+                   return cpu::predict_vecchia(
+                       training_input_,
+                       training_output_,
+                       test_input,
+                       kernel_params,
+                       n_tiles,
+                       n_tile_size,
+                       m_tiles,
+                       m_tile_size,
+                       n_reg,
+                       vecchia_neighbours);
+               })
+        .get();
+}
+
+std::vector<std::vector<double>>
+GP::predict_vecchia_with_uncertainty(const std::vector<double> &test_input, int m_tiles, int m_tile_size)
+{
+    check_vecchia();
+    return hpx::async(
+               [this, &test_input, m_tiles, m_tile_size]()
+               {
+                   const auto [n_tiles, n_tile_size] = train_tiles(TiledOperation::Predict);
+                   return cpu::predict_vecchia_with_uncertainty(
+                       training_input_,
+                       training_output_,
+                       test_input,
+                       kernel_params,
+                       n_tiles,
+                       n_tile_size,
+                       m_tiles,
+                       m_tile_size,
+                       n_reg,
+                       vecchia_neighbours);
+               })
+        .get();
+}
+
+double GP::calculate_vecchia_loss()
+{
+    check_vecchia();
+    return hpx::async(
+               [this]()
+               {
+                   const auto [n_tiles, n_tile_size] = train_tiles(TiledOperation::Optimize);
+                   return cpu::compute_loss_vecchia(
+                       training_input_,
+                       training_output_,
+                       kernel_params,
+                       n_tiles,
+                       n_tile_size,
+                       n_reg,
+                       vecchia_neighbours);
+               })
+        .get();
+}
+
+std::vector<double> GP::optimize_vecchia(const gprat_hyper::AdamParams &adam_params)
+{
+    check_vecchia();
+    invalidate_point_prediction_factor();
+    return hpx::async(
+               [this, &adam_params]()
+               {
+                   const auto [n_tiles, n_tile_size] = train_tiles(TiledOperation::Optimize);
+                   return cpu::optimize_vecchia(
+                       training_input_,
+                       training_output_,
+                       n_tiles,
+                       n_tile_size,
+                       n_reg,
+                       vecchia_neighbours,
+                       adam_params,
+                       kernel_params,
+                       trainable_params_);
+               })
+        .get();
+}
+
+void GP::check_experts() const
+{
+#if GPRAT_WITH_CUDA
+    if (target_->is_gpu())
+    {
+        throw std::runtime_error("Error: The expert computations are only available on the CPU.");
+    }
+#endif
+}
+
+std::vector<double> GP::predict_experts(const std::vector<double> &test_input, int m_tiles, int m_tile_size)
+{
+    check_experts();
+    return hpx::async(
+               [this, &test_input, m_tiles, m_tile_size]()
+               {
+                   const auto [n_tiles, n_tile_size] = train_tiles(TiledOperation::Predict);
+                   return cpu::predict_experts(
+                       training_input_,
+                       training_output_,
+                       test_input,
+                       kernel_params,
+                       expert_aggregation,
+                       n_tiles,
+                       n_tile_size,
+                       m_tiles,
+                       m_tile_size,
+                       n_reg);
+               })
+        .get();
+}
+
+std::vector<std::vector<double>>
+GP::predict_experts_with_uncertainty(const std::vector<double> &test_input, int m_tiles, int m_tile_size)
+{
+    check_experts();
+    return hpx::async(
+               [this, &test_input, m_tiles, m_tile_size]()
+               {
+                   const auto [n_tiles, n_tile_size] = train_tiles(TiledOperation::Predict);
+                   return cpu::predict_experts_with_uncertainty(
+                       training_input_,
+                       training_output_,
+                       test_input,
+                       kernel_params,
+                       expert_aggregation,
+                       n_tiles,
+                       n_tile_size,
+                       m_tiles,
+                       m_tile_size,
+                       n_reg);
+               })
+        .get();
+}
+
+double GP::calculate_experts_loss()
+{
+    check_experts();
+    return hpx::async(
+               [this]()
+               {
+                   const auto [n_tiles, n_tile_size] = train_tiles(TiledOperation::Optimize);
+                   return cpu::compute_loss_experts(
+                       training_input_, training_output_, kernel_params, n_tiles, n_tile_size, n_reg);
+               })
+        .get();
+}
+
+std::vector<double> GP::optimize_experts(const gprat_hyper::AdamParams &adam_params)
+{
+    check_experts();
+    invalidate_point_prediction_factor();
+    return hpx::async(
+               [this, &adam_params]()
+               {
+                   const auto [n_tiles, n_tile_size] = train_tiles(TiledOperation::Optimize);
+                   return cpu::optimize_experts(
+                       training_input_,
+                       training_output_,
+                       n_tiles,
+                       n_tile_size,
+                       n_reg,
+                       adam_params,
+                       kernel_params,
+                       trainable_params_);
+               })
+        .get();
+}
+
+void GP::check_blr() const
+{
+    if (blr_tolerance < 0.0)
+    {
+        throw std::invalid_argument("Error: The block low-rank tolerance must not be negative.");
+    }
+#if GPRAT_WITH_CUDA
+    if (target_->is_gpu())
+    {
+        throw std::runtime_error("Error: The block low-rank computations are only available on the CPU.");
+    }
+#endif
+}
+
+std::vector<double> GP::predict_blr(const std::vector<double> &test_input, int m_tiles, int m_tile_size)
+{
+    check_blr();
+    return hpx::async(
+               [this, &test_input, m_tiles, m_tile_size]()
+               {
+                   const auto [n_tiles, n_tile_size] = train_tiles(TiledOperation::Predict);
+                   return cpu::predict_blr(
+                       training_input_,
+                       training_output_,
+                       test_input,
+                       kernel_params,
+                       n_tiles,
+                       n_tile_size,
+                       m_tiles,
+                       m_tile_size,
+                       n_reg,
+                       blr_tolerance);
+               })
+        .get();
+}
+
+std::vector<std::vector<double>>
+GP::predict_blr_with_uncertainty(const std::vector<double> &test_input, int m_tiles, int m_tile_size)
+{
+    check_blr();
+    return hpx::async(
+               [this, &test_input, m_tiles, m_tile_size]()
+               {
+                   const auto [n_tiles, n_tile_size] = train_tiles(TiledOperation::Predict);
+                   return cpu::predict_blr_with_uncertainty(
+                       training_input_,
+                       training_output_,
+                       test_input,
+                       kernel_params,
+                       n_tiles,
+                       n_tile_size,
+                       m_tiles,
+                       m_tile_size,
+                       n_reg,
+                       blr_tolerance);
+               })
+        .get();
+}
+
+double GP::calculate_blr_loss()
+{
+    check_blr();
+    return hpx::async(
+               [this]()
+               {
+                   const auto [n_tiles, n_tile_size] = train_tiles(TiledOperation::Optimize);
+                   return cpu::compute_loss_blr(
+                       training_input_, training_output_, kernel_params, n_tiles, n_tile_size, n_reg, blr_tolerance);
+               })
+        .get();
+}
+
+double GP::calculate_blr_compression()
+{
+    check_blr();
+    return hpx::async(
+               [this]()
+               {
+                   const auto [n_tiles, n_tile_size] = train_tiles(TiledOperation::Cholesky);
+                   return cpu::compute_blr_compression(
+                       training_input_, kernel_params, n_tiles, n_tile_size, n_reg, blr_tolerance);
+               })
+        .get();
+}
+
+void GP::check_hodlr() const
+{
+    if (hodlr_tolerance < 0.0)
+    {
+        throw std::invalid_argument("Error: The HODLR tolerance must not be negative.");
+    }
+#if GPRAT_WITH_CUDA
+    if (target_->is_gpu())
+    {
+        throw std::runtime_error("Error: The HODLR computations are only available on the CPU.");
+    }
+#endif
+}
+
+std::vector<double> GP::predict_hodlr(const std::vector<double> &test_input, int m_tiles, int m_tile_size)
+{
+    check_hodlr();
+    return hpx::async(
+               [this, &test_input, m_tiles, m_tile_size]()
+               {
+                   const auto [n_tiles, n_tile_size] = train_tiles(TiledOperation::Predict);
+                   return cpu::predict_hodlr(
+                       training_input_,
+                       training_output_,
+                       test_input,
+                       kernel_params,
+                       n_tiles,
+                       n_tile_size,
+                       m_tiles,
+                       m_tile_size,
+                       n_reg,
+                       hodlr_tolerance);
+               })
+        .get();
+}
+
+std::vector<std::vector<double>>
+GP::predict_hodlr_with_uncertainty(const std::vector<double> &test_input, int m_tiles, int m_tile_size)
+{
+    check_hodlr();
+    return hpx::async(
+               [this, &test_input, m_tiles, m_tile_size]()
+               {
+                   const auto [n_tiles, n_tile_size] = train_tiles(TiledOperation::Predict);
+                   return cpu::predict_hodlr_with_uncertainty(
+                       training_input_,
+                       training_output_,
+                       test_input,
+                       kernel_params,
+                       n_tiles,
+                       n_tile_size,
+                       m_tiles,
+                       m_tile_size,
+                       n_reg,
+                       hodlr_tolerance);
+               })
+        .get();
+}
+
+double GP::calculate_hodlr_loss()
+{
+    check_hodlr();
+    return hpx::async(
+               [this]()
+               {
+                   const auto [n_tiles, n_tile_size] = train_tiles(TiledOperation::Optimize);
+                   return cpu::compute_loss_hodlr(
+                       training_input_, training_output_, kernel_params, n_tiles, n_tile_size, n_reg, hodlr_tolerance);
+               })
+        .get();
+}
+
+void GP::check_cg() const
+{
+    if (cg_tolerance <= 0.0 || cg_max_iterations < 0 || cg_preconditioner_rank < 0)
+    {
+        throw std::invalid_argument("Error: The conjugate gradient tolerance must be positive, the maximum "
+                                    "iterations and the preconditioner rank must not be negative.");
+    }
+    if (kernel_params.noise_variance <= 0.0)
+    {
+        throw std::invalid_argument("Error: The conjugate gradient computations require a positive noise variance.");
+    }
+#if GPRAT_WITH_CUDA
+    if (target_->is_gpu())
+    {
+        throw std::runtime_error("Error: The conjugate gradient computations are only available on the CPU.");
+    }
+#endif
+}
+
+std::vector<double> GP::predict_cg(const std::vector<double> &test_input, int m_tiles, int m_tile_size)
+{
+    check_cg();
+    return hpx::async(
+               [this, &test_input, m_tiles, m_tile_size]()
+               {
+                   const auto [n_tiles, n_tile_size] = train_tiles(TiledOperation::Predict);
+                   return cpu::predict_cg(
+                       training_input_,
+                       training_output_,
+                       test_input,
+                       kernel_params,
+                       n_tiles,
+                       n_tile_size,
+                       m_tiles,
+                       m_tile_size,
+                       n_reg,
+                       cg_tolerance,
+                       cg_max_iterations,
+                       cg_preconditioner_rank);
+               })
+        .get();
+}
+
+std::vector<std::vector<double>>
+GP::predict_cg_with_uncertainty(const std::vector<double> &test_input, int m_tiles, int m_tile_size)
+{
+    check_cg();
+    return hpx::async(
+               [this, &test_input, m_tiles, m_tile_size]()
+               {
+                   const auto [n_tiles, n_tile_size] = train_tiles(TiledOperation::Predict);
+                   return cpu::predict_cg_with_uncertainty(
+                       training_input_,
+                       training_output_,
+                       test_input,
+                       kernel_params,
+                       n_tiles,
+                       n_tile_size,
+                       m_tiles,
+                       m_tile_size,
+                       n_reg,
+                       cg_tolerance,
+                       cg_max_iterations,
+                       cg_preconditioner_rank);
+               })
+        .get();
+}
+
+void GP::check_slq() const
+{
+    if (slq_probes <= 0 || slq_lanczos_steps <= 0)
+    {
+        throw std::invalid_argument(
+            "Error: The number of probe vectors and of Lanczos steps of the stochastic Lanczos quadrature must be "
+            "positive.");
+    }
+    check_cg();
+}
+
+cpu::SLQParams GP::slq_params() const
+{
+    return cpu::SLQParams{
+        slq_probes, slq_lanczos_steps, slq_seed, cg_tolerance, cg_max_iterations, cg_preconditioner_rank
+    };
+}
+
+double GP::calculate_slq_loss()
+{
+    check_slq();
+    return hpx::async(
+               [this]()
+               {
+                   const auto [n_tiles, n_tile_size] = train_tiles(TiledOperation::Optimize);
+                   return cpu::compute_loss_slq(
+                       training_input_, training_output_, kernel_params, n_tiles, n_tile_size, n_reg, slq_params());
+               })
+        .get();
+}
+
+std::vector<double> GP::optimize_slq(const gprat_hyper::AdamParams &adam_params)
+{
+    check_slq();
+    invalidate_point_prediction_factor();
+    return hpx::async(
+               [this, &adam_params]()
+               {
+                   const auto [n_tiles, n_tile_size] = train_tiles(TiledOperation::Optimize);
+                   return cpu::optimize_slq(
+                       training_input_,
+                       training_output_,
+                       n_tiles,
+                       n_tile_size,
+                       n_reg,
+                       adam_params,
+                       kernel_params,
+                       trainable_params_,
+                       slq_params());
+               })
+        .get();
+}
+
+void GP::check_compact() const
+{
+    if (kernel_params.lengthscale <= 0.0)
+    {
+        throw std::invalid_argument("Error: The support radius of the compactly supported kernel, given by the "
+                                    "lengthscale, must be positive.");
+    }
+#if GPRAT_WITH_CUDA
+    if (target_->is_gpu())
+    {
+        throw std::runtime_error("Error: The compactly supported kernel is only available on the CPU.");
+    }
+#endif
+}
+
+std::vector<double> GP::predict_compact(const std::vector<double> &test_input, int m_tiles, int m_tile_size)
+{
+    check_compact();
+    return hpx::async(
+               [this, &test_input, m_tiles, m_tile_size]()
+               {
+                   const auto [n_tiles, n_tile_size] = train_tiles(TiledOperation::Predict);
+                   return cpu::predict_compact(
+                       training_input_,
+                       training_output_,
+                       test_input,
+                       kernel_params,
+                       n_tiles,
+                       n_tile_size,
+                       m_tiles,
+                       m_tile_size,
+                       n_reg,
+                       compact_reorder);
+               })
+        .get();
+}
+
+std::vector<std::vector<double>>
+GP::predict_compact_with_uncertainty(const std::vector<double> &test_input, int m_tiles, int m_tile_size)
+{
+    check_compact();
+    return hpx::async(
+               [this, &test_input, m_tiles, m_tile_size]()
+               {
+                   const auto [n_tiles, n_tile_size] = train_tiles(TiledOperation::Predict);
+                   return cpu::predict_compact_with_uncertainty(
+                       training_input_,
+                       training_output_,
+                       test_input,
+                       kernel_params,
+                       n_tiles,
+                       n_tile_size,
+                       m_tiles,
+                       m_tile_size,
+                       n_reg,
+                       compact_reorder);
+               })
+        .get();
+}
+
+double GP::calculate_compact_loss()
+{
+    check_compact();
+    return hpx::async(
+               [this]()
+               {
+                   const auto [n_tiles, n_tile_size] = train_tiles(TiledOperation::Optimize);
+                   return cpu::compute_loss_compact(
+                       training_input_, training_output_, kernel_params, n_tiles, n_tile_size, n_reg, compact_reorder);
+               })
+        .get();
+}
+
+std::vector<double> GP::optimize_compact(const gprat_hyper::AdamParams &adam_params)
+{
+    check_compact();
+    invalidate_point_prediction_factor();
+    return hpx::async(
+               [this, &adam_params]()
+               {
+                   const auto [n_tiles, n_tile_size] = train_tiles(TiledOperation::Optimize);
+                   return cpu::optimize_compact(
+                       training_input_,
+                       training_output_,
+                       n_tiles,
+                       n_tile_size,
+                       n_reg,
+                       adam_params,
+                       kernel_params,
+                       trainable_params_,
+                       compact_reorder);
+               })
+        .get();
+}
+
+double GP::calculate_compact_density()
+{
+    check_compact();
+    return hpx::async(
+               [this]()
+               {
+                   const auto [n_tiles, n_tile_size] = train_tiles(TiledOperation::Cholesky);
+                   return cpu::compute_compact_density(
+                       training_input_, kernel_params, n_tiles, n_tile_size, n_reg, compact_reorder);
+               })
+        .get();
+}
+
+std::vector<std::vector<double>> GP::cholesky()
+{
+    return hpx::async(
+               [this]()
+               {
+                   const auto [n_tiles, n_tile_size] = train_tiles(TiledOperation::Cholesky);
+#if GPRAT_WITH_CUDA
+                   if (target_->is_gpu())
+                   {
+                       const int n_train = count_samples(training_input_, n_tiles, n_tile_size, n_reg);
+                       check_full_tiles(n_train, n_tiles, n_tile_size);
+                       return gpu::cholesky(
+                           training_input_,
+                           kernel_params,
+                           n_tiles,
+                           n_tile_size,
+                           n_reg,
+                           *std::dynamic_pointer_cast<gprat::CUDA_GPU>(target_));
+                   }
+                   else
+                   {
+                       return cpu::cholesky(training_input_, kernel_params, n_tiles, n_tile_size, n_reg);
+                   }
+#else
+                   return cpu::cholesky(training_input_, kernel_params, n_tiles, n_tile_size, n_reg);
+#endif
+               })
+        .get();
+}
+
+RandomFeatureGP::RandomFeatureGP(std::vector<double> input,
+                                 std::vector<double> output,
+                                 int n_tiles,
+                                 int n_tile_size,
+                                 int n_regressors,
+                                 std::vector<double> kernel_hyperparams,
+                                 int n_features,
+                                 int n_feature_tiles,
+                                 std::uint64_t seed) :
+    training_input_(input),
+    training_output_(output),
+    n_tiles_(n_tiles),
+    n_tile_size_(n_tile_size),
+    n_features_(n_features),
+    n_feature_tiles_(n_feature_tiles),
+    n_feature_tile_size_(compute_feature_tile_size(n_features, n_feature_tiles)),
+    seed_(seed),
+    n_reg(n_regressors),
+    kernel_params(kernel_hyperparams[0], kernel_hyperparams[1], kernel_hyperparams[2])
+{ }
+
+std::string RandomFeatureGP::repr() const
+{
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(12);
+    oss << "Kernel_Params: [lengthscale=" << kernel_params.lengthscale << ", vertical_lengthscale="
+        << kernel_params.vertical_lengthscale << ", noise_variance=" << kernel_params.noise_variance
+        << ", n_regressors=" << n_reg << "], n_features=" << n_features_ << ", n_feature_tiles=" << n_feature_tiles_
+        << ", seed=" << seed_ << ", n_tiles=" << n_tiles_ << ", n_tile_size=" << n_tile_size_;
+    return oss.str();
+}
+
+int RandomFeatureGP::get_n_features() const { return n_features_; }
+
+std::vector<double> RandomFeatureGP::predict(const std::vector<double> &test_input, int m_tiles, int m_tile_size)
+{
+    return hpx::async(
+               [this, &test_input, m_tiles, m_tile_size]()
+               {
+                   return cpu::predict_random_features(
+                       training_input_,
+                       training_output_,
+                       test_input,
+                       kernel_params,
+                       n_tiles_,
+                       n_tile_size_,
+                       n_feature_tiles_,
+                       n_feature_tile_size_,
+                       m_tiles,
+                       m_tile_size,
+                       n_reg,
+                       n_features_,
+                       seed_);
+               })
+        .get();
+}
+
+std::vector<std::vector<double>>
+RandomFeatureGP::predict_with_uncertainty(const std::vector<double> &test_input, int m_tiles, int m_tile_size)
+{
+    return hpx::async(
+               [this, &test_input, m_tiles, m_tile_size]()
+               {
+                   return cpu::predict_random_features_with_uncertainty(
+                       training_input_,
+                       training_output_,
+                       test_input,
+                       kernel_params,
+                       n_tiles_,
+                       n_tile_size_,
+                       n_feature_tiles_,
+                       n_feature_tile_size_,
+                       m_tiles,
+                       m_tile_size,
+                       n_reg,
+                       n_features_,
+                       seed_);
                })
         .get();
 }
@@ -0,0 +1,253 @@
+#include "tile_tuner.hpp"
+
+#include "cpu/gp_functions.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <hpx/future.hpp>
+#include <hpx/runtime.hpp>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace gprat
+{
+
+// Largest problem size used for calibration benchmarks, larger problems are extrapolated
+constexpr int MAX_CALIBRATION_SAMPLES = 4096;
+// Smallest candidate tile size
+constexpr int MIN_TUNED_TILE_SIZE = 32;
+// Largest tile size returned for extrapolated problem sizes, a tile of 32 MiB in FP64
+constexpr int MAX_TUNED_TILE_SIZE = 2048;
+// Each candidate is timed at least MIN_CALIBRATION_REPETITIONS times and repeated until
+// it ran for MIN_CALIBRATION_SECONDS, at most MAX_CALIBRATION_REPETITIONS times. The
+// median of the runtimes is robust against outliers such as the first touch of memory.
+constexpr std::size_t MIN_CALIBRATION_REPETITIONS = 3;
+constexpr std::size_t MAX_CALIBRATION_REPETITIONS = 15;
+constexpr double MIN_CALIBRATION_SECONDS = 0.1;
+
+std::string tiled_operation_name(TiledOperation operation)
+{
+    switch (operation)
+    {
+        case TiledOperation::Cholesky: return "cholesky";
+        case TiledOperation::Predict: return "predict";
+        case TiledOperation::Optimize: return "optimize";
+    }
+    throw std::invalid_argument("Error: Unknown tiled operation.");
+}
+
+std::string default_tile_cache_path()
+{
+    if (const char *env_cache = std::getenv("GPRAT_TILE_CACHE"))
+    {
+        return env_cache;
+    }
+    if (const char *xdg_cache = std::getenv("XDG_CACHE_HOME"))
+    {
+        return (std::filesystem::path(xdg_cache) / "gprat" / "tile_sizes.txt").string();
+    }
+    if (const char *home = std::getenv("HOME"))
+    {
+        return (std::filesystem::path(home) / ".cache" / "gprat" / "tile_sizes.txt").string();
+    }
+    return "gprat_tile_sizes.txt";
+}
+
+double benchmark_tile_size(TiledOperation operation, int n_samples, int n_tile_size, int n_regressors)
+{
+    if (n_tile_size <= 0 || n_tile_size > n_samples)
+    {
+        throw std::invalid_argument("Error: Tile size " + std::to_string(n_tile_size)
+                                    + " is invalid for the number of samples " + std::to_string(n_samples) + ".");
+    }
+    // The last tile contains the remainder
+    const int n_tiles = (n_samples + n_tile_size - 1) / n_tile_size;
+
+    // Synthetic lagged time series with the same layout as GP_data
+    std::vector<double> input(static_cast<std::size_t>(n_samples + n_regressors - 1), 0.0);
+    for (std::size_t i = static_cast<std::size_t>(n_regressors - 1); i < input.size(); i++)
+    {
+        input[i] = std::sin(0.1 * static_cast<double>(i));
+    }
+    const std::vector<double> &output = input;
+
+    gprat_hyper::SEKParams sek_params(1.0, 1.0, 0.1);
+    gprat_hyper::AdamParams adam_params(0.1, 0.9, 0.999, 1e-8, 1);
+    const std::vector<bool> trainable = { true, true, true };
+
+    const auto start = std::chrono::steady_clock::now();
+    switch (operation)
+    {
+        case TiledOperation::Cholesky:
+            cpu::cholesky(input, sek_params, n_tiles, n_tile_size, n_regressors);
+            break;
+        case TiledOperation::Predict:
+            cpu::predict_with_uncertainty(
+                input, output, input, sek_params, n_tiles, n_tile_size, n_tiles, n_tile_size, n_regressors);
+            break;
+        case TiledOperation::Optimize:
+            cpu::optimize_step(
+                input, output, n_tiles, n_tile_size, n_regressors, adam_params, sek_params, trainable, 0);
+            break;
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+namespace
+{
+
+/**
+ * @brief Look up a tuned tile size in the cache file, returns 0 if not found.
+ */
+int read_cached_tile_size(const std::string &cache_path, const std::string &key)
+{
+    std::ifstream cache(cache_path);
+    std::string line;
+    int tile_size = 0;
+    while (std::getline(cache, line))
+    {
+        std::istringstream entry(line);
+        std::string operation;
+        int n_samples, n_regressors, n_threads, cached_tile_size;
+        if (entry >> operation >> n_samples >> n_regressors >> n_threads >> cached_tile_size)
+        {
+            std::ostringstream entry_key;
+            entry_key << operation << ' ' << n_samples << ' ' << n_regressors << ' ' << n_threads;
+            if (entry_key.str() == key)
+            {
+                // later entries override earlier ones
+                tile_size = cached_tile_size;
+            }
+        }
+    }
+    return tile_size;
+}
+
+/**
+ * @brief Append a tuned tile size to the cache file.
+ */
+void write_cached_tile_size(const std::string &cache_path, const std::string &key, int tile_size)
+{
+    const std::filesystem::path path(cache_path);
+    std::error_code error;
+    if (path.has_parent_path())
+    {
+        std::filesystem::create_directories(path.parent_path(), error);
+    }
+    std::ofstream cache(cache_path, std::ios::app);
+    if (cache)
+    {
+        cache << key << ' ' << tile_size << '\n';
+    }
+    else
+    {
+        std::cerr << "Warning: Could not write tile size cache " << cache_path << std::endl;
+    }
+}
+
+/**
+ * @brief Measure the median runtime of a tile size, see MIN_CALIBRATION_REPETITIONS.
+ */
+double measure_tile_size(TiledOperation operation, int n_samples, int n_tile_size, int n_regressors)
+{
+    std::vector<double> times;
+    double total_time = 0.0;
+    while (times.size() < MIN_CALIBRATION_REPETITIONS
+           || (total_time < MIN_CALIBRATION_SECONDS && times.size() < MAX_CALIBRATION_REPETITIONS))
+    {
+        times.push_back(benchmark_tile_size(operation, n_samples, n_tile_size, n_regressors));
+        total_time += times.back();
+    }
+    const auto median = times.begin() + static_cast<std::ptrdiff_t>(times.size() / 2);
+    std::nth_element(times.begin(), median, times.end());
+    return *median;
+}
+
+/**
+ * @brief Determine the fastest power of two tile size for a power of two number of samples.
+ */
+int calibrate_tile_size(TiledOperation operation, int n_calibration, int n_regressors, const std::string &cache_path)
+{
+    if (n_calibration <= MIN_TUNED_TILE_SIZE)
+    {
+        return n_calibration;
+    }
+
+    std::ostringstream key;
+    key << tiled_operation_name(operation) << ' ' << n_calibration << ' ' << n_regressors << ' '
+        << hpx::get_num_worker_threads();
+    if (!cache_path.empty())
+    {
+        const int cached_tile_size = read_cached_tile_size(cache_path, key.str());
+        if (cached_tile_size > 0)
+        {
+            return cached_tile_size;
+        }
+    }
+
+    // Benchmark all power of two tile sizes
+    int best_tile_size = n_calibration;
+    double best_time = std::numeric_limits<double>::max();
+    for (int tile_size = MIN_TUNED_TILE_SIZE; tile_size <= n_calibration; tile_size *= 2)
+    {
+        const double time = measure_tile_size(operation, n_calibration, tile_size, n_regressors);
+        if (time < best_time)
+        {
+            best_time = time;
+            best_tile_size = tile_size;
+        }
+    }
+
+    if (!cache_path.empty())
+    {
+        write_cached_tile_size(cache_path, key.str(), best_tile_size);
+    }
+    return best_tile_size;
+}
+
+}  // namespace
+
+int tune_tile_size(TiledOperation operation, int n_samples, int n_regressors, const std::string &cache_path)
+{
+    if (n_samples <= 0)
+    {
+        throw std::invalid_argument("Error: Please specify a positive number of samples for tile size tuning.");
+    }
+
+    // Calibrate on the largest power of two that does not exceed the problem size
+    int n_calibration = 1;
+    while (2 * n_calibration <= std::min(n_samples, MAX_CALIBRATION_SAMPLES))
+    {
+        n_calibration *= 2;
+    }
+    const int tile_size = calibrate_tile_size(operation, n_calibration, n_regressors, cache_path);
+    if (n_samples < 2 * n_calibration)
+    {
+        return tile_size;
+    }
+
+    // Extrapolate beyond MAX_CALIBRATION_SAMPLES: if the best tile size grows with the
+    // calibration size, the operation is limited by the number of tiles, which is kept.
+    // Otherwise the tile size is limited by the efficiency of the tile kernels and kept.
+    int extrapolated_tile_size = tile_size;
+    const int half_tile_size = calibrate_tile_size(operation, n_calibration / 2, n_regressors, cache_path);
+    if (tile_size > half_tile_size)
+    {
+        const int n_tiles = n_calibration / tile_size;
+        extrapolated_tile_size = (n_samples + n_tiles - 1) / n_tiles;
+    }
+    // The tile kernels lose cache efficiency beyond MAX_TUNED_TILE_SIZE, and every
+    // worker thread needs at least one tile row
+    const int n_threads = static_cast<int>(hpx::get_num_worker_threads());
+    const int max_tile_size = std::min(MAX_TUNED_TILE_SIZE, (n_samples + n_threads - 1) / n_threads);
+    return std::max(MIN_TUNED_TILE_SIZE, std::min(extrapolated_tile_size, max_tile_size));
+}
+
+}  // namespace gprat
@@ -1,6 +1,12 @@
 #include "utils_c.hpp"
 
+#ifdef GPRAT_ENABLE_HYBRID_BLAS
+#include "mkl_service.h"
+#endif
+#include <algorithm>
 #include <cstdio>
+#include <stdexcept>
+#include <string>
 
 namespace utils
 {
@@ -9,8 +15,8 @@ int compute_train_tiles(int n_samples, int n_tile_size)
 {
     if (n_tile_size > 0)
     {
-        // n_tiles
-        return n_samples / n_tile_size;
+        // n_tiles, the last tile contains the remainder
+        return (n_samples + n_tile_size - 1) / n_tile_size;
     }
     else
     {
@@ -22,8 +28,16 @@ int compute_train_tile_size(int n_samples, int n_tiles)
 {
     if (n_tiles > 0)
     {
-        // n_tile_size
-        return n_samples / n_tiles;
+        // n_tile_size, the last tile contains the remainder
+        const int n_tile_size = (n_samples + n_tiles - 1) / n_tiles;
+        // Rounding up the tile size may cover the samples with fewer tiles
+        if ((n_tiles - 1) * n_tile_size >= n_samples)
+        {
+            throw std::invalid_argument("Error: " + std::to_string(n_tiles) + " tiles leave the last tile empty for "
+                                        + std::to_string(n_samples)
+                                        + " samples, use compute_train_tiles to obtain the number of tiles.");
+        }
+        return n_tile_size;
     }
     else
     {
@@ -31,24 +45,25 @@ int compute_train_tile_size(int n_samples, int n_tiles)
     }
 }
 
-std::pair<int, int> compute_test_tiles(int n_test, int n_tiles, int n_tile_size)
+std::pair<int, int> compute_test_tiles(int n_test, int n_tile_size)
 {
-    int m_tiles;
-    int m_tile_size;
+    // Use the same tile size, the last tile contains the remainder
+    const int m_tile_size = std::min(n_tile_size, n_test);
+    return { compute_train_tiles(n_test, m_tile_size), m_tile_size };
+}
 
-    // if n_test is not divisible by (incl. smaller than) n_tile_size, use the same number of tiles
-    if ((n_test % n_tile_size) > 0)
-    {
-        m_tiles = n_tiles;
-        m_tile_size = n_test / m_tiles;
-    }
-    // if n_test is divisible by n_tile_size, use the same tile size
-    else
-    {
-        m_tiles = n_test / n_tile_size;
-        m_tile_size = n_tile_size;
-    }
-    return { m_tiles, m_tile_size };
+std::pair<int, int> compute_test_tiles(int n_test, int, int n_tile_size)
+{
+    return compute_test_tiles(n_test, n_tile_size);
+}
+
+std::pair<int, int> compute_tuned_train_tiles(int n_samples, int n_regressors, gprat::TiledOperation operation)
+{
+    const int tuned_tile_size =
+        hpx::async([=]() { return gprat::tune_tile_size(operation, n_samples, n_regressors); }).get();
+    // Keep the tuned tile size, the last tile contains the remainder
+    const int n_tile_size = std::min(tuned_tile_size, n_samples);
+    return { compute_train_tiles(n_samples, n_tile_size), n_tile_size };
 }
 
 std::vector<double> load_data(const std::string &file_path, int n_samples, int offset)
@@ -120,7 +135,16 @@ void print_vector(const std::vector<double> &vec, int start, int end, const std:
     std::cout << std::endl;
 }
 
-void start_hpx_runtime(int argc, char **argv) { hpx::start(nullptr, argc, argv); }
+void start_hpx_runtime(int argc, char **argv)
+{
+#ifdef GPRAT_ENABLE_HYBRID_BLAS
+    // Every HPX worker thread calls oneMKL, only the critical path kernels
+    // raise their thread count locally, see potrf_threaded
+    mkl_set_dynamic(0);
+    mkl_set_num_threads(1);
+#endif
+    hpx::start(nullptr, argc, argv);
+}
 
 void resume_hpx_runtime() { hpx::resume(); }
 
@@ -109,3 +109,8 @@ make -j
 ################################################################################
 
 ./gprat_cpp $use_gpu
+
+# Benchmark the random feature approximation against the exact GP on the CPU
+if [[ -z "$use_gpu" ]]; then
+    ./gprat_cpp_random_features
+fi
@@ -53,7 +53,7 @@ int main(int argc, char *argv[])
             {
                 // Compute tile sizes and number of predict tiles
                 int tile_size = utils::compute_train_tile_size(n_train, n_tiles);
-                auto result = utils::compute_test_tiles(n_test, n_tiles, tile_size);
+                auto result = utils::compute_test_tiles(n_test, tile_size);
                 /////////////////////
                 ///// hyperparams
                 gprat_hyper::AdamParams hpar = { 0.1, 0.9, 0.999, 1e-8, OPT_ITER };
@@ -0,0 +1,112 @@
+#include "gprat_c.hpp"
+#include "utils_c.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+
+int main(int argc, char *argv[])
+{
+    /////////////////////
+    /////// configuration
+    std::size_t START = 512;
+    std::size_t END = 1024;
+    std::size_t STEP = 2;
+    std::size_t LOOP = 2;
+    const std::vector<int> N_FEATURES = { 128, 256, 512, 1024 };
+    const int N_FEATURE_TILES = 4;
+
+    int n_test = 1024;
+    const std::size_t n_tiles = 16;
+    const std::size_t n_reg = 8;
+
+    std::string train_path = "../../../data/data_1024/training_input.txt";
+    std::string out_path = "../../../data/data_1024/training_output.txt";
+    std::string test_path = "../../../data/data_1024/test_input.txt";
+
+    // Initialize HPX, don't run hpx_main
+    utils::start_hpx_runtime(argc, argv);
+
+    for (std::size_t start = START; start <= END; start = start * STEP)
+    {
+        int n_train = static_cast<int>(start);
+        for (std::size_t l = 0; l < LOOP; l++)
+        {
+            // Compute tile sizes and number of predict tiles
+            int tile_size = utils::compute_train_tile_size(n_train, n_tiles);
+            auto result = utils::compute_test_tiles(n_test, tile_size);
+
+            /////////////////////
+            ////// data loading
+            gprat::GP_data training_input(train_path, n_train, n_reg);
+            gprat::GP_data training_output(out_path, n_train, n_reg);
+            gprat::GP_data test_input(test_path, n_test, n_reg);
+
+            /////////////////////
+            ///// exact GP as reference
+            std::vector<bool> trainable = { true, true, true };
+            gprat::GP gp_cpu(
+                training_input.data, training_output.data, n_tiles, tile_size, n_reg, { 1.0, 1.0, 0.1 }, trainable);
+            gp_cpu.small_problem_threshold = 0;
+
+            auto start_exact = std::chrono::high_resolution_clock::now();
+            std::vector<std::vector<double>> sum_exact =
+                gp_cpu.predict_with_uncertainty(test_input.data, result.first, result.second);
+            auto end_exact = std::chrono::high_resolution_clock::now();
+            std::chrono::duration<double> exact_time = end_exact - start_exact;
+
+            for (const int n_features : N_FEATURES)
+            {
+                /////////////////////
+                ///// random feature GP
+                gprat::RandomFeatureGP gp_rff(training_input.data,
+                                              training_output.data,
+                                              n_tiles,
+                                              tile_size,
+                                              n_reg,
+                                              { 1.0, 1.0, 0.1 },
+                                              n_features,
+                                              N_FEATURE_TILES,
+                                              l);
+
+                auto start_rff = std::chrono::high_resolution_clock::now();
+                std::vector<std::vector<double>> sum_rff =
+                    gp_rff.predict_with_uncertainty(test_input.data, result.first, result.second);
+                auto end_rff = std::chrono::high_resolution_clock::now();
+                std::chrono::duration<double> rff_time = end_rff - start_rff;
+
+                // Accuracy with respect to the exact GP
+                double mean_error = 0.0;
+                double max_uncertainty_error = 0.0;
+                for (std::size_t i = 0; i < sum_exact[0].size(); i++)
+                {
+                    mean_error += (sum_rff[0][i] - sum_exact[0][i]) * (sum_rff[0][i] - sum_exact[0][i]);
+                    max_uncertainty_error =
+                        std::max(max_uncertainty_error, std::abs(sum_rff[1][i] - sum_exact[1][i]));
+                }
+                mean_error = std::sqrt(mean_error / static_cast<double>(sum_exact[0].size()));
+
+                // Save parameters, times and errors to a .csv file with a header
+                std::ofstream outfile("../random_features_output.csv", std::ios::app);  // Append mode
+                if (outfile.tellp() == 0)
+                {
+                    // If file is empty, write the header
+                    outfile << "N_train,N_test,N_tiles,N_regressor,N_features,Exact_time,RFF_time,Pred_RMSE,"
+                               "Uncer_max_error,N_loop\n";
+                }
+                outfile << n_train << "," << n_test << "," << n_tiles << "," << n_reg << "," << n_features << ","
+                        << exact_time.count() << "," << rff_time.count() << "," << mean_error << ","
+                        << max_uncertainty_error << "," << l << "\n";
+                outfile.close();
+                std::cout << "n_train=" << n_train << " n_features=" << n_features << " speedup="
+                          << exact_time.count() / rff_time.count() << " pred_rmse=" << mean_error << std::endl;
+            }
+        }
+    }
+
+    // Stop the HPX runtime
+    utils::stop_hpx_runtime();
+
+    return 0;
+}
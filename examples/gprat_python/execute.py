@@ -31,9 +31,7 @@ use_gpu = gprat.compiled_with_cuda() and gprat.gpu_count() > 0 and args.use_gpu
 def gprat_run(config, output_csv_obj, n_train, l, cores):
 
     n_tile_size = gprat.compute_train_tile_size(n_train, config["N_TILES"])
-    m_tiles, m_tile_size = gprat.compute_test_tiles(
-        config["N_TEST"], config["N_TILES"], n_tile_size
-    )
+    m_tiles, m_tile_size = gprat.compute_test_tiles(config["N_TEST"], n_tile_size)
     hpar = gprat.AdamParams(learning_rate=0.1, opt_iter=config["OPT_ITER"])
     train_in = gprat.GP_data(config["train_in_file"], n_train, config["N_REG"])
     train_out = gprat.GP_data(
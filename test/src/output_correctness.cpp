@@ -1,16 +1,31 @@
+#include "cpu/gp_algorithms.hpp"
+#include "cpu/tiled_algorithms.hpp"
 #include "gprat_c.hpp"
+#include "tile_tuner.hpp"
 #include "utils_c.hpp"
+#include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <hpx/future.hpp>
+#include <hpx/runtime.hpp>
+#ifdef GPRAT_ENABLE_HYBRID_BLAS
+#include "mkl_service.h"
+#endif
 
 // This is a standalone test, so including this directly is fine.
 // Better than having the whole project depend on compiled Boost.Json!
 #include <boost/json/src.hpp>
 
 // std headers last
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
 #include <fstream>
+#include <stdexcept>
 #include <string>
 #include <string_view>
+#include <utility>
 
 // Struct containing all results we'd like to compare
 struct gprat_results
@@ -65,7 +80,7 @@ gprat_results run_on_data_cpu(const std::string &train_path, const std::string &
 
     // Compute tile sizes and number of predict tiles
     const int tile_size = utils::compute_train_tile_size(n_train, n_tiles);
-    const auto test_tiles = utils::compute_test_tiles(n_test, n_tiles, tile_size);
+    const auto test_tiles = utils::compute_test_tiles(n_test, tile_size);
 
     // hyperparams
     gprat_hyper::AdamParams hpar = { 0.1, 0.9, 0.999, 1e-8, OPT_ITER };
@@ -80,6 +95,8 @@ gprat_results run_on_data_cpu(const std::string &train_path, const std::string &
 
     gprat::GP gp_cpu(
         training_input.data, training_output.data, n_tiles, tile_size, n_reg, { 1.0, 1.0, 0.1 }, trainable);
+    // Always use the tiled algorithms
+    gp_cpu.small_problem_threshold = 0;
 
     // Initialize HPX with no arguments, don't run hpx_main
     utils::start_hpx_runtime(0, nullptr);
@@ -96,7 +113,7 @@ gprat_results run_on_data_cpu(const std::string &train_path, const std::string &
     results_cpu.losses = gp_cpu.optimize(hpar);
 
     // // Sequential version for creating reference
-    // const auto test_total = utils::compute_test_tiles(n_test, 1, n_test);
+    // const auto test_total = utils::compute_test_tiles(n_test, n_test);
     // gprat::GP gp_cpu_seq(
     //     training_input.data, training_output.data, 1, n_train, n_reg, { 1.0, 1.0, 0.1 }, trainable);
     // results_cpu.choleksy = gp_cpu.cholesky();
@@ -122,7 +139,7 @@ gprat_results run_on_data_gpu(const std::string &train_path, const std::string &
     const int n_streams = 1;
 
     const int tile_size = utils::compute_train_tile_size(n_train, n_tiles);
-    const auto test_tiles = utils::compute_test_tiles(n_test, n_tiles, tile_size);
+    const auto test_tiles = utils::compute_test_tiles(n_test, tile_size);
 
     gprat::GP_data training_input(train_path, n_train, n_reg);
     gprat::GP_data training_output(out_path, n_train, n_reg);
@@ -188,6 +205,457 @@ std::string get_root_directory()
     return "../data";
 }
 
+// Sets an environment variable, or removes it for a null value
+void set_environment_variable(const char *name, const char *value)
+{
+#ifdef _WIN32
+    _putenv_s(name, value ? value : "");
+#else
+    if (value)
+    {
+        setenv(name, value, 1);
+    }
+    else
+    {
+        unsetenv(name);
+    }
+#endif
+}
+
+// Training and test data of the data_1024 set shared by the CPU test cases
+struct test_data
+{
+    std::size_t n_reg;
+    gprat::GP_data training_input;
+    gprat::GP_data training_output;
+    gprat::GP_data test_input;
+
+    test_data(std::size_t n_train, std::size_t n_test, std::size_t n_regressors = 8) :
+        n_reg(n_regressors),
+        training_input(get_root_directory() + "/data_1024/training_input.txt", n_train, n_regressors),
+        training_output(get_root_directory() + "/data_1024/training_output.txt", n_train, n_regressors),
+        test_input(get_root_directory() + "/data_1024/test_input.txt", n_test, n_regressors)
+    { }
+
+    // All hyperparameters are trainable. The default small_problem_threshold routes problems
+    // of this size to the contiguous path, so it is disabled to test the tiled algorithms.
+    gprat::GP make_gp(int n_tiles, int tile_size, std::vector<double> kernel_params = { 1.0, 1.0, 0.1 }) const
+    {
+        gprat::GP gp(training_input.data,
+                     training_output.data,
+                     n_tiles,
+                     tile_size,
+                     n_reg,
+                     std::move(kernel_params),
+                     { true, true, true });
+        gp.small_problem_threshold = 0;
+        return gp;
+    }
+};
+
+// Runs the HPX runtime without hpx_main for the lifetime of the guard. The runtime is also
+// stopped if a requirement fails, such that the following test cases can start it again.
+struct hpx_runtime_guard
+{
+    hpx_runtime_guard() { utils::start_hpx_runtime(0, nullptr); }
+
+    ~hpx_runtime_guard() { utils::stop_hpx_runtime(); }
+
+    hpx_runtime_guard(const hpx_runtime_guard &) = delete;
+    hpx_runtime_guard &operator=(const hpx_runtime_guard &) = delete;
+};
+
+TEST_CASE("Tile sizes never leave an empty last tile", "[unit][cpu]")
+{
+    for (int n_samples = 1; n_samples <= 64; ++n_samples)
+    {
+        for (int n_tiles = 1; n_tiles <= n_samples; ++n_tiles)
+        {
+            INFO("Tile size " << n_samples << " " << n_tiles);
+            if (utils::compute_train_tiles(n_samples, (n_samples + n_tiles - 1) / n_tiles) == n_tiles)
+            {
+                const int tile_size = utils::compute_train_tile_size(n_samples, n_tiles);
+                REQUIRE((n_tiles - 1) * tile_size < n_samples);
+                REQUIRE(n_tiles * tile_size >= n_samples);
+            }
+            else
+            {
+                REQUIRE_THROWS_AS(utils::compute_train_tile_size(n_samples, n_tiles), std::invalid_argument);
+            }
+        }
+    }
+    // Rounding up the tile size covers 9 samples with 3 tiles of size 3 and 12 samples with 4 tiles of size 3
+    REQUIRE_THROWS_AS(utils::compute_train_tile_size(9, 4), std::invalid_argument);
+    REQUIRE_THROWS_AS(utils::compute_train_tile_size(12, 5), std::invalid_argument);
+
+    // The test tiles use the training tile size and hold the remainder in the last tile
+    REQUIRE(utils::compute_test_tiles(100, 32) == std::pair<int, int>{ 4, 32 });
+    REQUIRE(utils::compute_test_tiles(16, 32) == std::pair<int, int>{ 1, 16 });
+}
+
+TEST_CASE("Panel chunk sizes amortize the task overhead and keep all workers busy", "[unit][cpu]")
+{
+    const hpx_runtime_guard runtime;
+    const std::size_t n_threads =
+        std::max(std::size_t{ 1 }, static_cast<std::size_t>(hpx::get_num_worker_threads()));
+
+    for (std::size_t n_panel = 0; n_panel <= 256; ++n_panel)
+    {
+        // Tiles with enough work are never fused
+        REQUIRE(cpu::compute_panel_chunk_size(cpu::MIN_TASK_FLOPS, n_panel) == 1);
+        REQUIRE(cpu::compute_panel_chunk_size(4 * cpu::MIN_TASK_FLOPS, n_panel) == 1);
+        for (std::size_t tile_flops = 1; tile_flops < cpu::MIN_TASK_FLOPS; tile_flops *= 3)
+        {
+            INFO("CPU panel chunk " << tile_flops << " " << n_panel);
+            const std::size_t chunk = cpu::compute_panel_chunk_size(tile_flops, n_panel);
+            REQUIRE(chunk >= 1);
+            // No more tiles than required for the minimum work per task
+            REQUIRE(chunk <= (cpu::MIN_TASK_FLOPS + tile_flops - 1) / tile_flops);
+            // At least one chunk per worker thread, or one chunk per tile for short panels
+            if (n_panel > 0)
+            {
+                REQUIRE((n_panel + chunk - 1) / chunk >= std::min(n_panel, n_threads));
+            }
+        }
+    }
+}
+
+TEST_CASE("Multi right-hand side forward solves match separate forward solves", "[unit][cpu]")
+{
+    using Catch::Matchers::WithinAbs;
+    const hpx_runtime_guard runtime;
+    // Large tiles are solved one tile per task, small tiles are fused into column chunks
+    for (const auto &[N, M] : std::vector<std::pair<int, int>>{ { 16, 8 }, { 4, 3 } })
+    {
+        INFO("CPU multi right-hand side tile sizes " << N << " " << M);
+        // Neither dimension is divisible by the tile size
+        const std::size_t n_total = 70;
+        const std::size_t m_total = 93;
+        const std::size_t n_tiles = (n_total + static_cast<std::size_t>(N) - 1) / static_cast<std::size_t>(N);
+        const std::size_t m_tiles = (m_total + static_cast<std::size_t>(M) - 1) / static_cast<std::size_t>(M);
+        const auto tile_rows = [&](std::size_t k, int size, std::size_t total)
+        { return std::min(static_cast<std::size_t>(size), total - k * static_cast<std::size_t>(size)); };
+        // Diagonally dominant lower triangular factor and deterministic right-hand sides
+        const auto value = [](std::size_t i, std::size_t j)
+        { return std::sin(static_cast<double>(3 * i + 7 * j + 1)); };
+
+        Tiled_matrix_t<double> L_tiles(n_tiles * n_tiles);
+        for (std::size_t r = 0; r < n_tiles; r++)
+        {
+            for (std::size_t c = 0; c < n_tiles; c++)
+            {
+                const std::size_t rows = tile_rows(r, N, n_total);
+                const std::size_t cols = tile_rows(c, N, n_total);
+                std::vector<double> tile(rows * cols, 0.0);
+                for (std::size_t i = 0; i < rows; i++)
+                {
+                    for (std::size_t j = 0; j < cols; j++)
+                    {
+                        const std::size_t row = r * static_cast<std::size_t>(N) + i;
+                        const std::size_t col = c * static_cast<std::size_t>(N) + j;
+                        tile[i * cols + j] = row == col ? 4.0 : (row > col ? 0.5 * value(row, col) : 0.0);
+                    }
+                }
+                L_tiles[r * n_tiles + c] = hpx::make_ready_future(std::move(tile));
+            }
+        }
+        Tiled_vector_t<double> a_tiles(n_tiles);
+        Tiled_matrix_t<double> A_tiles(n_tiles * m_tiles);
+        for (std::size_t r = 0; r < n_tiles; r++)
+        {
+            const std::size_t rows = tile_rows(r, N, n_total);
+            std::vector<double> a(rows);
+            for (std::size_t i = 0; i < rows; i++)
+            {
+                a[i] = value(r * static_cast<std::size_t>(N) + i, m_total);
+            }
+            a_tiles[r] = hpx::make_ready_future(std::move(a));
+            for (std::size_t c = 0; c < m_tiles; c++)
+            {
+                const std::size_t cols = tile_rows(c, M, m_total);
+                std::vector<double> tile(rows * cols);
+                for (std::size_t i = 0; i < rows; i++)
+                {
+                    for (std::size_t j = 0; j < cols; j++)
+                    {
+                        tile[i * cols + j] =
+                            value(r * static_cast<std::size_t>(N) + i, c * static_cast<std::size_t>(M) + j);
+                    }
+                }
+                A_tiles[r * m_tiles + c] = hpx::make_ready_future(std::move(tile));
+            }
+        }
+
+        Tiled_vector_t<double> x_tiles = a_tiles;
+        Tiled_matrix_t<double> X_tiles = A_tiles;
+        cpu::forward_solve_tiled(L_tiles, x_tiles, N, n_tiles, n_total);
+        cpu::forward_solve_tiled_matrix(L_tiles, X_tiles, N, M, n_tiles, m_tiles, n_total, m_total);
+        Tiled_vector_t<double> x_multi_tiles = a_tiles;
+        Tiled_matrix_t<double> X_multi_tiles = A_tiles;
+        cpu::forward_solve_tiled_multi_rhs(L_tiles, x_multi_tiles, X_multi_tiles, N, n_tiles, m_tiles, n_total);
+
+        for (std::size_t r = 0; r < n_tiles; r++)
+        {
+            const auto &x = x_tiles[r].get();
+            const auto &x_multi = x_multi_tiles[r].get();
+            REQUIRE(x_multi.size() == x.size());
+            for (std::size_t i = 0; i < x.size(); i++)
+            {
+                REQUIRE_THAT(x_multi[i], WithinAbs(x[i], 1e-12));
+            }
+            for (std::size_t c = 0; c < m_tiles; c++)
+            {
+                const auto &X = X_tiles[r * m_tiles + c].get();
+                const auto &X_multi = X_multi_tiles[r * m_tiles + c].get();
+                REQUIRE(X_multi.size() == X.size());
+                for (std::size_t i = 0; i < X.size(); i++)
+                {
+                    REQUIRE_THAT(X_multi[i], WithinAbs(X[i], 1e-12));
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Posterior covariance updates only the lower triangle", "[unit][cpu]")
+{
+    using Catch::Matchers::WithinAbs;
+    const hpx_runtime_guard runtime;
+    // Neither dimension is divisible by the tile size
+    const int N = 16;
+    const int M = 12;
+    const std::size_t n_total = 40;
+    const std::size_t m_total = 30;
+    const std::size_t n_tiles = 3;
+    const std::size_t m_tiles = 3;
+    const auto tile_rows = [](std::size_t k, int size, std::size_t total)
+    { return std::min(static_cast<std::size_t>(size), total - k * static_cast<std::size_t>(size)); };
+    const auto V = [](std::size_t i, std::size_t j) { return std::sin(static_cast<double>(5 * i + 3 * j + 2)); };
+    const auto prior = [](std::size_t i, std::size_t j)
+    { return std::exp(-0.1 * std::abs(static_cast<double>(i) - static_cast<double>(j))); };
+
+    Tiled_matrix_t<double> V_tiles(n_tiles * m_tiles);
+    for (std::size_t r = 0; r < n_tiles; r++)
+    {
+        for (std::size_t c = 0; c < m_tiles; c++)
+        {
+            const std::size_t rows = tile_rows(r, N, n_total);
+            const std::size_t cols = tile_rows(c, M, m_total);
+            std::vector<double> tile(rows * cols);
+            for (std::size_t i = 0; i < rows; i++)
+            {
+                for (std::size_t j = 0; j < cols; j++)
+                {
+                    tile[i * cols + j] = V(r * static_cast<std::size_t>(N) + i, c * static_cast<std::size_t>(M) + j);
+                }
+            }
+            V_tiles[r * m_tiles + c] = hpx::make_ready_future(std::move(tile));
+        }
+    }
+    // Only the lower tiles of the prior covariance exist, the upper triangles of the diagonal tiles are poisoned
+    Tiled_matrix_t<double> Sigma_tiles(m_tiles * m_tiles);
+    for (std::size_t r = 0; r < m_tiles; r++)
+    {
+        for (std::size_t c = 0; c <= r; c++)
+        {
+            const std::size_t rows = tile_rows(r, M, m_total);
+            const std::size_t cols = tile_rows(c, M, m_total);
+            std::vector<double> tile(rows * cols);
+            for (std::size_t i = 0; i < rows; i++)
+            {
+                for (std::size_t j = 0; j < cols; j++)
+                {
+                    tile[i * cols + j] = r == c && j > i ? std::numeric_limits<double>::quiet_NaN()
+                                                         : prior(r * static_cast<std::size_t>(M) + i,
+                                                                 c * static_cast<std::size_t>(M) + j);
+                }
+            }
+            Sigma_tiles[r * m_tiles + c] = hpx::make_ready_future(std::move(tile));
+        }
+    }
+
+    cpu::symmetric_matrix_matrix_tiled(V_tiles, Sigma_tiles, N, M, n_tiles, m_tiles, n_total, m_total);
+
+    // Dense reference Sigma = prior(K) - V^T * V
+    const auto reference = [&](std::size_t i, std::size_t j)
+    {
+        double sigma = prior(i, j);
+        for (std::size_t l = 0; l < n_total; l++)
+        {
+            sigma -= V(l, i) * V(l, j);
+        }
+        return sigma;
+    };
+    for (std::size_t r = 0; r < m_tiles; r++)
+    {
+        for (std::size_t c = 0; c < m_tiles; c++)
+        {
+            INFO("CPU posterior covariance tile " << r << " " << c);
+            if (c > r)
+            {
+                // Upper tiles are never assigned
+                REQUIRE_FALSE(Sigma_tiles[r * m_tiles + c].valid());
+                continue;
+            }
+            const auto &tile = Sigma_tiles[r * m_tiles + c].get();
+            const std::size_t rows = tile_rows(r, M, m_total);
+            const std::size_t cols = tile_rows(c, M, m_total);
+            REQUIRE(tile.size() == rows * cols);
+            for (std::size_t i = 0; i < rows; i++)
+            {
+                for (std::size_t j = 0; j < cols; j++)
+                {
+                    const std::size_t row = r * static_cast<std::size_t>(M) + i;
+                    const std::size_t col = c * static_cast<std::size_t>(M) + j;
+                    if (row < col)
+                    {
+                        // The upper triangles of the diagonal tiles are neither read nor written
+                        REQUIRE(std::isnan(tile[i * cols + j]));
+                    }
+                    else
+                    {
+                        // The lower triangle holds the symmetric covariance
+                        REQUIRE_THAT(tile[i * cols + j], WithinAbs(reference(row, col), 1e-12));
+                        REQUIRE_THAT(tile[i * cols + j], WithinAbs(reference(col, row), 1e-12));
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("BLAS threads of critical path kernels do not oversubscribe the workers", "[unit][cpu]")
+{
+    const hpx_runtime_guard runtime;
+    const std::size_t n_threads =
+        std::max(std::size_t{ 1 }, static_cast<std::size_t>(hpx::get_num_worker_threads()));
+
+#ifdef GPRAT_ENABLE_HYBRID_BLAS
+    // Only potrf_threaded uses more than one oneMKL thread on the worker threads
+    REQUIRE(hpx::async([]() { return mkl_get_max_threads(); }).get() == 1);
+#endif
+    REQUIRE(cpu::compute_blas_threads(0) == static_cast<int>(n_threads));
+    for (std::size_t n_concurrent = 0; n_concurrent <= 2 * n_threads; ++n_concurrent)
+    {
+        INFO("CPU BLAS threads " << n_concurrent);
+        const std::size_t n_blas = static_cast<std::size_t>(cpu::compute_blas_threads(n_concurrent));
+        REQUIRE(n_blas >= 1);
+        // The concurrent single-threaded tasks and the BLAS threads fit on the workers
+        REQUIRE(std::min(n_concurrent, n_threads - 1) + n_blas <= n_threads);
+    }
+}
+
+TEST_CASE("GP CPU Cholesky factors with multi-threaded critical path kernels match", "[integration][cpu]")
+{
+    const std::size_t n_train = 128;
+
+    // One tile runs potrf_threaded with all BLAS threads, four tiles share them with the updates
+    const test_data data(n_train, 0);
+    gprat::GP gp_single = data.make_gp(1, static_cast<int>(n_train));
+    gprat::GP gp_tiled = data.make_gp(4, 32);
+    gprat::GP gp_contiguous = data.make_gp(4, 32);
+    gp_contiguous.small_problem_threshold = static_cast<int>(n_train);
+    const hpx_runtime_guard runtime;
+
+    const auto single_factor = gp_single.cholesky();
+    const auto tiled_factor = gp_tiled.cholesky();
+    const double tiled_loss = gp_tiled.calculate_loss();
+    const double contiguous_loss = gp_contiguous.calculate_loss();
+
+    using Catch::Matchers::WithinAbs;
+    const double tol = 1e-12;
+    REQUIRE_THAT(tiled_loss, WithinAbs(contiguous_loss, tol));
+    // The factors are returned as row-major tiles
+    const std::size_t tile_size = 32;
+    for (std::size_t i = 0; i != n_train; ++i)
+    {
+        for (std::size_t j = 0; j <= i; ++j)
+        {
+            INFO("CPU threaded Cholesky " << i << " " << j);
+            const double tiled_entry =
+                tiled_factor[(i / tile_size) * 4 + j / tile_size][(i % tile_size) * tile_size + j % tile_size];
+            REQUIRE_THAT(tiled_entry, WithinAbs(single_factor[0][i * n_train + j], tol));
+        }
+    }
+}
+
+TEST_CASE("Tile size tuning reads and appends the cache file", "[unit][cpu]")
+{
+    const std::string cache_path = (std::filesystem::temp_directory_path() / "gprat_test_tile_sizes.txt").string();
+    std::filesystem::remove(cache_path);
+    const hpx_runtime_guard runtime;
+    const std::size_t n_threads = hpx::get_num_worker_threads();
+
+    // The calibrations never select a tile size that is not a power of two
+    std::ofstream(cache_path) << "cholesky 64 8 " << n_threads << " 48\n";
+    REQUIRE(gprat::tune_tile_size(gprat::TiledOperation::Cholesky, 100, 8, cache_path) == 48);
+
+    // Uncached problem sizes are calibrated once and appended
+    const int tile_size = gprat::tune_tile_size(gprat::TiledOperation::Predict, 128, 8, cache_path);
+    REQUIRE(tile_size >= 32);
+    REQUIRE(tile_size <= 128);
+    std::vector<std::string> entries;
+    {
+        std::ifstream cache(cache_path);
+        for (std::string line; std::getline(cache, line);)
+        {
+            entries.push_back(line);
+        }
+    }
+    REQUIRE(entries.size() == 2);
+    REQUIRE(entries[1] == "predict 128 8 " + std::to_string(n_threads) + " " + std::to_string(tile_size));
+    REQUIRE(gprat::tune_tile_size(gprat::TiledOperation::Predict, 128, 8, cache_path) == tile_size);
+
+    // Later entries override earlier ones
+    std::ofstream(cache_path, std::ios::app) << "predict 128 8 " << n_threads << " 80\n";
+    REQUIRE(gprat::tune_tile_size(gprat::TiledOperation::Predict, 128, 8, cache_path) == 80);
+
+    // Entries are separate per number of regressors
+    std::ofstream(cache_path, std::ios::app) << "predict 128 4 " << n_threads << " 64\n";
+    REQUIRE(gprat::tune_tile_size(gprat::TiledOperation::Predict, 128, 4, cache_path) == 64);
+    REQUIRE(gprat::tune_tile_size(gprat::TiledOperation::Predict, 128, 8, cache_path) == 80);
+
+    // Extrapolated tile sizes are bounded, the number of tiles of the calibration would give tiles of 125000
+    const int n_large = 1000000;
+    const int max_tile_size = std::min(2048, (n_large + static_cast<int>(n_threads) - 1) / static_cast<int>(n_threads));
+    std::ofstream(cache_path, std::ios::app) << "optimize 4096 8 " << n_threads << " 512\n"
+                                             << "optimize 2048 8 " << n_threads << " 256\n";
+    REQUIRE(gprat::tune_tile_size(gprat::TiledOperation::Optimize, n_large, 8, cache_path) == max_tile_size);
+    // Tile sizes that do not grow with the calibration size are kept
+    std::ofstream(cache_path, std::ios::app) << "cholesky 4096 8 " << n_threads << " 256\n"
+                                             << "cholesky 2048 8 " << n_threads << " 256\n";
+    REQUIRE(gprat::tune_tile_size(gprat::TiledOperation::Cholesky, n_large, 8, cache_path)
+            == std::min(256, max_tile_size));
+    std::filesystem::remove(cache_path);
+}
+
+TEST_CASE("GP CPU tuned tiles use the tile size cache of GPRAT_TILE_CACHE", "[integration][cpu]")
+{
+    const std::size_t n_train = 100;
+    const std::string cache_path = (std::filesystem::temp_directory_path() / "gprat_test_env_tiles.txt").string();
+    const char *previous_cache = std::getenv("GPRAT_TILE_CACHE");
+    const std::string previous_path = previous_cache ? previous_cache : "";
+    set_environment_variable("GPRAT_TILE_CACHE", cache_path.c_str());
+
+    const test_data data(n_train, 0);
+    gprat::GP gp(
+        data.training_input.data, data.training_output.data, data.n_reg, { 1.0, 1.0, 0.1 }, { true, true, true });
+    gp.small_problem_threshold = 0;
+    const hpx_runtime_guard runtime;
+
+    // 100 samples are calibrated on 64 samples
+    std::ofstream(cache_path) << "cholesky 64 " << data.n_reg << ' ' << hpx::get_num_worker_threads() << " 48\n";
+    const std::string default_path = gprat::default_tile_cache_path();
+    const auto tiles = gp.get_train_tiles(gprat::TiledOperation::Cholesky);
+
+    std::filesystem::remove(cache_path);
+    set_environment_variable("GPRAT_TILE_CACHE", previous_cache ? previous_path.c_str() : nullptr);
+    REQUIRE(default_path == cache_path);
+    // The last tile contains the remainder
+    REQUIRE(tiles.first == 3);
+    REQUIRE(tiles.second == 48);
+}
+
 TEST_CASE("GP CPU results match known-good values", "[integration][cpu]")
 {
     const std::string root = get_root_directory();
@@ -247,6 +715,1024 @@ TEST_CASE("GP CPU results match known-good values", "[integration][cpu]")
     }
 }
 
+TEST_CASE("GP CPU small-problem fast path matches tiled results", "[integration][cpu]")
+{
+    const std::size_t n_test = 128;
+    const std::size_t n_train = 128;
+    const std::size_t n_tiles = 4;
+
+    const int tile_size = utils::compute_train_tile_size(n_train, n_tiles);
+    const auto test_tiles = utils::compute_test_tiles(n_test, tile_size);
+    const test_data data(n_train, n_test);
+    gprat::GP gp_tiled = data.make_gp(n_tiles, tile_size);
+    gprat::GP gp_contiguous = data.make_gp(n_tiles, tile_size);
+    gp_contiguous.small_problem_threshold = static_cast<int>(n_train);
+    const hpx_runtime_guard runtime;
+
+    const auto &test_input = data.test_input.data;
+    const auto tiled_sum = gp_tiled.predict_with_uncertainty(test_input, test_tiles.first, test_tiles.second);
+    const auto contiguous_sum = gp_contiguous.predict_with_uncertainty(test_input, test_tiles.first, test_tiles.second);
+    const auto tiled_full = gp_tiled.predict_with_full_cov(test_input, test_tiles.first, test_tiles.second);
+    const auto contiguous_full = gp_contiguous.predict_with_full_cov(test_input, test_tiles.first, test_tiles.second);
+    const auto tiled_pred = gp_tiled.predict(test_input, test_tiles.first, test_tiles.second);
+    const auto contiguous_pred = gp_contiguous.predict(test_input, test_tiles.first, test_tiles.second);
+    const double tiled_loss = gp_tiled.calculate_loss();
+    const double contiguous_loss = gp_contiguous.calculate_loss();
+
+    using Catch::Matchers::WithinRel;
+    double eps = std::numeric_limits<double>::epsilon() * 1'000'000;
+    for (std::size_t i = 0, n = tiled_sum.size(); i != n; ++i)
+    {
+        for (std::size_t j = 0, m = tiled_sum[i].size(); j != m; ++j)
+        {
+            INFO("CPU fast path sum " << i << " " << j);
+            REQUIRE_THAT(contiguous_sum[i][j], WithinRel(tiled_sum[i][j], eps));
+        }
+    }
+
+    for (std::size_t i = 0, n = tiled_full.size(); i != n; ++i)
+    {
+        for (std::size_t j = 0, m = tiled_full[i].size(); j != m; ++j)
+        {
+            INFO("CPU fast path full " << i << " " << j);
+            REQUIRE_THAT(contiguous_full[i][j], WithinRel(tiled_full[i][j], eps));
+        }
+    }
+
+    for (std::size_t i = 0, n = tiled_pred.size(); i != n; ++i)
+    {
+        INFO("CPU fast path pred " << i);
+        REQUIRE_THAT(contiguous_pred[i], WithinRel(tiled_pred[i], eps));
+    }
+
+    REQUIRE_THAT(contiguous_loss, WithinRel(tiled_loss, eps));
+}
+
+TEST_CASE("GP CPU tiled results with smaller last tile match contiguous results", "[integration][cpu]")
+{
+    // Neither sample count is divisible by the tile size
+    const std::size_t n_test = 100;
+    const std::size_t n_train = 120;
+    const int tile_size = 32;
+
+    const int n_tiles = utils::compute_train_tiles(n_train, tile_size);
+    const auto test_tiles = utils::compute_test_tiles(n_test, tile_size);
+    REQUIRE(n_tiles == 4);
+    REQUIRE(test_tiles.first == 4);
+    REQUIRE(test_tiles.second == tile_size);
+    const test_data data(n_train, n_test);
+    gprat::GP gp_tiled = data.make_gp(n_tiles, tile_size);
+    gprat::GP gp_contiguous = data.make_gp(n_tiles, tile_size);
+    gp_contiguous.small_problem_threshold = static_cast<int>(n_train);
+    const hpx_runtime_guard runtime;
+
+    const auto &test_input = data.test_input.data;
+    const auto tiled_full = gp_tiled.predict_with_full_cov(test_input, test_tiles.first, test_tiles.second);
+    const auto contiguous_full = gp_contiguous.predict_with_full_cov(test_input, test_tiles.first, test_tiles.second);
+    const auto tiled_sum = gp_tiled.predict_with_uncertainty(test_input, test_tiles.first, test_tiles.second);
+    const double tiled_loss = gp_tiled.calculate_loss();
+    const double contiguous_loss = gp_contiguous.calculate_loss();
+
+    using Catch::Matchers::WithinRel;
+    double eps = std::numeric_limits<double>::epsilon() * 1'000'000;
+    for (std::size_t i = 0, n = tiled_full.size(); i != n; ++i)
+    {
+        REQUIRE(tiled_full[i].size() == n_test);
+        for (std::size_t j = 0; j != n_test; ++j)
+        {
+            INFO("CPU ragged tiles full " << i << " " << j);
+            REQUIRE_THAT(tiled_full[i][j], WithinRel(contiguous_full[i][j], eps));
+            REQUIRE_THAT(tiled_sum[i][j], WithinRel(contiguous_full[i][j], eps));
+            // The diagonal of the lower triangle SYRK covariance is the variance
+            REQUIRE_THAT(tiled_full[i][j], WithinRel(tiled_sum[i][j], eps));
+        }
+    }
+
+    REQUIRE_THAT(tiled_loss, WithinRel(contiguous_loss, eps));
+}
+
+TEST_CASE("GP CPU contiguous uncertainty without transposition matches the tiled results", "[integration][cpu]")
+{
+    // Different training and test sizes, such that swapped dimensions of cross(K)^T cannot go unnoticed
+    const std::size_t n_test = 40;
+    const std::size_t n_train = 96;
+    const int tile_size = 32;
+
+    const int n_tiles = utils::compute_train_tiles(n_train, tile_size);
+    const auto test_tiles = utils::compute_test_tiles(n_test, tile_size);
+    const test_data data(n_train, n_test);
+    gprat::GP gp_tiled = data.make_gp(n_tiles, tile_size);
+    gprat::GP gp_contiguous = data.make_gp(n_tiles, tile_size);
+    gp_contiguous.small_problem_threshold = static_cast<int>(n_train);
+    const hpx_runtime_guard runtime;
+
+    const auto &test_input = data.test_input.data;
+    const auto tiled_sum = gp_tiled.predict_with_uncertainty(test_input, test_tiles.first, test_tiles.second);
+    const auto contiguous_sum = gp_contiguous.predict_with_uncertainty(test_input, test_tiles.first, test_tiles.second);
+    const auto contiguous_full = gp_contiguous.predict_with_full_cov(test_input, test_tiles.first, test_tiles.second);
+    const auto contiguous_pred = gp_contiguous.predict(test_input, test_tiles.first, test_tiles.second);
+
+    using Catch::Matchers::WithinRel;
+    double eps = std::numeric_limits<double>::epsilon() * 1'000'000;
+    REQUIRE(contiguous_sum.size() == 2);
+    REQUIRE(contiguous_full.size() == 2);
+    for (std::size_t i = 0; i != 2; ++i)
+    {
+        REQUIRE(contiguous_sum[i].size() == n_test);
+        REQUIRE(contiguous_full[i].size() == n_test);
+        for (std::size_t j = 0; j != n_test; ++j)
+        {
+            INFO("CPU contiguous uncertainty " << i << " " << j);
+            REQUIRE_THAT(contiguous_sum[i][j], WithinRel(tiled_sum[i][j], eps));
+            REQUIRE_THAT(contiguous_full[i][j], WithinRel(tiled_sum[i][j], eps));
+        }
+    }
+    for (std::size_t j = 0; j != n_test; ++j)
+    {
+        INFO("CPU contiguous uncertainty pred " << j);
+        REQUIRE_THAT(contiguous_pred[j], WithinRel(tiled_sum[0][j], eps));
+    }
+}
+
+TEST_CASE("GP CPU single precision predictions match double precision", "[integration][cpu]")
+{
+    const std::size_t n_test = 128;
+    const std::size_t n_train = 128;
+    const std::size_t n_tiles = 4;
+
+    const int tile_size = utils::compute_train_tile_size(n_train, n_tiles);
+    const auto test_tiles = utils::compute_test_tiles(n_test, tile_size);
+    const test_data data(n_train, n_test);
+    gprat::GP gp = data.make_gp(n_tiles, tile_size);
+    const hpx_runtime_guard runtime;
+
+    const auto &test_input = data.test_input.data;
+    const auto fp64_sum = gp.predict_with_uncertainty(test_input, test_tiles.first, test_tiles.second);
+    gp.precision = gprat::Precision::FP32;
+    const auto fp32_sum = gp.predict_with_uncertainty(test_input, test_tiles.first, test_tiles.second);
+    const auto fp32_full = gp.predict_with_full_cov(test_input, test_tiles.first, test_tiles.second);
+    const auto fp32_pred = gp.predict(test_input, test_tiles.first, test_tiles.second);
+
+    using Catch::Matchers::WithinAbs;
+    // Single precision Cholesky factor of a covariance matrix with noise variance 0.1
+    const double tol = 1e-4;
+    for (std::size_t i = 0, n = fp64_sum.size(); i != n; ++i)
+    {
+        REQUIRE(fp32_sum[i].size() == n_test);
+        for (std::size_t j = 0; j != n_test; ++j)
+        {
+            INFO("CPU FP32 " << i << " " << j);
+            REQUIRE_THAT(fp32_sum[i][j], WithinAbs(fp64_sum[i][j], tol));
+            REQUIRE_THAT(fp32_full[i][j], WithinAbs(fp64_sum[i][j], tol));
+        }
+    }
+
+    for (std::size_t i = 0; i != n_test; ++i)
+    {
+        INFO("CPU FP32 pred " << i);
+        REQUIRE_THAT(fp32_pred[i], WithinAbs(fp64_sum[0][i], tol));
+    }
+}
+
+TEST_CASE("GP CPU mixed precision predictions match double precision", "[integration][cpu]")
+{
+    const std::size_t n_test = 128;
+    const std::size_t n_train = 128;
+    const std::size_t n_tiles = 4;
+
+    const int tile_size = utils::compute_train_tile_size(n_train, n_tiles);
+    const auto test_tiles = utils::compute_test_tiles(n_test, tile_size);
+    const test_data data(n_train, n_test);
+    gprat::GP gp = data.make_gp(n_tiles, tile_size);
+    const hpx_runtime_guard runtime;
+
+    const auto &test_input = data.test_input.data;
+    const auto fp64_pred = gp.predict(test_input, test_tiles.first, test_tiles.second);
+    gp.precision = gprat::Precision::Mixed;
+    const auto mixed_pred = gp.predict(test_input, test_tiles.first, test_tiles.second);
+    const auto report = gp.get_refinement_report();
+
+    // The refinement must reach FP64 accuracy without falling back to FP64
+    REQUIRE(report.converged);
+    REQUIRE_FALSE(report.fallback);
+
+    using Catch::Matchers::WithinAbs;
+    const double tol = 1e-12;
+    REQUIRE(mixed_pred.size() == n_test);
+    for (std::size_t i = 0; i != n_test; ++i)
+    {
+        INFO("CPU mixed pred " << i);
+        REQUIRE_THAT(mixed_pred[i], WithinAbs(fp64_pred[i], tol));
+    }
+}
+
+TEST_CASE("GP CPU predictions with FP32 cross-covariance storage match FP64 storage", "[integration][cpu]")
+{
+    const std::size_t n_test = 128;
+    const std::size_t n_train = 128;
+    const std::size_t n_tiles = 4;
+
+    const int tile_size = utils::compute_train_tile_size(n_train, n_tiles);
+    const auto test_tiles = utils::compute_test_tiles(n_test, tile_size);
+    const test_data data(n_train, n_test);
+    gprat::GP gp = data.make_gp(n_tiles, tile_size);
+    const hpx_runtime_guard runtime;
+
+    const auto &test_input = data.test_input.data;
+    const auto fp64_sum = gp.predict_with_uncertainty(test_input, test_tiles.first, test_tiles.second);
+    gp.cross_covariance_storage = gprat::StoragePrecision::FP32;
+    const auto stored_sum = gp.predict_with_uncertainty(test_input, test_tiles.first, test_tiles.second);
+    const auto stored_full = gp.predict_with_full_cov(test_input, test_tiles.first, test_tiles.second);
+
+    using Catch::Matchers::WithinAbs;
+    // Rounding the cross-covariance to FP32 bounds the error, the solves accumulate in FP64
+    const double tol = 1e-5;
+    for (std::size_t i = 0, n = fp64_sum.size(); i != n; ++i)
+    {
+        REQUIRE(stored_sum[i].size() == n_test);
+        for (std::size_t j = 0; j != n_test; ++j)
+        {
+            INFO("CPU FP32 storage " << i << " " << j);
+            REQUIRE_THAT(stored_sum[i][j], WithinAbs(fp64_sum[i][j], tol));
+            REQUIRE_THAT(stored_full[i][j], WithinAbs(fp64_sum[i][j], tol));
+        }
+    }
+}
+
+TEST_CASE("GP CPU streaming predictions with uncertainty match the tiled predictions", "[integration][cpu]")
+{
+    const std::size_t n_test = 100;
+    const std::size_t n_train = 128;
+    const std::size_t n_tiles = 4;
+
+    const int tile_size = utils::compute_train_tile_size(n_train, n_tiles);
+    const auto test_tiles = utils::compute_test_tiles(n_test, tile_size);
+    const test_data data(n_train, n_test);
+    gprat::GP gp = data.make_gp(n_tiles, tile_size);
+    const hpx_runtime_guard runtime;
+
+    const auto &test_input = data.test_input.data;
+    const auto tiled_sum = gp.predict_with_uncertainty(test_input, test_tiles.first, test_tiles.second);
+    const auto streamed_sum = gp.predict_with_uncertainty_streaming(test_input, test_tiles.first, test_tiles.second);
+
+    using Catch::Matchers::WithinAbs;
+    const double tol = 1e-12;
+    for (std::size_t i = 0, n = tiled_sum.size(); i != n; ++i)
+    {
+        REQUIRE(streamed_sum[i].size() == n_test);
+        for (std::size_t j = 0; j != n_test; ++j)
+        {
+            INFO("CPU streaming " << i << " " << j);
+            REQUIRE_THAT(streamed_sum[i][j], WithinAbs(tiled_sum[i][j], tol));
+        }
+    }
+}
+
+TEST_CASE("GP CPU chunked predictions match the tiled predictions", "[integration][cpu]")
+{
+    const std::size_t n_test = 100;
+    const std::size_t n_train = 128;
+    const std::size_t n_tiles = 4;
+    const std::size_t chunk_size = 30;
+
+    const int tile_size = utils::compute_train_tile_size(n_train, n_tiles);
+    const auto test_tiles = utils::compute_test_tiles(n_test, tile_size);
+    const test_data data(n_train, n_test);
+    gprat::GP gp = data.make_gp(n_tiles, tile_size);
+    const auto &test_input = data.test_input.data;
+
+    // Each chunk repeats the n_reg - 1 leading entries of its lagged features
+    std::size_t chunk_begin = 0;
+    const auto next_test_chunk = [&]()
+    {
+        if (chunk_begin == n_test)
+        {
+            return std::vector<double>{};
+        }
+        const std::size_t chunk_end = std::min(chunk_begin + chunk_size, n_test);
+        std::vector<double> chunk(test_input.begin() + static_cast<std::ptrdiff_t>(chunk_begin),
+                                  test_input.begin() + static_cast<std::ptrdiff_t>(chunk_end + data.n_reg - 1));
+        chunk_begin = chunk_end;
+        return chunk;
+    };
+    std::vector<std::vector<double>> chunked_sum(2);
+    const auto consume_chunk = [&](std::vector<double> prediction, std::vector<double> uncertainty)
+    {
+        chunked_sum[0].insert(chunked_sum[0].end(), prediction.begin(), prediction.end());
+        chunked_sum[1].insert(chunked_sum[1].end(), uncertainty.begin(), uncertainty.end());
+    };
+    const hpx_runtime_guard runtime;
+
+    const auto tiled_sum = gp.predict_with_uncertainty(test_input, test_tiles.first, test_tiles.second);
+    const std::size_t n_chunks = gp.predict_chunked(next_test_chunk, consume_chunk, true);
+
+    REQUIRE(n_chunks == (n_test + chunk_size - 1) / chunk_size);
+    using Catch::Matchers::WithinAbs;
+    const double tol = 1e-12;
+    for (std::size_t i = 0, n = tiled_sum.size(); i != n; ++i)
+    {
+        REQUIRE(chunked_sum[i].size() == n_test);
+        for (std::size_t j = 0; j != n_test; ++j)
+        {
+            INFO("CPU chunked " << i << " " << j);
+            REQUIRE_THAT(chunked_sum[i][j], WithinAbs(tiled_sum[i][j], tol));
+        }
+    }
+
+    // A chunk without a complete sample is rejected
+    bool short_chunk_sent = false;
+    const auto next_short_chunk = [&]()
+    {
+        if (short_chunk_sent)
+        {
+            return std::vector<double>{};
+        }
+        short_chunk_sent = true;
+        return std::vector<double>(data.n_reg - 1, 0.0);
+    };
+    REQUIRE_THROWS_AS(gp.predict_chunked(next_short_chunk, consume_chunk, true), std::invalid_argument);
+}
+
+TEST_CASE("GP CPU inline point predictions match the tiled predictions", "[integration][cpu]")
+{
+    const std::size_t n_test = 64;
+    const std::size_t n_train = 128;
+    const std::size_t n_tiles = 4;
+
+    const int tile_size = utils::compute_train_tile_size(n_train, n_tiles);
+    const auto test_tiles = utils::compute_test_tiles(n_test, tile_size);
+    const test_data data(n_train, n_test);
+    gprat::GP gp = data.make_gp(n_tiles, tile_size);
+    const hpx_runtime_guard runtime;
+
+    const auto &test_input = data.test_input.data;
+    const auto tiled_sum = gp.predict_with_uncertainty(test_input, test_tiles.first, test_tiles.second);
+    // The factor is computed on first use, the predictions afterwards run inline on this thread
+    const auto batch_pred = gp.predict_small_batch(test_input);
+    std::vector<double> point_pred;
+    std::vector<std::pair<double, double>> point_sum;
+    for (std::size_t i = 0; i != n_test; ++i)
+    {
+        const std::vector<double> features(test_input.begin() + static_cast<std::ptrdiff_t>(i),
+                                           test_input.begin() + static_cast<std::ptrdiff_t>(i + data.n_reg));
+        point_pred.push_back(gp.predict_point(features));
+        point_sum.push_back(gp.predict_point_with_uncertainty(features));
+    }
+
+    using Catch::Matchers::WithinAbs;
+    const double tol = 1e-12;
+    REQUIRE(batch_pred.size() == n_test);
+    for (std::size_t i = 0; i != n_test; ++i)
+    {
+        INFO("CPU point " << i);
+        REQUIRE_THAT(point_pred[i], WithinAbs(tiled_sum[0][i], tol));
+        REQUIRE_THAT(point_sum[i].first, WithinAbs(tiled_sum[0][i], tol));
+        REQUIRE_THAT(point_sum[i].second, WithinAbs(tiled_sum[1][i], tol));
+        REQUIRE_THAT(batch_pred[i], WithinAbs(tiled_sum[0][i], tol));
+    }
+
+    // The cached factor follows the kernel parameters of the optimizer and of direct changes
+    gprat_hyper::AdamParams adam_params(0.1, 0.9, 0.999, 1e-8, 1);
+    gp.optimize_step(adam_params, 0);
+    const auto optimized_pred = gp.predict(test_input, test_tiles.first, test_tiles.second);
+    const auto optimized_batch = gp.predict_small_batch(test_input);
+    gp.kernel_params.lengthscale = 2.0;
+    gp.invalidate_point_prediction_factor();
+    const auto changed_pred = gp.predict(test_input, test_tiles.first, test_tiles.second);
+    const auto changed_batch = gp.predict_small_batch(test_input);
+    for (std::size_t i = 0; i != n_test; ++i)
+    {
+        INFO("CPU point after parameter change " << i);
+        REQUIRE_THAT(optimized_batch[i], WithinAbs(optimized_pred[i], tol));
+        REQUIRE_THAT(changed_batch[i], WithinAbs(changed_pred[i], tol));
+    }
+}
+
+TEST_CASE("GP CPU recursive forecasts match repeated point predictions", "[integration][cpu]")
+{
+    const std::size_t n_train = 128;
+    const std::size_t n_tiles = 4;
+    const std::size_t n_reg = 8;
+    // Several recomputations of the incrementally updated distances
+    const int horizon = 50;
+
+    const int tile_size = utils::compute_train_tile_size(n_train, n_tiles);
+    const test_data data(n_train, n_reg, n_reg);
+    gprat::GP gp = data.make_gp(n_tiles, tile_size);
+    const hpx_runtime_guard runtime;
+
+    // The window holds the most recent outputs
+    const auto &test_input = data.test_input.data;
+    const std::vector<double> window(test_input.end() - static_cast<std::ptrdiff_t>(n_reg), test_input.end());
+    const auto naive = gp.forecast(window, horizon, cpu::ForecastUncertainty::Naive);
+    const auto linearized = gp.forecast(window, horizon, cpu::ForecastUncertainty::Linearized);
+    const auto scenarios = gp.forecast_scenarios({ window, window }, horizon, cpu::ForecastUncertainty::Linearized);
+    // Reference: shift each point prediction into the window by hand
+    std::vector<std::pair<double, double>> reference;
+    std::vector<double> features = window;
+    for (int step = 0; step != horizon; ++step)
+    {
+        reference.push_back(gp.predict_point_with_uncertainty(features));
+        features.erase(features.begin());
+        features.push_back(reference.back().first);
+    }
+
+    using Catch::Matchers::WithinAbs;
+    const double tol = 1e-12;
+    REQUIRE(naive[0].size() == static_cast<std::size_t>(horizon));
+    REQUIRE(scenarios.size() == 2);
+    for (std::size_t i = 0; i != static_cast<std::size_t>(horizon); ++i)
+    {
+        INFO("CPU forecast " << i);
+        REQUIRE_THAT(naive[0][i], WithinAbs(reference[i].first, tol));
+        REQUIRE_THAT(naive[1][i], WithinAbs(reference[i].second, tol));
+        REQUIRE_THAT(linearized[0][i], WithinAbs(reference[i].first, tol));
+        // The propagated variance of the fed back predictions only adds to the uncertainty
+        REQUIRE(linearized[1][i] >= naive[1][i] - tol);
+    }
+    REQUIRE(scenarios[1] == linearized);
+    // The first step only depends on the exact window
+    REQUIRE_THAT(linearized[1][0], WithinAbs(naive[1][0], tol));
+
+    // A spike leaving the window cancels the incremental distance updates, which are recomputed
+    std::vector<double> spiked_window = window;
+    spiked_window.front() = 1e4;
+    const auto spiked = gp.forecast(spiked_window, horizon, cpu::ForecastUncertainty::Naive);
+    features = spiked_window;
+    for (std::size_t i = 0; i != static_cast<std::size_t>(horizon); ++i)
+    {
+        INFO("CPU forecast spiked " << i);
+        const auto point = gp.predict_point_with_uncertainty(features);
+        REQUIRE_THAT(spiked[0][i], WithinAbs(point.first, tol));
+        REQUIRE_THAT(spiked[1][i], WithinAbs(point.second, tol));
+        features.erase(features.begin());
+        features.push_back(point.first);
+    }
+}
+
+TEST_CASE("GP CPU posterior samples match the posterior mean and variance", "[integration][cpu]")
+{
+    const std::size_t n_test = 100;
+    const std::size_t n_train = 128;
+    const std::size_t n_tiles = 4;
+    const int n_samples = 2000;
+
+    const int tile_size = utils::compute_train_tile_size(n_train, n_tiles);
+    const auto test_tiles = utils::compute_test_tiles(n_test, tile_size);
+    const test_data data(n_train, n_test);
+    gprat::GP gp = data.make_gp(n_tiles, tile_size);
+    const hpx_runtime_guard runtime;
+
+    const auto &test_input = data.test_input.data;
+    const auto tiled_sum = gp.predict_with_uncertainty(test_input, test_tiles.first, test_tiles.second);
+    const auto samples = gp.sample_posterior(test_input, test_tiles.first, test_tiles.second, n_samples, 42);
+    const auto repeated_samples = gp.sample_posterior(test_input, test_tiles.first, test_tiles.second, n_samples, 42);
+
+    // Equal seeds result in equal samples
+    REQUIRE(samples == repeated_samples);
+    REQUIRE(samples.size() == static_cast<std::size_t>(n_samples));
+    for (std::size_t j = 0; j != n_test; ++j)
+    {
+        double mean = 0.0;
+        for (const auto &sample : samples)
+        {
+            REQUIRE(sample.size() == n_test);
+            mean += sample[j];
+        }
+        mean /= n_samples;
+        double variance = 0.0;
+        for (const auto &sample : samples)
+        {
+            variance += (sample[j] - mean) * (sample[j] - mean);
+        }
+        variance /= n_samples - 1;
+
+        // Generous bounds of the sampling error of 2000 samples
+        INFO("CPU posterior sample " << j);
+        REQUIRE(std::abs(mean - tiled_sum[0][j]) <= 5.0 * std::sqrt(tiled_sum[1][j] / n_samples));
+        REQUIRE(std::abs(variance - tiled_sum[1][j]) <= 0.25 * tiled_sum[1][j]);
+    }
+}
+
+TEST_CASE("GP CPU sparse approximations with the training inputs as inducing points are exact", "[integration][cpu]")
+{
+    const std::size_t n_test = 100;
+    const std::size_t n_train = 128;
+    const std::size_t n_tiles = 4;
+
+    const int tile_size = utils::compute_train_tile_size(n_train, n_tiles);
+    const auto test_tiles = utils::compute_test_tiles(n_test, tile_size);
+    const test_data data(n_train, n_test);
+    gprat::GP gp = data.make_gp(n_tiles, tile_size);
+    const hpx_runtime_guard runtime;
+
+    // Inducing tiles differ from the training tiles, the last one is smaller
+    const auto &test_input = data.test_input.data;
+    gp.set_inducing_points(data.training_input.data, 3, 48);
+    const auto tiled_sum = gp.predict_with_uncertainty(test_input, test_tiles.first, test_tiles.second);
+    const double loss = gp.calculate_loss();
+    std::vector<std::vector<std::vector<double>>> sparse_sums;
+    std::vector<double> sparse_losses;
+    for (const auto approximation :
+         { cpu::SparseApproximation::DTC, cpu::SparseApproximation::FITC, cpu::SparseApproximation::VFE })
+    {
+        gp.sparse_approximation = approximation;
+        sparse_sums.push_back(gp.predict_sparse_with_uncertainty(test_input, test_tiles.first, test_tiles.second));
+        sparse_losses.push_back(gp.calculate_sparse_loss());
+    }
+    const auto sparse_predictions = gp.predict_sparse(test_input, test_tiles.first, test_tiles.second);
+    const auto sparse_optimization_losses = gp.optimize_sparse(gprat_hyper::AdamParams(0.1, 0.9, 0.999, 1e-8, 5));
+
+    // Q = K up to the jitter of K_mm
+    using Catch::Matchers::WithinAbs;
+    const double tol = 1e-5;
+    for (std::size_t a = 0; a != sparse_sums.size(); ++a)
+    {
+        REQUIRE_THAT(sparse_losses[a], WithinAbs(loss, tol));
+        for (std::size_t i = 0; i != n_test; ++i)
+        {
+            INFO("CPU sparse approximation " << a << " prediction " << i);
+            REQUIRE_THAT(sparse_sums[a][0][i], WithinAbs(tiled_sum[0][i], tol));
+            REQUIRE_THAT(sparse_sums[a][1][i], WithinAbs(tiled_sum[1][i], tol));
+        }
+    }
+    REQUIRE(sparse_predictions == sparse_sums.back()[0]);
+    REQUIRE(sparse_optimization_losses.back() < sparse_optimization_losses.front());
+}
+
+TEST_CASE("GP CPU random feature predictions approximate the tiled predictions", "[integration][cpu]")
+{
+    const std::size_t n_test = 100;
+    const std::size_t n_train = 128;
+    const std::size_t n_tiles = 4;
+
+    const int tile_size = utils::compute_train_tile_size(n_train, n_tiles);
+    const auto test_tiles = utils::compute_test_tiles(n_test, tile_size);
+    const test_data data(n_train, n_test);
+    gprat::GP gp = data.make_gp(n_tiles, tile_size);
+    // The last of the feature tiles is smaller
+    gprat::RandomFeatureGP random_feature_gp(data.training_input.data,
+                                             data.training_output.data,
+                                             n_tiles,
+                                             tile_size,
+                                             data.n_reg,
+                                             { 1.0, 1.0, 0.1 },
+                                             1000,
+                                             3,
+                                             7);
+    const hpx_runtime_guard runtime;
+
+    const auto &test_input = data.test_input.data;
+    const auto tiled_sum = gp.predict_with_uncertainty(test_input, test_tiles.first, test_tiles.second);
+    const auto random_feature_sum =
+        random_feature_gp.predict_with_uncertainty(test_input, test_tiles.first, test_tiles.second);
+    const auto random_feature_predictions = random_feature_gp.predict(test_input, test_tiles.first, test_tiles.second);
+
+    // Monte Carlo error of 1000 features
+    using Catch::Matchers::WithinAbs;
+    REQUIRE(random_feature_predictions == random_feature_sum[0]);
+    for (std::size_t i = 0; i != n_test; ++i)
+    {
+        INFO("CPU random feature prediction " << i);
+        REQUIRE_THAT(random_feature_sum[0][i], WithinAbs(tiled_sum[0][i], 0.05));
+        REQUIRE_THAT(random_feature_sum[1][i], WithinAbs(tiled_sum[1][i], 0.005));
+    }
+
+    // No features, and 4 features in 3 tiles of size 2 leaving the last tile empty
+    const auto make_random_feature_gp = [&](int n_features, int n_feature_tiles)
+    {
+        return gprat::RandomFeatureGP(data.training_input.data,
+                                      data.training_output.data,
+                                      n_tiles,
+                                      tile_size,
+                                      data.n_reg,
+                                      { 1.0, 1.0, 0.1 },
+                                      n_features,
+                                      n_feature_tiles,
+                                      7);
+    };
+    REQUIRE_THROWS_AS(make_random_feature_gp(0, 1), std::invalid_argument);
+    REQUIRE_THROWS_AS(make_random_feature_gp(4, 3), std::invalid_argument);
+}
+
+TEST_CASE("GP CPU Vecchia approximation conditioned on all samples is exact", "[integration][cpu]")
+{
+    const std::size_t n_test = 100;
+    const std::size_t n_train = 128;
+    const std::size_t n_tiles = 3;
+
+    // The last training tile is smaller
+    const int tile_size = utils::compute_train_tile_size(n_train, n_tiles);
+    const auto test_tiles = utils::compute_test_tiles(n_test, tile_size);
+    const test_data data(n_train, n_test);
+    gprat::GP gp = data.make_gp(n_tiles, tile_size);
+    gprat::GP vecchia_gp = data.make_gp(n_tiles, tile_size);
+    vecchia_gp.vecchia_neighbours = static_cast<int>(n_train);
+    const hpx_runtime_guard runtime;
+
+    const auto &test_input = data.test_input.data;
+    const auto tiled_sum = gp.predict_with_uncertainty(test_input, test_tiles.first, test_tiles.second);
+    const double loss = gp.calculate_loss();
+    const auto vecchia_sum =
+        vecchia_gp.predict_vecchia_with_uncertainty(test_input, test_tiles.first, test_tiles.second);
+    const auto vecchia_predictions = vecchia_gp.predict_vecchia(test_input, test_tiles.first, test_tiles.second);
+    const double vecchia_loss = vecchia_gp.calculate_vecchia_loss();
+    const gprat_hyper::AdamParams adam_params(0.1, 0.9, 0.999, 1e-8, 5);
+    const auto optimization_losses = gp.optimize(adam_params);
+    const auto vecchia_optimization_losses = vecchia_gp.optimize_vecchia(adam_params);
+
+    // The conditionals of all earlier samples factorize the exact likelihood
+    using Catch::Matchers::WithinAbs;
+    const double tol = 1e-8;
+    REQUIRE(vecchia_predictions == vecchia_sum[0]);
+    REQUIRE_THAT(vecchia_loss, WithinAbs(loss, tol));
+    for (std::size_t i = 0; i != n_test; ++i)
+    {
+        INFO("CPU Vecchia prediction " << i);
+        REQUIRE_THAT(vecchia_sum[0][i], WithinAbs(tiled_sum[0][i], tol));
+        REQUIRE_THAT(vecchia_sum[1][i], WithinAbs(tiled_sum[1][i], tol));
+    }
+    for (std::size_t i = 0; i != optimization_losses.size(); ++i)
+    {
+        INFO("CPU Vecchia optimization iteration " << i);
+        REQUIRE_THAT(vecchia_optimization_losses[i], WithinAbs(optimization_losses[i], tol));
+    }
+    REQUIRE_THAT(vecchia_gp.kernel_params.lengthscale, WithinAbs(gp.kernel_params.lengthscale, tol));
+    REQUIRE_THAT(vecchia_gp.kernel_params.noise_variance, WithinAbs(gp.kernel_params.noise_variance, tol));
+}
+
+TEST_CASE("GP CPU experts reduce to the exact GP for a single tile", "[integration][cpu]")
+{
+    const std::size_t n_test = 100;
+    const std::size_t n_train = 128;
+
+    const int tile_size = utils::compute_train_tile_size(n_train, 1);
+    const auto test_tiles = utils::compute_test_tiles(n_test, tile_size);
+    const test_data data(n_train, n_test);
+    gprat::GP gp = data.make_gp(1, tile_size);
+    gprat::GP expert_gp = data.make_gp(1, tile_size);
+    // Four experts, the last one is smaller
+    gprat::GP experts_gp = data.make_gp(4, 40);
+    const hpx_runtime_guard runtime;
+
+    const auto &test_input = data.test_input.data;
+    const auto tiled_sum = gp.predict_with_uncertainty(test_input, test_tiles.first, test_tiles.second);
+    const double loss = gp.calculate_loss();
+    std::vector<std::vector<std::vector<double>>> expert_sums;
+    for (const auto aggregation :
+         { cpu::ExpertAggregation::PoE, cpu::ExpertAggregation::gPoE, cpu::ExpertAggregation::BCM })
+    {
+        expert_gp.expert_aggregation = aggregation;
+        expert_sums.push_back(
+            expert_gp.predict_experts_with_uncertainty(test_input, test_tiles.first, test_tiles.second));
+    }
+    const double expert_loss = expert_gp.calculate_experts_loss();
+    const gprat_hyper::AdamParams adam_params(0.1, 0.9, 0.999, 1e-8, 5);
+    const auto optimization_losses = gp.optimize(adam_params);
+    const auto expert_optimization_losses = expert_gp.optimize_experts(adam_params);
+
+    const auto experts_sum = experts_gp.predict_experts_with_uncertainty(test_input, 4, 25);
+    const auto experts_predictions = experts_gp.predict_experts(test_input, 4, 25);
+    const auto experts_optimization_losses = experts_gp.optimize_experts(adam_params);
+
+    // A single expert factorizes the full covariance
+    using Catch::Matchers::WithinAbs;
+    const double tol = 1e-8;
+    REQUIRE_THAT(expert_loss, WithinAbs(loss, tol));
+    for (std::size_t a = 0; a != expert_sums.size(); ++a)
+    {
+        for (std::size_t i = 0; i != n_test; ++i)
+        {
+            INFO("CPU expert aggregation " << a << " prediction " << i);
+            REQUIRE_THAT(expert_sums[a][0][i], WithinAbs(tiled_sum[0][i], tol));
+            REQUIRE_THAT(expert_sums[a][1][i], WithinAbs(tiled_sum[1][i], tol));
+        }
+    }
+    for (std::size_t i = 0; i != optimization_losses.size(); ++i)
+    {
+        INFO("CPU expert optimization iteration " << i);
+        REQUIRE_THAT(expert_optimization_losses[i], WithinAbs(optimization_losses[i], tol));
+    }
+
+    // The robust BCM uncertainties are positive and bounded by the prior variance
+    REQUIRE(experts_predictions == experts_sum[0]);
+    for (std::size_t i = 0; i != n_test; ++i)
+    {
+        INFO("CPU rBCM prediction " << i);
+        REQUIRE(experts_sum[1][i] > 0.0);
+        REQUIRE(experts_sum[1][i] <= 1.0);
+    }
+    REQUIRE(experts_optimization_losses.back() < experts_optimization_losses.front());
+}
+
+TEST_CASE("Adaptive cross approximation stops at the numerical rank of a block", "[unit][cpu]")
+{
+    // A lengthscale far above the spread of the inputs makes the blocks numerically low-rank,
+    // the residuals of the later crosses are rounding errors
+    std::vector<double> input(24);
+    for (std::size_t i = 0; i != input.size(); ++i)
+    {
+        input[i] = 0.05 * static_cast<double>(i);
+    }
+    const gprat_hyper::SEKParams sek_params(100.0, 1.0, 0.1);
+    const std::size_t n_rows = 16;
+    const std::size_t n_cols = 8;
+
+    // Without a tolerance, only pivots above the rounding error of the first pivot add a cross
+    const LowRankTile block =
+        cpu::gen_block_cross_covariance_low_rank(0, n_rows, n_rows, n_cols, 1, sek_params, input, input, 0.0);
+
+    REQUIRE(block.rank < n_cols);
+    using Catch::Matchers::WithinAbs;
+    for (std::size_t i = 0; i != n_rows; ++i)
+    {
+        for (std::size_t j = 0; j != n_cols; ++j)
+        {
+            double entry = 0.0;
+            for (std::size_t l = 0; l != block.rank; ++l)
+            {
+                entry += block.U[i * block.rank + l] * block.V[j * block.rank + l];
+            }
+            const double distance = (input[i] - input[n_rows + j]) / 100.0;
+            INFO("CPU cross approximation " << i << " " << j);
+            REQUIRE_THAT(entry, WithinAbs(std::exp(-0.5 * distance * distance), 1e-12));
+        }
+    }
+}
+
+TEST_CASE("GP CPU block low-rank Cholesky with a tight tolerance is exact", "[integration][cpu]")
+{
+    const std::size_t n_test = 100;
+
+    // Four training tiles, the last one is smaller
+    const test_data data(128, n_test);
+    gprat::GP gp = data.make_gp(4, 35);
+    gp.blr_tolerance = 1e-14;
+    const hpx_runtime_guard runtime;
+
+    const auto &test_input = data.test_input.data;
+    const auto tiled_sum = gp.predict_with_uncertainty(test_input, 4, 25);
+    const double loss = gp.calculate_loss();
+    const auto blr_sum = gp.predict_blr_with_uncertainty(test_input, 4, 25);
+    const auto blr_predictions = gp.predict_blr(test_input, 4, 25);
+    const double blr_loss = gp.calculate_blr_loss();
+    const double tight_compression = gp.calculate_blr_compression();
+    gp.blr_tolerance = 1e-4;
+    const double loose_compression = gp.calculate_blr_compression();
+
+    using Catch::Matchers::WithinAbs;
+    const double tol = 1e-8;
+    REQUIRE_THAT(blr_loss, WithinAbs(loss, tol));
+    for (std::size_t i = 0; i != n_test; ++i)
+    {
+        INFO("CPU block low-rank prediction " << i);
+        REQUIRE_THAT(blr_sum[0][i], WithinAbs(tiled_sum[0][i], tol));
+        REQUIRE_THAT(blr_sum[1][i], WithinAbs(tiled_sum[1][i], tol));
+        REQUIRE_THAT(blr_predictions[i], WithinAbs(tiled_sum[0][i], tol));
+    }
+
+    // The off-diagonal tiles are compressed, the more the larger the tolerance
+    REQUIRE(tight_compression < 1.0);
+    REQUIRE(loose_compression < tight_compression);
+}
+
+TEST_CASE("GP CPU HODLR solver with a tight tolerance is exact", "[integration][cpu]")
+{
+    const std::size_t n_test = 100;
+
+    // Five training tiles, an unbalanced tree with a smaller last leaf
+    const test_data data(128, n_test);
+    gprat::GP gp = data.make_gp(5, 28);
+    gp.hodlr_tolerance = 1e-14;
+    const hpx_runtime_guard runtime;
+
+    const auto &test_input = data.test_input.data;
+    const auto tiled_sum = gp.predict_with_uncertainty(test_input, 4, 25);
+    const double loss = gp.calculate_loss();
+    const auto hodlr_sum = gp.predict_hodlr_with_uncertainty(test_input, 4, 25);
+    const auto hodlr_predictions = gp.predict_hodlr(test_input, 4, 25);
+    const double hodlr_loss = gp.calculate_hodlr_loss();
+
+    using Catch::Matchers::WithinAbs;
+    const double tol = 1e-8;
+    REQUIRE_THAT(hodlr_loss, WithinAbs(loss, tol));
+    for (std::size_t i = 0; i != n_test; ++i)
+    {
+        INFO("CPU HODLR prediction " << i);
+        REQUIRE_THAT(hodlr_sum[0][i], WithinAbs(tiled_sum[0][i], tol));
+        REQUIRE_THAT(hodlr_sum[1][i], WithinAbs(tiled_sum[1][i], tol));
+        REQUIRE_THAT(hodlr_predictions[i], WithinAbs(tiled_sum[0][i], tol));
+    }
+}
+
+TEST_CASE("GP CPU matrix-free conjugate gradient solver matches the Cholesky solver", "[integration][cpu]")
+{
+    const std::size_t n_test = 100;
+
+    // Four training tiles, the last one is smaller
+    const test_data data(128, n_test);
+    gprat::GP gp = data.make_gp(4, 35);
+    gp.cg_tolerance = 1e-12;
+    gp.cg_preconditioner_rank = 16;
+    const hpx_runtime_guard runtime;
+
+    const auto &test_input = data.test_input.data;
+    const auto tiled_sum = gp.predict_with_uncertainty(test_input, 4, 25);
+    const auto cg_sum = gp.predict_cg_with_uncertainty(test_input, 4, 25);
+    const auto cg_predictions = gp.predict_cg(test_input, 4, 25);
+    // Without the low-rank part of the preconditioner
+    gp.cg_preconditioner_rank = 0;
+    const auto unpreconditioned_predictions = gp.predict_cg(test_input, 4, 25);
+
+    using Catch::Matchers::WithinAbs;
+    const double tol = 1e-8;
+    for (std::size_t i = 0; i != n_test; ++i)
+    {
+        INFO("CPU conjugate gradient prediction " << i);
+        REQUIRE_THAT(cg_sum[0][i], WithinAbs(tiled_sum[0][i], tol));
+        REQUIRE_THAT(cg_sum[1][i], WithinAbs(tiled_sum[1][i], tol));
+        REQUIRE_THAT(cg_predictions[i], WithinAbs(tiled_sum[0][i], tol));
+        REQUIRE_THAT(unpreconditioned_predictions[i], WithinAbs(tiled_sum[0][i], tol));
+    }
+}
+
+TEST_CASE("GP CPU stochastic Lanczos quadrature approximates the loss and optimization", "[integration][cpu]")
+{
+    // Four training tiles, the last one is smaller
+    const test_data data(128, 0);
+    gprat::GP gp = data.make_gp(4, 35);
+    gprat::GP gp_slq = data.make_gp(4, 35);
+    gp_slq.slq_probes = 64;
+    gprat::GP gp_slq_accurate = data.make_gp(4, 35);
+    gp_slq_accurate.slq_probes = 1024;
+    const gprat_hyper::AdamParams adam_params(0.1, 0.9, 0.999, 1e-8, 10);
+    const hpx_runtime_guard runtime;
+
+    const double loss = gp.calculate_loss();
+    const double slq_loss = gp_slq.calculate_slq_loss();
+    const double repeated_slq_loss = gp_slq.calculate_slq_loss();
+    const double accurate_slq_loss = gp_slq_accurate.calculate_slq_loss();
+    const std::vector<double> losses = gp.optimize(adam_params);
+    const std::vector<double> slq_losses = gp_slq.optimize_slq(adam_params);
+
+    using Catch::Matchers::WithinAbs;
+    using Catch::Matchers::WithinRel;
+    // The estimates are stochastic, but reproducible for a seed
+    REQUIRE(slq_loss == Catch::Approx(repeated_slq_loss).epsilon(1e-12));
+    REQUIRE_THAT(slq_loss, WithinAbs(loss, 0.05));
+    // The error of the log-determinant estimate decreases with the square root of the number of probes
+    REQUIRE_THAT(accurate_slq_loss, WithinAbs(loss, 0.005));
+    REQUIRE(std::abs(accurate_slq_loss - loss) < std::abs(slq_loss - loss));
+    REQUIRE(slq_losses.size() == losses.size());
+    for (std::size_t i = 0; i != losses.size(); ++i)
+    {
+        INFO("CPU stochastic Lanczos quadrature loss " << i);
+        REQUIRE_THAT(slq_losses[i], WithinAbs(losses[i], 0.05));
+    }
+    REQUIRE_THAT(gp_slq.kernel_params.lengthscale, WithinRel(gp.kernel_params.lengthscale, 0.1));
+    REQUIRE_THAT(gp_slq.kernel_params.vertical_lengthscale, WithinRel(gp.kernel_params.vertical_lengthscale, 0.1));
+    REQUIRE_THAT(gp_slq.kernel_params.noise_variance, WithinRel(gp.kernel_params.noise_variance, 0.1));
+}
+
+TEST_CASE("GP CPU compactly supported kernel skips zero tiles independently of the ordering", "[integration][cpu]")
+{
+    const std::size_t n_test = 64;
+
+    // The lengthscale is the support radius of the Wendland kernel
+    const test_data data(128, n_test, 2);
+    gprat::GP gp = data.make_gp(8, 16, { 0.2, 1.0, 0.1 });
+    gprat::GP gp_ordered = data.make_gp(8, 16, { 0.2, 1.0, 0.1 });
+    gprat::GP gp_dense = data.make_gp(8, 16, { 100.0, 1.0, 0.1 });
+    gp_ordered.compact_reorder = false;
+    const gprat_hyper::AdamParams adam_params(0.1, 0.9, 0.999, 1e-8, 5);
+    const hpx_runtime_guard runtime;
+
+    const auto &test_input = data.test_input.data;
+    const double density = gp.calculate_compact_density();
+    const double ordered_density = gp_ordered.calculate_compact_density();
+    const double dense_density = gp_dense.calculate_compact_density();
+    const double loss = gp.calculate_compact_loss();
+    const double ordered_loss = gp_ordered.calculate_compact_loss();
+    const std::vector<double> predictions = gp.predict_compact(test_input, 4, 16);
+    const std::vector<std::vector<double>> uncertainty = gp.predict_compact_with_uncertainty(test_input, 4, 16);
+    const std::vector<std::vector<double>> ordered_uncertainty =
+        gp_ordered.predict_compact_with_uncertainty(test_input, 4, 16);
+    const std::vector<double> losses = gp.optimize_compact(adam_params);
+    const std::vector<double> ordered_losses = gp_ordered.optimize_compact(adam_params);
+
+    using Catch::Matchers::WithinAbs;
+    using Catch::Matchers::WithinRel;
+    REQUIRE(density < 1.0);
+    REQUIRE(ordered_density < 1.0);
+    REQUIRE(dense_density == Catch::Approx(1.0));
+    // The reordering changes the tiles but not the model
+    REQUIRE_THAT(loss, WithinAbs(ordered_loss, 1e-10));
+    REQUIRE(predictions.size() == n_test);
+    for (std::size_t i = 0; i != n_test; ++i)
+    {
+        INFO("CPU compactly supported kernel prediction " << i);
+        REQUIRE_THAT(predictions[i], WithinAbs(uncertainty[0][i], 1e-10));
+        REQUIRE_THAT(predictions[i], WithinAbs(ordered_uncertainty[0][i], 1e-10));
+        REQUIRE_THAT(uncertainty[1][i], WithinAbs(ordered_uncertainty[1][i], 1e-10));
+        REQUIRE(uncertainty[1][i] > 0.0);
+    }
+    REQUIRE(losses.size() == ordered_losses.size());
+    for (std::size_t i = 0; i != losses.size(); ++i)
+    {
+        INFO("CPU compactly supported kernel loss " << i);
+        REQUIRE_THAT(losses[i], WithinAbs(ordered_losses[i], 1e-10));
+    }
+    REQUIRE(losses.back() < losses.front());
+    REQUIRE_THAT(gp.kernel_params.lengthscale, WithinRel(gp_ordered.kernel_params.lengthscale, 1e-8));
+    REQUIRE_THAT(gp.kernel_params.noise_variance, WithinRel(gp_ordered.kernel_params.noise_variance, 1e-8));
+}
+
+TEST_CASE("GP CPU compactly supported kernel matches a dense Cholesky reference", "[integration][cpu]")
+{
+    const std::size_t n_train = 128;
+    const std::size_t n_test = 64;
+    const std::size_t n_reg = 2;
+    const double support = 0.2;
+    const double vertical_lengthscale = 1.0;
+    const double noise_variance = 0.1;
+
+    const test_data data(n_train, n_test, n_reg);
+    gprat::GP gp = data.make_gp(8, 16, { support, vertical_lengthscale, noise_variance });
+    const hpx_runtime_guard runtime;
+
+    const auto &training_input = data.training_input.data;
+    const auto &training_output = data.training_output.data;
+    const auto &test_input = data.test_input.data;
+    const std::vector<std::vector<double>> uncertainty = gp.predict_compact_with_uncertainty(test_input, 4, 16);
+    const double loss = gp.calculate_compact_loss();
+
+    // Wendland kernel of two regressors, (1 - r)^4 * (4 * r + 1) for r = distance / support < 1
+    const auto kernel = [&](const double *x, const double *z)
+    {
+        const double r = std::hypot(x[0] - z[0], x[1] - z[1]) / support;
+        return r < 1.0 ? vertical_lengthscale * std::pow(1.0 - r, 4) * (4.0 * r + 1.0) : 0.0;
+    };
+    // Dense K = L * L^T by an unblocked Cholesky decomposition
+    std::vector<double> L(n_train * n_train, 0.0);
+    for (std::size_t i = 0; i != n_train; ++i)
+    {
+        for (std::size_t j = 0; j <= i; ++j)
+        {
+            double value = kernel(&training_input[i], &training_input[j]) + (i == j ? noise_variance : 0.0);
+            for (std::size_t k = 0; k != j; ++k)
+            {
+                value -= L[i * n_train + k] * L[j * n_train + k];
+            }
+            L[i * n_train + j] = i == j ? std::sqrt(value) : value / L[j * n_train + j];
+        }
+    }
+    // Solve L * w = b in place
+    const auto forward_solve = [&](std::vector<double> &b)
+    {
+        for (std::size_t i = 0; i != n_train; ++i)
+        {
+            for (std::size_t k = 0; k != i; ++k)
+            {
+                b[i] -= L[i * n_train + k] * b[k];
+            }
+            b[i] /= L[i * n_train + i];
+        }
+    };
+    // Loss 0.5 / N * (y^T * K^-1 * y + log det(K) + N * log(2 * pi)) with beta = L^-1 * y
+    std::vector<double> beta(training_output.begin(), training_output.begin() + static_cast<std::ptrdiff_t>(n_train));
+    forward_solve(beta);
+    double reference_loss = static_cast<double>(n_train) * std::log(2.0 * std::acos(-1.0));
+    for (std::size_t i = 0; i != n_train; ++i)
+    {
+        reference_loss += beta[i] * beta[i] + 2.0 * std::log(L[i * n_train + i]);
+    }
+    reference_loss *= 0.5 / static_cast<double>(n_train);
+
+    using Catch::Matchers::WithinAbs;
+    const double tol = 1e-10;
+    REQUIRE_THAT(loss, WithinAbs(reference_loss, tol));
+    for (std::size_t j = 0; j != n_test; ++j)
+    {
+        // hat(y) = v^T * beta and sigma^2 = k(x, x) - v^T * v with v = L^-1 * k(X, x)
+        std::vector<double> v(n_train);
+        for (std::size_t i = 0; i != n_train; ++i)
+        {
+            v[i] = kernel(&training_input[i], &test_input[j]);
+        }
+        forward_solve(v);
+        double prediction = 0.0;
+        double variance = vertical_lengthscale;
+        for (std::size_t i = 0; i != n_train; ++i)
+        {
+            prediction += v[i] * beta[i];
+            variance -= v[i] * v[i];
+        }
+        INFO("CPU compactly supported kernel dense reference " << j);
+        REQUIRE_THAT(uncertainty[0][j], WithinAbs(prediction, tol));
+        REQUIRE_THAT(uncertainty[1][j], WithinAbs(variance, tol));
+    }
+}
+
 // Test for GPU
 TEST_CASE("GP GPU results match known-good values (no loss)", "[integration][gpu]")
 {